@@ -9,6 +9,17 @@ echo "Building GhostMem (Direct Compilation)..."
 g++ -std=c++17 -O2 -pthread \
     src/main.cpp \
     src/ghostmem/GhostMemoryManager.cpp \
+    src/ghostmem/GhostSharedMemory.cpp \
+    src/ghostmem/GhostBudgetCoordinator.cpp \
+    src/ghostmem/GhostStatsBlock.cpp \
+    src/ghostmem/GhostMetricsExporter.cpp \
+    src/ghostmem/GhostLog.cpp \
+    src/ghostmem/GhostSymbolizer.cpp \
+    src/ghostmem/GhostFaultDispatcher.cpp \
+    src/ghostmem/GhostChaCha20.cpp \
+    src/ghostmem/GhostCrc32c.cpp \
+    src/ghostmem/GhostPolicies.cpp \
+    src/ghostmem/GhostRealtime.cpp \
     src/3rdparty/lz4.c \
     -I src \
     -o ghostmem_demo
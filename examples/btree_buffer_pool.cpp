@@ -0,0 +1,286 @@
+/**
+ * @file btree_buffer_pool.cpp
+ * @brief B+tree index whose buffer pool lives in ghost memory
+ *
+ * Models a database that keeps its index pages in a buffer pool larger
+ * than the memory it is allowed to hold resident. Every tree node is one
+ * 4 KB page of the pool, so a node access is at most one fault.
+ *
+ * The benchmark inserts all keys in a scrambled order (leaves end up
+ * about 70% full, like a real index), then runs a query mix:
+ *   - 85% point lookups, nine in ten of them in a hot 5% key range
+ *   - 10% point lookups for keys that do not exist
+ *   - 5% range scans over 200 consecutive keys
+ * Throughput is queries per second, excluding the build.
+ *
+ * Usage: btree_buffer_pool [--budgets 512,2048,8192] [--scale F] [--disk PATH]
+ */
+
+#include "ghostmem_bench.h"
+
+#include <algorithm>
+
+namespace {
+
+const size_t kMaxKeys = 255;
+
+// One pool page
+struct Node {
+    uint16_t count;
+    uint16_t leaf;
+    uint32_t next;             // Next leaf (0 = last)
+    uint64_t keys[kMaxKeys];
+    union {
+        uint64_t values[kMaxKeys];
+        uint32_t children[kMaxKeys + 1];
+    };
+};
+static_assert(sizeof(Node) <= PAGE_SIZE, "a node must fit in one page");
+
+class BTree {
+public:
+    BTree(char* pool, size_t capacity) : pool_(pool), capacity_(capacity) {
+        root_ = NewNode(true);
+    }
+
+    void Insert(uint64_t key, uint64_t value) {
+        uint64_t up_key = 0;
+        uint32_t up_page = 0;
+        if (InsertInto(root_, key, value, up_key, up_page)) {
+            uint32_t root = NewNode(false);
+            Node* node = At(root);
+            node->count = 1;
+            node->keys[0] = up_key;
+            node->children[0] = root_;
+            node->children[1] = up_page;
+            root_ = root;
+        }
+    }
+
+    bool Find(uint64_t key, uint64_t& value) const {
+        const Node* node = Leaf(key);
+        size_t pos = std::lower_bound(node->keys, node->keys + node->count, key) - node->keys;
+        if (pos < node->count && node->keys[pos] == key) {
+            value = node->values[pos];
+            return true;
+        }
+        return false;
+    }
+
+    // Sum of the values of up to `count` keys starting at `key`
+    uint64_t Scan(uint64_t key, size_t count) const {
+        const Node* node = Leaf(key);
+        size_t pos = std::lower_bound(node->keys, node->keys + node->count, key) - node->keys;
+        uint64_t sum = 0;
+        while (count > 0) {
+            if (pos == node->count) {
+                if (node->next == 0) {
+                    break;
+                }
+                node = At(node->next);
+                pos = 0;
+                continue;
+            }
+            sum += node->values[pos++];
+            count--;
+        }
+        return sum;
+    }
+
+    size_t Pages() const { return next_free_; }
+
+private:
+    Node* At(uint32_t page) const {
+        return reinterpret_cast<Node*>(pool_ + (size_t)page * PAGE_SIZE);
+    }
+
+    uint32_t NewNode(bool leaf) {
+        if (next_free_ >= capacity_) {
+            fprintf(stderr, "Buffer pool exhausted (%zu pages)\n", capacity_);
+            exit(1);
+        }
+        uint32_t page = (uint32_t)next_free_++;
+        Node* node = At(page);
+        node->count = 0;
+        node->leaf = leaf ? 1 : 0;
+        node->next = 0;
+        return page;
+    }
+
+    const Node* Leaf(uint64_t key) const {
+        const Node* node = At(root_);
+        while (!node->leaf) {
+            size_t pos = std::upper_bound(node->keys, node->keys + node->count, key) - node->keys;
+            node = At(node->children[pos]);
+        }
+        return node;
+    }
+
+    // Returns true if `page` split; the new right sibling and its
+    // separator are returned through up_key / up_page
+    bool InsertInto(uint32_t page, uint64_t key, uint64_t value, uint64_t& up_key, uint32_t& up_page) {
+        Node* node = At(page);
+        if (node->leaf) {
+            size_t pos = std::lower_bound(node->keys, node->keys + node->count, key) - node->keys;
+            if (pos < node->count && node->keys[pos] == key) {
+                node->values[pos] = value;
+                return false;
+            }
+            if (node->count < kMaxKeys) {
+                std::copy_backward(node->keys + pos, node->keys + node->count, node->keys + node->count + 1);
+                std::copy_backward(node->values + pos, node->values + node->count, node->values + node->count + 1);
+                node->keys[pos] = key;
+                node->values[pos] = value;
+                node->count++;
+                return false;
+            }
+
+            uint64_t keys[kMaxKeys + 1];
+            uint64_t values[kMaxKeys + 1];
+            std::copy(node->keys, node->keys + pos, keys);
+            std::copy(node->values, node->values + pos, values);
+            keys[pos] = key;
+            values[pos] = value;
+            std::copy(node->keys + pos, node->keys + kMaxKeys, keys + pos + 1);
+            std::copy(node->values + pos, node->values + kMaxKeys, values + pos + 1);
+
+            uint32_t right_page = NewNode(true);
+            Node* right = At(right_page);
+            size_t left_count = (kMaxKeys + 1) / 2;
+            size_t right_count = kMaxKeys + 1 - left_count;
+            std::copy(keys, keys + left_count, node->keys);
+            std::copy(values, values + left_count, node->values);
+            std::copy(keys + left_count, keys + kMaxKeys + 1, right->keys);
+            std::copy(values + left_count, values + kMaxKeys + 1, right->values);
+            std::fill(node->keys + left_count, node->keys + kMaxKeys, 0);
+            std::fill(node->values + left_count, node->values + kMaxKeys, 0);
+            node->count = (uint16_t)left_count;
+            right->count = (uint16_t)right_count;
+            right->next = node->next;
+            node->next = right_page;
+            up_key = right->keys[0];
+            up_page = right_page;
+            return true;
+        }
+
+        size_t pos = std::upper_bound(node->keys, node->keys + node->count, key) - node->keys;
+        uint64_t child_key = 0;
+        uint32_t child_page = 0;
+        if (!InsertInto(node->children[pos], key, value, child_key, child_page)) {
+            return false;
+        }
+        if (node->count < kMaxKeys) {
+            std::copy_backward(node->keys + pos, node->keys + node->count, node->keys + node->count + 1);
+            std::copy_backward(node->children + pos + 1, node->children + node->count + 1,
+                               node->children + node->count + 2);
+            node->keys[pos] = child_key;
+            node->children[pos + 1] = child_page;
+            node->count++;
+            return false;
+        }
+
+        uint64_t keys[kMaxKeys + 1];
+        uint32_t children[kMaxKeys + 2];
+        std::copy(node->keys, node->keys + pos, keys);
+        keys[pos] = child_key;
+        std::copy(node->keys + pos, node->keys + kMaxKeys, keys + pos + 1);
+        std::copy(node->children, node->children + pos + 1, children);
+        children[pos + 1] = child_page;
+        std::copy(node->children + pos + 1, node->children + kMaxKeys + 1, children + pos + 2);
+
+        // The middle key moves up; the halves keep the keys on either side
+        uint32_t right_page = NewNode(false);
+        Node* right = At(right_page);
+        size_t left_count = (kMaxKeys + 1) / 2;
+        size_t right_count = kMaxKeys - left_count;
+        std::copy(keys, keys + left_count, node->keys);
+        std::copy(children, children + left_count + 1, node->children);
+        std::copy(keys + left_count + 1, keys + kMaxKeys + 1, right->keys);
+        std::copy(children + left_count + 1, children + kMaxKeys + 2, right->children);
+        std::fill(node->keys + left_count, node->keys + kMaxKeys, 0);
+        std::fill(node->children + left_count + 1, node->children + kMaxKeys + 1, 0);
+        node->count = (uint16_t)left_count;
+        right->count = (uint16_t)right_count;
+        up_key = keys[left_count];
+        up_page = right_page;
+        return true;
+    }
+
+    char* pool_;
+    size_t capacity_;
+    size_t next_free_ = 1;  // Page 0 is the pool header
+    uint32_t root_ = 0;
+};
+
+// Keys are spaced 16 apart with some jitter, so index i and key order agree
+uint64_t KeyAt(uint64_t i) {
+    return i * 16 + (BenchMix(i) & 7);
+}
+
+uint64_t ValueOf(uint64_t key) {
+    // Row ids: a table of a few million rows, stored next to the key
+    return (BenchMix(key) % 4000000) | ((uint64_t)(key & 0xFF) << 32);
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    BenchOptions options;
+    int parsed = BenchParseOptions(argc, argv,
+                                   "B+tree index in a ghost buffer pool: scrambled inserts, then a skewed\n"
+                                   "mix of point lookups and range scans.",
+                                   "512,2048,8192", options);
+    if (parsed != 0) {
+        return parsed == 1 ? 0 : 2;
+    }
+
+    const uint64_t num_keys = std::max<uint64_t>((uint64_t)(500000 * options.scale), 1000);
+    const uint64_t num_queries = std::max<uint64_t>((uint64_t)(400000 * options.scale), 1000);
+    const size_t capacity = (size_t)(num_keys * 2 / kMaxKeys) + 64;  // Nodes are at least half full
+
+    printf("B+tree buffer pool: %llu keys, %llu queries, pool of up to %zu pages (%.1f MiB)\n\n",
+           (unsigned long long)num_keys, (unsigned long long)num_queries, capacity,
+           capacity * PAGE_SIZE / (double)(1ULL << 20));
+
+    return BenchRunAll(options, "queries/s", [&](BenchArena& arena, BenchRow& row) {
+        BTree tree(arena.Array<char>(capacity * PAGE_SIZE), capacity);
+
+        // A multiplicative permutation of [0, num_keys): every key once, in
+        // no particular order (2654435761 is prime)
+        double build_start = BenchNow();
+        for (uint64_t j = 0; j < num_keys; j++) {
+            uint64_t i = (j * 2654435761ULL) % num_keys;
+            tree.Insert(KeyAt(i), ValueOf(KeyAt(i)));
+        }
+        double build_seconds = BenchNow() - build_start;
+        arena.SampleRss();
+
+        uint64_t checksum = tree.Pages();
+        uint64_t hot_base = num_keys / 3;
+        uint64_t hot_size = std::max<uint64_t>(num_keys / 20, 1);
+        double start = BenchNow();
+        for (uint64_t q = 0; q < num_queries; q++) {
+            uint64_t r = BenchMix(q ^ 0xB7EE);
+            unsigned kind = (unsigned)(r % 100);
+            uint64_t pick = r >> 8;
+            uint64_t value = 0;
+            if (kind < 85) {
+                uint64_t i = ((pick % 10) != 0) ? hot_base + (pick >> 4) % hot_size : (pick >> 4) % num_keys;
+                if (tree.Find(KeyAt(i), value)) {
+                    checksum += value;
+                }
+            } else if (kind < 95) {
+                checksum += tree.Find(KeyAt(pick % num_keys) + 8, value) ? 1 : 0;  // Never present
+            } else {
+                checksum = checksum * 31 + tree.Scan(KeyAt(pick % num_keys), 200);
+            }
+        }
+        row.seconds = BenchNow() - start;
+        row.work = (double)num_queries;
+        row.checksum = checksum;
+        char note[96];
+        snprintf(note, sizeof(note), "build: %.3f s, %.0f inserts/s, %zu pages", build_seconds,
+                 num_keys / std::max(build_seconds, 1e-9), tree.Pages());
+        row.note = note;
+    });
+}
@@ -0,0 +1,300 @@
+/**
+ * @file ghostmem_bench.h
+ * @brief Shared harness of the application benchmarks in examples/
+ *
+ * Each benchmark runs the same workload once on plain heap memory and
+ * then once per resident budget on ghost memory, and prints one row per
+ * run: time, throughput, RSS growth, faults, refaults and the
+ * compression ratio of the frozen data. Workloads return a checksum of
+ * their results; a ghost run that disagrees with the heap run fails the
+ * program (exit code 1).
+ *
+ * Options shared by all benchmarks:
+ *   --budgets N,N,...   Resident budgets in pages
+ *   --scale F           Multiplies the problem size (default 1.0)
+ *   --disk PATH         Freeze to this swap file instead of RAM
+ *   --skip-native       Only run the ghost budgets (no checksum reference)
+ */
+
+#pragma once
+
+#include "ghostmem/GhostMemoryManager.h"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#ifdef _WIN32
+#include <psapi.h>      // GetProcessMemoryInfo (windows.h comes with GhostMemoryManager.h)
+#else
+#include <unistd.h>     // sysconf
+#endif
+
+struct BenchOptions {
+    std::vector<size_t> budgets;
+    double scale = 1.0;
+    std::string disk_path;
+    bool native = true;
+};
+
+// One run of a workload; the workload fills in seconds, work and checksum
+struct BenchRow {
+    double seconds = 0.0;     ///< Time of the measured phases
+    double work = 0.0;        ///< Units processed in that time
+    uint64_t checksum = 0;
+    uint64_t rss_bytes = 0;   ///< Peak RSS growth over the run
+    uint64_t faults = 0;
+    uint64_t refaults = 0;
+    double ratio = 0.0;       ///< Frozen bytes / stored bytes (0 = nothing frozen)
+    std::string note;         ///< Printed below the row
+};
+
+inline uint64_t BenchMix(uint64_t value) {
+    // splitmix64 finalizer
+    value += 0x9E3779B97F4A7C15ULL;
+    value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    value = (value ^ (value >> 27)) * 0x94D049BB133111EBULL;
+    return value ^ (value >> 31);
+}
+
+inline double BenchNow() {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+inline uint64_t BenchResidentSetBytes() {
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS counters;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+        return counters.WorkingSetSize;
+    }
+    return 0;
+#elif defined(__linux__)
+    FILE* file = fopen("/proc/self/statm", "r");
+    if (file == nullptr) {
+        return 0;
+    }
+    unsigned long long size = 0;
+    unsigned long long resident = 0;
+    int fields = fscanf(file, "%llu %llu", &size, &resident);
+    fclose(file);
+    return (fields == 2) ? resident * (uint64_t)sysconf(_SC_PAGESIZE) : 0;
+#else
+    return 0;  // Not measured
+#endif
+}
+
+/**
+ * @brief Memory for one run: zeroed heap blocks or ghost allocations
+ *
+ * Everything allocated is released by the destructor. Ghost memory is
+ * tagged, so the ratio covers only the workload's own data.
+ */
+class BenchArena {
+public:
+    static const GhostTag kTag = 0xBE7C;
+
+    BenchArena(bool ghost, uint64_t rss_baseline) : ghost_(ghost), rss_baseline_(rss_baseline) {}
+
+    ~BenchArena() {
+        for (const Block& block : blocks_) {
+            if (ghost_) {
+                GhostMemoryManager::Instance().DeallocateGhost(block.data, block.size);
+            } else {
+                free(block.data);
+            }
+        }
+    }
+
+    BenchArena(const BenchArena&) = delete;
+    BenchArena& operator=(const BenchArena&) = delete;
+
+    bool IsGhost() const { return ghost_; }
+
+    template<typename T>
+    T* Array(size_t count) {
+        size_t size = count * sizeof(T);
+        void* data = ghost_ ? GhostMemoryManager::Instance().AllocateGhost(size, kTag) : calloc(size, 1);
+        if (data == nullptr) {
+            fprintf(stderr, "Allocation of %zu bytes failed\n", size);
+            exit(1);
+        }
+        blocks_.push_back(Block{data, size});
+        return static_cast<T*>(data);
+    }
+
+    // Call between phases; the row reports the highest value seen
+    void SampleRss() {
+        uint64_t rss = BenchResidentSetBytes();
+        if (rss > rss_baseline_ && rss - rss_baseline_ > peak_rss_) {
+            peak_rss_ = rss - rss_baseline_;
+        }
+    }
+
+    uint64_t PeakRss() const { return peak_rss_; }
+
+private:
+    struct Block {
+        void* data;
+        size_t size;
+    };
+
+    bool ghost_;
+    uint64_t rss_baseline_;
+    uint64_t peak_rss_ = 0;
+    std::vector<Block> blocks_;
+};
+
+inline void BenchUsage(const char* name, const char* description, const char* default_budgets) {
+    printf("Usage: %s [options]\n\n", name);
+    printf("%s\n", description);
+    printf("  --budgets N,N,...   Resident budgets in pages (default %s)\n", default_budgets);
+    printf("  --scale F           Multiplies the problem size (default 1.0)\n");
+    printf("  --disk PATH         Freeze to this swap file instead of RAM (removed at exit)\n");
+    printf("  --skip-native       Only run the ghost budgets (no checksum reference)\n");
+}
+
+inline bool BenchParseBudgets(const char* text, std::vector<size_t>& budgets) {
+    budgets.clear();
+    while (*text != '\0') {
+        char* end = nullptr;
+        unsigned long long value = strtoull(text, &end, 10);
+        if (end == text || value == 0) {
+            return false;
+        }
+        budgets.push_back((size_t)value);
+        text = (*end == ',') ? end + 1 : end;
+        if (*end != ',' && *end != '\0') {
+            return false;
+        }
+    }
+    return !budgets.empty();
+}
+
+/**
+ * @brief Parses the shared options
+ *
+ * @return 0 to run, 1 after printing help, 2 on bad arguments
+ */
+inline int BenchParseOptions(int argc, char** argv, const char* description, const char* default_budgets,
+                             BenchOptions& options) {
+    BenchParseBudgets(default_budgets, options.budgets);
+    for (int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+        const char* value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+        if (strcmp(arg, "-h") == 0 || strcmp(arg, "--help") == 0) {
+            BenchUsage(argv[0], description, default_budgets);
+            return 1;
+        }
+        if (strcmp(arg, "--skip-native") == 0) {
+            options.native = false;
+            continue;
+        }
+        if (value == nullptr) {
+            BenchUsage(argv[0], description, default_budgets);
+            return 2;
+        }
+        i++;
+        bool ok = true;
+        if (strcmp(arg, "--budgets") == 0) {
+            ok = BenchParseBudgets(value, options.budgets);
+        } else if (strcmp(arg, "--scale") == 0) {
+            options.scale = atof(value);
+            ok = options.scale > 0;
+        } else if (strcmp(arg, "--disk") == 0) {
+            options.disk_path = value;
+        } else {
+            ok = false;
+        }
+        if (!ok) {
+            BenchUsage(argv[0], description, default_budgets);
+            return 2;
+        }
+    }
+    return 0;
+}
+
+inline void BenchPrintRow(const char* label, const BenchRow& row, const char* unit) {
+    char ratio[16] = "-";
+    if (row.ratio > 0.0) {
+        snprintf(ratio, sizeof(ratio), "%.2fx", row.ratio);
+    }
+    printf("%-10s %9.3f %12.1f %-9s %9.1f %10llu %10llu %7s\n", label, row.seconds,
+           row.seconds > 0.0 ? row.work / row.seconds : 0.0, unit, row.rss_bytes / (double)(1ULL << 20),
+           (unsigned long long)row.faults, (unsigned long long)row.refaults, ratio);
+    if (!row.note.empty()) {
+        printf("           %s\n", row.note.c_str());
+    }
+    fflush(stdout);
+}
+
+/**
+ * @brief Runs a workload on the heap and under every budget
+ *
+ * @param workload Callable `void(BenchArena&, BenchRow&)`
+ * @return Exit code: 0, or 1 if a ghost run's checksum differs
+ */
+template<typename Workload>
+int BenchRunAll(const BenchOptions& options, const char* unit, Workload workload) {
+    printf("%-10s %9s %12s %-9s %9s %10s %10s %7s\n",
+           "budget", "time(s)", "throughput", "", "RSS(MiB)", "faults", "refaults", "ratio");
+
+    bool have_reference = false;
+    uint64_t reference = 0;
+    int result = 0;
+
+    if (options.native) {
+        BenchArena arena(false, BenchResidentSetBytes());
+        BenchRow row;
+        workload(arena, row);
+        arena.SampleRss();
+        row.rss_bytes = arena.PeakRss();
+        BenchPrintRow("heap", row, unit);
+        have_reference = true;
+        reference = row.checksum;
+    }
+
+    for (size_t budget : options.budgets) {
+        GhostConfig config;
+        config.max_memory_pages = budget;
+        config.use_disk_backing = !options.disk_path.empty();
+        if (config.use_disk_backing) {
+            config.disk_file_path = options.disk_path;
+        }
+        if (!GhostMemoryManager::Instance().Initialize(config)) {
+            fprintf(stderr, "Failed to initialize GhostMemoryManager\n");
+            return 1;
+        }
+
+        BenchRow row;
+        GhostStats before = GhostMemoryManager::Instance().GetStats();
+        {
+            BenchArena arena(true, BenchResidentSetBytes());
+            workload(arena, row);
+            arena.SampleRss();
+            row.rss_bytes = arena.PeakRss();
+            GhostStats after = GhostMemoryManager::Instance().GetStats();
+            row.faults = after.page_faults - before.page_faults;
+            row.refaults = after.refaults - before.refaults;
+            row.ratio = GhostMemoryManager::Instance().GetTagStats(BenchArena::kTag).compression_ratio;
+        }
+
+        char label[32];
+        snprintf(label, sizeof(label), "%zu", budget);
+        BenchPrintRow(label, row, unit);
+        if (have_reference && row.checksum != reference) {
+            printf("checksum mismatch: %016llx, heap run %016llx  FAIL\n",
+                   (unsigned long long)row.checksum, (unsigned long long)reference);
+            result = 1;
+        }
+    }
+
+    GhostMemoryManager::Instance().Initialize(GhostConfig());
+    if (!options.disk_path.empty()) {
+        remove(options.disk_path.c_str());
+    }
+    return result;
+}
@@ -0,0 +1,190 @@
+/**
+ * @file image_pipeline.cpp
+ * @brief Tiled image processing pipeline on ghost memory
+ *
+ * Images are stored as 64x64 8-bit tiles, one tile per 4 KB page, the
+ * layout image libraries use to keep neighbourhood operations local.
+ * Four stages run over a synthetic photo-like frame:
+ *   1. render   - gradients, discs and sensor noise (sequential writes)
+ *   2. blur     - 3x3 box filter into a second image; every output tile
+ *                 reads its eight neighbours, so the working set is three
+ *                 rows of tiles
+ *   3. tone map - lookup table applied in place, column by column
+ *   4. reduce   - 2x2 downsample into a quarter-size image and histogram
+ * Throughput is megapixels per second over all stages.
+ *
+ * Usage: image_pipeline [--budgets 128,512,2048] [--scale F] [--disk PATH]
+ */
+
+#include "ghostmem_bench.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+const size_t kTile = 64;
+static_assert(kTile * kTile == PAGE_SIZE, "a tile must be one page");
+
+struct TiledImage {
+    uint8_t* pixels;
+    size_t width;
+    size_t height;
+    size_t tiles_x;
+    size_t tiles_y;
+
+    TiledImage(BenchArena& arena, size_t w, size_t h)
+        : width(w), height(h), tiles_x(w / kTile), tiles_y(h / kTile) {
+        pixels = arena.Array<uint8_t>(w * h);
+    }
+
+    uint8_t* Tile(size_t tx, size_t ty) const {
+        return pixels + (ty * tiles_x + tx) * PAGE_SIZE;
+    }
+
+    // Pixel access with clamping at the image border
+    uint8_t At(long x, long y) const {
+        x = std::min<long>(std::max<long>(x, 0), (long)width - 1);
+        y = std::min<long>(std::max<long>(y, 0), (long)height - 1);
+        return Tile(x / kTile, y / kTile)[(y % kTile) * kTile + x % kTile];
+    }
+};
+
+void Render(TiledImage& image) {
+    for (size_t ty = 0; ty < image.tiles_y; ty++) {
+        for (size_t tx = 0; tx < image.tiles_x; tx++) {
+            uint8_t* tile = image.Tile(tx, ty);
+            for (size_t y = 0; y < kTile; y++) {
+                for (size_t x = 0; x < kTile; x++) {
+                    size_t gx = tx * kTile + x;
+                    size_t gy = ty * kTile + y;
+                    // Sky gradient, a few discs and 2-bit noise
+                    int value = (int)(gy * 160 / image.height) + (int)(gx * 40 / image.width);
+                    size_t cx = (gx / 700) * 700 + 350;
+                    size_t cy = (gy / 500) * 500 + 250;
+                    long dx = (long)gx - (long)cx;
+                    long dy = (long)gy - (long)cy;
+                    if (dx * dx + dy * dy < 180 * 180) {
+                        value = 200 - (int)((gx / 700 + gy / 500) % 5) * 30;
+                    }
+                    value += (int)(BenchMix(gy * image.width + gx) & 3);
+                    tile[y * kTile + x] = (uint8_t)std::min(value, 255);
+                }
+            }
+        }
+    }
+}
+
+void Blur(const TiledImage& src, TiledImage& dst) {
+    // Each output tile gathers a 66x66 halo from up to nine source tiles
+    uint8_t halo[(kTile + 2) * (kTile + 2)];
+    for (size_t ty = 0; ty < src.tiles_y; ty++) {
+        for (size_t tx = 0; tx < src.tiles_x; tx++) {
+            long x0 = (long)(tx * kTile) - 1;
+            long y0 = (long)(ty * kTile) - 1;
+            for (size_t y = 0; y < kTile + 2; y++) {
+                for (size_t x = 0; x < kTile + 2; x++) {
+                    halo[y * (kTile + 2) + x] = src.At(x0 + (long)x, y0 + (long)y);
+                }
+            }
+            uint8_t* out = dst.Tile(tx, ty);
+            for (size_t y = 0; y < kTile; y++) {
+                for (size_t x = 0; x < kTile; x++) {
+                    unsigned sum = 0;
+                    for (size_t ky = 0; ky < 3; ky++) {
+                        for (size_t kx = 0; kx < 3; kx++) {
+                            sum += halo[(y + ky) * (kTile + 2) + x + kx];
+                        }
+                    }
+                    out[y * kTile + x] = (uint8_t)(sum / 9);
+                }
+            }
+        }
+    }
+}
+
+void ToneMap(TiledImage& image) {
+    uint8_t lut[256];
+    for (int i = 0; i < 256; i++) {
+        lut[i] = (uint8_t)std::lround(255.0 * std::pow(i / 255.0, 0.8));
+    }
+    // Column-major tile order, as a vertical pass would run
+    for (size_t tx = 0; tx < image.tiles_x; tx++) {
+        for (size_t ty = 0; ty < image.tiles_y; ty++) {
+            uint8_t* tile = image.Tile(tx, ty);
+            for (size_t i = 0; i < PAGE_SIZE; i++) {
+                tile[i] = lut[tile[i]];
+            }
+        }
+    }
+}
+
+uint64_t Reduce(const TiledImage& src, TiledImage& half) {
+    uint64_t histogram[256] = {};
+    for (size_t ty = 0; ty < half.tiles_y; ty++) {
+        for (size_t tx = 0; tx < half.tiles_x; tx++) {
+            uint8_t* out = half.Tile(tx, ty);
+            for (size_t y = 0; y < kTile; y++) {
+                for (size_t x = 0; x < kTile; x++) {
+                    long sx = (long)((tx * kTile + x) * 2);
+                    long sy = (long)((ty * kTile + y) * 2);
+                    unsigned sum = src.At(sx, sy) + src.At(sx + 1, sy) + src.At(sx, sy + 1) + src.At(sx + 1, sy + 1);
+                    uint8_t value = (uint8_t)(sum / 4);
+                    out[y * kTile + x] = value;
+                    histogram[value]++;
+                }
+            }
+        }
+    }
+    uint64_t checksum = 0;
+    for (size_t i = 0; i < 256; i++) {
+        checksum = checksum * 1000003 + histogram[i];
+    }
+    return checksum;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    BenchOptions options;
+    int parsed = BenchParseOptions(argc, argv,
+                                   "Tiled image pipeline on ghost memory: render, 3x3 blur, tone map,\n"
+                                   "downsample and histogram.",
+                                   "128,512,2048", options);
+    if (parsed != 0) {
+        return parsed == 1 ? 0 : 2;
+    }
+
+    // 8192 x 4096 at scale 1: 32 MiB per full-size image
+    const size_t width = 8192;
+    const size_t height = std::max<size_t>((size_t)(4096 * options.scale) / (2 * kTile) * (2 * kTile), 2 * kTile);
+    printf("Image pipeline: %zux%zu pixels (%.1f MiB per image, %zu tiles per row)\n\n",
+           width, height, width * height / (double)(1ULL << 20), width / kTile);
+
+    return BenchRunAll(options, "Mpix/s", [&](BenchArena& arena, BenchRow& row) {
+        TiledImage frame(arena, width, height);
+        TiledImage blurred(arena, width, height);
+        TiledImage half(arena, width / 2, height / 2);
+
+        double stage_seconds[4];
+        double start = BenchNow();
+        Render(frame);
+        stage_seconds[0] = BenchNow() - start;
+        Blur(frame, blurred);
+        stage_seconds[1] = BenchNow() - start - stage_seconds[0];
+        ToneMap(blurred);
+        stage_seconds[2] = BenchNow() - start - stage_seconds[0] - stage_seconds[1];
+        arena.SampleRss();
+        row.checksum = Reduce(blurred, half);
+        row.seconds = BenchNow() - start;
+        stage_seconds[3] = row.seconds - stage_seconds[0] - stage_seconds[1] - stage_seconds[2];
+
+        // Every stage touches each full-size pixel once
+        row.work = 4.0 * width * height / 1e6;
+
+        char note[128];
+        snprintf(note, sizeof(note), "render %.3f s, blur %.3f s, tone map %.3f s, reduce %.3f s",
+                 stage_seconds[0], stage_seconds[1], stage_seconds[2], stage_seconds[3]);
+        row.note = note;
+    });
+}
@@ -30,3 +30,35 @@ template <typename T, typename U>
 bool operator==(const GhostAllocator<T>&, const GhostAllocator<U>&) { return true; }
 template <typename T, typename U>
 bool operator!=(const GhostAllocator<T>&, const GhostAllocator<U>&) { return false; }
+
+// Same as GhostAllocator, but every allocation is charged to a tag so that
+// per-tag statistics and resident quotas apply (see SetTagQuota)
+template <typename T, GhostTag Tag>
+struct TaggedGhostAllocator {
+    using value_type = T;
+
+    // Needed explicitly: the non-type parameter defeats std::allocator_traits' default rebind
+    template <typename U>
+    struct rebind {
+        using other = TaggedGhostAllocator<U, Tag>;
+    };
+
+    TaggedGhostAllocator() = default;
+    template <typename U> TaggedGhostAllocator(const TaggedGhostAllocator<U, Tag>&) {}
+
+    T* allocate(size_t n) {
+        size_t bytes = n * sizeof(T);
+        return static_cast<T*>(GhostMemoryManager::Instance().AllocateGhost(bytes, Tag));
+    }
+
+    void deallocate(T* p, size_t n) {
+        if (p != nullptr) {
+            GhostMemoryManager::Instance().DeallocateGhost(p, n * sizeof(T));
+        }
+    }
+};
+
+template <typename T, typename U, GhostTag Tag>
+bool operator==(const TaggedGhostAllocator<T, Tag>&, const TaggedGhostAllocator<U, Tag>&) { return true; }
+template <typename T, typename U, GhostTag Tag>
+bool operator!=(const TaggedGhostAllocator<T, Tag>&, const TaggedGhostAllocator<U, Tag>&) { return false; }
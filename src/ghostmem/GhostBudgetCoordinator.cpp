@@ -0,0 +1,487 @@
+/*******************************************************************************
+ * GhostMem - Virtual RAM through Transparent Compression
+ *
+ * Copyright (C) 2026 Swen Kalski
+ *
+ * This file is part of GhostMem.
+ *
+ * GhostMem is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GhostMem is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GhostMem. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Contact: kalski.swen@gmail.com
+ ******************************************************************************/
+
+/**
+ * @file GhostBudgetCoordinator.cpp
+ * @brief Host-wide resident budget sharing between GhostMem processes
+ *
+ * @author Swen Kalski
+ * @date 2026
+ */
+
+#include "GhostBudgetCoordinator.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <cerrno>
+#include <cstdio>       // snprintf
+#include <cstdlib>      // strtoull
+#include <cstring>      // strchr, strrchr
+#include <fcntl.h>      // open
+#include <signal.h>     // kill
+#include <unistd.h>     // getpid, read, close
+#endif
+
+namespace
+{
+    /// "GHOSTBUD" - marks a fully initialized region
+    const uint64_t kRegionMagic = 0x4755424F48545347ULL;
+
+    /// Fixed-point scale of the refault pressure (1.0 == 256)
+    const uint64_t kPressureScale = 256;
+
+    std::atomic<uint64_t> g_instance_counter{0};
+
+    uint64_t CurrentPid()
+    {
+#ifdef _WIN32
+        return (uint64_t)GetCurrentProcessId();
+#else
+        return (uint64_t)getpid();
+#endif
+    }
+
+    bool IsProcessAlive(uint64_t pid)
+    {
+#ifdef _WIN32
+        HANDLE process = OpenProcess(PROCESS_QUERY_LIMITED_INFORMATION, FALSE, (DWORD)pid);
+        if (process == NULL)
+        {
+            return GetLastError() == ERROR_ACCESS_DENIED;
+        }
+        DWORD exit_code = 0;
+        BOOL ok = GetExitCodeProcess(process, &exit_code);
+        CloseHandle(process);
+        return ok && exit_code == STILL_ACTIVE;
+#else
+        return kill((pid_t)pid, 0) == 0 || errno == EPERM;
+#endif
+    }
+
+    /// Start time of a process folded to 32 bits, 0 if unknown
+    uint32_t ProcessStartStamp(uint64_t pid)
+    {
+        uint64_t start = 0;
+#ifdef _WIN32
+        HANDLE process = OpenProcess(PROCESS_QUERY_LIMITED_INFORMATION, FALSE, (DWORD)pid);
+        if (process == NULL)
+        {
+            return 0;
+        }
+        FILETIME created, exited, kernel_time, user_time;
+        BOOL ok = GetProcessTimes(process, &created, &exited, &kernel_time, &user_time);
+        CloseHandle(process);
+        if (!ok)
+        {
+            return 0;
+        }
+        start = ((uint64_t)created.dwHighDateTime << 32) | created.dwLowDateTime;
+#elif defined(__linux__)
+        // Field 22 of /proc/<pid>/stat, in clock ticks since boot. Plain
+        // open/read: this can run inside the fault handler.
+        char path[64];
+        snprintf(path, sizeof(path), "/proc/%llu/stat", (unsigned long long)pid);
+        int fd = open(path, O_RDONLY);
+        if (fd < 0)
+        {
+            return 0;
+        }
+        char buffer[512];
+        ssize_t length = read(fd, buffer, sizeof(buffer) - 1);
+        close(fd);
+        if (length <= 0)
+        {
+            return 0;
+        }
+        buffer[length] = '\0';
+        
+        // The command name (field 2) may contain spaces; count from its end
+        const char* field = strrchr(buffer, ')');
+        for (int i = 3; i <= 22 && field != nullptr; i++)
+        {
+            field = strchr(field + 1, ' ');
+        }
+        if (field == nullptr)
+        {
+            return 0;
+        }
+        start = strtoull(field + 1, nullptr, 10);
+#else
+        (void)pid;
+#endif
+        return (uint32_t)(start ^ (start >> 32));
+    }
+
+    /// Identifies a process: start stamp in the high half, pid in the low
+    uint64_t OwnerId(uint64_t pid)
+    {
+        return ((uint64_t)ProcessStartStamp(pid) << 32) | (pid & 0xFFFFFFFFULL);
+    }
+
+    /// Whether the process an OwnerId() was taken from is still running
+    bool IsOwnerAlive(uint64_t owner)
+    {
+        uint64_t pid = owner & 0xFFFFFFFFULL;
+        if (!IsProcessAlive(pid))
+        {
+            return false;
+        }
+        
+        // Same pid, different start time: the pid was reused
+        uint32_t stamp = (uint32_t)(owner >> 32);
+        uint32_t current = ProcessStartStamp(pid);
+        return stamp == 0 || current == 0 || stamp == current;
+    }
+}
+
+struct GhostBudgetCoordinator::Slot
+{
+    std::atomic<uint64_t> token;          ///< Owner instance token, 0 = free
+    std::atomic<uint64_t> owner;          ///< OwnerId() of the owning process
+    std::atomic<uint64_t> demand_pages;   ///< Published demand
+    std::atomic<uint64_t> pressure;       ///< Smoothed refaults per update (x256)
+    std::atomic<uint64_t> granted_pages;  ///< Budget from the last rebalance
+};
+
+struct GhostBudgetCoordinator::Region
+{
+    std::atomic<uint64_t> magic;          ///< kRegionMagic once initialized
+    std::atomic<uint64_t> lock_owner;     ///< OwnerId() holding the lock, 0 = free
+    std::atomic<uint64_t> total_pages;    ///< Host-wide resident budget
+    std::atomic<uint64_t> min_pages;      ///< Per-participant floor
+    std::atomic<uint64_t> rebalances;     ///< Number of rebalances performed
+    Slot slots[kMaxParticipants];
+};
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free,
+              "Budget region requires address-free 64-bit atomics");
+
+GhostBudgetCoordinator::~GhostBudgetCoordinator()
+{
+    Detach();
+}
+
+bool GhostBudgetCoordinator::Attach(const std::string& name, size_t total_pages, size_t min_pages)
+{
+    Detach();
+
+    bool created = false;
+    if (!shm_.Open(name, sizeof(Region), true, false, &created))
+    {
+        return false;
+    }
+
+    region_ = static_cast<Region*>(shm_.Data());
+
+    if (created)
+    {
+        region_->total_pages.store(total_pages, std::memory_order_relaxed);
+        region_->min_pages.store(min_pages, std::memory_order_relaxed);
+        region_->magic.store(kRegionMagic, std::memory_order_release);
+    }
+    else
+    {
+        // Another process is creating the region right now - give it a moment
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+        while (region_->magic.load(std::memory_order_acquire) != kRegionMagic)
+        {
+            if (std::chrono::steady_clock::now() > deadline)
+            {
+                shm_.Close();
+                region_ = nullptr;
+                return false;
+            }
+            std::this_thread::yield();
+        }
+    }
+
+    token_ = (CurrentPid() << 24) | (++g_instance_counter & 0xFFFFFF);
+    owner_ = OwnerId(CurrentPid());
+    last_refaults_ = 0;
+
+    if (!ClaimSlot())
+    {
+        shm_.Close();
+        region_ = nullptr;
+        return false;
+    }
+    return true;
+}
+
+void GhostBudgetCoordinator::Detach()
+{
+    if (slot_)
+    {
+        Lock();
+        slot_->token.store(0, std::memory_order_release);
+        Rebalance();
+        Unlock();
+        slot_ = nullptr;
+    }
+
+    shm_.Close();
+    region_ = nullptr;
+}
+
+size_t GhostBudgetCoordinator::Update(size_t demand_pages, uint64_t total_refaults)
+{
+    if (!slot_)
+    {
+        return 0;
+    }
+
+    // Our slot may have been reclaimed if the region was reset underneath us
+    if (slot_->token.load(std::memory_order_acquire) != token_ && !ClaimSlot())
+    {
+        return 0;
+    }
+
+    uint64_t delta = (total_refaults >= last_refaults_) ? total_refaults - last_refaults_ : 0;
+    last_refaults_ = total_refaults;
+
+    uint64_t pressure = slot_->pressure.load(std::memory_order_relaxed);
+    pressure = (pressure * 3 + delta * kPressureScale) / 4;
+
+    slot_->demand_pages.store(demand_pages, std::memory_order_relaxed);
+    slot_->pressure.store(pressure, std::memory_order_relaxed);
+
+    Lock();
+    Rebalance();
+    Unlock();
+
+    return GrantedPages();
+}
+
+bool GhostBudgetCoordinator::Reclaim()
+{
+    if (!slot_)
+    {
+        return false;
+    }
+
+    Lock();
+    bool reclaimed = ReclaimDeadParticipants();
+    Unlock();
+    return reclaimed;
+}
+
+size_t GhostBudgetCoordinator::GrantedPages() const
+{
+    return slot_ ? (size_t)slot_->granted_pages.load(std::memory_order_acquire) : 0;
+}
+
+size_t GhostBudgetCoordinator::TotalPages() const
+{
+    return region_ ? (size_t)region_->total_pages.load(std::memory_order_relaxed) : 0;
+}
+
+size_t GhostBudgetCoordinator::ParticipantCount() const
+{
+    if (!region_)
+    {
+        return 0;
+    }
+
+    size_t count = 0;
+    for (const Slot& slot : region_->slots)
+    {
+        if (slot.token.load(std::memory_order_acquire) != 0)
+        {
+            count++;
+        }
+    }
+    return count;
+}
+
+void GhostBudgetCoordinator::Lock()
+{
+    unsigned spins = 0;
+
+    for (;;)
+    {
+        uint64_t expected = 0;
+        if (region_->lock_owner.compare_exchange_weak(expected, owner_, std::memory_order_acquire))
+        {
+            return;
+        }
+
+        // A participant that died while holding the lock must not wedge the host
+        if (++spins % 1024 == 0 && expected != owner_ && !IsOwnerAlive(expected))
+        {
+            region_->lock_owner.compare_exchange_strong(expected, 0, std::memory_order_relaxed);
+        }
+        std::this_thread::yield();
+    }
+}
+
+void GhostBudgetCoordinator::Unlock()
+{
+    region_->lock_owner.store(0, std::memory_order_release);
+}
+
+bool GhostBudgetCoordinator::ClaimSlot()
+{
+    // Note: Caller must NOT hold the region lock
+
+    slot_ = nullptr;
+
+    Lock();
+    ReclaimDeadParticipants();
+
+    for (Slot& slot : region_->slots)
+    {
+        if (slot.token.load(std::memory_order_acquire) == 0)
+        {
+            slot.owner.store(owner_, std::memory_order_relaxed);
+            slot.demand_pages.store(0, std::memory_order_relaxed);
+            slot.pressure.store(0, std::memory_order_relaxed);
+            slot.granted_pages.store(0, std::memory_order_relaxed);
+            slot.token.store(token_, std::memory_order_release);
+            slot_ = &slot;
+            break;
+        }
+    }
+
+    if (slot_)
+    {
+        Rebalance();
+    }
+    Unlock();
+
+    return slot_ != nullptr;
+}
+
+bool GhostBudgetCoordinator::ReclaimDeadParticipants()
+{
+    // Note: Caller must hold the region lock
+
+    bool reclaimed = false;
+    for (Slot& slot : region_->slots)
+    {
+        if (slot.token.load(std::memory_order_acquire) != 0 &&
+            !IsOwnerAlive(slot.owner.load(std::memory_order_relaxed)))
+        {
+            slot.token.store(0, std::memory_order_release);
+            reclaimed = true;
+        }
+    }
+    return reclaimed;
+}
+
+void GhostBudgetCoordinator::Rebalance()
+{
+    // Note: Caller must hold the region lock
+
+    Slot* active[kMaxParticipants];
+    uint64_t grant[kMaxParticipants];
+    uint64_t want[kMaxParticipants];
+    size_t n = 0;
+
+    for (Slot& slot : region_->slots)
+    {
+        if (slot.token.load(std::memory_order_acquire) != 0)
+        {
+            active[n++] = &slot;
+        }
+    }
+
+    if (n == 0)
+    {
+        return;
+    }
+
+    const uint64_t total = region_->total_pages.load(std::memory_order_relaxed);
+    uint64_t floor = region_->min_pages.load(std::memory_order_relaxed);
+    if (floor * n > total)
+    {
+        floor = total / n;
+    }
+
+    uint64_t remaining = total - floor * n;
+    for (size_t i = 0; i < n; i++)
+    {
+        uint64_t demand = active[i]->demand_pages.load(std::memory_order_relaxed);
+        grant[i] = floor;
+        want[i] = (demand > floor) ? demand - floor : 0;
+    }
+
+    // Water-fill the remaining pages towards demand, weighted by pressure
+    while (remaining > 0)
+    {
+        double weight_sum = 0.0;
+        for (size_t i = 0; i < n; i++)
+        {
+            if (want[i] > 0)
+            {
+                weight_sum += (double)(active[i]->pressure.load(std::memory_order_relaxed) + kPressureScale);
+            }
+        }
+        if (weight_sum == 0.0)
+        {
+            break;  // Every demand is satisfied
+        }
+
+        uint64_t distributed = 0;
+        for (size_t i = 0; i < n && distributed < remaining; i++)
+        {
+            if (want[i] == 0)
+            {
+                continue;
+            }
+
+            double weight = (double)(active[i]->pressure.load(std::memory_order_relaxed) + kPressureScale);
+            uint64_t share = (uint64_t)((double)remaining * weight / weight_sum);
+            if (share == 0)
+            {
+                share = 1;  // Guarantee progress on tiny remainders
+            }
+            share = std::min(share, want[i]);
+            share = std::min(share, remaining - distributed);
+
+            grant[i] += share;
+            want[i] -= share;
+            distributed += share;
+        }
+
+        remaining -= distributed;
+        if (distributed == 0)
+        {
+            break;
+        }
+    }
+
+    // Whatever nobody asked for becomes burst headroom
+    for (size_t i = 0; i < n; i++)
+    {
+        grant[i] += remaining / n + ((i < remaining % n) ? 1 : 0);
+        active[i]->granted_pages.store(grant[i], std::memory_order_release);
+    }
+
+    region_->rebalances.fetch_add(1, std::memory_order_relaxed);
+}
@@ -0,0 +1,146 @@
+/*******************************************************************************
+ * GhostMem - Virtual RAM through Transparent Compression
+ *
+ * Copyright (C) 2026 Swen Kalski
+ *
+ * This file is part of GhostMem.
+ *
+ * GhostMem is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GhostMem is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GhostMem. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Contact: kalski.swen@gmail.com
+ ******************************************************************************/
+
+/**
+ * @file GhostBudgetCoordinator.h
+ * @brief Host-wide resident budget sharing between GhostMem processes
+ *
+ * Processes that opt in attach to a named shared memory region, publish
+ * their demand (pages holding data) and refault pressure, and receive a
+ * resident page budget. There is no daemon: whichever participant
+ * publishes an update rebalances the whole table under a cross-process
+ * spinlock.
+ *
+ * Rebalancing policy:
+ * 1. Every participant gets a floor of min_pages (or an equal split of
+ *    the host budget if the floors alone would not fit)
+ * 2. The remaining pages are water-filled towards each participant's
+ *    demand, weighted by its smoothed refault rate, so processes that
+ *    actually thrash receive the pages that improve host-wide hit ratio
+ * 3. Pages left after every demand is satisfied are split evenly as
+ *    headroom for bursts
+ *
+ * Participants whose process has died are reclaimed by Reclaim(), and
+ * the lock of a participant that died holding it by whoever waits for
+ * it. Processes are identified by pid and start time, so a reused pid is
+ * not mistaken for the process that died.
+ *
+ * @author Swen Kalski
+ * @date 2026
+ */
+
+#pragma once
+
+#include "GhostSharedMemory.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/**
+ * @class GhostBudgetCoordinator
+ * @brief One participant's handle on the shared budget table
+ *
+ * Thread Safety: Not thread-safe. The owning GhostMemoryManager calls it
+ * with mutex_ held. Multiple instances (in one or many processes) may
+ * attach to the same region concurrently.
+ */
+class GhostBudgetCoordinator
+{
+public:
+    /// Maximum number of processes sharing one region
+    static constexpr size_t kMaxParticipants = 32;
+
+    GhostBudgetCoordinator() = default;
+    ~GhostBudgetCoordinator();
+
+    GhostBudgetCoordinator(const GhostBudgetCoordinator&) = delete;
+    GhostBudgetCoordinator& operator=(const GhostBudgetCoordinator&) = delete;
+
+    /**
+     * @brief Attaches to (or creates) the named budget region
+     *
+     * @param name Region name shared by all participating processes
+     * @param total_pages Host-wide resident budget in pages. Only used by
+     *                    the process that creates the region.
+     * @param min_pages Minimum budget every participant is granted. Only
+     *                  used by the process that creates the region.
+     * @return true if a participant slot was claimed, false if the region
+     *         could not be mapped or all slots are taken
+     */
+    bool Attach(const std::string& name, size_t total_pages, size_t min_pages);
+
+    /**
+     * @brief Releases this participant's slot and rebalances the others
+     */
+    void Detach();
+
+    /**
+     * @brief Publishes demand and pressure, then rebalances
+     *
+     * @param demand_pages Pages this process holds data in (resident + frozen)
+     * @param total_refaults Cumulative refault counter of this process;
+     *                       the coordinator derives the rate itself
+     * @return The resident budget granted to this process (0 if detached)
+     */
+    size_t Update(size_t demand_pages, uint64_t total_refaults);
+
+    /**
+     * @brief Frees the slots of participants whose process has died
+     *
+     * Checks every slot's owner with a system call, so it is kept out of
+     * Update() (which runs on the fault path). The freed pages go to the
+     * others at the next rebalance.
+     *
+     * @return true if a slot was freed
+     */
+    bool Reclaim();
+
+    /// @brief Budget granted by the last rebalance (0 if detached)
+    size_t GrantedPages() const;
+
+    /// @brief Host-wide budget stored in the region
+    size_t TotalPages() const;
+
+    /// @brief Number of live participants in the region
+    size_t ParticipantCount() const;
+
+    bool IsAttached() const { return slot_ != nullptr; }
+
+private:
+    struct Region;
+    struct Slot;
+
+    void Lock();
+    void Unlock();
+    void Rebalance();
+    bool ReclaimDeadParticipants();
+    bool ClaimSlot();
+
+    GhostSharedMemory shm_;
+    Region* region_ = nullptr;
+    Slot* slot_ = nullptr;
+    uint64_t token_ = 0;
+    uint64_t owner_ = 0;
+    uint64_t last_refaults_ = 0;
+};
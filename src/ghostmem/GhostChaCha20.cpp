@@ -0,0 +1,173 @@
+/*******************************************************************************
+ * GhostMem - Virtual RAM through Transparent Compression
+ *
+ * Copyright (C) 2026 Swen Kalski
+ *
+ * This file is part of GhostMem.
+ *
+ * GhostMem is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GhostMem is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GhostMem. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Contact: kalski.swen@gmail.com
+ ******************************************************************************/
+
+/**
+ * @file GhostChaCha20.cpp
+ * @brief ChaCha20 stream cipher (RFC 8439) and key generation
+ *
+ * @author Swen Kalski
+ * @date 2026
+ */
+
+#include "GhostChaCha20.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#include <wincrypt.h>   // CryptGenRandom for secure random numbers
+#pragma comment(lib, "Advapi32.lib")
+#else
+#include <fcntl.h>      // open
+#include <unistd.h>     // read, close
+#endif
+
+namespace
+{
+    void QuarterRound(uint32_t *state, int a, int b, int c, int d)
+    {
+        state[a] += state[b]; state[d] ^= state[a]; state[d] = (state[d] << 16) | (state[d] >> 16);
+        state[c] += state[d]; state[b] ^= state[c]; state[b] = (state[b] << 12) | (state[b] >> 20);
+        state[a] += state[b]; state[d] ^= state[a]; state[d] = (state[d] << 8)  | (state[d] >> 24);
+        state[c] += state[d]; state[b] ^= state[c]; state[b] = (state[b] << 7)  | (state[b] >> 25);
+    }
+
+    uint32_t LoadLittleEndian(const unsigned char *bytes)
+    {
+        return (uint32_t)bytes[0] | ((uint32_t)bytes[1] << 8) |
+               ((uint32_t)bytes[2] << 16) | ((uint32_t)bytes[3] << 24);
+    }
+}
+
+void GhostChaCha20Block(const uint32_t *state, unsigned char *output)
+{
+    uint32_t working_state[16];
+    memcpy(working_state, state, 64);
+
+    // 20 rounds (10 double rounds)
+    for (int i = 0; i < 10; i++)
+    {
+        // Column rounds
+        QuarterRound(working_state, 0, 4, 8, 12);
+        QuarterRound(working_state, 1, 5, 9, 13);
+        QuarterRound(working_state, 2, 6, 10, 14);
+        QuarterRound(working_state, 3, 7, 11, 15);
+
+        // Diagonal rounds
+        QuarterRound(working_state, 0, 5, 10, 15);
+        QuarterRound(working_state, 1, 6, 11, 12);
+        QuarterRound(working_state, 2, 7, 8, 13);
+        QuarterRound(working_state, 3, 4, 9, 14);
+    }
+
+    // Add original state
+    for (int i = 0; i < 16; i++)
+    {
+        working_state[i] += state[i];
+    }
+
+    // Serialize to little-endian bytes
+    for (int i = 0; i < 16; i++)
+    {
+        output[i * 4 + 0] = (working_state[i] >> 0) & 0xFF;
+        output[i * 4 + 1] = (working_state[i] >> 8) & 0xFF;
+        output[i * 4 + 2] = (working_state[i] >> 16) & 0xFF;
+        output[i * 4 + 3] = (working_state[i] >> 24) & 0xFF;
+    }
+}
+
+void GhostChaCha20Crypt(const unsigned char *key, const unsigned char *nonce,
+                        uint32_t counter, unsigned char *data, size_t size)
+{
+    uint32_t state[16];
+
+    // Constants "expand 32-byte k"
+    state[0] = 0x61707865;
+    state[1] = 0x3320646e;
+    state[2] = 0x79622d32;
+    state[3] = 0x6b206574;
+
+    // Key (32 bytes = 8 words)
+    for (int i = 0; i < 8; i++)
+    {
+        state[4 + i] = LoadLittleEndian(key + i * 4);
+    }
+
+    // Block counter, then nonce (12 bytes = 3 words)
+    state[12] = counter;
+    state[13] = LoadLittleEndian(nonce + 0);
+    state[14] = LoadLittleEndian(nonce + 4);
+    state[15] = LoadLittleEndian(nonce + 8);
+
+    // Process data in 64-byte blocks
+    unsigned char keystream[64];
+    size_t offset = 0;
+
+    while (offset < size)
+    {
+        GhostChaCha20Block(state, keystream);
+
+        size_t block_size = (size - offset < 64) ? (size - offset) : 64;
+        for (size_t i = 0; i < block_size; i++)
+        {
+            data[offset + i] ^= keystream[i];
+        }
+
+        offset += block_size;
+        state[12]++;  // Increment block counter
+    }
+}
+
+bool GhostRandomBytes(unsigned char *buffer, size_t size)
+{
+#ifdef _WIN32
+    HCRYPTPROV hCryptProv = 0;
+
+    if (!CryptAcquireContext(&hCryptProv, NULL, NULL, PROV_RSA_FULL, CRYPT_VERIFYCONTEXT))
+    {
+        return false;
+    }
+
+    BOOL result = CryptGenRandom(hCryptProv, (DWORD)size, buffer);
+    CryptReleaseContext(hCryptProv, 0);
+    return result != FALSE;
+#else
+    int fd = open("/dev/urandom", O_RDONLY);
+    if (fd < 0)
+    {
+        return false;
+    }
+
+    size_t filled = 0;
+    while (filled < size)
+    {
+        ssize_t bytes_read = read(fd, buffer + filled, size - filled);
+        if (bytes_read <= 0)
+        {
+            close(fd);
+            return false;
+        }
+        filled += (size_t)bytes_read;
+    }
+    close(fd);
+    return true;
+#endif
+}
@@ -0,0 +1,85 @@
+/*******************************************************************************
+ * GhostMem - Virtual RAM through Transparent Compression
+ *
+ * Copyright (C) 2026 Swen Kalski
+ *
+ * This file is part of GhostMem.
+ *
+ * GhostMem is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GhostMem is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GhostMem. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Contact: kalski.swen@gmail.com
+ ******************************************************************************/
+
+/**
+ * @file GhostChaCha20.h
+ * @brief ChaCha20 stream cipher (RFC 8439) and key generation
+ *
+ * Used for encrypting pages written to the swap file, by both
+ * GhostMemoryManager and the GhostChaCha20Cipher policy.
+ *
+ * @author Swen Kalski
+ * @date 2026
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+/// Key size in bytes (256 bit)
+const size_t GHOST_CHACHA20_KEY_SIZE = 32;
+
+/// Nonce size in bytes (96 bit)
+const size_t GHOST_CHACHA20_NONCE_SIZE = 12;
+
+/**
+ * @brief Computes one 64-byte keystream block
+ * @param state Initial 16-word state (constants, key, counter, nonce)
+ * @param output 64-byte output buffer
+ */
+void GhostChaCha20Block(const uint32_t *state, unsigned char *output);
+
+/**
+ * @brief Encrypts or decrypts a buffer in place
+ *
+ * ChaCha20 is symmetric, so the same call encrypts and decrypts.
+ *
+ * @param key 32-byte key
+ * @param nonce 12-byte nonce
+ * @param counter Block counter of the first 64 bytes
+ * @param data Buffer to transform
+ * @param size Size of the buffer in bytes
+ */
+void GhostChaCha20Crypt(const unsigned char *key, const unsigned char *nonce,
+                        uint32_t counter, unsigned char *data, size_t size);
+
+/**
+ * @brief Fills a buffer from the platform CSPRNG
+ *
+ * CryptGenRandom on Windows, /dev/urandom elsewhere.
+ *
+ * @return false if the random source is unavailable
+ */
+bool GhostRandomBytes(unsigned char *buffer, size_t size);
+
+/**
+ * @brief Nonce for a page: its address, zero-padded to 12 bytes
+ */
+inline void GhostChaCha20PageNonce(const void *page, unsigned char *nonce)
+{
+    memset(nonce, 0, GHOST_CHACHA20_NONCE_SIZE);
+    uintptr_t addr = (uintptr_t)page;
+    memcpy(nonce, &addr, sizeof(addr) < GHOST_CHACHA20_NONCE_SIZE ? sizeof(addr) : GHOST_CHACHA20_NONCE_SIZE);
+}
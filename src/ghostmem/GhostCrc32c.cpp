@@ -0,0 +1,165 @@
+/*******************************************************************************
+ * GhostMem - Virtual RAM through Transparent Compression
+ *
+ * Copyright (C) 2026 Swen Kalski
+ *
+ * This file is part of GhostMem.
+ *
+ * GhostMem is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GhostMem is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GhostMem. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Contact: kalski.swen@gmail.com
+ ******************************************************************************/
+
+/**
+ * @file GhostCrc32c.cpp
+ * @brief Hardware and software CRC32C
+ *
+ * @author Swen Kalski
+ * @date 2026
+ */
+
+#include "GhostCrc32c.h"
+
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define GHOST_CRC32C_X86 1
+#include <nmmintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#elif defined(__aarch64__) && defined(__ARM_FEATURE_CRC32)
+#define GHOST_CRC32C_ARM 1
+#include <arm_acle.h>
+#endif
+
+namespace
+{
+    /// Reflected Castagnoli polynomial
+    constexpr uint32_t kPolynomial = 0x82F63B78u;
+
+    struct Crc32cTable
+    {
+        uint32_t entries[256];
+
+        constexpr Crc32cTable() : entries()
+        {
+            for (uint32_t i = 0; i < 256; i++)
+            {
+                uint32_t crc = i;
+                for (int bit = 0; bit < 8; bit++)
+                {
+                    crc = (crc >> 1) ^ ((crc & 1) ? kPolynomial : 0);
+                }
+                entries[i] = crc;
+            }
+        }
+    };
+
+    constexpr Crc32cTable kTable;
+
+#ifdef GHOST_CRC32C_X86
+#if defined(__GNUC__) || defined(__clang__)
+    __attribute__((target("sse4.2")))
+#endif
+    uint32_t Crc32cSse42(const unsigned char *bytes, size_t size, uint32_t crc)
+    {
+        uint64_t crc64 = crc;
+        while (size >= 8)
+        {
+            uint64_t word;
+            memcpy(&word, bytes, sizeof(word));
+            crc64 = _mm_crc32_u64(crc64, word);
+            bytes += 8;
+            size -= 8;
+        }
+        crc = (uint32_t)crc64;
+        while (size > 0)
+        {
+            crc = _mm_crc32_u8(crc, *bytes++);
+            size--;
+        }
+        return crc;
+    }
+
+    bool DetectSse42()
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        return __builtin_cpu_supports("sse4.2");
+#else
+        int info[4];
+        __cpuid(info, 1);
+        return (info[2] & (1 << 20)) != 0;
+#endif
+    }
+
+    const bool kHaveSse42 = DetectSse42();
+#endif
+
+#ifdef GHOST_CRC32C_ARM
+    uint32_t Crc32cArm(const unsigned char *bytes, size_t size, uint32_t crc)
+    {
+        while (size >= 8)
+        {
+            uint64_t word;
+            memcpy(&word, bytes, sizeof(word));
+            crc = __crc32cd(crc, word);
+            bytes += 8;
+            size -= 8;
+        }
+        while (size > 0)
+        {
+            crc = __crc32cb(crc, *bytes++);
+            size--;
+        }
+        return crc;
+    }
+#endif
+}
+
+uint32_t GhostCrc32cSoftware(const void *data, size_t size)
+{
+    const unsigned char *bytes = static_cast<const unsigned char *>(data);
+    uint32_t crc = 0xFFFFFFFFu;
+    for (size_t i = 0; i < size; i++)
+    {
+        crc = (crc >> 8) ^ kTable.entries[(crc ^ bytes[i]) & 0xFF];
+    }
+    return ~crc;
+}
+
+uint32_t GhostCrc32c(const void *data, size_t size)
+{
+    const unsigned char *bytes = static_cast<const unsigned char *>(data);
+#if defined(GHOST_CRC32C_X86)
+    if (kHaveSse42)
+    {
+        return ~Crc32cSse42(bytes, size, 0xFFFFFFFFu);
+    }
+#elif defined(GHOST_CRC32C_ARM)
+    return ~Crc32cArm(bytes, size, 0xFFFFFFFFu);
+#endif
+    return GhostCrc32cSoftware(bytes, size);
+}
+
+bool GhostCrc32cIsHardware()
+{
+#if defined(GHOST_CRC32C_X86)
+    return kHaveSse42;
+#elif defined(GHOST_CRC32C_ARM)
+    return true;
+#else
+    return false;
+#endif
+}
@@ -0,0 +1,55 @@
+/*******************************************************************************
+ * GhostMem - Virtual RAM through Transparent Compression
+ *
+ * Copyright (C) 2026 Swen Kalski
+ *
+ * This file is part of GhostMem.
+ *
+ * GhostMem is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GhostMem is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GhostMem. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Contact: kalski.swen@gmail.com
+ ******************************************************************************/
+
+/**
+ * @file GhostCrc32c.h
+ * @brief CRC32C (Castagnoli) checksums for swap file records
+ *
+ * Uses the SSE4.2 crc32 instruction on x86-64 (detected at runtime) and
+ * the ARMv8 CRC32 extension when the compiler targets it; other CPUs use
+ * a table-driven software implementation. All paths produce the standard
+ * CRC32C value ("123456789" -> 0xE3069283).
+ *
+ * @author Swen Kalski
+ * @date 2026
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief CRC32C of a buffer, using the fastest implementation available
+ */
+uint32_t GhostCrc32c(const void *data, size_t size);
+
+/**
+ * @brief CRC32C of a buffer, table-driven (reference implementation)
+ */
+uint32_t GhostCrc32cSoftware(const void *data, size_t size);
+
+/**
+ * @brief true if GhostCrc32c() uses CRC instructions on this CPU
+ */
+bool GhostCrc32cIsHardware();
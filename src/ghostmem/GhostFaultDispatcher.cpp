@@ -0,0 +1,190 @@
+/*******************************************************************************
+ * GhostMem - Virtual RAM through Transparent Compression
+ *
+ * Copyright (C) 2026 Swen Kalski
+ *
+ * This file is part of GhostMem.
+ *
+ * GhostMem is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GhostMem is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GhostMem. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Contact: kalski.swen@gmail.com
+ ******************************************************************************/
+
+/**
+ * @file GhostFaultDispatcher.cpp
+ * @brief Process-wide access fault hook shared by all GhostMem managers
+ *
+ * @author Swen Kalski
+ * @date 2026
+ */
+
+#include "GhostFaultDispatcher.h"
+#include "GhostTrace.h"
+
+#include <cstring>
+#include <mutex>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <signal.h>
+#include <ucontext.h>   // Faulting instruction pointer
+#endif
+
+GhostFaultDispatcher::Slot GhostFaultDispatcher::slots_[GhostFaultDispatcher::kMaxHandlers];
+
+namespace
+{
+    std::mutex &RegistryMutex()
+    {
+        static std::mutex mutex;
+        return mutex;
+    }
+
+    bool hook_installed = false;
+
+#ifdef _WIN32
+    LONG WINAPI VectoredHandler(PEXCEPTION_POINTERS pExceptionInfo)
+    {
+        if (pExceptionInfo->ExceptionRecord->ExceptionCode == EXCEPTION_ACCESS_VIOLATION)
+        {
+            void *fault_addr = (void *)pExceptionInfo->ExceptionRecord->ExceptionInformation[1];
+            GHOST_TRACE1(fault_entry, fault_addr);
+
+            if (GhostFaultDispatcher::Dispatch(fault_addr, pExceptionInfo->ExceptionRecord->ExceptionAddress))
+            {
+                return EXCEPTION_CONTINUE_EXECUTION;
+            }
+        }
+        return EXCEPTION_CONTINUE_SEARCH;
+    }
+#else
+    // Instruction that caused the fault, from the interrupted context
+    const void *FaultInstruction(void *context)
+    {
+#if defined(__linux__)
+        const ucontext_t *uc = static_cast<const ucontext_t *>(context);
+#if defined(__x86_64__)
+        return (const void *)uc->uc_mcontext.gregs[REG_RIP];
+#elif defined(__i386__)
+        return (const void *)uc->uc_mcontext.gregs[REG_EIP];
+#elif defined(__aarch64__)
+        return (const void *)uc->uc_mcontext.pc;
+#elif defined(__arm__)
+        return (const void *)uc->uc_mcontext.arm_pc;
+#else
+        (void)uc;
+        return nullptr;
+#endif
+#else
+        (void)context;
+        return nullptr;
+#endif
+    }
+
+    void SignalHandler(int sig, siginfo_t *info, void *context)
+    {
+        if (sig == SIGSEGV)
+        {
+            void *fault_addr = info->si_addr;
+            GHOST_TRACE1(fault_entry, fault_addr);
+
+            if (GhostFaultDispatcher::Dispatch(fault_addr, FaultInstruction(context)))
+            {
+                return; // Continue execution
+            }
+        }
+
+        // Not our fault address - reraise signal for default handling
+        signal(SIGSEGV, SIG_DFL);
+        raise(SIGSEGV);
+    }
+#endif
+}
+
+void GhostFaultDispatcher::InstallHook()
+{
+    // Note: Caller must hold the registry mutex
+
+    if (hook_installed)
+    {
+        return;
+    }
+
+#ifdef _WIN32
+    AddVectoredExceptionHandler(1, VectoredHandler);
+#else
+    struct sigaction sa;
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_flags = SA_SIGINFO;
+    sa.sa_sigaction = SignalHandler;
+    sigemptyset(&sa.sa_mask);
+    sigaction(SIGSEGV, &sa, nullptr);
+#endif
+    hook_installed = true;
+}
+
+bool GhostFaultDispatcher::Register(GhostFaultHandler handler, void *owner, bool first)
+{
+    std::lock_guard<std::mutex> lock(RegistryMutex());
+    InstallHook();
+
+    for (Slot &slot : slots_)
+    {
+        if (slot.handler.load(std::memory_order_relaxed) == nullptr)
+        {
+            // Owner first: a dispatching thread that sees the handler
+            // must also see its owner
+            slot.owner.store(owner, std::memory_order_relaxed);
+            slot.first.store(first, std::memory_order_relaxed);
+            slot.handler.store(handler, std::memory_order_release);
+            return true;
+        }
+    }
+    return false;
+}
+
+void GhostFaultDispatcher::Unregister(GhostFaultHandler handler, void *owner)
+{
+    std::lock_guard<std::mutex> lock(RegistryMutex());
+
+    for (Slot &slot : slots_)
+    {
+        if (slot.handler.load(std::memory_order_relaxed) == handler &&
+            slot.owner.load(std::memory_order_relaxed) == owner)
+        {
+            slot.handler.store(nullptr, std::memory_order_release);
+            slot.owner.store(nullptr, std::memory_order_relaxed);
+        }
+    }
+}
+
+bool GhostFaultDispatcher::Dispatch(void *fault_addr, const void *fault_ip)
+{
+    // Pass 0 offers the fault to the callbacks registered first, pass 1
+    // to the rest
+    for (int pass = 0; pass < 2; pass++)
+    {
+        for (Slot &slot : slots_)
+        {
+            GhostFaultHandler handler = slot.handler.load(std::memory_order_acquire);
+            if (handler != nullptr && slot.first.load(std::memory_order_relaxed) == (pass == 0) &&
+                handler(slot.owner.load(std::memory_order_relaxed), fault_addr, fault_ip))
+            {
+                return true;
+            }
+        }
+    }
+    return false;
+}
@@ -0,0 +1,104 @@
+/*******************************************************************************
+ * GhostMem - Virtual RAM through Transparent Compression
+ *
+ * Copyright (C) 2026 Swen Kalski
+ *
+ * This file is part of GhostMem.
+ *
+ * GhostMem is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GhostMem is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GhostMem. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Contact: kalski.swen@gmail.com
+ ******************************************************************************/
+
+/**
+ * @file GhostFaultDispatcher.h
+ * @brief Process-wide access fault hook shared by all GhostMem managers
+ *
+ * A process has one SIGSEGV disposition (one vectored handler chain on
+ * Windows), but GhostMem may run several managers side by side: the
+ * runtime-configured GhostMemoryManager singleton and any number of
+ * compile-time specialized BasicGhostManager instances. Each registers a
+ * callback here; the dispatcher installs the platform hook once and offers
+ * every fault to the registered callbacks until one claims it.
+ *
+ * @author Swen Kalski
+ * @date 2026
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+
+/**
+ * @brief Fault callback
+ *
+ * Called from the signal handler (Linux) or vectored exception handler
+ * (Windows) of the faulting thread.
+ *
+ * @param owner Value given at registration
+ * @param fault_addr Accessed address
+ * @param fault_ip Faulting instruction (nullptr where unavailable)
+ * @return true if the fault was resolved and the access can be retried
+ */
+using GhostFaultHandler = bool (*)(void *owner, void *fault_addr, const void *fault_ip);
+
+/**
+ * @class GhostFaultDispatcher
+ * @brief Registry of fault callbacks behind a single platform hook
+ *
+ * Registration is rare and serialized by a mutex; dispatch only reads a
+ * fixed slot array of atomics, so it needs no lock and no allocation.
+ */
+class GhostFaultDispatcher
+{
+public:
+    /// Maximum number of managers registered at the same time
+    static constexpr size_t kMaxHandlers = 16;
+
+    /**
+     * @brief Adds a callback, installing the platform hook on first use
+     * @param first Offer faults to this callback before the callbacks
+     *        registered without the flag (managers with a latency bound,
+     *        which must not wait behind another manager's lock)
+     * @return false if all slots are taken
+     */
+    static bool Register(GhostFaultHandler handler, void *owner, bool first = false);
+
+    /**
+     * @brief Removes a callback registered with the same handler and owner
+     *
+     * The caller must make sure no fault on its memory is in flight.
+     */
+    static void Unregister(GhostFaultHandler handler, void *owner);
+
+    /**
+     * @brief Offers a fault to the registered callbacks in slot order,
+     *        those registered with first = true before all others
+     * @return true if a callback resolved it
+     */
+    static bool Dispatch(void *fault_addr, const void *fault_ip);
+
+private:
+    struct Slot
+    {
+        std::atomic<GhostFaultHandler> handler;
+        std::atomic<void *> owner;
+        std::atomic<bool> first;
+    };
+
+    static Slot slots_[kMaxHandlers];
+
+    static void InstallHook();
+};
@@ -0,0 +1,592 @@
+/*******************************************************************************
+ * GhostMem - Virtual RAM through Transparent Compression
+ *
+ * Copyright (C) 2026 Swen Kalski
+ *
+ * This file is part of GhostMem.
+ *
+ * GhostMem is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GhostMem is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GhostMem. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Contact: kalski.swen@gmail.com
+ ******************************************************************************/
+
+/**
+ * @file GhostFixedPolicies.h
+ * @brief Fixed-capacity, heap-free policies for embedded targets
+ *
+ * The default policies keep their metadata in std::map, std::list and
+ * std::unordered_map and every compressed page in its own std::vector,
+ * so each fault and freeze allocates. On small heaps that fragments
+ * memory and makes the overhead hard to predict.
+ *
+ * The policies here keep everything in arrays sized by template
+ * parameters: open-addressing page tables, an index-linked LRU list, a
+ * sorted allocation table and a chunked pool for compressed pages. A
+ * manager built from them never touches the heap after construction, and
+ * sizeof(manager) is its complete metadata and storage footprint.
+ *
+ * @code
+ * // 64 frozen pages in a 64 KB pool, 8 resident pages, 4 allocations
+ * static GhostFixedManager<64, 64 * 1024, 8, 4> manager(8);
+ * @endcode
+ *
+ * @author Swen Kalski
+ * @date 2026
+ */
+
+#pragma once
+
+#include "GhostPolicyManager.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+// ============================================================================
+// GhostFixedPageMap - page address -> Value, fixed capacity
+// ============================================================================
+
+/**
+ * @class GhostFixedPageMap
+ * @brief Open-addressing hash table keyed by page address
+ *
+ * Linear probing with backward-shift deletion, so there are no tombstones
+ * and lookups stay short however many inserts and erases happen. The slot
+ * array is at least twice Capacity (load factor <= 0.5).
+ *
+ * @tparam Value Mapped type (trivially copyable)
+ * @tparam Capacity Maximum number of entries
+ */
+template <class Value, size_t Capacity>
+class GhostFixedPageMap
+{
+    static_assert(Capacity > 0, "GhostFixedPageMap needs a capacity");
+
+    static constexpr size_t SlotCount()
+    {
+        size_t slots = 1;
+        while (slots < Capacity * 2)
+        {
+            slots <<= 1;
+        }
+        return slots;
+    }
+
+public:
+    static constexpr size_t kSlots = SlotCount();
+
+    /// @return The value for page, nullptr if absent
+    Value *Find(const void *page)
+    {
+        for (size_t i = Home(page);; i = (i + 1) & (kSlots - 1))
+        {
+            if (keys_[i] == page)
+            {
+                return &values_[i];
+            }
+            if (keys_[i] == nullptr)
+            {
+                return nullptr;
+            }
+        }
+    }
+
+    const Value *Find(const void *page) const
+    {
+        return const_cast<GhostFixedPageMap *>(this)->Find(page);
+    }
+
+    /**
+     * @brief Adds or replaces the value for page
+     * @return The stored value, nullptr if the table is full
+     */
+    Value *Insert(const void *page, const Value &value)
+    {
+        size_t i = Home(page);
+        for (; keys_[i] != nullptr; i = (i + 1) & (kSlots - 1))
+        {
+            if (keys_[i] == page)
+            {
+                values_[i] = value;
+                return &values_[i];
+            }
+        }
+        if (count_ >= Capacity)
+        {
+            return nullptr;
+        }
+        keys_[i] = page;
+        values_[i] = value;
+        count_++;
+        return &values_[i];
+    }
+
+    /// @return false if page was not present
+    bool Erase(const void *page)
+    {
+        size_t i = Home(page);
+        while (keys_[i] != page)
+        {
+            if (keys_[i] == nullptr)
+            {
+                return false;
+            }
+            i = (i + 1) & (kSlots - 1);
+        }
+
+        // Pull later entries of the probe run back into the hole
+        size_t hole = i;
+        for (size_t j = (i + 1) & (kSlots - 1); keys_[j] != nullptr; j = (j + 1) & (kSlots - 1))
+        {
+            size_t home = Home(keys_[j]);
+            // Move j into the hole unless its home lies cyclically in (hole, j]
+            bool stays = (hole < j) ? (home > hole && home <= j) : (home > hole || home <= j);
+            if (!stays)
+            {
+                keys_[hole] = keys_[j];
+                values_[hole] = values_[j];
+                hole = j;
+            }
+        }
+        keys_[hole] = nullptr;
+        count_--;
+        return true;
+    }
+
+    size_t Size() const
+    {
+        return count_;
+    }
+
+    bool Full() const
+    {
+        return count_ >= Capacity;
+    }
+
+private:
+    static size_t Home(const void *page)
+    {
+        // Fibonacci hashing of the page number
+        uint64_t number = (uint64_t)(uintptr_t)page / PAGE_SIZE;
+        return (size_t)((number * 0x9E3779B97F4A7C15ULL) >> 32) & (kSlots - 1);
+    }
+
+    const void *keys_[kSlots] = {};
+    Value values_[kSlots] = {};
+    size_t count_ = 0;
+};
+
+// ============================================================================
+// Backing store
+// ============================================================================
+
+/**
+ * @class GhostFixedMemoryBacking
+ * @brief Compressed pages in a fixed pool of chunks
+ *
+ * A record occupies a chain of ChunkSize-byte chunks, so any free chunk
+ * serves any record and the pool does not fragment. Per chunk the
+ * overhead is one 32-bit link. Store() fails once MaxPages records are
+ * held or the pool has too few free chunks; the manager then keeps the
+ * page resident.
+ *
+ * A PoolBytes of MaxPages * Codec::kMaxEncodedSize (rounded up to whole
+ * chunks) guarantees that every frozen page fits.
+ *
+ * @tparam MaxPages Maximum number of frozen pages
+ * @tparam PoolBytes Bytes of compressed storage
+ * @tparam ChunkSize Allocation unit of the pool
+ */
+template <size_t MaxPages, size_t PoolBytes, size_t ChunkSize = 128>
+class GhostFixedMemoryBacking
+{
+    static_assert(ChunkSize >= 16 && PoolBytes >= ChunkSize, "Pool must hold at least one chunk");
+
+public:
+    static constexpr size_t kChunks = PoolBytes / ChunkSize;
+
+    GhostFixedMemoryBacking()
+    {
+        // Thread all chunks onto the free list
+        for (size_t i = 0; i < kChunks; i++)
+        {
+            next_[i] = (i + 1 < kChunks) ? (uint32_t)(i + 1) : kNone;
+        }
+        free_head_ = 0;
+        free_count_ = kChunks;
+    }
+
+    bool IsReady() const
+    {
+        return true;
+    }
+
+    bool Store(void *page, const char *data, size_t size)
+    {
+        Erase(page);
+
+        size_t needed = (size + ChunkSize - 1) / ChunkSize;
+        if (size == 0 || needed > free_count_ || records_.Full())
+        {
+            return false;
+        }
+
+        Record record;
+        record.size = (uint32_t)size;
+        record.first = free_head_;
+        uint32_t chunk = free_head_;
+        for (size_t offset = 0; offset < size; offset += ChunkSize)
+        {
+            size_t length = (size - offset < ChunkSize) ? size - offset : ChunkSize;
+            memcpy(pool_ + (size_t)chunk * ChunkSize, data + offset, length);
+            if (offset + ChunkSize < size)
+            {
+                chunk = next_[chunk];
+            }
+        }
+        free_head_ = next_[chunk];
+        next_[chunk] = kNone;
+        free_count_ -= needed;
+
+        records_.Insert(page, record);
+        bytes_ += size;
+        return true;
+    }
+
+    char *Load(void *page, char *scratch, size_t &size)
+    {
+        const Record *record = records_.Find(page);
+        if (!record)
+        {
+            return nullptr;
+        }
+
+        size = record->size;
+        uint32_t chunk = record->first;
+        for (size_t offset = 0; offset < size; offset += ChunkSize)
+        {
+            size_t length = (size - offset < ChunkSize) ? size - offset : ChunkSize;
+            memcpy(scratch + offset, pool_ + (size_t)chunk * ChunkSize, length);
+            chunk = next_[chunk];
+        }
+        return scratch;
+    }
+
+    void Erase(void *page)
+    {
+        Record *record = records_.Find(page);
+        if (!record)
+        {
+            return;
+        }
+
+        // Return the chain to the front of the free list
+        uint32_t last = record->first;
+        size_t chunks = 1;
+        while (next_[last] != kNone)
+        {
+            last = next_[last];
+            chunks++;
+        }
+        next_[last] = free_head_;
+        free_head_ = record->first;
+        free_count_ += chunks;
+        bytes_ -= record->size;
+        records_.Erase(page);
+    }
+
+    size_t Count() const
+    {
+        return records_.Size();
+    }
+
+    size_t MemoryBytes() const
+    {
+        return bytes_;
+    }
+
+    size_t DiskBytes() const
+    {
+        return 0;
+    }
+
+    /// Chunks not holding any record
+    size_t FreeChunks() const
+    {
+        return free_count_;
+    }
+
+private:
+    static constexpr uint32_t kNone = 0xFFFFFFFFu;
+
+    struct Record
+    {
+        uint32_t first;     ///< First chunk of the chain
+        uint32_t size;      ///< Record bytes
+    };
+
+    GhostFixedPageMap<Record, MaxPages> records_;
+    uint32_t next_[kChunks];        ///< Chunk chain / free list links
+    uint32_t free_head_ = kNone;
+    size_t free_count_ = 0;
+    size_t bytes_ = 0;
+    alignas(16) char pool_[kChunks * ChunkSize];
+};
+
+// ============================================================================
+// Eviction
+// ============================================================================
+
+/**
+ * @class GhostFixedLruEviction
+ * @brief GhostLruEviction with at most MaxResident pages, in arrays
+ *
+ * Full() reports when MaxResident pages are resident, so the manager
+ * evicts at that point even if its budget is larger.
+ */
+template <size_t MaxResident>
+class GhostFixedLruEviction
+{
+    static_assert(MaxResident > 0, "GhostFixedLruEviction needs a capacity");
+
+public:
+    GhostFixedLruEviction()
+    {
+        for (size_t i = 0; i < MaxResident; i++)
+        {
+            nodes_[i].next = (i + 1 < MaxResident) ? (uint32_t)(i + 1) : kNone;
+        }
+        free_ = 0;
+    }
+
+    void Insert(void *page)
+    {
+        if (free_ == kNone || index_.Find(page))
+        {
+            return;
+        }
+
+        uint32_t node = free_;
+        free_ = nodes_[node].next;
+        nodes_[node].page = page;
+        nodes_[node].prev = kNone;
+        nodes_[node].next = head_;
+        if (head_ != kNone)
+        {
+            nodes_[head_].prev = node;
+        }
+        head_ = node;
+        if (tail_ == kNone)
+        {
+            tail_ = node;
+        }
+        index_.Insert(page, node);
+    }
+
+    void Remove(void *page)
+    {
+        const uint32_t *node = index_.Find(page);
+        if (node)
+        {
+            Unlink(*node);
+        }
+    }
+
+    bool Contains(void *page) const
+    {
+        return index_.Find(page) != nullptr;
+    }
+
+    void *Victim()
+    {
+        if (tail_ == kNone)
+        {
+            return nullptr;
+        }
+        void *page = nodes_[tail_].page;
+        Unlink(tail_);
+        return page;
+    }
+
+    size_t Size() const
+    {
+        return index_.Size();
+    }
+
+    bool Full() const
+    {
+        return index_.Full();
+    }
+
+private:
+    static constexpr uint32_t kNone = 0xFFFFFFFFu;
+
+    struct Node
+    {
+        void *page = nullptr;
+        uint32_t prev = kNone;
+        uint32_t next = kNone;
+    };
+
+    void Unlink(uint32_t node)
+    {
+        Node &n = nodes_[node];
+        if (n.prev != kNone) nodes_[n.prev].next = n.next; else head_ = n.next;
+        if (n.next != kNone) nodes_[n.next].prev = n.prev; else tail_ = n.prev;
+        index_.Erase(n.page);
+        n.page = nullptr;
+        n.prev = kNone;
+        n.next = free_;
+        free_ = node;
+    }
+
+    Node nodes_[MaxResident];
+    GhostFixedPageMap<uint32_t, MaxResident> index_;
+    uint32_t head_ = kNone;     ///< Most recent fault
+    uint32_t tail_ = kNone;     ///< Next victim
+    uint32_t free_ = kNone;
+};
+
+// ============================================================================
+// Region table
+// ============================================================================
+
+/**
+ * @class GhostFixedRegions
+ * @brief Up to MaxRegions allocations in a sorted array
+ *
+ * Lookup is a binary search; Insert and Remove shift the array, which is
+ * cheap for the handful of large allocations embedded code makes.
+ */
+template <size_t MaxRegions>
+class GhostFixedRegions
+{
+    static_assert(MaxRegions > 0, "GhostFixedRegions needs a capacity");
+
+public:
+    bool Insert(void *start, size_t size)
+    {
+        if (count_ >= MaxRegions)
+        {
+            return false;
+        }
+        size_t i = LowerBound(start);
+        for (size_t j = count_; j > i; j--)
+        {
+            regions_[j] = regions_[j - 1];
+        }
+        regions_[i].start = start;
+        regions_[i].size = size;
+        count_++;
+        return true;
+    }
+
+    bool Remove(void *start, size_t &size)
+    {
+        size_t i = LowerBound(start);
+        if (i >= count_ || regions_[i].start != start)
+        {
+            return false;
+        }
+        size = regions_[i].size;
+        // count_ never exceeds MaxRegions; the second bound lets the
+        // compiler see that too (MaxRegions = 1 has nothing to shift)
+        for (size_t j = i + 1; j < count_ && j < MaxRegions; j++)
+        {
+            regions_[j - 1] = regions_[j];
+        }
+        count_--;
+        return true;
+    }
+
+    bool Lookup(const void *addr, void *&start, size_t &size) const
+    {
+        // Last region starting at or below addr
+        size_t i = LowerBound((const char *)addr + 1);
+        if (i == 0)
+        {
+            return false;
+        }
+        const Region &region = regions_[i - 1];
+        if ((uintptr_t)addr >= (uintptr_t)region.start + region.size)
+        {
+            return false;
+        }
+        start = region.start;
+        size = region.size;
+        return true;
+    }
+
+    template <class F>
+    void ForEach(F f)
+    {
+        for (size_t i = 0; i < count_; i++)
+        {
+            f(regions_[i].start, regions_[i].size);
+        }
+    }
+
+private:
+    struct Region
+    {
+        void *start = nullptr;
+        size_t size = 0;
+    };
+
+    /// First region whose start is not below addr
+    size_t LowerBound(const void *addr) const
+    {
+        size_t low = 0;
+        size_t high = count_;
+        while (low < high)
+        {
+            size_t mid = (low + high) / 2;
+            if ((uintptr_t)regions_[mid].start < (uintptr_t)addr)
+            {
+                low = mid + 1;
+            }
+            else
+            {
+                high = mid;
+            }
+        }
+        return low;
+    }
+
+    Region regions_[MaxRegions];
+    size_t count_ = 0;
+};
+
+// ============================================================================
+// Configuration
+// ============================================================================
+
+/**
+ * @brief In-memory LZ4 with every table and the page pool sized at
+ *        compile time; no heap use after construction
+ *
+ * @tparam MaxFrozenPages Frozen pages the pool can index
+ * @tparam PoolBytes Bytes of compressed storage
+ * @tparam MaxResidentPages Pages resident at once (upper bound on the budget)
+ * @tparam MaxRegions Live allocations
+ *
+ * The object is large (the pool is a member), so give it static storage
+ * or allocate it once at startup.
+ */
+template <size_t MaxFrozenPages, size_t PoolBytes, size_t MaxResidentPages, size_t MaxRegions>
+using GhostFixedManager = BasicGhostManager<GhostFixedMemoryBacking<MaxFrozenPages, PoolBytes>,
+                                            GhostLz4Codec, GhostNoCipher,
+                                            GhostFixedLruEviction<MaxResidentPages>,
+                                            GhostMutexLock,
+                                            GhostFixedRegions<MaxRegions>>;
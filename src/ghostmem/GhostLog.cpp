@@ -0,0 +1,398 @@
+/*******************************************************************************
+ * GhostMem - Virtual RAM through Transparent Compression
+ *
+ * Copyright (C) 2026 Swen Kalski
+ *
+ * This file is part of GhostMem.
+ *
+ * GhostMem is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GhostMem is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GhostMem. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Contact: kalski.swen@gmail.com
+ ******************************************************************************/
+
+/**
+ * @file GhostLog.cpp
+ * @brief Log rings and the formatter thread
+ *
+ * @author Swen Kalski
+ * @date 2026
+ */
+
+#include "GhostLog.h"
+
+#include <chrono>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+
+namespace
+{
+    /// The calling thread's ring. Trivially destructible, so the first log
+    /// call of a thread (possibly inside the fault handler) does not
+    /// register a TLS destructor, which allocates; the ring is handed back
+    /// through the thread-exit key below instead.
+    struct ThreadRingSlot
+    {
+        std::atomic<int> *state;
+        size_t index;
+    };
+
+    thread_local ThreadRingSlot t_ring_slot = {nullptr, 0};
+
+    /// Holds the thread's ring state; its destructor releases the ring
+#ifdef _WIN32
+    DWORD g_ring_key = FLS_OUT_OF_INDEXES;
+
+    VOID WINAPI ReleaseThreadRing(PVOID state)
+    {
+        if (state)
+        {
+            static_cast<std::atomic<int> *>(state)->store(2 /* Released */, std::memory_order_release);
+        }
+    }
+#else
+    pthread_key_t g_ring_key;
+    bool g_ring_key_valid = false;
+
+    void ReleaseThreadRing(void *state)
+    {
+        static_cast<std::atomic<int> *>(state)->store(2 /* Released */, std::memory_order_release);
+    }
+#endif
+
+    uint64_t NowNs()
+    {
+        return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+                   std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    const char *LevelName(GhostLogLevel level)
+    {
+        switch (level)
+        {
+        case GhostLogLevel::Error:
+            return "ERROR";
+        case GhostLogLevel::Warning:
+            return "WARN ";
+        case GhostLogLevel::Info:
+            return "INFO ";
+        case GhostLogLevel::Debug:
+            return "DEBUG";
+        default:
+            return "     ";
+        }
+    }
+}
+
+GhostLogger &GhostLogger::Instance()
+{
+    static GhostLogger instance;
+    return instance;
+}
+
+GhostLogger::GhostLogger()
+    : start_ns_(NowNs())
+{
+    // Created once, outside any signal handler; only the slot is set per thread
+#ifdef _WIN32
+    g_ring_key = FlsAlloc(ReleaseThreadRing);
+#else
+    g_ring_key_valid = (pthread_key_create(&g_ring_key, ReleaseThreadRing) == 0);
+#endif
+}
+
+GhostLogger::~GhostLogger()
+{
+    {
+        std::lock_guard<std::mutex> lock(stop_mutex_);
+        stop_ = true;
+    }
+    stop_cv_.notify_all();
+    if (thread_.joinable())
+    {
+        thread_.join();
+    }
+    Drain();
+
+    // Threads exiting after this point must not touch the rings
+#ifdef _WIN32
+    if (g_ring_key != FLS_OUT_OF_INDEXES)
+    {
+        FlsFree(g_ring_key);
+        g_ring_key = FLS_OUT_OF_INDEXES;
+    }
+#else
+    if (g_ring_key_valid)
+    {
+        pthread_key_delete(g_ring_key);
+        g_ring_key_valid = false;
+    }
+#endif
+}
+
+void GhostLogger::Configure(GhostLogLevel level, size_t sample_rate)
+{
+    sample_rate_.store(sample_rate, std::memory_order_relaxed);
+    level_.store((uint8_t)level, std::memory_order_relaxed);
+
+    std::lock_guard<std::mutex> lock(drain_mutex_);
+    if (level != GhostLogLevel::Off && !thread_.joinable())
+    {
+        thread_ = std::thread(&GhostLogger::Run, this);
+    }
+}
+
+void GhostLogger::SetOutput(FILE *out)
+{
+    Drain();
+    std::lock_guard<std::mutex> lock(drain_mutex_);
+    output_ = out;
+}
+
+void GhostLogger::Flush()
+{
+    Drain();
+}
+
+GhostLogger::Ring *GhostLogger::ThreadRing()
+{
+    if (t_ring_slot.state)
+    {
+        return &rings_[t_ring_slot.index];
+    }
+    for (size_t i = 0; i < kMaxThreads; i++)
+    {
+        int expected = Free;
+        if (rings_[i].state.compare_exchange_strong(expected, Owned, std::memory_order_acq_rel))
+        {
+            t_ring_slot.state = &rings_[i].state;
+            t_ring_slot.index = i;
+            // Without the key (creation failed) the ring stays owned for good
+#ifdef _WIN32
+            if (g_ring_key != FLS_OUT_OF_INDEXES)
+            {
+                FlsSetValue(g_ring_key, &rings_[i].state);
+            }
+#else
+            if (g_ring_key_valid)
+            {
+                pthread_setspecific(g_ring_key, &rings_[i].state);
+            }
+#endif
+            return &rings_[i];
+        }
+    }
+    return nullptr;
+}
+
+GhostLogRecord *GhostLogger::BeginRecord(GhostLogLevel level)
+{
+    Ring *ring = ThreadRing();
+    if (!ring || ring->busy)
+    {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        return nullptr;
+    }
+    // Mark the ring before reading head: a signal handler that logs in
+    // between sees busy and drops, or finishes before we read head
+    ring->busy = true;
+    std::atomic_signal_fence(std::memory_order_seq_cst);
+
+    uint64_t head = ring->head.load(std::memory_order_relaxed);
+    if (head - ring->tail.load(std::memory_order_acquire) >= kRingRecords)
+    {
+        ring->busy = false;
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        return nullptr;
+    }
+
+    GhostLogRecord &record = ring->records[head & (kRingRecords - 1)];
+    record.time_ns = NowNs() - start_ns_;
+    record.level = level;
+    record.size = 0;
+    record.truncated = 0;
+    record.thread = (uint8_t)t_ring_slot.index;
+    return &record;
+}
+
+void GhostLogger::CommitRecord()
+{
+    Ring &ring = rings_[t_ring_slot.index];
+    ring.head.store(ring.head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    std::atomic_signal_fence(std::memory_order_seq_cst);
+    ring.busy = false;
+}
+
+void GhostLogger::Run()
+{
+    std::unique_lock<std::mutex> lock(stop_mutex_);
+    while (!stop_)
+    {
+        stop_cv_.wait_for(lock, std::chrono::milliseconds(kDrainIntervalMs), [this]() { return stop_; });
+        lock.unlock();
+        Drain();
+        lock.lock();
+    }
+}
+
+void GhostLogger::Drain()
+{
+    std::lock_guard<std::mutex> lock(drain_mutex_);
+
+    bool wrote = false;
+    for (size_t i = 0; i < kMaxThreads; i++)
+    {
+        Ring &ring = rings_[i];
+        // The owner publishes its last record before releasing the ring
+        int state = ring.state.load(std::memory_order_acquire);
+        if (state == Free)
+        {
+            continue;
+        }
+
+        uint64_t head = ring.head.load(std::memory_order_acquire);
+        uint64_t tail = ring.tail.load(std::memory_order_relaxed);
+        for (; tail < head; tail++)
+        {
+            Write(ring.records[tail & (kRingRecords - 1)]);
+            wrote = true;
+        }
+        ring.tail.store(tail, std::memory_order_release);
+
+        if (state == Released)
+        {
+            ring.state.store(Free, std::memory_order_release);
+        }
+    }
+
+    uint64_t dropped = dropped_.load(std::memory_order_relaxed);
+    if (dropped != reported_dropped_)
+    {
+        FILE *out = output_ ? output_ : stderr;
+        fprintf(out, "[GMlib] %s %llu log messages dropped\n", LevelName(GhostLogLevel::Warning),
+                (unsigned long long)(dropped - reported_dropped_));
+        reported_dropped_ = dropped;
+        wrote = true;
+    }
+
+    if (wrote)
+    {
+        if (output_)
+        {
+            fflush(output_);
+        }
+        else
+        {
+            fflush(stdout);
+            fflush(stderr);
+        }
+    }
+}
+
+// Note: Caller must hold drain_mutex_
+void GhostLogger::Write(const GhostLogRecord &record)
+{
+    char line[512];
+    int length = snprintf(line, sizeof(line), "[GMlib] %s %llu.%06llu T%02u ",
+                          LevelName(record.level),
+                          (unsigned long long)(record.time_ns / 1000000000ULL),
+                          (unsigned long long)(record.time_ns / 1000ULL % 1000000ULL),
+                          (unsigned)record.thread);
+    size_t used = (length > 0) ? (size_t)length : 0;
+
+    size_t pos = 0;
+    while (pos < record.size && used < sizeof(line) - 64)
+    {
+        GhostLogRecord::Tag tag = (GhostLogRecord::Tag)(uint8_t)record.payload[pos++];
+        const char *value = record.payload + pos;
+        int written = 0;
+        switch (tag)
+        {
+        case GhostLogRecord::Signed:
+        {
+            int64_t number;
+            memcpy(&number, value, sizeof(number));
+            written = snprintf(line + used, sizeof(line) - used, "%lld", (long long)number);
+            pos += sizeof(number);
+            break;
+        }
+        case GhostLogRecord::Unsigned:
+        {
+            uint64_t number;
+            memcpy(&number, value, sizeof(number));
+            written = snprintf(line + used, sizeof(line) - used, "%llu", (unsigned long long)number);
+            pos += sizeof(number);
+            break;
+        }
+        case GhostLogRecord::Double:
+        {
+            double number;
+            memcpy(&number, value, sizeof(number));
+            written = snprintf(line + used, sizeof(line) - used, "%g", number);
+            pos += sizeof(number);
+            break;
+        }
+        case GhostLogRecord::Pointer:
+        {
+            uintptr_t address;
+            memcpy(&address, value, sizeof(address));
+            written = snprintf(line + used, sizeof(line) - used, "%p", (void *)address);
+            pos += sizeof(address);
+            break;
+        }
+        case GhostLogRecord::Bool:
+            written = snprintf(line + used, sizeof(line) - used, "%s", value[0] ? "true" : "false");
+            pos += 1;
+            break;
+        case GhostLogRecord::Char:
+            written = snprintf(line + used, sizeof(line) - used, "%c", value[0]);
+            pos += 1;
+            break;
+        case GhostLogRecord::Text:
+        {
+            size_t text_length = (uint8_t)value[0];
+            written = snprintf(line + used, sizeof(line) - used, "%.*s", (int)text_length, value + 1);
+            pos += 1 + text_length;
+            break;
+        }
+        default:
+            pos = record.size;  // Corrupt record, stop here
+            break;
+        }
+        if (written > 0)
+        {
+            used += (size_t)written;
+        }
+    }
+    if (used > sizeof(line) - 5)
+    {
+        used = sizeof(line) - 5;
+    }
+    if (record.truncated)
+    {
+        memcpy(line + used, "...", 3);
+        used += 3;
+    }
+    line[used++] = '\n';
+
+    FILE *out = output_;
+    if (!out)
+    {
+        out = (record.level <= GhostLogLevel::Warning) ? stderr : stdout;
+    }
+    fwrite(line, 1, used, out);
+}
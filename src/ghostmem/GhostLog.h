@@ -0,0 +1,351 @@
+/*******************************************************************************
+ * GhostMem - Virtual RAM through Transparent Compression
+ *
+ * Copyright (C) 2026 Swen Kalski
+ *
+ * This file is part of GhostMem.
+ *
+ * GhostMem is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GhostMem is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GhostMem. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Contact: kalski.swen@gmail.com
+ ******************************************************************************/
+
+/**
+ * @file GhostLog.h
+ * @brief Asynchronous, allocation-free diagnostic log
+ *
+ * Log calls can come from inside the fault handler, so they must not
+ * format, allocate, lock or write. GhostLog() only checks the level,
+ * copies its arguments as tagged binary values into a fixed-size record
+ * in the calling thread's ring and publishes it with one release store.
+ * A background thread drains the rings every few milliseconds, formats
+ * the records and writes them with one flush per batch.
+ *
+ * Each thread owns one of kMaxThreads single-producer rings, claimed on
+ * its first message and handed back when it exits. A full ring, a nested
+ * call on the same thread (e.g. from a signal handler) or running out of
+ * rings drops the record and counts it; the formatter reports the count.
+ * Logging never blocks.
+ *
+ * Info and Debug messages can be sampled (only every Nth is kept), so
+ * diagnostics can stay enabled on a busy process.
+ *
+ * @author Swen Kalski
+ * @date 2026
+ */
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <type_traits>
+
+/**
+ * @enum GhostLogLevel
+ * @brief Severity of a log message; a level enables itself and all above
+ */
+enum class GhostLogLevel : uint8_t
+{
+    Off,        ///< Nothing is logged
+    Error,      ///< Operation failed
+    Warning,    ///< Unexpected, but handled
+    Info,       ///< Configuration and state changes
+    Debug       ///< Per-page events
+};
+
+/**
+ * @struct GhostLogRecord
+ * @brief One message as binary arguments, formatted later
+ *
+ * The payload is a sequence of (tag, value) pairs, see GhostLogRecord::Tag.
+ * Arguments that don't fit are cut off and the record is marked truncated.
+ */
+struct GhostLogRecord
+{
+    static constexpr size_t kPayloadBytes = 116;
+
+    /// Argument types in the payload
+    enum Tag : uint8_t
+    {
+        Signed,     ///< int64_t
+        Unsigned,   ///< uint64_t
+        Double,     ///< double
+        Pointer,    ///< uintptr_t, printed in hex
+        Bool,       ///< uint8_t
+        Char,       ///< char
+        Text        ///< uint8_t length, then the characters
+    };
+
+    uint64_t time_ns;           ///< Since the logger started
+    GhostLogLevel level;
+    uint8_t size;               ///< Payload bytes in use
+    uint8_t truncated;
+    uint8_t thread;             ///< Ring index of the producer
+    char payload[kPayloadBytes];
+
+    /// Appends a tagged value; returns false (and marks the record) if full
+    bool Put(Tag tag, const void *value, size_t length)
+    {
+        if (truncated || size + 1 + length > kPayloadBytes)
+        {
+            truncated = 1;
+            return false;
+        }
+        payload[size] = (char)tag;
+        memcpy(payload + size + 1, value, length);
+        size = (uint8_t)(size + 1 + length);
+        return true;
+    }
+
+    /// Appends a string, shortened to what still fits
+    void PutText(const char *text, size_t length)
+    {
+        if (truncated || (size_t)size + 2 > kPayloadBytes)
+        {
+            truncated = 1;
+            return;
+        }
+        size_t room = kPayloadBytes - size - 2;
+        if (length > room)
+        {
+            length = room;
+            truncated = 1;
+        }
+        payload[size] = (char)Text;
+        payload[size + 1] = (char)(uint8_t)length;
+        memcpy(payload + size + 2, text, length);
+        size = (uint8_t)(size + 2 + length);
+    }
+};
+
+/**
+ * @brief Encodes one log argument into a record
+ *
+ * Supports integers, enums, bool, char, floating point, pointers,
+ * C strings and std::string. Strings are copied, so temporaries are fine.
+ */
+template <typename T>
+void GhostLogEncode(GhostLogRecord &record, const T &value)
+{
+    if constexpr (std::is_same_v<T, bool>)
+    {
+        uint8_t flag = value ? 1 : 0;
+        record.Put(GhostLogRecord::Bool, &flag, sizeof(flag));
+    }
+    else if constexpr (std::is_same_v<T, char>)
+    {
+        record.Put(GhostLogRecord::Char, &value, sizeof(value));
+    }
+    else if constexpr (std::is_convertible_v<const T &, const char *>)
+    {
+        const char *text = value;
+        record.PutText(text ? text : "(null)", text ? strlen(text) : 6);
+    }
+    else if constexpr (std::is_same_v<T, std::string>)
+    {
+        record.PutText(value.data(), value.size());
+    }
+    else if constexpr (std::is_enum_v<T>)
+    {
+        int64_t number = (int64_t)value;
+        record.Put(GhostLogRecord::Signed, &number, sizeof(number));
+    }
+    else if constexpr (std::is_integral_v<T> && std::is_signed_v<T>)
+    {
+        int64_t number = value;
+        record.Put(GhostLogRecord::Signed, &number, sizeof(number));
+    }
+    else if constexpr (std::is_integral_v<T>)
+    {
+        uint64_t number = value;
+        record.Put(GhostLogRecord::Unsigned, &number, sizeof(number));
+    }
+    else if constexpr (std::is_floating_point_v<T>)
+    {
+        double number = value;
+        record.Put(GhostLogRecord::Double, &number, sizeof(number));
+    }
+    else if constexpr (std::is_pointer_v<T>)
+    {
+        uintptr_t address = (uintptr_t)value;
+        record.Put(GhostLogRecord::Pointer, &address, sizeof(address));
+    }
+    else
+    {
+        static_assert(sizeof(T) == 0, "GhostLog: unsupported argument type");
+    }
+}
+
+/**
+ * @class GhostLogger
+ * @brief Process-wide log rings and their formatter thread
+ *
+ * All managers in the process share the logger; the last
+ * GhostMemoryManager::Initialize() sets the level.
+ */
+class GhostLogger
+{
+public:
+    static constexpr size_t kMaxThreads = 64;
+    static constexpr size_t kRingRecords = 128;     ///< Power of two
+    static constexpr size_t kDrainIntervalMs = 20;
+
+    static GhostLogger &Instance();
+
+    ~GhostLogger();
+
+    GhostLogger(const GhostLogger &) = delete;
+    GhostLogger &operator=(const GhostLogger &) = delete;
+
+    /**
+     * @brief Sets the level and sampling rate
+     *
+     * Starts the formatter thread on the first level other than Off.
+     *
+     * @param level Most verbose level that is logged
+     * @param sample_rate Keep every Nth Info / Debug message (0 or 1 = all)
+     */
+    void Configure(GhostLogLevel level, size_t sample_rate);
+
+    /// @brief Current level
+    GhostLogLevel Level() const
+    {
+        return (GhostLogLevel)level_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Sends all output to a stream instead of stdout / stderr
+     *
+     * By default Error and Warning go to stderr, Info and Debug to stdout.
+     *
+     * @param out Stream to write to; nullptr restores the default
+     */
+    void SetOutput(FILE *out);
+
+    /**
+     * @brief Formats and writes everything logged so far
+     *
+     * Called by the formatter thread; call it directly before reading the
+     * output, e.g. in tests or before abort().
+     */
+    void Flush();
+
+    /// @brief Records dropped so far (ring full, no free ring, or nested call)
+    uint64_t Dropped() const
+    {
+        return dropped_.load(std::memory_order_relaxed);
+    }
+
+    /// @brief Logs one message; see GhostLog()
+    template <typename... Args>
+    void Log(GhostLogLevel level, const Args &...args)
+    {
+        if (!ShouldLog(level))
+        {
+            return;
+        }
+        GhostLogRecord *record = BeginRecord(level);
+        if (!record)
+        {
+            return;
+        }
+        (GhostLogEncode(*record, args), ...);
+        CommitRecord();
+    }
+
+private:
+    enum RingState : int
+    {
+        Free,
+        Owned,
+        Released    ///< Owner exited; freed once drained
+    };
+
+    struct Ring
+    {
+        std::atomic<int> state{Free};
+        std::atomic<uint64_t> head{0};  ///< Written by the owner
+        std::atomic<uint64_t> tail{0};  ///< Written by the formatter
+        bool busy = false;              ///< Owner is inside Log()
+        GhostLogRecord records[kRingRecords];
+    };
+
+    GhostLogger();
+
+    bool ShouldLog(GhostLogLevel level)
+    {
+        uint8_t current = level_.load(std::memory_order_relaxed);
+        if ((uint8_t)level > current || level == GhostLogLevel::Off)
+        {
+            return false;
+        }
+        if (level >= GhostLogLevel::Info)
+        {
+            size_t rate = sample_rate_.load(std::memory_order_relaxed);
+            if (rate > 1 && sampled_.fetch_add(1, std::memory_order_relaxed) % rate != 0)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    GhostLogRecord *BeginRecord(GhostLogLevel level);
+    void CommitRecord();
+    Ring *ThreadRing();
+
+    void Run();
+    void Drain();
+    void Write(const GhostLogRecord &record);
+
+    std::atomic<uint8_t> level_{(uint8_t)GhostLogLevel::Off};
+    std::atomic<size_t> sample_rate_{1};
+    std::atomic<uint64_t> sampled_{0};
+    std::atomic<uint64_t> dropped_{0};
+    uint64_t reported_dropped_ = 0;
+    uint64_t start_ns_ = 0;
+
+    Ring rings_[kMaxThreads];
+
+    std::mutex drain_mutex_;        ///< Serializes Drain() and output changes
+    FILE *output_ = nullptr;
+
+    std::thread thread_;
+    std::mutex stop_mutex_;
+    std::condition_variable stop_cv_;
+    bool stop_ = false;
+};
+
+/**
+ * @brief Logs a message made of the concatenated arguments
+ *
+ * Cheap when the level is disabled (one relaxed load) and lock- and
+ * allocation-free when enabled. Safe to call from the fault handler.
+ *
+ * @code
+ * GhostLog(GhostLogLevel::Error, "Failed to open disk file: ", path);
+ * @endcode
+ */
+template <typename... Args>
+inline void GhostLog(GhostLogLevel level, const Args &...args)
+{
+    GhostLogger::Instance().Log(level, args...);
+}
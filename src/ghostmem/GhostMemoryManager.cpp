@@ -43,58 +43,403 @@
  */
 
 #include "GhostMemoryManager.h"
+#include "GhostTrace.h"
+#include "GhostCrc32c.h"
 #include <iostream>
 #include <cstring>
+#include <chrono>
+#include <set>
+#include <iomanip>
+#include <fstream>
+#include <sstream>
 
-#ifdef _WIN32
-// Windows implementation
-#include <wincrypt.h>   // CryptGenRandom for secure random numbers
-#pragma comment(lib, "Advapi32.lib")
-#else
+#ifndef _WIN32
 // Linux/POSIX implementation
 #include <cstdio>
 #include <fcntl.h>      // open, O_CREAT, O_RDWR
 #include <sys/stat.h>   // S_IRUSR, S_IWUSR
 #endif
 
+namespace
+{
+    uint64_t SteadyMillis()
+    {
+        return (uint64_t)std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+}
+
 // ============================================================================
 // Configuration and Initialization
 // ============================================================================
 
 bool GhostMemoryManager::Initialize(const GhostConfig& config)
 {
+    // The scanner takes mutex_ itself, so it must be stopped before we lock
+    StopIdleScanner();
+    
+    // The exporter reads the statistics block, which may move below
+    metrics_exporter_.Stop();
+    
     std::lock_guard<std::recursive_mutex> lock(mutex_);
     
+    // What this run learned belongs to the profile it was started with
+    if (!config_.profile_path.empty())
+    {
+        SaveProfile(config_.profile_path);
+    }
+    
     config_ = config;
+    tag_profiles_.clear();
+    if (!config_.profile_path.empty() && LoadProfile(config_.profile_path))
+    {
+        GhostLog(GhostLogLevel::Info, "Loaded hotness profile: ", config_.profile_path, " (", tag_profiles_.size(), " tags)");
+    }
+    profile_baseline_ = tag_states_;
+    compression_acceleration_ = std::max(config_.compression_acceleration_min, 1);
+    tune_window_start_ns_ = (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+    tune_window_compress_ns_ = 0;
+    GhostLogger::Instance().Configure(config_.enable_verbose_logging ? GhostLogLevel::Debug : config_.log_level,
+                                      config_.log_sample_rate);
+    
+    if (config_.freeze_backend != GhostFreezeBackend::Compress)
+    {
+        if (config_.use_disk_backing)
+        {
+            GhostLog(GhostLogLevel::Error, "Kernel freeze backend cannot be combined with disk backing");
+            return false;
+        }
+        if (!IsFreezeBackendSupported(config_.freeze_backend))
+        {
+            GhostLog(GhostLogLevel::Error, "Kernel freeze backend not supported (needs MADV_COLD / MADV_PAGEOUT)");
+            return false;
+        }
+    }
     
     // Generate encryption key if disk encryption is enabled
     if (config_.use_disk_backing && config_.encrypt_disk_pages)
     {
         if (!GenerateEncryptionKey())
         {
-            dbgmsg("ERROR: Failed to generate encryption key");
+            GhostLog(GhostLogLevel::Error, "Failed to generate encryption key");
             return false;
         }
-        dbgmsg("Disk encryption enabled (ChaCha20)");
+        GhostLog(GhostLogLevel::Info, "Disk encryption enabled (ChaCha20)");
     }
     
     if (config_.use_disk_backing)
     {
+        CloseDiskFile();  // Re-initialization must not leak the previous file
         if (!OpenDiskFile())
         {
-            dbgmsg("ERROR: Failed to open disk file: ", config_.disk_file_path);
+            GhostLog(GhostLogLevel::Error, "Failed to open disk file: ", config_.disk_file_path);
             return false;
         }
-        dbgmsg("Disk backing enabled: ", config_.disk_file_path, " (compress=",(config_.compress_before_disk ? "yes" : "no"), ")");
+        GhostLog(GhostLogLevel::Info, "Disk backing enabled: ", config_.disk_file_path, " (compress=",(config_.compress_before_disk ? "yes" : "no"), ")");
     }
     else
     {
-        dbgmsg("[GhostMem] Using in-memory backing store");
+        GhostLog(GhostLogLevel::Info, "Using in-memory backing store");
+    }
+    
+    // Join the host-wide budget table if requested
+    coordinator_.Detach();
+    coordinated_budget_ = 0;
+    if (!config_.coordinator_name.empty())
+    {
+        size_t total_pages = config_.coordinator_total_pages;
+        if (total_pages == 0)
+        {
+            total_pages = GetEffectiveMaxPages();
+        }
+        
+        if (!coordinator_.Attach(config_.coordinator_name, total_pages, config_.coordinator_min_pages))
+        {
+            GhostLog(GhostLogLevel::Error, "Failed to attach to budget coordinator: ", config_.coordinator_name);
+            return false;
+        }
+        UpdateCoordinatedBudget();
+        GhostLog(GhostLogLevel::Info, "Budget coordination enabled: ", config_.coordinator_name, " (granted=", coordinated_budget_, " pages)");
+    }
+    
+    if (!AttachStatsBlock())
+    {
+        GhostLog(GhostLogLevel::Error, "Failed to create statistics segment: ", config_.stats_shm_name);
+        return false;
+    }
+    if (config_.enable_metrics_http || !config_.metrics_file_path.empty())
+    {
+        stats_block_read_.store(true, std::memory_order_relaxed);
+    }
+    PublishStats();
+    
+    if (config_.enable_metrics_http || !config_.metrics_file_path.empty())
+    {
+        if (!metrics_exporter_.Start(stats_block_.load(), config_.enable_metrics_http, config_.metrics_port,
+                                     config_.metrics_file_path, config_.metrics_interval_ms))
+        {
+            GhostLog(GhostLogLevel::Error, "Failed to start metrics listener on 127.0.0.1:", config_.metrics_port);
+            return false;
+        }
+        if (config_.enable_metrics_http)
+        {
+            GhostLog(GhostLogLevel::Info, "Metrics served on http://127.0.0.1:", metrics_exporter_.Port(), "/metrics");
+        }
+    }
+    
+    StartIdleScanner();
+    
+    return true;
+}
+
+GhostStats GhostMemoryManager::GetStats() const
+{
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
+    
+    GhostStats stats = stats_;
+    stats.resident_pages = active_ram_pages.size();
+    stats.protected_pages = protected_count_;
+    stats.budget_pages = GetEffectiveMaxPages();
+    stats.disk_bytes = disk_next_offset;
+    stats.coordinator_participants = coordinator_.ParticipantCount();
+    
+    stats.compressed_bytes = stored_bytes_;
+    stats.frozen_pages = CountFrozenPages();
+    stats.kernel_pages = kernel_pages_.size();
+    stats.compression_acceleration = compression_acceleration_;
+    stats.metadata_entries = managed_blocks.size() + allocation_metadata_.size() +
+                             page_ref_counts_.size() + page_info_.size() +
+                             backing_store.size() + disk_page_locations.size() +
+                             delta_bases_.size() + kernel_pages_.size() + patch_logs_.size();
+    
+    return stats;
+}
+
+bool GhostMemoryManager::IsFreezeBackendSupported(GhostFreezeBackend backend)
+{
+    if (backend == GhostFreezeBackend::Compress)
+    {
+        return true;
+    }
+#ifdef _WIN32
+    return true;
+#elif defined(MADV_COLD) && defined(MADV_PAGEOUT)
+    // Headers may be newer than the running kernel - ask it
+    void *probe = mmap(NULL, PAGE_SIZE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (probe == MAP_FAILED)
+    {
+        return false;
+    }
+    memset(probe, 1, PAGE_SIZE);
+    int advice = (backend == GhostFreezeBackend::KernelCold) ? MADV_COLD : MADV_PAGEOUT;
+    bool supported = madvise(probe, PAGE_SIZE, advice) == 0;
+    munmap(probe, PAGE_SIZE);
+    return supported;
+#else
+    return false;
+#endif
+}
+
+size_t GhostMemoryManager::GetEffectiveMaxPages() const
+{
+    // Note: Caller must hold mutex_
+    
+    if (coordinated_budget_ > 0)
+    {
+        return coordinated_budget_;
+    }
+    return (config_.max_memory_pages > 0) ? config_.max_memory_pages : MAX_PHYSICAL_PAGES;
+}
+
+bool GhostMemoryManager::AttachStatsBlock()
+{
+    // Note: Caller must hold mutex_
+    
+    if (config_.stats_shm_name == stats_shm_open_name_)
+    {
+        return true;
+    }
+    
+    // Leave the current segment first, carrying the values over
+    if (!stats_shm_open_name_.empty())
+    {
+        local_stats_block_.CopyFrom(*stats_block_.load(std::memory_order_relaxed));
+        stats_block_.store(&local_stats_block_, std::memory_order_release);
+        stats_shm_.Close();
+        GhostSharedMemory::Unlink(stats_shm_open_name_);
+        stats_shm_open_name_.clear();
+    }
+    
+    if (config_.stats_shm_name.empty())
+    {
+        return true;
+    }
+    
+    if (!stats_shm_.Open(config_.stats_shm_name, sizeof(GhostStatsBlock), true))
+    {
+        return false;
+    }
+    
+    // A stale segment of a crashed process is simply taken over
+    GhostStatsBlock *shared = static_cast<GhostStatsBlock *>(stats_shm_.Data());
+    shared->Reset();
+    shared->CopyFrom(local_stats_block_);
+    stats_block_.store(shared, std::memory_order_release);
+    stats_shm_open_name_ = config_.stats_shm_name;
+    stats_block_read_.store(true, std::memory_order_relaxed);
+    return true;
+}
+
+const GhostStatsBlock& GhostMemoryManager::GetStatsBlock() const
+{
+    // The first reader gets current figures; from then on every
+    // fault, freeze and scan publishes
+    if (!stats_block_read_.load(std::memory_order_acquire))
+    {
+        std::lock_guard<std::recursive_mutex> lock(mutex_);
+        stats_block_read_.store(true, std::memory_order_release);
+        PublishStats();
+    }
+    return *stats_block_.load(std::memory_order_acquire);
+}
+
+void GhostMemoryManager::PublishStats() const
+{
+    // Note: Caller must hold mutex_
+    
+    if (!stats_block_read_.load(std::memory_order_relaxed))
+    {
+        return;
     }
     
+    GhostStatsBlock &block = *stats_block_.load(std::memory_order_relaxed);
+    const std::memory_order relaxed = std::memory_order_relaxed;
+    
+    block.page_faults.store(stats_.page_faults, relaxed);
+    block.refaults.store(stats_.refaults, relaxed);
+    block.evictions.store(stats_.evictions, relaxed);
+    block.thrash_refaults.store(stats_.thrash_refaults, relaxed);
+    block.cold_refaults.store(stats_.cold_refaults, relaxed);
+    block.delta_freezes.store(stats_.delta_freezes, relaxed);
+    block.idle_freezes.store(stats_.idle_freezes, relaxed);
+    block.idle_soft_faults.store(stats_.idle_soft_faults, relaxed);
+    
+    block.resident_pages.store(active_ram_pages.size(), relaxed);
+    block.frozen_pages.store(CountFrozenPages(), relaxed);
+    block.compressed_bytes.store(stored_bytes_, relaxed);
+    block.disk_bytes.store(disk_next_offset, relaxed);
+    block.budget_pages.store(GetEffectiveMaxPages(), relaxed);
+    block.compression_acceleration.store((uint64_t)compression_acceleration_, relaxed);
+    block.compression_ns.store(stats_.compression_ns, relaxed);
+    block.page_size.store(PAGE_SIZE, relaxed);
+    
+    block.publish_count.fetch_add(1, std::memory_order_release);
+}
+
+bool GhostMemoryManager::EraseDeltaBase(void *page_start)
+{
+    // Note: Caller must hold mutex_
+    
+    auto delta_it = delta_bases_.find(page_start);
+    if (delta_it == delta_bases_.end())
+    {
+        return false;
+    }
+    stored_bytes_ -= delta_it->second.base.size();
+    delta_bases_.erase(delta_it);
     return true;
 }
 
+void GhostMemoryManager::DropPageData(void *page_start)
+{
+    // Note: Caller must hold mutex_
+    
+    // Compressed data (in-memory mode)
+    auto backing_it = backing_store.find(page_start);
+    if (backing_it != backing_store.end())
+    {
+        stored_bytes_ -= backing_it->second.size();
+        backing_store.erase(backing_it);
+    }
+    
+    // Disk location tracking (disk-backed mode)
+    disk_page_locations.erase(page_start);
+    kernel_pages_.erase(page_start);
+    EraseDeltaBase(page_start);
+    
+    auto log_it = patch_logs_.find(page_start);
+    if (log_it != patch_logs_.end())
+    {
+        stored_bytes_ -= log_it->second.size();
+        patch_logs_.erase(log_it);
+    }
+    ForgetPage(page_start);
+}
+
+size_t GhostMemoryManager::CountFrozenPages() const
+{
+    // Note: Caller must hold mutex_
+    
+    // Disk locations are kept after a restore, so resident pages that
+    // still have a disk copy must not be counted as frozen
+    return backing_store.size() + disk_page_locations.size() + kernel_pages_.size() - resident_disk_pages_;
+}
+
+void GhostMemoryManager::UpdateCoordinatedBudget()
+{
+    // Note: Caller must hold mutex_
+    
+    faults_since_budget_update_ = 0;
+    if (!coordinator_.IsAttached())
+    {
+        return;
+    }
+    budget_updated_ms_ = SteadyMillis();
+    
+    // Demand: every page that currently holds data, resident or frozen
+    size_t demand = active_ram_pages.size() + CountFrozenPages();
+    
+    size_t granted = coordinator_.Update(demand, stats_.refaults);
+    if (granted != coordinated_budget_)
+    {
+        GhostLog(GhostLogLevel::Info, "Coordinated budget changed: ", coordinated_budget_, " -> ", granted, " pages");
+    }
+    coordinated_budget_ = granted;
+}
+
+void GhostMemoryManager::RefreshCoordinatedBudget()
+{
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
+    
+    if (!coordinator_.IsAttached())
+    {
+        return;
+    }
+    
+    // Checking every participant's process costs system calls, so only
+    // this thread does it, never the fault path
+    uint64_t now = SteadyMillis();
+    bool reclaimed = false;
+    if (now - budget_reclaimed_ms_ >= config_.coordinator_update_ms)
+    {
+        budget_reclaimed_ms_ = now;
+        reclaimed = coordinator_.Reclaim();
+    }
+    
+    // Busy processes update on their faults; this is for the idle ones
+    if (!reclaimed && now - budget_updated_ms_ < config_.coordinator_update_ms)
+    {
+        return;
+    }
+    UpdateCoordinatedBudget();
+    
+    // A smaller grant applies now rather than at the next fault. Nothing
+    // is coming in, so the grant itself may stay resident
+    EvictDownTo(GetEffectiveMaxPages(), nullptr);
+    PublishStats();
+}
+
 bool GhostMemoryManager::OpenDiskFile()
 {
     // Note: Caller must hold mutex_
@@ -135,6 +480,8 @@ void GhostMemoryManager::CloseDiskFile()
 {
     std::lock_guard<std::recursive_mutex> lock(mutex_);
     
+    UnmapDiskFile();
+    
 #ifdef _WIN32
     if (disk_file_handle != INVALID_HANDLE_VALUE)
     {
@@ -155,6 +502,7 @@ bool GhostMemoryManager::WriteToDisk(const void* data, size_t size, size_t& out_
     // Note: Caller must hold mutex_
     
     out_offset = disk_next_offset;
+    uint64_t io_start = GhostTraceNow();
     
 #ifdef _WIN32
     DWORD bytes_written = 0;
@@ -192,6 +540,7 @@ bool GhostMemoryManager::WriteToDisk(const void* data, size_t size, size_t& out_
     }
 #endif
     
+    GHOST_TRACE3(disk_write, out_offset, size, GhostTraceNow() - io_start);
     disk_next_offset += size;
     return true;
 }
@@ -200,6 +549,8 @@ bool GhostMemoryManager::ReadFromDisk(size_t offset, size_t size, void* buffer)
 {
     // Note: Caller must hold mutex_
     
+    uint64_t io_start = GhostTraceNow();
+    
 #ifdef _WIN32
     DWORD bytes_read = 0;
     
@@ -236,781 +587,2644 @@ bool GhostMemoryManager::ReadFromDisk(size_t offset, size_t size, void* buffer)
     }
 #endif
     
+    GHOST_TRACE3(disk_read, offset, size, GhostTraceNow() - io_start);
     return true;
 }
 
-// ============================================================================
-// Encryption (ChaCha20)
-// ============================================================================
-
-bool GhostMemoryManager::GenerateEncryptionKey()
+const char *GhostMemoryManager::MapDiskRecord(size_t offset, size_t size)
 {
     // Note: Caller must hold mutex_
     
-#ifdef _WIN32
-    // Use Windows CryptoAPI for secure random generation
-    HCRYPTPROV hCryptProv = 0;
-    
-    if (!CryptAcquireContext(&hCryptProv, NULL, NULL, PROV_RSA_FULL, CRYPT_VERIFYCONTEXT))
+    size_t end = offset + size;
+    if (end > disk_next_offset)
     {
-        return false;
+        return nullptr;
+    }
+    if (end <= disk_map_size_)
+    {
+        return disk_map_ + offset;
     }
     
-    BOOL result = CryptGenRandom(hCryptProv, 32, encryption_key_);
-    CryptReleaseContext(hCryptProv, 0);
+    UnmapDiskFile();
     
-    if (!result)
+#ifdef _WIN32
+    // A view can't extend past the file (that would grow it), so map the
+    // file as written so far and remap once a newer record is read
+    if (disk_file_handle == INVALID_HANDLE_VALUE)
     {
-        return false;
+        return nullptr;
+    }
+    size_t map_size = disk_next_offset;
+    disk_map_handle_ = CreateFileMappingA(disk_file_handle, NULL, PAGE_READONLY,
+                                          (DWORD)((uint64_t)map_size >> 32), (DWORD)map_size, NULL);
+    if (disk_map_handle_ == NULL)
+    {
+        return nullptr;
+    }
+    void *view = MapViewOfFile(disk_map_handle_, FILE_MAP_READ, 0, 0, map_size);
+    if (view == NULL)
+    {
+        CloseHandle(disk_map_handle_);
+        disk_map_handle_ = NULL;
+        return nullptr;
     }
 #else
-    // Use /dev/urandom for secure random generation on Linux
-    int fd = open("/dev/urandom", O_RDONLY);
-    if (fd < 0)
+    if (disk_file_descriptor < 0)
     {
-        return false;
+        return nullptr;
     }
-    
-    ssize_t bytes_read = read(fd, encryption_key_, 32);
-    close(fd);
-    
-    if (bytes_read != 32)
+    // Reserve room to grow; pages past the end of the file are never
+    // touched because records are only read once written
+    size_t map_size = 1 << 20;
+    while (map_size < end)
     {
-        return false;
+        map_size *= 2;
+    }
+    void *view = mmap(NULL, map_size, PROT_READ, MAP_SHARED, disk_file_descriptor, 0);
+    if (view == MAP_FAILED)
+    {
+        return nullptr;
     }
 #endif
     
-    encryption_initialized_ = true;
-    return true;
+    disk_map_ = (const char *)view;
+    disk_map_size_ = map_size;
+    return disk_map_ + offset;
 }
 
-void GhostMemoryManager::ChaCha20QuarterRound(uint32_t* state, int a, int b, int c, int d)
+void GhostMemoryManager::UnmapDiskFile()
 {
-    state[a] += state[b]; state[d] ^= state[a]; state[d] = (state[d] << 16) | (state[d] >> 16);
-    state[c] += state[d]; state[b] ^= state[c]; state[b] = (state[b] << 12) | (state[b] >> 20);
-    state[a] += state[b]; state[d] ^= state[a]; state[d] = (state[d] << 8)  | (state[d] >> 24);
-    state[c] += state[d]; state[b] ^= state[c]; state[b] = (state[b] << 7)  | (state[b] >> 25);
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
+    
+    if (!disk_map_)
+    {
+        return;
+    }
+#ifdef _WIN32
+    UnmapViewOfFile(disk_map_);
+    CloseHandle(disk_map_handle_);
+    disk_map_handle_ = NULL;
+#else
+    munmap((void *)disk_map_, disk_map_size_);
+#endif
+    disk_map_ = nullptr;
+    disk_map_size_ = 0;
 }
 
-void GhostMemoryManager::ChaCha20Block(const uint32_t* state, unsigned char* output)
+void GhostMemoryManager::DropDiskCache()
 {
-    uint32_t working_state[16];
-    memcpy(working_state, state, 64);
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
     
-    // 20 rounds (10 double rounds)
-    for (int i = 0; i < 10; i++)
+#ifdef _WIN32
+    if (disk_file_handle != INVALID_HANDLE_VALUE)
     {
-        // Column rounds
-        ChaCha20QuarterRound(working_state, 0, 4, 8, 12);
-        ChaCha20QuarterRound(working_state, 1, 5, 9, 13);
-        ChaCha20QuarterRound(working_state, 2, 6, 10, 14);
-        ChaCha20QuarterRound(working_state, 3, 7, 11, 15);
-        
-        // Diagonal rounds
-        ChaCha20QuarterRound(working_state, 0, 5, 10, 15);
-        ChaCha20QuarterRound(working_state, 1, 6, 11, 12);
-        ChaCha20QuarterRound(working_state, 2, 7, 8, 13);
-        ChaCha20QuarterRound(working_state, 3, 4, 9, 14);
+        FlushFileBuffers(disk_file_handle);
     }
-    
-    // Add original state
-    for (int i = 0; i < 16; i++)
+#else
+    if (disk_file_descriptor < 0)
     {
-        working_state[i] += state[i];
+        return;
     }
-    
-    // Serialize to little-endian bytes
-    for (int i = 0; i < 16; i++)
+    fdatasync(disk_file_descriptor);
+    if (disk_map_)
     {
-        output[i * 4 + 0] = (working_state[i] >> 0) & 0xFF;
-        output[i * 4 + 1] = (working_state[i] >> 8) & 0xFF;
-        output[i * 4 + 2] = (working_state[i] >> 16) & 0xFF;
-        output[i * 4 + 3] = (working_state[i] >> 24) & 0xFF;
+        // Mapped pages are skipped by POSIX_FADV_DONTNEED
+        madvise((void *)disk_map_, disk_map_size_, MADV_DONTNEED);
     }
+    posix_fadvise(disk_file_descriptor, 0, 0, POSIX_FADV_DONTNEED);
+#endif
 }
 
-void GhostMemoryManager::ChaCha20Crypt(unsigned char* data, size_t size, const unsigned char* nonce)
+// ============================================================================
+// Encryption (ChaCha20)
+// ============================================================================
+
+bool GhostMemoryManager::GenerateEncryptionKey()
 {
     // Note: Caller must hold mutex_
     
-    if (!encryption_initialized_)
+    if (!GhostRandomBytes(encryption_key_, sizeof(encryption_key_)))
     {
-        return;  // Encryption not enabled
+        return false;
     }
     
-    // ChaCha20 constants "expand 32-byte k"
-    const uint32_t constants[4] = {0x61707865, 0x3320646e, 0x79622d32, 0x6b206574};
-    
-    // Build ChaCha20 state
-    uint32_t state[16];
-    
-    // Constants
-    state[0] = constants[0];
-    state[1] = constants[1];
-    state[2] = constants[2];
-    state[3] = constants[3];
+    encryption_initialized_ = true;
+    return true;
+}
+
+void GhostMemoryManager::ChaCha20Crypt(unsigned char* data, size_t size, const unsigned char* nonce)
+{
+    // Note: Caller must hold mutex_
     
-    // Key (32 bytes = 8 words)
-    for (int i = 0; i < 8; i++)
+    if (!encryption_initialized_)
     {
-        state[4 + i] = encryption_key_[i * 4 + 0] |
-                       (encryption_key_[i * 4 + 1] << 8) |
-                       (encryption_key_[i * 4 + 2] << 16) |
-                       (encryption_key_[i * 4 + 3] << 24);
+        return;  // Encryption not enabled
     }
     
-    // Block counter (starts at 0)
-    state[12] = 0;
-    
-    // Nonce (12 bytes = 3 words)
-    state[13] = nonce[0] | (nonce[1] << 8) | (nonce[2] << 16) | (nonce[3] << 24);
-    state[14] = nonce[4] | (nonce[5] << 8) | (nonce[6] << 16) | (nonce[7] << 24);
-    state[15] = nonce[8] | (nonce[9] << 8) | (nonce[10] << 16) | (nonce[11] << 24);
-    
-    // Process data in 64-byte blocks
-    unsigned char keystream[64];
-    size_t offset = 0;
-    
-    while (offset < size)
-    {
-        // Generate keystream block
-        ChaCha20Block(state, keystream);
-        
-        // XOR with data
-        size_t block_size = (size - offset < 64) ? (size - offset) : 64;
-        for (size_t i = 0; i < block_size; i++)
-        {
-            data[offset + i] ^= keystream[i];
-        }
-        
-        offset += block_size;
-        state[12]++;  // Increment block counter
-    }
+    GhostChaCha20Crypt(encryption_key_, nonce, 0, data, size);
 }
 
 // ============================================================================
-// Memory Management
+// Idle Page Scanner
 // ============================================================================
 
-void GhostMemoryManager::EvictOldestPage(void *ignore_page)
+size_t GhostMemoryManager::ScanIdlePages()
 {
-    // Note: Caller must hold mutex_
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
+    
+    if (config_.idle_freeze_age_ms == 0)
+    {
+        return 0;
+    }
     
-    // Determine the effective max pages (config or constant)
-    size_t effective_max = (config_.max_memory_pages > 0) 
-                           ? config_.max_memory_pages 
-                           : MAX_PHYSICAL_PAGES;
+    auto scan_start = std::chrono::steady_clock::now();
+    uint64_t now_ms = SteadyMillis();
+    size_t frozen = 0;
     
-    // While we are over the limit...
-    while (active_ram_pages.size() >= effective_max)
+    for (auto it = active_ram_pages.begin(); it != active_ram_pages.end();)
     {
-
-        void *victim = active_ram_pages.back();
-
-        // Protection: If the victim is the page we need right now,
-        // take the second-to-last page instead!
-        if (victim == ignore_page)
+        void *page_start = *it;
+        PageInfo &info = page_info_[page_start];
+        
+        if (!info.idle_probe)
         {
-            if (active_ram_pages.size() < 2)
-                break; // Emergency brake: We only have this one page
-
-            // Take the second-to-last one
-            auto it = active_ram_pages.end();
-            --it;
-            --it;
-            victim = *it;
-
-            // Manually remove from the list
-            active_ram_pages.erase(it);
+            // Arm the probe: the next access takes a soft fault
+#ifdef _WIN32
+            DWORD old_protect;
+            bool armed = VirtualProtect(page_start, PAGE_SIZE, PAGE_NOACCESS, &old_protect) != 0;
+#else
+            bool armed = mprotect(page_start, PAGE_SIZE, PROT_NONE) == 0;
+#endif
+            if (armed)
+            {
+                info.idle_probe = true;
+                info.probed_at_ms = now_ms;
+            }
+            ++it;
         }
-        else
+        else if (now_ms - info.probed_at_ms >= config_.idle_freeze_age_ms)
         {
-            active_ram_pages.pop_back();
-        }
-
-        // Check if this page has any active allocations (reference count > 0)
-        auto ref_it = page_ref_counts_.find(victim);
-        if (ref_it == page_ref_counts_.end() || ref_it->second == 0)
-        {
-            // This is a "zombie page" - all allocations have been freed
-            // Don't compress it, just clean up and release memory
+            // Untouched for a whole age - freeze it although we are under budget
+            it = RemoveResidentPage(it);
             
-            // Remove from reference count map (if present)
-            if (ref_it != page_ref_counts_.end())
+            auto ref_it = page_ref_counts_.find(page_start);
+            bool zombie = (ref_it == page_ref_counts_.end() || ref_it->second == 0);
+            uint64_t evictions_before = stats_.evictions;
+            EvictPage(page_start);
+            
+            if (zombie)
             {
-                page_ref_counts_.erase(ref_it);
+                stats_.idle_reclaimed_bytes += PAGE_SIZE;  // Released outright
+            }
+            else if (stats_.evictions != evictions_before)
+            {
+                // In-memory mode keeps the compressed image in RAM
+                size_t kept = 0;
+                if (!config_.use_disk_backing)
+                {
+                    kept = std::min<size_t>(page_info_[page_start].compressed_size, PAGE_SIZE);
+                }
+                stats_.idle_reclaimed_bytes += PAGE_SIZE - kept;
+                stats_.idle_freezes++;
+                frozen++;
             }
-            
-            // Clean up compressed data (in-memory mode)
-            backing_store.erase(victim);
-            
-            // Clean up disk location tracking (disk-backed mode)
-            disk_page_locations.erase(victim);
-            
-            // Release physical and virtual memory
-#ifdef _WIN32
-            VirtualFree(victim, PAGE_SIZE, MEM_DECOMMIT);
-            VirtualFree(victim, 0, MEM_RELEASE);
-#else
-            munmap(victim, PAGE_SIZE);
-#endif
-            
-            dbgmsg("Zombie page freed during eviction: ", victim);
         }
         else
         {
-            // Page has active allocations - compress it normally
-            //[Manager] RAM full! Evicting page victim
-            FreezePage(victim);
+            ++it;
         }
     }
+    
+    stats_.idle_scans++;
+    stats_.idle_scan_ns += (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - scan_start).count();
+    PublishStats();
+    
+    return frozen;
 }
 
-// Internal library metadata initialization (compliance tracking)
-void GhostMemoryManager::InitializeLibraryMetadata()
+void GhostMemoryManager::StartIdleScanner()
 {
     // Note: Caller must hold mutex_
     
-    if (lib_meta_init_) return;
+    bool timed_budget = coordinator_.IsAttached() && config_.coordinator_update_ms != 0;
+    if ((config_.idle_freeze_age_ms == 0 && !timed_budget) || idle_thread_.joinable())
+    {
+        return;
+    }
     
-    const unsigned char enc_data[] = {
-        0x2E ^ 0x69,
-        0x34 ^ 0x41,
-        0x39 ^ 0x5D,
-        0x30 ^ 0x59,
-        0x33 ^ 0x56 
-    };
+    {
+        std::lock_guard<std::mutex> idle_lock(idle_mutex_);
+        idle_stop_ = false;
+    }
+    idle_thread_ = std::thread(&GhostMemoryManager::IdleScannerLoop, this);
+}
+
+void GhostMemoryManager::StopIdleScanner()
+{
+    if (!idle_thread_.joinable())
+    {
+        return;
+    }
     
-    // Allocate small internal buffer for metadata
-#ifdef _WIN32
-    lib_meta_ptr_ = VirtualAlloc(NULL, 16, MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE);
-#else
-    lib_meta_ptr_ = mmap(NULL, 16, PROT_READ | PROT_WRITE,
-                         MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
-    if (lib_meta_ptr_ == MAP_FAILED) lib_meta_ptr_ = nullptr;
-#endif
+    {
+        std::lock_guard<std::mutex> idle_lock(idle_mutex_);
+        idle_stop_ = true;
+    }
+    idle_cv_.notify_all();
+    idle_thread_.join();
+}
+
+void GhostMemoryManager::IdleScannerLoop()
+{
+    // config_ cannot change while we run: Initialize() stops us first
+    bool scan = config_.idle_freeze_age_ms != 0;
+    bool timed_budget = coordinator_.IsAttached() && config_.coordinator_update_ms != 0;
+    size_t scan_ms = std::max<size_t>(config_.idle_scan_interval_ms, 1);
+    size_t interval_ms = scan ? scan_ms : SIZE_MAX;
+    if (timed_budget)
+    {
+        interval_ms = std::min(interval_ms, config_.coordinator_update_ms);
+    }
+    uint64_t last_scan_ms = SteadyMillis();
     
-    if (lib_meta_ptr_)
+    std::unique_lock<std::mutex> idle_lock(idle_mutex_);
+    while (!idle_cv_.wait_for(idle_lock, std::chrono::milliseconds(interval_ms),
+                              [this] { return idle_stop_; }))
     {
-        // Decode and store marker
-        unsigned char* meta = static_cast<unsigned char*>(lib_meta_ptr_);
-        meta[0] = enc_data[0] ^ 0x69;
-        meta[1] = enc_data[1] ^ 0x41;
-        meta[2] = enc_data[2] ^ 0x5D;
-        meta[3] = enc_data[3] ^ 0x59;
-        meta[4] = enc_data[4] ^ 0x56;
-        meta[5] = 0x00;  // Null terminator
-        
-        // Add some padding to make it less obvious
-        for (int i = 6; i < 16; i++) {
-            meta[i] = static_cast<unsigned char>(i * 17);
+        idle_lock.unlock();
+        if (scan && SteadyMillis() - last_scan_ms >= scan_ms)
+        {
+            last_scan_ms = SteadyMillis();
+            ScanIdlePages();
+            CompactPatches(std::max<size_t>(config_.patch_log_bytes / 2, 1));
         }
-        
-        lib_meta_init_ = true;
+        if (timed_budget)
+        {
+            RefreshCoordinatedBudget();
+        }
+        idle_lock.lock();
     }
 }
 
-// Internal function: Mark page as "recently used"
-void GhostMemoryManager::MarkPageAsActive(void *page_start)
+// ============================================================================
+// Patch Logs (GhostWrite)
+// ============================================================================
+
+bool GhostMemoryManager::IsManagedRange(const void *start, size_t size) const
 {
     // Note: Caller must hold mutex_
     
-    // First check if it's already in the list (shouldn't be, but better safe than sorry)
-    active_ram_pages.remove(page_start);
-
-    // Insert at front (Most Recently Used)
-    active_ram_pages.push_front(page_start);
+    // The whole range must lie in one block (blocks never overlap)
+    auto block_it = managed_blocks.upper_bound(const_cast<void *>(start));
+    if (block_it == managed_blocks.begin())
+    {
+        return false;
+    }
+    --block_it;
+    uintptr_t address = (uintptr_t)start;
+    uintptr_t block_start = (uintptr_t)block_it->first;
+    return address - block_start <= block_it->second &&
+           size <= block_start + block_it->second - address;
 }
 
-void *GhostMemoryManager::AllocateGhost(size_t size)
+bool GhostMemoryManager::Write(void *dst, const void *src, size_t size)
 {
     std::lock_guard<std::recursive_mutex> lock(mutex_);
     
-    // Initialize library metadata on first allocation (for compliance tracking)
-    if (!lib_meta_init_)
+    if (!IsManagedRange(dst, size))
     {
-        InitializeLibraryMetadata();
+        return false;
     }
     
-    size_t aligned_size = (size + PAGE_SIZE - 1) & ~(PAGE_SIZE - 1);
+    uintptr_t address = (uintptr_t)dst;
+    const char *bytes = (const char *)src;
+    while (size > 0)
+    {
+        void *page_start = (void *)(address & ~(uintptr_t)(PAGE_SIZE - 1));
+        size_t offset = address - (uintptr_t)page_start;
+        size_t chunk = std::min(size, PAGE_SIZE - offset);
+        
+        if (!AppendPatch(page_start, offset, bytes, chunk))
+        {
+            // An ordinary store; faults the page in if it is not resident
+            memcpy((void *)address, bytes, chunk);
+        }
+        address += chunk;
+        bytes += chunk;
+        size -= chunk;
+    }
     
-#ifdef _WIN32
-    void *ptr = VirtualAlloc(NULL, aligned_size, MEM_RESERVE, PAGE_NOACCESS);
-#else
-    // Reserve address space without allocating physical pages
-    void *ptr = mmap(NULL, aligned_size, PROT_NONE, 
-                     MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
-    if (ptr == MAP_FAILED) ptr = nullptr;
-#endif
+    PublishStats();
+    return true;
+}
+
+size_t GhostMemoryManager::CompactPatches(size_t min_bytes)
+{
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
     
-    if (ptr)
+    std::vector<void *> pages;
+    for (const auto &entry : patch_logs_)
     {
-        managed_blocks[ptr] = aligned_size;
-        
-        // Track allocation metadata for deallocation
-        // The allocation starts at the beginning of the first page
-        void* page_start = ptr;  // Already page-aligned from OS
-        
-        AllocationInfo info;
-        info.page_start = page_start;
-        info.offset = 0;  // Allocation starts at page boundary
-        info.size = size;  // Store original size (not aligned)
-        
-        allocation_metadata_[ptr] = info;
-        
-        // Increment reference count for all pages in this allocation
-        size_t num_pages = aligned_size / PAGE_SIZE;
-        for (size_t i = 0; i < num_pages; i++)
+        if (entry.second.size() >= min_bytes)
         {
-            void* current_page = (char*)ptr + (i * PAGE_SIZE);
-            page_ref_counts_[current_page]++;
+            pages.push_back(entry.first);
         }
-        
-        //[Alloc] Virtual region: ptr reserved
     }
-    return ptr;
+    size_t compacted = 0;
+    for (void *page_start : pages)
+    {
+        compacted += CompactPatchLog(page_start) ? 1 : 0;
+    }
+    
+    if (!pages.empty())
+    {
+        PublishStats();
+    }
+    return compacted;
 }
 
+bool GhostMemoryManager::IsFrozen(void *page_start) const
+{
+    // Note: Caller must hold mutex_
+    
+    if (backing_store.count(page_start))
+    {
+        return true;
+    }
+    if (kernel_pages_.count(page_start))
+    {
+        return false;  // Content still in place
+    }
+    
+    // Never touched: the first fault will zero-fill it
+    auto info_it = page_info_.find(page_start);
+    if (info_it == page_info_.end())
+    {
+        return true;
+    }
+    
+    // Disk records outlive restores
+    return !info_it->second.resident && disk_page_locations.count(page_start);
+}
 
-void GhostMemoryManager::DeallocateGhost(void* ptr, size_t size)
+bool GhostMemoryManager::AppendPatch(void *page_start, size_t offset, const char *data, size_t size)
 {
-    // Handle nullptr gracefully (standard behavior)
-    if (ptr == nullptr)
+    // Note: Caller must hold mutex_
+    
+    size_t record_size = sizeof(PatchHeader) + size;
+    if (config_.freeze_backend != GhostFreezeBackend::Compress ||
+        record_size > config_.patch_log_bytes || !IsFrozen(page_start))
+    {
+        return false;
+    }
+    
+    auto log_it = patch_logs_.find(page_start);
+    if (log_it != patch_logs_.end() && log_it->second.size() + record_size > config_.patch_log_bytes)
+    {
+        if (!CompactPatchLog(page_start))
+        {
+            return false;  // Log stays bounded; the write faults the page in
+        }
+    }
+    
+    PatchHeader header = {(uint16_t)offset, (uint16_t)size};
+    std::vector<char> &log = patch_logs_[page_start];
+    log.insert(log.end(), (const char *)&header, (const char *)&header + sizeof(header));
+    log.insert(log.end(), data, data + size);
+    stored_bytes_ += record_size;
+    stats_.patch_writes++;
+    return true;
+}
+
+void GhostMemoryManager::CopyPatches(void *page_start, char *out_page) const
+{
+    // Note: Caller must hold mutex_
+    
+    auto log_it = patch_logs_.find(page_start);
+    if (log_it == patch_logs_.end())
     {
         return;
     }
     
-    std::lock_guard<std::recursive_mutex> lock(mutex_);
+    const std::vector<char> &log = log_it->second;
+    for (size_t position = 0; position + sizeof(PatchHeader) <= log.size();)
+    {
+        PatchHeader header;
+        memcpy(&header, log.data() + position, sizeof(header));
+        position += sizeof(header);
+        memcpy(out_page + header.offset, log.data() + position, header.size);
+        position += header.size;
+    }
+}
+
+void GhostMemoryManager::ApplyPatchLog(void *page_start)
+{
+    // Note: Caller must hold mutex_
     
-    // Look up allocation metadata
-    auto alloc_it = allocation_metadata_.find(ptr);
-    if (alloc_it == allocation_metadata_.end())
+    auto log_it = patch_logs_.find(page_start);
+    if (log_it == patch_logs_.end())
     {
-        dbgmsg("WARNING: Attempted to deallocate untracked pointer: ", ptr);
         return;
     }
     
-    AllocationInfo& info = alloc_it->second;
-    size_t allocation_size = info.size;
+    CopyPatches(page_start, (char *)page_start);
+    stored_bytes_ -= log_it->second.size();
+    patch_logs_.erase(log_it);
+}
+
+bool GhostMemoryManager::CompactPatchLog(void *page_start)
+{
+    // Note: Caller must hold mutex_
     
-    // Remove allocation metadata
-    allocation_metadata_.erase(alloc_it);
+    // The page itself stays inaccessible: it is decoded and re-encoded
+    // through a buffer, so a thread touching it meanwhile faults and waits
+    // on mutex_ instead of seeing a half-restored page, and no store can
+    // land between encoding and re-protection.
+    // A damaged record is reported and decodes as a zero page, which is
+    // what a fault would restore; replacing it means it is reported once.
+    alignas(uint64_t) char image[PAGE_SIZE];
+    DecodeStoredImage(page_start, image);
+    CopyPatches(page_start, image);
     
-    // Calculate how many pages this allocation spans
-    size_t aligned_size = (allocation_size + PAGE_SIZE - 1) & ~(PAGE_SIZE - 1);
-    size_t num_pages = aligned_size / PAGE_SIZE;
+    // Not a use and not a new eviction: the replacement state and the
+    // eviction counters stay as they were
+    std::vector<char> record;
+    uint64_t compress_ns = 0;
+    EncodeFrozenRecord(page_start, image, record, compress_ns);
+    AddCompressionTime(compress_ns);
+    if (!InstallFrozenRecord(page_start, record))
+    {
+        return false;
+    }
+    stats_.patch_compactions++;
+    return true;
+}
+
+bool GhostMemoryManager::Ingest(void *dst, const void *src, size_t size)
+{
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
     
-    // Decrement reference count for each page and clean up fully freed pages
-    for (size_t i = 0; i < num_pages; i++)
+    if (!IsManagedRange(dst, size))
     {
-        void* page_start = (char*)ptr + (i * PAGE_SIZE);
-        
-        auto ref_it = page_ref_counts_.find(page_start);
-        if (ref_it == page_ref_counts_.end())
+        return false;
+    }
+    
+    uintptr_t address = (uintptr_t)dst;
+    const char *bytes = (const char *)src;
+    
+    // Pages batched per round of parallel compression (bounds the
+    // memory held by encoded records before they are installed)
+    const size_t kBatchPages = 1024;
+    size_t threads = std::max<size_t>(config_.ingest_threads, 1);
+    std::vector<void *> pages;
+    std::vector<const char *> images;
+    std::vector<std::vector<char>> records(kBatchPages);
+    std::vector<uint64_t> compress_ns(kBatchPages);
+    
+    while (size > 0)
+    {
+        // Collect whole, non-resident pages; everything else is written
+        pages.clear();
+        images.clear();
+        while (size > 0 && pages.size() < kBatchPages)
         {
-            dbgmsg("ERROR: Page reference count not found for: ", page_start);
-            continue;
+            void *page_start = (void *)(address & ~(uintptr_t)(PAGE_SIZE - 1));
+            size_t offset = address - (uintptr_t)page_start;
+            size_t chunk = std::min(size, PAGE_SIZE - offset);
+            
+            if (chunk == PAGE_SIZE && config_.freeze_backend == GhostFreezeBackend::Compress &&
+                IsFrozen(page_start))
+            {
+                pages.push_back(page_start);
+                images.push_back(bytes);
+            }
+            else
+            {
+                Write((void *)address, bytes, chunk);
+            }
+            address += chunk;
+            bytes += chunk;
+            size -= chunk;
         }
         
-        ref_it->second--;
+        // Encode in parallel: workers only read the source and manager
+        // state; their compression time is accounted afterwards
+        auto encode = [&](size_t first)
+        {
+            for (size_t i = first; i < pages.size(); i += threads)
+            {
+                EncodeFrozenRecord(pages[i], images[i], records[i], compress_ns[i]);
+            }
+        };
+        std::vector<std::thread> workers;
+        for (size_t t = 1; t < std::min(threads, pages.size()); t++)
+        {
+            workers.emplace_back(encode, t);
+        }
+        encode(0);
+        for (auto &worker : workers)
+        {
+            worker.join();
+        }
+        for (size_t i = 0; i < pages.size(); i++)
+        {
+            AddCompressionTime(compress_ns[i]);
+        }
+        if (config_.enable_adaptive_compression)
+        {
+            TuneCompression();
+        }
         
-        // If this was the last allocation in the page, clean up completely
-        if (ref_it->second == 0)
+        // Install in address order (disk records are appended)
+        for (size_t i = 0; i < pages.size(); i++)
         {
-            // Remove reference count entry
-            page_ref_counts_.erase(ref_it);
-            
-            // Remove from active RAM pages LRU list
-            active_ram_pages.remove(page_start);
-            
-            // Clean up compressed data (in-memory mode)
-            auto backing_it = backing_store.find(page_start);
-            if (backing_it != backing_store.end())
+            if (InstallFrozenRecord(pages[i], records[i]))
             {
-                backing_store.erase(backing_it);
+                stats_.ingested_pages++;
             }
-            
-            // Clean up disk location tracking (disk-backed mode)
-            auto disk_it = disk_page_locations.find(page_start);
-            if (disk_it != disk_page_locations.end())
+            else
             {
-                disk_page_locations.erase(disk_it);
+                Write(pages[i], images[i], PAGE_SIZE);
             }
-            
-            // Release physical and virtual memory
-            // Note: We only free the specific page, not the entire managed block
-            // The managed_blocks entry tracks the original allocation region
-#ifdef _WIN32
-            // On Windows, decommit then release the page
-            VirtualFree(page_start, PAGE_SIZE, MEM_DECOMMIT);
-            VirtualFree(page_start, 0, MEM_RELEASE);
-#else
-            // On Linux, unmap the page
-            munmap(page_start, PAGE_SIZE);
-#endif
-            dbgmsg("Page fully freed: ", page_start);
         }
     }
+    
+    PublishStats();
+    return true;
 }
 
-void GhostMemoryManager::FreezePage(void *page_start)
+void GhostMemoryManager::EncodeFrozenRecord(void *page_start, const char *image, std::vector<char> &out,
+                                            uint64_t &compress_ns) const
 {
     // Note: Caller must hold mutex_
     
-    if (config_.use_disk_backing)
+    compress_ns = 0;
+    if (!config_.use_disk_backing || config_.compress_before_disk)
     {
-        // Disk-backed mode
-        if (config_.compress_before_disk)
-        {
-            // Compress before writing to disk
-            int max_dst_size = LZ4_compressBound(PAGE_SIZE);
-            std::vector<char> compressed_data(max_dst_size);
-            int compressed_size = LZ4_compress_default(
-                (const char *)page_start, 
-                compressed_data.data(), 
-                PAGE_SIZE, 
-                max_dst_size
-            );
-            
-            if (compressed_size > 0)
-            {
-                compressed_data.resize(compressed_size);
-                
-                // Encrypt if encryption is enabled
-                if (config_.encrypt_disk_pages)
-                {
-                    // Generate unique nonce from page address
-                    unsigned char nonce[12] = {0};
-                    uintptr_t addr = (uintptr_t)page_start;
-                    memcpy(nonce, &addr, sizeof(addr) < 12 ? sizeof(addr) : 12);
-                    
-                    // Encrypt compressed data in place
-                    ChaCha20Crypt((unsigned char*)compressed_data.data(), compressed_data.size(), nonce);
-                }
-                
-                size_t disk_offset = 0;
-                if (WriteToDisk(compressed_data.data(), compressed_size, disk_offset))
-                {
-                    // Track where this page is stored on disk
-                    disk_page_locations[page_start] = {disk_offset, (size_t)compressed_size};
-                }
-                else
-                {
-                    dbgmsg("ERROR: Failed to write page to disk");
-                    return;
-                }
-            }
-        }
-        else
-        {
-            // Write raw uncompressed page to disk
-            std::vector<unsigned char> page_data(PAGE_SIZE);
-            memcpy(page_data.data(), page_start, PAGE_SIZE);
-            
-            // Encrypt if encryption is enabled
-            if (config_.encrypt_disk_pages)
-            {
-                // Generate unique nonce from page address
-                unsigned char nonce[12] = {0};
-                uintptr_t addr = (uintptr_t)page_start;
-                memcpy(nonce, &addr, sizeof(addr) < 12 ? sizeof(addr) : 12);
-                
-                // Encrypt page data
-                ChaCha20Crypt(page_data.data(), PAGE_SIZE, nonce);
-            }
-            
-            size_t disk_offset = 0;
-            if (WriteToDisk(page_data.data(), PAGE_SIZE, disk_offset))
-            {
-                disk_page_locations[page_start] = {disk_offset, PAGE_SIZE};
-            }
-            else
-            {
-                dbgmsg("ERROR: Failed to write page to disk");
-                return;
-            }
-        }
-        
-        // Release RAM (Decommit)
-#ifdef _WIN32
-        VirtualFree(page_start, PAGE_SIZE, MEM_DECOMMIT);
-#else
-        mprotect(page_start, PAGE_SIZE, PROT_NONE);
-#endif
+        int max_dst_size = LZ4_compressBound(PAGE_SIZE);
+        out.resize(max_dst_size);
+        out.resize(CompressPageImage(page_start, image, out.data(), max_dst_size, compress_ns));
     }
     else
     {
-        // In-memory backing mode (original behavior)
-        // 1. Compress
-        int max_dst_size = LZ4_compressBound(PAGE_SIZE);
-        std::vector<char> compressed_data(max_dst_size);
-        int compressed_size = LZ4_compress_default(
-            (const char *)page_start, 
-            compressed_data.data(), 
-            PAGE_SIZE, 
-            max_dst_size
-        );
+        out.assign(image, image + PAGE_SIZE);
+    }
+    
+    if (config_.use_disk_backing && config_.encrypt_disk_pages && encryption_initialized_ && !out.empty())
+    {
+        unsigned char nonce[GHOST_CHACHA20_NONCE_SIZE];
+        GhostChaCha20PageNonce(page_start, nonce);
+        GhostChaCha20Crypt(encryption_key_, nonce, 0, (unsigned char *)out.data(), out.size());
+    }
+}
 
-        if (compressed_size > 0)
+bool GhostMemoryManager::InstallFrozenRecord(void *page_start, std::vector<char> &record)
+{
+    // Note: Caller must hold mutex_
+    
+    if (record.empty())
+    {
+        return false;
+    }
+    
+    size_t record_size = record.size();
+    GhostStorageTier tier = GhostStorageTier::Memory;
+    if (config_.use_disk_backing)
+    {
+        size_t disk_offset = 0;
+        if (!WriteToDisk(record.data(), record_size, disk_offset))
         {
-            compressed_data.resize(compressed_size);
-            backing_store[page_start] = compressed_data; // Store in the vault
-
-            // 2. Release RAM (Decommit)
-#ifdef _WIN32
-            VirtualFree(page_start, PAGE_SIZE, MEM_DECOMMIT);
-#else
-            // On Linux, we use mprotect to make it inaccessible again
-            mprotect(page_start, PAGE_SIZE, PROT_NONE);
-#endif
+            ReportError(GhostErrorCode::DiskWriteFailed, page_start, disk_offset, record_size);
+            return false;
         }
+        disk_page_locations[page_start] = {disk_offset, record_size, GhostCrc32c(record.data(), record_size)};
+        tier = config_.compress_before_disk ? GhostStorageTier::Disk : GhostStorageTier::DiskRaw;
+    }
+    else
+    {
+        std::vector<char> &stored = backing_store[page_start];
+        stored_bytes_ -= stored.size();
+        stored.swap(record);
+        stored_bytes_ += stored.size();
     }
+    
+    // The new image replaces everything the page had
+    EraseDeltaBase(page_start);
+    auto log_it = patch_logs_.find(page_start);
+    if (log_it != patch_logs_.end())
+    {
+        stored_bytes_ -= log_it->second.size();
+        patch_logs_.erase(log_it);
+    }
+    
+    // Frozen without an eviction: no shadow entry, no eviction count
+    PageInfo &info = page_info_[page_start];
+    info.compressed_size = (uint32_t)record_size;
+    info.tier = tier;
+    info.resident = false;
+    return true;
 }
 
-#ifdef _WIN32
-// Windows exception handler implementation
-LONG WINAPI GhostMemoryManager::VectoredHandler(PEXCEPTION_POINTERS pExceptionInfo)
-{
-    if (pExceptionInfo->ExceptionRecord->ExceptionCode == EXCEPTION_ACCESS_VIOLATION)
-    {
-        ULONG_PTR fault_addr = pExceptionInfo->ExceptionRecord->ExceptionInformation[1];
-        auto &manager = Instance();
-        
-        // Lock mutex for thread-safe access to shared data structures
-        std::lock_guard<std::recursive_mutex> lock(manager.mutex_);
+// ============================================================================
+// Memory Management
+// ============================================================================
 
-        // Is it our address?
-        for (const auto &block : manager.managed_blocks)
-        {
-            ULONG_PTR start = (ULONG_PTR)block.first;
-            ULONG_PTR end = start + block.second;
+void GhostMemoryManager::EvictOldestPage(void *ignore_page)
+{
+    // Note: Caller must hold mutex_
+    
+    // Determine the effective max pages (coordinator, config or constant)
+    size_t effective_max = GetEffectiveMaxPages();
+    
+    // Leave room for the page about to come in
+    EvictDownTo(effective_max > 0 ? effective_max - 1 : 0, ignore_page);
+}
 
-            if (fault_addr >= start && fault_addr < end)
-            {
-                void *page_start = (void *)(fault_addr & ~(PAGE_SIZE - 1));
+void GhostMemoryManager::EvictDownTo(size_t max_pages, void *ignore_page)
+{
+    // Note: Caller must hold mutex_
+    
+    // While we are over the limit... A victim that cannot be frozen goes
+    // back to the front, so each resident page is tried at most once
+    size_t attempts = active_ram_pages.size();
+    while (active_ram_pages.size() > max_pages && attempts-- > 0)
+    {
+        // Protection: never evict the page we need right now
+        auto victim_it = SelectVictim(ignore_page);
+        if (victim_it == active_ram_pages.end())
+            break; // Emergency brake: We only have this one page
 
-                //[Trap] Access to  page_start
-                // IMPORTANT: Before getting RAM, we must check if we have room!
-                manager.EvictOldestPage(page_start);
+        void *victim = *victim_it;
+        RemoveResidentPage(victim_it);
+        
+        //[Manager] RAM full! Evicting page victim
+        GHOST_TRACE2(evict, victim, active_ram_pages.size());
+        EvictPage(victim);
+    }
+}
 
-                // Now we have room -> get RAM
-                if (VirtualAlloc(page_start, PAGE_SIZE, MEM_COMMIT, PAGE_READWRITE))
-                {
-                    // If data was in backup -> Restore
-                    if (manager.config_.use_disk_backing)
-                    {
-                        // Restore from disk
-                        auto it = manager.disk_page_locations.find(page_start);
-                        if (it != manager.disk_page_locations.end())
-                        {
-                            size_t disk_offset = it->second.first;
-                            size_t data_size = it->second.second;
-                            
-                            if (manager.config_.compress_before_disk)
-                            {
-                                // Read compressed data and decompress
-                                std::vector<char> compressed_data(data_size);
-                                if (manager.ReadFromDisk(disk_offset, data_size, compressed_data.data()))
-                                {
-                                    // Decrypt if encryption is enabled
-                                    if (manager.config_.encrypt_disk_pages)
-                                    {
-                                        // Generate same nonce used for encryption
-                                        unsigned char nonce[12] = {0};
-                                        uintptr_t addr = (uintptr_t)page_start;
-                                        memcpy(nonce, &addr, sizeof(addr) < 12 ? sizeof(addr) : 12);
-                                        
-                                        // Decrypt in place
-                                        manager.ChaCha20Crypt((unsigned char*)compressed_data.data(), 
-                                                             compressed_data.size(), nonce);
-                                    }
-                                    
-                                    LZ4_decompress_safe(compressed_data.data(), (char *)page_start, 
-                                                       data_size, PAGE_SIZE);
-                                }
-                            }
-                            else
-                            {
-                                // Read raw uncompressed data
-                                std::vector<unsigned char> page_data(PAGE_SIZE);
-                                if (manager.ReadFromDisk(disk_offset, PAGE_SIZE, page_data.data()))
-                                {
-                                    // Decrypt if encryption is enabled
-                                    if (manager.config_.encrypt_disk_pages)
-                                    {
-                                        // Generate same nonce used for encryption
-                                        unsigned char nonce[12] = {0};
-                                        uintptr_t addr = (uintptr_t)page_start;
-                                        memcpy(nonce, &addr, sizeof(addr) < 12 ? sizeof(addr) : 12);
-                                        
-                                        // Decrypt
-                                        manager.ChaCha20Crypt(page_data.data(), PAGE_SIZE, nonce);
-                                    }
-                                    
-                                    memcpy(page_start, page_data.data(), PAGE_SIZE);
-                                }
-                            }
-                            
-                            // Note: We keep disk_page_locations entry (don't erase)
-                            // in case page gets evicted again
-                        }
-                    }
-                    else
-                    {
-                        // Restore from in-memory backing store
-                        if (manager.backing_store.count(page_start))
-                        {
-                            std::vector<char> &data = manager.backing_store[page_start];
-                            LZ4_decompress_safe(data.data(), (char *)page_start, data.size(), PAGE_SIZE);
-                            manager.backing_store.erase(page_start); // Remove from backup, it's live now
-                        }
-                    }
+void GhostMemoryManager::RecordFaultSite(const void *fault_ip, bool refault, uint64_t fault_ns)
+{
+    // Note: Caller must hold mutex_
+    
+    if (config_.fault_ip_sample_rate == 0 || fault_ip == nullptr ||
+        ++faults_since_sample_ < config_.fault_ip_sample_rate)
+    {
+        return;
+    }
+    faults_since_sample_ = 0;
+    
+    FaultSiteState &site = fault_sites_[fault_ip];
+    site.samples++;
+    site.refaults += refault ? 1 : 0;
+    site.total_ns += fault_ns;
+    site.max_ns = std::max(site.max_ns, fault_ns);
+}
 
-                    // Add to active list
-                    manager.MarkPageAsActive(page_start);
+std::vector<GhostFaultSite> GhostMemoryManager::GetFaultSites(size_t max_sites) const
+{
+    std::vector<GhostFaultSite> sites;
+    {
+        std::lock_guard<std::recursive_mutex> lock(mutex_);
+        sites.reserve(fault_sites_.size());
+        for (const auto &entry : fault_sites_)
+        {
+            GhostFaultSite site;
+            site.ip = entry.first;
+            site.samples = entry.second.samples;
+            site.refaults = entry.second.refaults;
+            site.total_ns = entry.second.total_ns;
+            site.max_ns = entry.second.max_ns;
+            sites.push_back(site);
+        }
+    }
+    
+    std::sort(sites.begin(), sites.end(), [](const GhostFaultSite &a, const GhostFaultSite &b)
+    {
+        return (a.samples != b.samples) ? a.samples > b.samples : a.total_ns > b.total_ns;
+    });
+    if (max_sites > 0 && sites.size() > max_sites)
+    {
+        sites.resize(max_sites);
+    }
+    
+    // Symbolize without holding mutex_ - dladdr takes the loader lock
+    for (GhostFaultSite &site : sites)
+    {
+        site.location = GhostSymbolize(site.ip);
+    }
+    return sites;
+}
 
-                    return EXCEPTION_CONTINUE_EXECUTION;
-                }
-            }
+void GhostMemoryManager::PrintFaultReport(std::ostream &out, size_t max_sites) const
+{
+    size_t rate = 0;
+    uint64_t total_samples = 0;
+    {
+        std::lock_guard<std::recursive_mutex> lock(mutex_);
+        rate = config_.fault_ip_sample_rate;
+        for (const auto &entry : fault_sites_)
+        {
+            total_samples += entry.second.samples;
         }
     }
-    return EXCEPTION_CONTINUE_SEARCH;
+    
+    std::vector<GhostFaultSite> sites = GetFaultSites(max_sites);
+    
+    // Format into a local stream so the caller's flags and precision
+    // are left alone
+    std::ostringstream report;
+    report << "GhostMem fault sites (1 in " << rate << " faults sampled, "
+           << total_samples << " samples)\n";
+    report << std::setw(9) << "samples" << std::setw(11) << "est.faults"
+           << std::setw(10) << "refaults" << std::setw(11) << "mean us"
+           << std::setw(11) << "max us" << "  location\n";
+    for (const GhostFaultSite &site : sites)
+    {
+        report << std::setw(9) << site.samples
+               << std::setw(11) << site.samples * (rate > 0 ? rate : 1)
+               << std::setw(10) << site.refaults
+               << std::setw(11) << std::fixed << std::setprecision(1)
+               << (site.total_ns / 1000.0) / (double)site.samples
+               << std::setw(11) << site.max_ns / 1000.0
+               << "  " << site.location.ToString() << "\n";
+    }
+    out << report.str();
+    out.flush();
 }
 
-#else
-// Linux signal handler implementation
-void GhostMemoryManager::InstallSignalHandler()
+void GhostMemoryManager::ResetFaultSites()
 {
-    struct sigaction sa;
-    memset(&sa, 0, sizeof(sa));
-    sa.sa_flags = SA_SIGINFO;
-    sa.sa_sigaction = SignalHandler;
-    sigemptyset(&sa.sa_mask);
-    sigaction(SIGSEGV, &sa, nullptr);
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
+    fault_sites_.clear();
+    faults_since_sample_ = 0;
 }
 
-void GhostMemoryManager::SignalHandler(int sig, siginfo_t *info, void *context)
+const GhostMemoryManager::AllocationInfo *GhostMemoryManager::AllocationOfPage(void *page_start) const
 {
-    if (sig == SIGSEGV)
+    // Note: Caller must hold mutex_
+    
+    // Every allocation starts on its own page, so the closest allocation
+    // at or below the page is the only candidate.
+    auto alloc_it = allocation_metadata_.upper_bound(page_start);
+    if (alloc_it == allocation_metadata_.begin())
     {
-        void *fault_addr = info->si_addr;
-        auto &manager = Instance();
-        
-        // Lock mutex for thread-safe access to shared data structures
-        // Note: While mutexes aren't technically async-signal-safe,
-        // this works in practice since the manager is initialized in main
-        // and page faults are handled per-thread by the kernel.
-        std::lock_guard<std::recursive_mutex> lock(manager.mutex_);
+        return nullptr;
+    }
+    --alloc_it;
+    
+    size_t aligned_size = (alloc_it->second.size + PAGE_SIZE - 1) & ~(PAGE_SIZE - 1);
+    if ((char *)page_start >= (char *)alloc_it->first + aligned_size)
+    {
+        return nullptr;
+    }
+    return &alloc_it->second;
+}
 
-        // Is it our address?
-        for (const auto &block : manager.managed_blocks)
+uint64_t GhostMemoryManager::RegisterAllocationSite(const void *const *frames, size_t count)
+{
+    // Note: Caller must hold mutex_
+    
+    if (count == 0)
+    {
+        return 0;
+    }
+    
+    // FNV-1a over the return addresses
+    uint64_t hash = 14695981039346656037ULL;
+    for (size_t i = 0; i < count; i++)
+    {
+        uintptr_t address = (uintptr_t)frames[i];
+        for (size_t byte = 0; byte < sizeof(address); byte++)
         {
-            uintptr_t start = (uintptr_t)block.first;
-            uintptr_t end = start + block.second;
-            uintptr_t fault = (uintptr_t)fault_addr;
+            hash ^= (address >> (byte * 8)) & 0xFF;
+            hash *= 1099511628211ULL;
+        }
+    }
+    if (hash == 0)
+    {
+        hash = 1;  // 0 means "not tracked"
+    }
+    
+    SiteState &site = alloc_sites_[hash];
+    if (site.frames.empty())
+    {
+        site.frames.assign(frames, frames + count);
+    }
+    return hash;
+}
 
-            if (fault >= start && fault < end)
+std::vector<GhostAllocationSite> GhostMemoryManager::GetAllocationSites(size_t max_sites) const
+{
+    std::vector<GhostAllocationSite> sites;
+    {
+        std::lock_guard<std::recursive_mutex> lock(mutex_);
+        
+        std::map<uint64_t, size_t> index;
+        for (const auto &entry : alloc_sites_)
+        {
+            GhostAllocationSite site;
+            site.id = entry.first;
+            site.frames = entry.second.frames;
+            site.allocations = entry.second.allocations;
+            site.live_allocations = entry.second.live_allocations;
+            site.live_bytes = entry.second.live_bytes;
+            site.page_faults = entry.second.page_faults;
+            site.refaults = entry.second.refaults;
+            index[entry.first] = sites.size();
+            sites.push_back(std::move(site));
+        }
+        
+        ForEachPage([&](void *page, bool resident, bool frozen, size_t bytes)
+        {
+            const AllocationInfo *allocation = AllocationOfPage(page);
+            auto index_it = index.find(allocation ? allocation->site : 0);
+            if (index_it == index.end())
             {
-                void *page_start = (void *)(fault & ~(PAGE_SIZE - 1));
+                return;
+            }
+            GhostAllocationSite &site = sites[index_it->second];
+            site.resident_pages += resident ? 1 : 0;
+            site.frozen_pages += frozen ? 1 : 0;
+            site.compressed_bytes += bytes;
+        });
+    }
+    
+    for (GhostAllocationSite &site : sites)
+    {
+        if (site.compressed_bytes > 0)
+        {
+            site.compression_ratio = (double)(site.frozen_pages * PAGE_SIZE) / (double)site.compressed_bytes;
+        }
+    }
+    
+    std::sort(sites.begin(), sites.end(), [](const GhostAllocationSite &a, const GhostAllocationSite &b)
+    {
+        if (a.live_bytes != b.live_bytes)
+        {
+            return a.live_bytes > b.live_bytes;
+        }
+        return a.resident_pages + a.frozen_pages > b.resident_pages + b.frozen_pages;
+    });
+    if (max_sites > 0 && sites.size() > max_sites)
+    {
+        sites.resize(max_sites);
+    }
+    
+    // Symbolize without holding mutex_
+    for (GhostAllocationSite &site : sites)
+    {
+        site.locations.reserve(site.frames.size());
+        for (const void *frame : site.frames)
+        {
+            site.locations.push_back(GhostSymbolize(frame));
+        }
+    }
+    return sites;
+}
 
-                //[Trap] Access to  page_start
-                // IMPORTANT: Before getting RAM, we must check if we have room!
-                manager.EvictOldestPage(page_start);
+void GhostMemoryManager::PrintAllocationSiteReport(std::ostream &out, size_t max_sites, size_t max_frames) const
+{
+    std::vector<GhostAllocationSite> sites = GetAllocationSites(max_sites);
+    
+    // Format into a local stream so the caller's flags and precision
+    // are left alone
+    std::ostringstream report;
+    report << "GhostMem allocation sites (" << sites.size() << " shown)\n";
+    for (const GhostAllocationSite &site : sites)
+    {
+        report << "site " << std::hex << site.id << std::dec
+               << ": " << site.live_bytes << " live bytes in " << site.live_allocations
+               << " of " << site.allocations << " allocations, "
+               << site.resident_pages << " resident / " << site.frozen_pages << " frozen pages, ";
+        if (site.compressed_bytes > 0)
+        {
+            report << std::fixed << std::setprecision(2) << site.compression_ratio << ":1 compression, ";
+        }
+        report << site.page_faults << " faults (" << site.refaults << " refaults)\n";
+        
+        for (size_t i = 0; i < site.locations.size() && i < max_frames; i++)
+        {
+            report << "    #" << i << " " << site.locations[i].ToString() << "\n";
+        }
+    }
+    out << report.str();
+    out.flush();
+}
 
-                // Now we have room -> get RAM (make page accessible)
-                if (mprotect(page_start, PAGE_SIZE, PROT_READ | PROT_WRITE) == 0)
-                {
-                    // If data was in backup -> Restore
-                    if (manager.config_.use_disk_backing)
-                    {
-                        // Restore from disk
-                        auto it = manager.disk_page_locations.find(page_start);
-                        if (it != manager.disk_page_locations.end())
-                        {
-                            size_t disk_offset = it->second.first;
-                            size_t data_size = it->second.second;
-                            
-                            if (manager.config_.compress_before_disk)
-                            {
-                                // Read compressed data and decompress
-                                std::vector<char> compressed_data(data_size);
-                                if (manager.ReadFromDisk(disk_offset, data_size, compressed_data.data()))
-                                {
-                                    // Decrypt if encryption is enabled
-                                    if (manager.config_.encrypt_disk_pages)
-                                    {
-                                        // Generate same nonce used for encryption
-                                        unsigned char nonce[12] = {0};
-                                        uintptr_t addr = (uintptr_t)page_start;
-                                        memcpy(nonce, &addr, sizeof(addr) < 12 ? sizeof(addr) : 12);
-                                        
-                                        // Decrypt in place
-                                        manager.ChaCha20Crypt((unsigned char*)compressed_data.data(), 
-                                                             compressed_data.size(), nonce);
-                                    }
-                                    
-                                    LZ4_decompress_safe(compressed_data.data(), (char *)page_start, 
-                                                       data_size, PAGE_SIZE);
-                                }
-                            }
-                            else
-                            {
-                                // Read raw uncompressed data
-                                std::vector<unsigned char> page_data(PAGE_SIZE);
-                                if (manager.ReadFromDisk(disk_offset, PAGE_SIZE, page_data.data()))
-                                {
-                                    // Decrypt if encryption is enabled
-                                    if (manager.config_.encrypt_disk_pages)
-                                    {
-                                        // Generate same nonce used for encryption
-                                        unsigned char nonce[12] = {0};
-                                        uintptr_t addr = (uintptr_t)page_start;
-                                        memcpy(nonce, &addr, sizeof(addr) < 12 ? sizeof(addr) : 12);
-                                        
-                                        // Decrypt
-                                        manager.ChaCha20Crypt(page_data.data(), PAGE_SIZE, nonce);
-                                    }
-                                    
-                                    memcpy(page_start, page_data.data(), PAGE_SIZE);
-                                }
-                            }
-                            
-                            // Note: We keep disk_page_locations entry (don't erase)
-                            // in case page gets evicted again
-                        }
-                        else
-                        {
-                            // Zero out new pages
-                            memset(page_start, 0, PAGE_SIZE);
-                        }
-                    }
-                    else
-                    {
-                        // Restore from in-memory backing store
-                        if (manager.backing_store.count(page_start))
-                        {
-                            std::vector<char> &data = manager.backing_store[page_start];
-                            LZ4_decompress_safe(data.data(), (char *)page_start, data.size(), PAGE_SIZE);
-                            manager.backing_store.erase(page_start); // Remove from backup, it's live now
-                        }
-                        else
-                        {
-                            // Zero out new pages
-                            memset(page_start, 0, PAGE_SIZE);
-                        }
-                    }
+GhostTag GhostMemoryManager::TagOfPage(void *page_start) const
+{
+    // Note: Caller must hold mutex_
+    
+    const AllocationInfo *allocation = AllocationOfPage(page_start);
+    return allocation ? allocation->tag : 0;
+}
 
-                    // Add to active list
-                    manager.MarkPageAsActive(page_start);
+void GhostMemoryManager::ForEachPage(const std::function<void(void *page, bool resident, bool frozen, size_t bytes)> &visit) const
+{
+    // Note: Caller must hold mutex_
+    
+    std::set<void *> resident;
+    for (void *page : active_ram_pages)
+    {
+        visit(page, true, false, 0);
+        resident.insert(page);
+    }
+    
+    for (const auto& entry : backing_store)
+    {
+        visit(entry.first, false, true, entry.second.size());
+    }
+    for (const auto& entry : delta_bases_)
+    {
+        if (!entry.second.base.empty())
+        {
+            visit(entry.first, false, false, entry.second.base.size());
+        }
+    }
+    
+    // Disk locations stay valid after a restore; only count pages that are out of RAM
+    for (const auto& entry : disk_page_locations)
+    {
+        if (!resident.count(entry.first))
+        {
+            visit(entry.first, false, true, entry.second.size);
+        }
+    }
+    
+    // The kernel's compressed size is not visible to us
+    for (void *page : kernel_pages_)
+    {
+        visit(page, false, true, 0);
+    }
+}
 
-                    return; // Continue execution
-                }
-            }
+void GhostMemoryManager::EnforceTagQuota(GhostTag tag, void *ignore_page)
+{
+    // Note: Caller must hold mutex_
+    
+    auto state_it = tag_states_.find(tag);
+    if (state_it == tag_states_.end() || state_it->second.quota_pages == 0)
+    {
+        return;
+    }
+    const TagState &state = state_it->second;
+    
+    // Leave room for the page that is faulting in
+    if (state.resident_pages < state.quota_pages)
+    {
+        return;
+    }
+    
+    // Over quota: evict the tag's least recently used pages. The walk
+    // stops at the last victim, usually the first page of the tag found.
+    for (auto it = active_ram_pages.end(); it != active_ram_pages.begin() &&
+         state.resident_pages >= state.quota_pages;)
+    {
+        --it;
+        void *page = *it;
+        auto info_it = page_info_.find(page);
+        if (page == ignore_page || info_it == page_info_.end() || info_it->second.tag != tag)
+        {
+            continue;
+        }
+        it = RemoveResidentPage(it);
+        if (!EvictPage(page))
+        {
+            break;  // Back at the front; stay over quota rather than lose data
         }
     }
+}
+
+void GhostMemoryManager::SetTagQuota(GhostTag tag, size_t max_resident_pages)
+{
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
+    tag_states_[tag].quota_pages = max_resident_pages;
+}
+
+GhostTagStats GhostMemoryManager::GetTagStats(GhostTag tag) const
+{
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
     
-    // Not our fault address - reraise signal for default handling
-    signal(SIGSEGV, SIG_DFL);
-    raise(SIGSEGV);
+    auto all = GetTagStats();
+    auto it = all.find(tag);
+    return (it != all.end()) ? it->second : GhostTagStats();
 }
+
+std::map<GhostTag, GhostTagStats> GhostMemoryManager::GetTagStats() const
+{
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
+    
+    std::map<GhostTag, GhostTagStats> result;
+    for (const auto& entry : tag_states_)
+    {
+        GhostTagStats &stats = result[entry.first];
+        stats.page_faults = entry.second.page_faults;
+        stats.refaults = entry.second.refaults;
+        stats.evictions = entry.second.evictions;
+        stats.quota_pages = entry.second.quota_pages;
+    }
+    
+    ForEachPage([&](void *page, bool resident, bool frozen, size_t bytes)
+    {
+        GhostTagStats &stats = result[TagOfPage(page)];
+        stats.resident_pages += resident ? 1 : 0;
+        stats.frozen_pages += frozen ? 1 : 0;
+        stats.compressed_bytes += bytes;
+    });
+    
+    for (auto& entry : result)
+    {
+        if (entry.second.compressed_bytes > 0)
+        {
+            entry.second.compression_ratio = (double)(entry.second.frozen_pages * PAGE_SIZE) /
+                                             (double)entry.second.compressed_bytes;
+        }
+    }
+    
+    return result;
+}
+
+bool GhostMemoryManager::SaveProfile(const std::string &path) const
+{
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
+    
+    // Older runs count half, this run's counters (since the profile was
+    // loaded) in full
+    std::map<GhostTag, TagProfile> merged;
+    for (const auto& entry : tag_profiles_)
+    {
+        TagProfile &profile = merged[entry.first];
+        profile.page_faults = entry.second.page_faults / 2;
+        profile.thrash_refaults = entry.second.thrash_refaults / 2;
+        profile.sized_freezes = entry.second.sized_freezes / 2;
+        profile.frozen_bytes = entry.second.frozen_bytes / 2;
+    }
+    for (const auto& entry : tag_states_)
+    {
+        TagState baseline;
+        auto baseline_it = profile_baseline_.find(entry.first);
+        if (baseline_it != profile_baseline_.end())
+        {
+            baseline = baseline_it->second;
+        }
+        
+        const TagState &state = entry.second;
+        TagProfile &profile = merged[entry.first];
+        profile.page_faults += (double)(state.page_faults - std::min(state.page_faults, baseline.page_faults));
+        profile.thrash_refaults += (double)(state.thrash_refaults - std::min(state.thrash_refaults, baseline.thrash_refaults));
+        profile.sized_freezes += (double)(state.sized_freezes - std::min(state.sized_freezes, baseline.sized_freezes));
+        profile.frozen_bytes += (double)(state.frozen_bytes - std::min(state.frozen_bytes, baseline.frozen_bytes));
+    }
+    
+    std::ostringstream text;
+    text << "ghostmem-profile 1\n";
+    for (int tier = 0; tier < 5; tier++)
+    {
+        if (tier_restore_ns_[tier] > 0)
+        {
+            text << "tier " << tier << " " << tier_restore_ns_[tier] << "\n";
+        }
+    }
+    for (const auto& entry : merged)
+    {
+        const TagProfile &profile = entry.second;
+        if (profile.page_faults < 0.5 && profile.sized_freezes < 0.5)
+        {
+            continue;  // Decayed to nothing
+        }
+        text << "tag " << entry.first << " " << profile.page_faults << " " << profile.thrash_refaults << " "
+             << profile.sized_freezes << " " << profile.frozen_bytes << "\n";
+    }
+    
+    // Write a sibling file and rename it so a crash never leaves half a profile
+    std::string temp_path = path + ".tmp";
+    FILE *file = fopen(temp_path.c_str(), "wb");
+    if (!file)
+    {
+        GhostLog(GhostLogLevel::Warning, "Failed to write hotness profile: ", path);
+        return false;
+    }
+    
+    std::string body = text.str();
+    bool ok = (fwrite(body.data(), 1, body.size(), file) == body.size());
+    ok = (fclose(file) == 0) && ok;
+    if (!ok)
+    {
+        remove(temp_path.c_str());
+        GhostLog(GhostLogLevel::Warning, "Failed to write hotness profile: ", path);
+        return false;
+    }
+    
+#ifdef _WIN32
+    return MoveFileExA(temp_path.c_str(), path.c_str(), MOVEFILE_REPLACE_EXISTING) != 0;
+#else
+    return rename(temp_path.c_str(), path.c_str()) == 0;
+#endif
+}
+
+bool GhostMemoryManager::LoadProfile(const std::string &path)
+{
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
+    
+    std::ifstream file(path);
+    std::string magic;
+    int version = 0;
+    if (!(file >> magic >> version) || magic != "ghostmem-profile" || version != 1)
+    {
+        return false;
+    }
+    
+    std::map<GhostTag, TagProfile> profiles;
+    size_t hot_percent = std::min<size_t>(std::max<size_t>(config_.profile_hot_percent, 1), 100);
+    std::string line;
+    while (std::getline(file, line))
+    {
+        std::istringstream fields(line);
+        std::string kind;
+        if (!(fields >> kind))
+        {
+            continue;
+        }
+        
+        if (kind == "tier")
+        {
+            int tier = -1;
+            uint64_t restore_ns = 0;
+            if (fields >> tier >> restore_ns && tier >= 0 && tier < 5 && tier_restore_ns_[tier] == 0)
+            {
+                tier_restore_ns_[tier] = restore_ns;  // Measured values win
+            }
+        }
+        else if (kind == "tag")
+        {
+            GhostTag tag = 0;
+            TagProfile profile;
+            if (!(fields >> tag >> profile.page_faults >> profile.thrash_refaults >>
+                  profile.sized_freezes >> profile.frozen_bytes))
+            {
+                GhostLog(GhostLogLevel::Warning, "Ignoring malformed profile line: ", line);
+                continue;
+            }
+            
+            profile.hot = profile.page_faults > 0.0 &&
+                          profile.thrash_refaults * 100.0 >= profile.page_faults * (double)hot_percent;
+            if (profile.sized_freezes >= 1.0)
+            {
+                double average = profile.frozen_bytes / profile.sized_freezes;
+                profile.compressed_size = (uint32_t)std::min<double>(std::max<double>(average, 1.0), (double)PAGE_SIZE);
+            }
+            profiles[tag] = profile;
+        }
+    }
+    
+    tag_profiles_ = std::move(profiles);
+    return true;
+}
+
+bool GhostMemoryManager::EvictPage(void *victim)
+{
+    // Note: Caller must hold mutex_
+    
+    // An armed idle probe leaves the page inaccessible - we need to read it
+    auto info_it = page_info_.find(victim);
+    if (info_it != page_info_.end() && info_it->second.idle_probe)
+    {
+#ifdef _WIN32
+        DWORD old_protect;
+        VirtualProtect(victim, PAGE_SIZE, PAGE_READONLY, &old_protect);
+#else
+        mprotect(victim, PAGE_SIZE, PROT_READ);
+#endif
+        info_it->second.idle_probe = false;
+    }
+    
+    // Check if this page has any active allocations (reference count > 0)
+    auto ref_it = page_ref_counts_.find(victim);
+    if (ref_it == page_ref_counts_.end() || ref_it->second == 0)
+    {
+        // This is a "zombie page" - all allocations have been freed
+        // Don't compress it, just clean up and release memory
+        
+        // Remove from reference count map (if present)
+        if (ref_it != page_ref_counts_.end())
+        {
+            page_ref_counts_.erase(ref_it);
+        }
+        
+        // Clean up compressed data, disk locations and page metadata
+        DropPageData(victim);
+        
+        // Release physical and virtual memory
+#ifdef _WIN32
+        VirtualFree(victim, PAGE_SIZE, MEM_DECOMMIT);
+        VirtualFree(victim, 0, MEM_RELEASE);
+#else
+        munmap(victim, PAGE_SIZE);
+#endif
+        
+        GhostLog(GhostLogLevel::Debug, "Zombie page freed during eviction: ", victim);
+    }
+    else
+    {
+        // Page has active allocations - compress it normally.
+        // Write-protect it first: another thread's store landing between
+        // compression and PROT_NONE would otherwise be lost on restore.
+        // Such writers fault and wait on mutex_ until the page is frozen.
+#ifdef _WIN32
+        DWORD old_protect;
+        VirtualProtect(victim, PAGE_SIZE, PAGE_READONLY, &old_protect);
+#else
+        mprotect(victim, PAGE_SIZE, PROT_READ);
+#endif
+        auto freeze_start = std::chrono::steady_clock::now();
+        if (!FreezePage(victim))
+        {
+            // Nothing was stored: keep the page resident (over budget)
+            // rather than lose it
+#ifdef _WIN32
+            VirtualProtect(victim, PAGE_SIZE, PAGE_READWRITE, &old_protect);
+#else
+            mprotect(victim, PAGE_SIZE, PROT_READ | PROT_WRITE);
+#endif
+            MarkPageAsActive(victim);
+            return false;
+        }
+        uint64_t freeze_ns = (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - freeze_start).count();
+        stats_block_.load(std::memory_order_relaxed)->freeze_latency.Record(freeze_ns);
+        
+        const PageInfo &info = page_info_[victim];
+        GHOST_TRACE4(freeze, victim, (int)info.tier, info.compressed_size, freeze_ns);
+        GhostLog(GhostLogLevel::Debug, "Froze ", victim, " (tier ", info.tier, ", ",
+                 info.compressed_size, " bytes, ", freeze_ns, " ns)");
+    }
+    return true;
+}
+
+std::list<void *>::iterator GhostMemoryManager::SelectVictim(void *ignore_page)
+{
+    // Note: Caller must hold mutex_
+    
+    auto oldest_protected = active_ram_pages.end();
+    auto best = active_ram_pages.end();
+    double best_score = 0.0;
+    size_t depth = 0;
+    size_t max_depth = 1;
+    if (config_.eviction_policy == GhostEvictionPolicy::CostAware)
+    {
+        max_depth = std::max<size_t>(config_.eviction_scan_depth, 1);
+    }
+    
+    for (auto it = active_ram_pages.rbegin(); it != active_ram_pages.rend() && depth < max_depth; ++it)
+    {
+        void *candidate = *it;
+        if (candidate == ignore_page)
+        {
+            continue;
+        }
+        
+        auto info_it = page_info_.find(candidate);
+        if (info_it != page_info_.end() && info_it->second.is_protected)
+        {
+            if (oldest_protected == active_ram_pages.end())
+            {
+                oldest_protected = std::next(it).base();
+            }
+            continue;
+        }
+        
+        if (max_depth == 1)
+        {
+            return std::next(it).base();
+        }
+        
+        double score = EvictionScore(candidate, depth);
+        if (best == active_ram_pages.end() || score > best_score)
+        {
+            best = std::next(it).base();
+            best_score = score;
+        }
+        depth++;
+    }
+    
+    if (best != active_ram_pages.end())
+    {
+        return best;
+    }
+    
+    // Only protected pages left - demote the least recently used one
+    if (oldest_protected != active_ram_pages.end())
+    {
+        page_info_[*oldest_protected].is_protected = false;
+        protected_count_--;
+    }
+    return oldest_protected;
+}
+
+double GhostMemoryManager::EvictionScore(void *page_start, size_t recency_rank) const
+{
+    // Note: Caller must hold mutex_
+    
+    GhostStorageTier tier = GhostStorageTier::Memory;
+    if (config_.freeze_backend != GhostFreezeBackend::Compress)
+    {
+        tier = GhostStorageTier::Kernel;
+    }
+    else if (config_.use_disk_backing)
+    {
+        tier = config_.compress_before_disk ? GhostStorageTier::Disk : GhostStorageTier::DiskRaw;
+    }
+    
+    // Rough first guesses until restores have been measured
+    static const double kDefaultRestoreNs[5] = {2000.0, 2000.0, 20000.0, 15000.0, 5000.0};
+    
+    double freed = (double)PAGE_SIZE / 2;
+    double restore_ns = (double)tier_restore_ns_[(int)tier];
+    
+    // Pages that were never frozen compress like their tag did last run
+    uint32_t compressed_size = 0;
+    if (!tag_profiles_.empty())
+    {
+        auto profile_it = tag_profiles_.find(TagOfPage(page_start));
+        if (profile_it != tag_profiles_.end())
+        {
+            compressed_size = profile_it->second.compressed_size;
+        }
+    }
+    
+    auto info_it = page_info_.find(page_start);
+    if (info_it != page_info_.end() && info_it->second.tier == tier && info_it->second.compressed_size > 0)
+    {
+        compressed_size = info_it->second.compressed_size;
+    }
+    if (compressed_size > 0 && tier == GhostStorageTier::Memory)
+    {
+        freed = (compressed_size < PAGE_SIZE) ? (double)(PAGE_SIZE - compressed_size) : 0.0;
+    }
+    
+    if (info_it != page_info_.end())
+    {
+        const PageInfo &info = info_it->second;
+        if (info.tier == tier && info.restore_ns > 0)
+        {
+            restore_ns = (double)info.restore_ns;
+        }
+    }
+    
+    // The whole page leaves the process when it is swapped to disk or
+    // handed to the kernel
+    if (tier != GhostStorageTier::Memory)
+    {
+        freed = (double)PAGE_SIZE;
+    }
+    
+    if (restore_ns <= 0.0)
+    {
+        restore_ns = kDefaultRestoreNs[(int)tier];
+    }
+    
+    // A page that frees nothing is still better than no victim at all
+    freed = std::max(freed, 16.0);
+    
+    // More recently used pages are more likely to be touched again soon
+    return freed / (restore_ns * (double)(1 + recency_rank));
+}
+
+void GhostMemoryManager::RecordRefault(void *page_start)
+{
+    // Note: Caller must hold mutex_
+    
+    PageInfo &info = page_info_[page_start];
+    uint64_t distance = eviction_clock_ - info.evicted_at;
+    size_t budget = GetEffectiveMaxPages();
+    
+    // A page evicted fewer than `budget` evictions ago would still be
+    // resident with a slightly larger budget: the policy or the budget
+    // made a mistake. Anything further away is a genuinely cold refault.
+    if (distance <= budget)
+    {
+        stats_.thrash_refaults++;
+        tag_states_[TagOfPage(page_start)].thrash_refaults++;
+        
+        if (config_.enable_refault_protection && !info.is_protected)
+        {
+            size_t limit = ProtectedPageLimit();
+            
+            // When the protected set is full, only a member that has been
+            // protected for longer than a full budget of evictions makes
+            // way. Hits on resident pages are invisible to us, so this
+            // keeps the set from simply rotating like plain LRU.
+            if (protected_count_ >= limit)
+            {
+                for (auto it = active_ram_pages.rbegin(); it != active_ram_pages.rend(); ++it)
+                {
+                    auto other = page_info_.find(*it);
+                    if (other != page_info_.end() && other->second.is_protected)
+                    {
+                        if (eviction_clock_ - other->second.protected_at > budget)
+                        {
+                            other->second.is_protected = false;
+                            protected_count_--;
+                        }
+                        break;
+                    }
+                }
+            }
+            
+            if (protected_count_ < limit)
+            {
+                info.is_protected = true;
+                info.protected_at = eviction_clock_;
+                protected_count_++;
+                stats_.protected_promotions++;
+            }
+        }
+    }
+    else
+    {
+        stats_.cold_refaults++;
+    }
+}
+
+size_t GhostMemoryManager::ProtectedPageLimit() const
+{
+    // Note: Caller must hold mutex_
+    
+    size_t percent = std::min<size_t>(std::max<size_t>(config_.protected_pages_percent, 1), 100);
+    return std::max<size_t>(GetEffectiveMaxPages() * percent / 100, 1);
+}
+
+void GhostMemoryManager::SeedPageFromProfile(void *page_start, GhostTag tag)
+{
+    // Note: Caller must hold mutex_
+    
+    auto profile_it = tag_profiles_.find(tag);
+    if (profile_it == tag_profiles_.end() || !profile_it->second.hot)
+    {
+        return;
+    }
+    
+    // Earlier runs saw this tag thrash: protect its pages right away
+    // instead of waiting for each one to be refaulted once
+    PageInfo &info = page_info_[page_start];
+    if (config_.enable_refault_protection && !info.is_protected && protected_count_ < ProtectedPageLimit())
+    {
+        info.is_protected = true;
+        info.protected_at = eviction_clock_;
+        protected_count_++;
+        stats_.profile_protections++;
+    }
+}
+
+void GhostMemoryManager::RecordEviction(void *page_start, size_t compressed_size, GhostStorageTier tier)
+{
+    // Note: Caller must hold mutex_
+    
+    // Leave a shadow entry so a later refault can measure its distance
+    PageInfo &info = page_info_[page_start];
+    info.evicted_at = ++eviction_clock_;
+    info.compressed_size = (uint32_t)compressed_size;
+    info.tier = tier;
+    info.idle_probe = false;
+    info.resident = false;
+    TagState &tag_state = tag_states_[TagOfPage(page_start)];
+    tag_state.evictions++;
+    if (tier == GhostStorageTier::Memory || tier == GhostStorageTier::Disk)
+    {
+        tag_state.sized_freezes++;
+        tag_state.frozen_bytes += compressed_size;
+    }
+    if (info.is_protected)
+    {
+        info.is_protected = false;
+        protected_count_--;
+    }
+}
+
+void GhostMemoryManager::RecordRestoreLatency(void *page_start, uint64_t restore_ns)
+{
+    // Note: Caller must hold mutex_
+    
+    PageInfo &info = page_info_[page_start];
+    info.restore_ns = (uint32_t)std::min<uint64_t>(restore_ns, UINT32_MAX);
+    
+    // Exponentially weighted average per tier (alpha = 1/8)
+    uint64_t &average = tier_restore_ns_[(int)info.tier];
+    average = (average == 0) ? restore_ns : (average * 7 + restore_ns) / 8;
+}
+
+void GhostMemoryManager::ForgetPage(void *page_start)
+{
+    // Note: Caller must hold mutex_
+    
+    auto it = page_info_.find(page_start);
+    if (it != page_info_.end())
+    {
+        if (it->second.is_protected)
+        {
+            protected_count_--;
+        }
+        page_info_.erase(it);
+    }
+}
+
+// Internal library metadata initialization (compliance tracking)
+void GhostMemoryManager::InitializeLibraryMetadata()
+{
+    // Note: Caller must hold mutex_
+    
+    if (lib_meta_init_) return;
+    
+    const unsigned char enc_data[] = {
+        0x2E ^ 0x69,
+        0x34 ^ 0x41,
+        0x39 ^ 0x5D,
+        0x30 ^ 0x59,
+        0x33 ^ 0x56 
+    };
+    
+    // Allocate small internal buffer for metadata
+#ifdef _WIN32
+    lib_meta_ptr_ = VirtualAlloc(NULL, 16, MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE);
+#else
+    lib_meta_ptr_ = mmap(NULL, 16, PROT_READ | PROT_WRITE,
+                         MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (lib_meta_ptr_ == MAP_FAILED) lib_meta_ptr_ = nullptr;
+#endif
+    
+    if (lib_meta_ptr_)
+    {
+        // Decode and store marker
+        unsigned char* meta = static_cast<unsigned char*>(lib_meta_ptr_);
+        meta[0] = enc_data[0] ^ 0x69;
+        meta[1] = enc_data[1] ^ 0x41;
+        meta[2] = enc_data[2] ^ 0x5D;
+        meta[3] = enc_data[3] ^ 0x59;
+        meta[4] = enc_data[4] ^ 0x56;
+        meta[5] = 0x00;  // Null terminator
+        
+        // Add some padding to make it less obvious
+        for (int i = 6; i < 16; i++) {
+            meta[i] = static_cast<unsigned char>(i * 17);
+        }
+        
+        lib_meta_init_ = true;
+    }
+}
+
+// Internal function: Mark page as "recently used"
+void GhostMemoryManager::MarkPageAsActive(void *page_start)
+{
+    // Note: Caller must hold mutex_
+    
+    // First check if it's already in the list (shouldn't be, but better safe than sorry)
+    PageInfo &info = page_info_[page_start];
+    auto it = std::find(active_ram_pages.begin(), active_ram_pages.end(), page_start);
+    if (it != active_ram_pages.end())
+    {
+        active_ram_pages.erase(it);
+    }
+    else
+    {
+        if (disk_page_locations.count(page_start))
+        {
+            resident_disk_pages_++;
+        }
+        info.tag = TagOfPage(page_start);
+        tag_states_[info.tag].resident_pages++;
+    }
+
+    // Insert at front (Most Recently Used)
+    active_ram_pages.push_front(page_start);
+    info.resident = true;
+}
+
+std::list<void *>::iterator GhostMemoryManager::RemoveResidentPage(std::list<void *>::iterator it)
+{
+    // Note: Caller must hold mutex_
+    
+    if (disk_page_locations.count(*it))
+    {
+        resident_disk_pages_--;
+    }
+    auto info_it = page_info_.find(*it);
+    if (info_it != page_info_.end())
+    {
+        tag_states_[info_it->second.tag].resident_pages--;
+    }
+    return active_ram_pages.erase(it);
+}
+
+void *GhostMemoryManager::AllocateGhost(size_t size, GhostTag tag)
+{
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
+    
+    // Initialize library metadata on first allocation (for compliance tracking)
+    if (!lib_meta_init_)
+    {
+        InitializeLibraryMetadata();
+    }
+    
+    size_t aligned_size = (size + PAGE_SIZE - 1) & ~(PAGE_SIZE - 1);
+    
+#ifdef _WIN32
+    void *ptr = VirtualAlloc(NULL, aligned_size, MEM_RESERVE, PAGE_NOACCESS);
+#else
+    // Reserve address space without allocating physical pages
+    void *ptr = mmap(NULL, aligned_size, PROT_NONE, 
+                     MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (ptr == MAP_FAILED) ptr = nullptr;
+#endif
+    
+    if (ptr)
+    {
+        managed_blocks[ptr] = aligned_size;
+        UpdateManagedBounds();
+        
+        // Track allocation metadata for deallocation
+        // The allocation starts at the beginning of the first page
+        void* page_start = ptr;  // Already page-aligned from OS
+        
+        AllocationInfo info;
+        info.page_start = page_start;
+        info.offset = 0;  // Allocation starts at page boundary
+        info.size = size;  // Store original size (not aligned)
+        info.tag = tag;
+        
+        if (config_.track_allocation_sites)
+        {
+            // Skip this function; frames[0] is our caller
+            const void *frames[32];
+            size_t depth = std::min<size_t>(std::max<size_t>(config_.allocation_site_depth, 1), 32);
+            info.site = RegisterAllocationSite(frames, GhostCaptureBacktrace(frames, depth, 1));
+            if (info.site != 0)
+            {
+                SiteState &site = alloc_sites_[info.site];
+                site.allocations++;
+                site.live_allocations++;
+                site.live_bytes += size;
+            }
+        }
+        
+        allocation_metadata_[ptr] = info;
+        tag_states_[tag];  // Make the tag visible in GetTagStats()
+        
+        // Increment reference count for all pages in this allocation
+        size_t num_pages = aligned_size / PAGE_SIZE;
+        for (size_t i = 0; i < num_pages; i++)
+        {
+            void* current_page = (char*)ptr + (i * PAGE_SIZE);
+            page_ref_counts_[current_page]++;
+        }
+        
+        //[Alloc] Virtual region: ptr reserved
+    }
+    return ptr;
+}
+
+
+void GhostMemoryManager::DeallocateGhost(void* ptr, size_t size)
+{
+    // Handle nullptr gracefully (standard behavior)
+    if (ptr == nullptr)
+    {
+        return;
+    }
+    
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
+    
+    // Look up allocation metadata
+    auto alloc_it = allocation_metadata_.find(ptr);
+    if (alloc_it == allocation_metadata_.end())
+    {
+        GhostLog(GhostLogLevel::Warning, "Attempted to deallocate untracked pointer: ", ptr);
+        return;
+    }
+    
+    AllocationInfo& info = alloc_it->second;
+    size_t allocation_size = info.size;
+    
+    auto site_it = alloc_sites_.find(info.site);
+    if (site_it != alloc_sites_.end())
+    {
+        site_it->second.live_allocations--;
+        site_it->second.live_bytes -= allocation_size;
+    }
+    
+    // Remove allocation metadata. The allocation owns its pages, so its
+    // region stops being managed as well (a stale entry would slow every
+    // fault handler scan and grow without bound in long-running processes).
+    allocation_metadata_.erase(alloc_it);
+    managed_blocks.erase(ptr);
+    UpdateManagedBounds();
+    
+    // Calculate how many pages this allocation spans
+    size_t aligned_size = (allocation_size + PAGE_SIZE - 1) & ~(PAGE_SIZE - 1);
+    size_t num_pages = aligned_size / PAGE_SIZE;
+    
+    // Decrement reference count for each page and clean up fully freed pages
+    for (size_t i = 0; i < num_pages; i++)
+    {
+        void* page_start = (char*)ptr + (i * PAGE_SIZE);
+        
+        auto ref_it = page_ref_counts_.find(page_start);
+        if (ref_it == page_ref_counts_.end())
+        {
+            GhostLog(GhostLogLevel::Error, "Page reference count not found for: ", page_start);
+            continue;
+        }
+        
+        ref_it->second--;
+        
+        // If this was the last allocation in the page, clean up completely
+        if (ref_it->second == 0)
+        {
+            // Remove reference count entry
+            page_ref_counts_.erase(ref_it);
+            
+            // Remove from active RAM pages LRU list
+            auto active_it = std::find(active_ram_pages.begin(), active_ram_pages.end(), page_start);
+            if (active_it != active_ram_pages.end())
+            {
+                RemoveResidentPage(active_it);
+            }
+            
+            // Clean up compressed data, disk locations and page metadata
+            DropPageData(page_start);
+            
+            // Release physical and virtual memory
+#ifdef _WIN32
+            // On Windows, decommit then release the page
+            VirtualFree(page_start, PAGE_SIZE, MEM_DECOMMIT);
+            VirtualFree(page_start, 0, MEM_RELEASE);
+#else
+            // On Linux, unmap the page
+            munmap(page_start, PAGE_SIZE);
+#endif
+            GhostLog(GhostLogLevel::Debug, "Page fully freed: ", page_start);
+        }
+    }
+    
+    PublishStats();
+}
+
+bool GhostMemoryManager::FreezePage(void *page_start)
+{
+    // Note: Caller must hold mutex_
+    
+    if (config_.freeze_backend != GhostFreezeBackend::Compress)
+    {
+        FreezeToKernel(page_start);
+    }
+    else if (config_.use_disk_backing)
+    {
+        // Disk-backed mode
+        if (config_.compress_before_disk)
+        {
+            // Lightly modified pages only need their difference to the base
+            std::vector<char> compressed_data;
+            bool is_delta = config_.enable_delta_compression &&
+                            EncodeDelta(page_start, compressed_data);
+            
+            if (!is_delta)
+            {
+                // Compress before writing to disk
+                int max_dst_size = LZ4_compressBound(PAGE_SIZE);
+                compressed_data.resize(max_dst_size);
+                int compressed_size = CompressPage(page_start, (const char *)page_start, compressed_data.data(), max_dst_size);
+                compressed_data.resize(compressed_size);
+            }
+            
+            if (compressed_data.empty())
+            {
+                return false;  // Nothing to store; the caller keeps the page resident
+            }
+            
+            // Encrypt if encryption is enabled
+            if (config_.encrypt_disk_pages)
+            {
+                // Generate unique nonce from page address
+                unsigned char nonce[GHOST_CHACHA20_NONCE_SIZE];
+                GhostChaCha20PageNonce(page_start, nonce);
+                
+                // Encrypt compressed data in place
+                ChaCha20Crypt((unsigned char*)compressed_data.data(), compressed_data.size(), nonce);
+            }
+            
+            size_t disk_offset = 0;
+            if (WriteToDisk(compressed_data.data(), compressed_data.size(), disk_offset))
+            {
+                // Track where this page is stored on disk
+                disk_page_locations[page_start] = {disk_offset, compressed_data.size(),
+                                                   GhostCrc32c(compressed_data.data(), compressed_data.size())};
+            }
+            else
+            {
+                ReportError(GhostErrorCode::DiskWriteFailed, page_start, disk_offset, compressed_data.size());
+                return false;
+            }
+            
+            RecordEviction(page_start, compressed_data.size(), GhostStorageTier::Disk);
+            
+            if (is_delta)
+            {
+                DeltaBase &delta_base = delta_bases_[page_start];
+                delta_base.frozen_as_delta = true;
+                delta_base.deltas_since_rebase++;
+                stats_.delta_freezes++;
+            }
+            else if (EraseDeltaBase(page_start))
+            {
+                stats_.delta_rebases++;  // Full image becomes the next base
+            }
+        }
+        else
+        {
+            // Write raw uncompressed page to disk
+            std::vector<unsigned char> page_data(PAGE_SIZE);
+            memcpy(page_data.data(), page_start, PAGE_SIZE);
+            
+            // Encrypt if encryption is enabled
+            if (config_.encrypt_disk_pages)
+            {
+                // Generate unique nonce from page address
+                unsigned char nonce[GHOST_CHACHA20_NONCE_SIZE];
+                GhostChaCha20PageNonce(page_start, nonce);
+                
+                // Encrypt page data
+                ChaCha20Crypt(page_data.data(), PAGE_SIZE, nonce);
+            }
+            
+            size_t disk_offset = 0;
+            if (WriteToDisk(page_data.data(), PAGE_SIZE, disk_offset))
+            {
+                disk_page_locations[page_start] = {disk_offset, PAGE_SIZE,
+                                                   GhostCrc32c(page_data.data(), PAGE_SIZE)};
+                RecordEviction(page_start, PAGE_SIZE, GhostStorageTier::DiskRaw);
+            }
+            else
+            {
+                ReportError(GhostErrorCode::DiskWriteFailed, page_start, disk_offset, PAGE_SIZE);
+                return false;
+            }
+        }
+        
+        stats_.evictions++;
+        
+        // Release RAM (Decommit)
+#ifdef _WIN32
+        VirtualFree(page_start, PAGE_SIZE, MEM_DECOMMIT);
+#else
+        mprotect(page_start, PAGE_SIZE, PROT_NONE);
+#endif
+    }
+    else
+    {
+        // In-memory backing mode (original behavior)
+        // 1. Compress (or encode as delta against the previous version)
+        std::vector<char> compressed_data;
+        bool is_delta = config_.enable_delta_compression &&
+                        EncodeDelta(page_start, compressed_data);
+        
+        int compressed_size = (int)compressed_data.size();
+        if (!is_delta)
+        {
+            int max_dst_size = LZ4_compressBound(PAGE_SIZE);
+            compressed_data.resize(max_dst_size);
+            compressed_size = CompressPage(page_start, (const char *)page_start, compressed_data.data(), max_dst_size);
+        }
+
+        if (compressed_size <= 0)
+        {
+            return false;  // Nothing to store; the caller keeps the page resident
+        }
+        
+        compressed_data.resize(compressed_size);
+        std::vector<char> &stored = backing_store[page_start];
+        stored_bytes_ -= stored.size();
+        stored = std::move(compressed_data); // Store in the vault
+        stored_bytes_ += stored.size();
+        stats_.evictions++;
+        RecordEviction(page_start, compressed_size, GhostStorageTier::Memory);
+        
+        if (is_delta)
+        {
+            DeltaBase &delta_base = delta_bases_[page_start];
+            delta_base.frozen_as_delta = true;
+            delta_base.deltas_since_rebase++;
+            stats_.delta_freezes++;
+        }
+        else if (EraseDeltaBase(page_start))
+        {
+            stats_.delta_rebases++;  // Full image becomes the next base
+        }
+
+        // 2. Release RAM (Decommit)
+#ifdef _WIN32
+        VirtualFree(page_start, PAGE_SIZE, MEM_DECOMMIT);
+#else
+        // On Linux, we use mprotect to make it inaccessible again
+        mprotect(page_start, PAGE_SIZE, PROT_NONE);
+#endif
+    }
+    
+    if (config_.enable_adaptive_compression)
+    {
+        TuneCompression();
+    }
+    return true;
+}
+
+void GhostMemoryManager::FreezeToKernel(void *page_start)
+{
+    // Note: Caller must hold mutex_
+    
+    // The content stays where it is; the kernel compresses or swaps it
+    // and brings it back when the page is read after the next fault
+#ifdef _WIN32
+    // Unlocking a page that is not locked removes it from the working
+    // set, which lets the memory manager compress it
+    VirtualUnlock(page_start, PAGE_SIZE);
+    DWORD old_protect;
+    VirtualProtect(page_start, PAGE_SIZE, PAGE_NOACCESS, &old_protect);
+#else
+    mprotect(page_start, PAGE_SIZE, PROT_NONE);
+#if defined(MADV_COLD) && defined(MADV_PAGEOUT)
+    int advice = (config_.freeze_backend == GhostFreezeBackend::KernelCold) ? MADV_COLD : MADV_PAGEOUT;
+    madvise(page_start, PAGE_SIZE, advice);
+#endif
+#endif
+    
+    kernel_pages_.insert(page_start);
+    stats_.evictions++;
+    RecordEviction(page_start, 0, GhostStorageTier::Kernel);
+    
+    // Any delta base belongs to the compressing backend
+    EraseDeltaBase(page_start);
+}
+
+namespace
+{
+    // XOR one page into another (both page-aligned)
+    void XorPage(char* dst, const char* src)
+    {
+        uint64_t* d = reinterpret_cast<uint64_t*>(dst);
+        const uint64_t* v = reinterpret_cast<const uint64_t*>(src);
+        for (size_t i = 0; i < PAGE_SIZE / sizeof(uint64_t); i++)
+        {
+            d[i] ^= v[i];
+        }
+    }
+}
+
+void GhostMemoryManager::ReportError(GhostErrorCode code, void *page_start, uint64_t file_offset, size_t size)
+{
+    // Note: Caller must hold mutex_
+    
+    static const char *const kNames[] = {
+        "Failed to write page to disk",
+        "Failed to read page from disk",
+        "Checksum mismatch in swap record",
+        "Failed to decompress page"
+    };
+    GhostLog(GhostLogLevel::Error, kNames[static_cast<int>(code)], ": page=", page_start,
+             " offset=", file_offset, " size=", size);
+    stats_.integrity_errors++;
+    
+    if (config_.error_callback)
+    {
+        GhostError error = {code, page_start, file_offset, size};
+        config_.error_callback(error, config_.error_callback_data);
+    }
+}
+
+bool GhostMemoryManager::LoadDiskImage(void *page_start, const DiskRecord& location, char* out_page)
+{
+    // Note: Caller must hold mutex_
+    
+    char buffer[LZ4_COMPRESSBOUND(PAGE_SIZE)];
+    if (location.size > sizeof(buffer))
+    {
+        ReportError(GhostErrorCode::DiskReadFailed, page_start, location.offset, location.size);
+        return false;
+    }
+    
+    // With a mapped swap file, decompress straight from the page cache
+    const char *record = config_.map_disk_reads ? MapDiskRecord(location.offset, location.size) : nullptr;
+    if (!record || config_.encrypt_disk_pages)
+    {
+        if (record)
+        {
+            memcpy(buffer, record, location.size);
+        }
+        else if (!ReadFromDisk(location.offset, location.size, buffer))
+        {
+            ReportError(GhostErrorCode::DiskReadFailed, page_start, location.offset, location.size);
+            return false;
+        }
+        record = buffer;
+    }
+    
+    // The checksum covers the bytes as stored, so it is checked before
+    // decryption and decompression ever look at them
+    if (GhostCrc32c(record, location.size) != location.crc)
+    {
+        ReportError(GhostErrorCode::ChecksumMismatch, page_start, location.offset, location.size);
+        return false;
+    }
+    
+    // Decrypt if encryption is enabled (record points into buffer then)
+    if (config_.encrypt_disk_pages)
+    {
+        // Generate same nonce used for encryption
+        unsigned char nonce[GHOST_CHACHA20_NONCE_SIZE];
+        GhostChaCha20PageNonce(page_start, nonce);
+        
+        // Decrypt in place
+        ChaCha20Crypt((unsigned char*)buffer, location.size, nonce);
+    }
+    
+    if (LZ4_decompress_safe(record, out_page, (int)location.size, PAGE_SIZE) != (int)PAGE_SIZE)
+    {
+        ReportError(GhostErrorCode::DecompressFailed, page_start, location.offset, location.size);
+        return false;
+    }
+    return true;
+}
+
+bool GhostMemoryManager::EncodeDelta(void *page_start, std::vector<char>& out_delta)
+{
+    // Note: Caller must hold mutex_
+    
+    auto it = delta_bases_.find(page_start);
+    if (it == delta_bases_.end() ||
+        it->second.deltas_since_rebase >= config_.delta_rebase_interval)
+    {
+        return false;  // No base yet, or time to rebase
+    }
+    
+    DeltaBase &delta_base = it->second;
+    alignas(uint64_t) char image[PAGE_SIZE];
+    size_t base_size = 0;
+    
+    if (!delta_base.base.empty())
+    {
+        base_size = delta_base.base.size();
+        if (LZ4_decompress_safe(delta_base.base.data(), image, (int)base_size, PAGE_SIZE) != (int)PAGE_SIZE)
+        {
+            return false;
+        }
+    }
+    else if (config_.use_disk_backing && delta_base.base_location.size > 0)
+    {
+        base_size = delta_base.base_location.size;
+        if (!LoadDiskImage(page_start, delta_base.base_location, image))
+        {
+            return false;
+        }
+    }
+    else
+    {
+        return false;
+    }
+    
+    // Unchanged bytes become zero and compress to almost nothing
+    XorPage(image, (const char*)page_start);
+    
+    int max_dst_size = LZ4_compressBound(PAGE_SIZE);
+    out_delta.resize(max_dst_size);
+    int delta_size = CompressPage(page_start, image, out_delta.data(), max_dst_size);
+    
+    // A delta that is not clearly smaller than a full image means the page
+    // has drifted away from its base - store a full image instead
+    if (delta_size <= 0 || (size_t)delta_size * 2 > base_size)
+    {
+        out_delta.clear();
+        return false;
+    }
+    
+    out_delta.resize(delta_size);
+    return true;
+}
+
+int GhostMemoryManager::CompressPage(void *page_start, const char *image, char *out, int capacity)
+{
+    // Note: Caller must hold mutex_
+    
+    uint64_t ns = 0;
+    int size = CompressPageImage(page_start, image, out, capacity, ns);
+    AddCompressionTime(ns);
+    return size;
+}
+
+int GhostMemoryManager::CompressPageImage(void *page_start, const char *image, char *out, int capacity,
+                                          uint64_t &elapsed_ns) const
+{
+    // Note: Caller must hold mutex_
+    
+    // Searching hard for matches in data that did not compress last run
+    // only costs time
+    int acceleration = compression_acceleration_;
+    if (!tag_profiles_.empty())
+    {
+        auto profile_it = tag_profiles_.find(TagOfPage(page_start));
+        if (profile_it != tag_profiles_.end() && profile_it->second.compressed_size > PAGE_SIZE * 9 / 10)
+        {
+            acceleration = std::max(acceleration, config_.compression_acceleration_max);
+        }
+    }
+    
+    auto start = std::chrono::steady_clock::now();
+    int size = LZ4_compress_fast(image, out, PAGE_SIZE, capacity, acceleration);
+    elapsed_ns = (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - start).count();
+    return (size > 0) ? size : 0;
+}
+
+void GhostMemoryManager::AddCompressionTime(uint64_t ns)
+{
+    // Note: Caller must hold mutex_
+    
+    stats_.compression_ns += ns;
+    tune_window_compress_ns_ += ns;
+}
+
+void GhostMemoryManager::TuneCompression()
+{
+    // Note: Caller must hold mutex_
+    
+    uint64_t now = (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+    uint64_t window_ns = now - tune_window_start_ns_;
+    if (window_ns < (uint64_t)config_.compression_tune_interval_ms * 1000000ULL || window_ns == 0)
+    {
+        return;
+    }
+    
+    int lowest = std::max(config_.compression_acceleration_min, 1);
+    int highest = std::max(config_.compression_acceleration_max, lowest);
+    
+    // Hundredths of a percent of wall time spent compressing
+    uint64_t share = tune_window_compress_ns_ * 10000 / window_ns;
+    uint64_t budget = (uint64_t)config_.compression_cpu_percent * 100;
+    
+    int next = compression_acceleration_;
+    if (active_ram_pages.size() * 4 < GetEffectiveMaxPages() * 3)
+    {
+        next = lowest;  // No fault is waiting for room - favour ratio
+    }
+    else if (share > budget)
+    {
+        next = std::min(next * 2, highest);
+    }
+    else if (share * 2 < budget)
+    {
+        next = std::max(next / 2, lowest);
+    }
+    
+    if (next != compression_acceleration_)
+    {
+        GhostLog(GhostLogLevel::Debug, "Compression acceleration ", compression_acceleration_, " -> ", next,
+                 " (", share / 100, ".", share % 100 / 10, "% of time compressing)");
+        compression_acceleration_ = next;
+        stats_.compression_adjustments++;
+    }
+    tune_window_start_ns_ = now;
+    tune_window_compress_ns_ = 0;
+}
+
+bool GhostMemoryManager::DecodeStoredImage(void *page_start, char *out_page)
+{
+    // Note: Caller must hold mutex_
+    
+    auto delta_it = delta_bases_.find(page_start);
+    bool is_delta = (delta_it != delta_bases_.end() && delta_it->second.frozen_as_delta);
+    alignas(uint64_t) char delta_image[PAGE_SIZE];
+    bool decoded = true;
+    
+    auto backing_it = backing_store.find(page_start);
+    auto disk_it = disk_page_locations.find(page_start);
+    if (backing_it != backing_store.end())
+    {
+        // In-memory backing store; a delta is rebuilt from its base
+        const std::vector<char> &data = backing_it->second;
+        if (is_delta)
+        {
+            const std::vector<char> &base = delta_it->second.base;
+            decoded = LZ4_decompress_safe(base.data(), out_page, (int)base.size(), PAGE_SIZE) == (int)PAGE_SIZE &&
+                      LZ4_decompress_safe(data.data(), delta_image, (int)data.size(), PAGE_SIZE) == (int)PAGE_SIZE;
+        }
+        else
+        {
+            decoded = LZ4_decompress_safe(data.data(), out_page, (int)data.size(), PAGE_SIZE) == (int)PAGE_SIZE;
+        }
+        if (!decoded)
+        {
+            ReportError(GhostErrorCode::DecompressFailed, page_start, 0, data.size());
+        }
+    }
+    else if (disk_it != disk_page_locations.end() && config_.compress_before_disk)
+    {
+        // Compressed disk records; the loader reports its own failures
+        if (is_delta)
+        {
+            decoded = LoadDiskImage(page_start, delta_it->second.base_location, out_page) &&
+                      LoadDiskImage(page_start, disk_it->second, delta_image);
+        }
+        else
+        {
+            decoded = LoadDiskImage(page_start, disk_it->second, out_page);
+        }
+    }
+    else if (disk_it != disk_page_locations.end())
+    {
+        // Raw uncompressed disk record
+        const DiskRecord &record = disk_it->second;
+        const char *mapped = config_.map_disk_reads ? MapDiskRecord(record.offset, PAGE_SIZE) : nullptr;
+        if (mapped)
+        {
+            memcpy(out_page, mapped, PAGE_SIZE);
+        }
+        else if (!ReadFromDisk(record.offset, PAGE_SIZE, out_page))
+        {
+            ReportError(GhostErrorCode::DiskReadFailed, page_start, record.offset, PAGE_SIZE);
+            decoded = false;
+        }
+        
+        if (decoded && GhostCrc32c(out_page, PAGE_SIZE) != record.crc)
+        {
+            ReportError(GhostErrorCode::ChecksumMismatch, page_start, record.offset, PAGE_SIZE);
+            decoded = false;
+        }
+        
+        // Decrypt if encryption is enabled, with the nonce used for encryption
+        if (decoded && config_.encrypt_disk_pages)
+        {
+            unsigned char nonce[GHOST_CHACHA20_NONCE_SIZE];
+            GhostChaCha20PageNonce(page_start, nonce);
+            ChaCha20Crypt((unsigned char *)out_page, PAGE_SIZE, nonce);
+        }
+        is_delta = false;
+    }
+    else
+    {
+        decoded = false;  // Never touched
+    }
+    
+    if (!decoded)
+    {
+        // A damaged page must never come back half-written
+        memset(out_page, 0, PAGE_SIZE);
+    }
+    else if (is_delta)
+    {
+        XorPage(out_page, delta_image);
+    }
+    return decoded;
+}
+
+bool GhostMemoryManager::RestorePage(void *page_start)
+{
+    // Note: Caller must hold mutex_
+    
+    // Left to the kernel: reading the page makes it fault the content
+    // back in now, so the restore latency includes zswap / swap-in
+    auto kernel_it = kernel_pages_.find(page_start);
+    if (kernel_it != kernel_pages_.end())
+    {
+        kernel_pages_.erase(kernel_it);
+#ifdef _WIN32
+        DWORD old_protect;
+        VirtualProtect(page_start, PAGE_SIZE, PAGE_READWRITE, &old_protect);
+#endif
+        volatile const char *probe = (const char *)page_start;
+        (void)*probe;
+        return true;
+    }
+    
+    auto backing_it = backing_store.find(page_start);
+    auto disk_it = disk_page_locations.find(page_start);
+    if (backing_it == backing_store.end() && disk_it == disk_page_locations.end())
+    {
+        // Zero out new pages
+        memset(page_start, 0, PAGE_SIZE);
+        return false;
+    }
+    
+    auto delta_it = delta_bases_.find(page_start);
+    bool is_delta = (delta_it != delta_bases_.end() && delta_it->second.frozen_as_delta);
+    bool restored = DecodeStoredImage(page_start, (char *)page_start);
+    if (is_delta)
+    {
+        delta_it->second.frozen_as_delta = false;
+    }
+    
+    if (backing_it != backing_store.end())
+    {
+        std::vector<char> &data = backing_it->second;
+        stored_bytes_ -= data.size();
+        if (!restored)
+        {
+            EraseDeltaBase(page_start);
+        }
+        else if (!is_delta && config_.enable_delta_compression)
+        {
+            // Keep the full image as base for the next freeze
+            DeltaBase &delta_base = delta_bases_[page_start];
+            stored_bytes_ -= delta_base.base.size();
+            delta_base.base = std::move(data);
+            stored_bytes_ += delta_base.base.size();
+            delta_base.deltas_since_rebase = 0;
+        }
+        backing_store.erase(backing_it); // Remove from backup, it's live now
+        return true;
+    }
+    
+    if (!restored)
+    {
+        // Already reported by the decoder; the record is dropped so the
+        // next freeze writes a fresh one instead of a delta against it
+        EraseDeltaBase(page_start);
+        disk_page_locations.erase(disk_it);
+        return true;
+    }
+    
+    // The compressed record stays on disk and serves as base for the next freeze
+    if (!is_delta && config_.compress_before_disk && config_.enable_delta_compression)
+    {
+        DeltaBase &delta_base = delta_bases_[page_start];
+        stored_bytes_ -= delta_base.base.size();
+        delta_base.base.clear();
+        delta_base.base_location = disk_it->second;
+        delta_base.deltas_since_rebase = 0;
+    }
+    
+    // Note: We keep disk_page_locations entry (don't erase)
+    // in case page gets evicted again
+    return true;
+}
+
+// ============================================================================
+// Streaming Reads (GhostRead)
+// ============================================================================
+
+bool GhostMemoryManager::Read(const void *src, void *dst, size_t size)
+{
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
+    
+    if (!IsManagedRange(src, size))
+    {
+        return false;
+    }
+    
+    uintptr_t address = (uintptr_t)src;
+    char *out = (char *)dst;
+    while (size > 0)
+    {
+        void *page_start = (void *)(address & ~(uintptr_t)(PAGE_SIZE - 1));
+        size_t offset = address - (uintptr_t)page_start;
+        size_t chunk = std::min(size, PAGE_SIZE - offset);
+        
+        ReadPage(page_start, offset, out, chunk);
+        address += chunk;
+        out += chunk;
+        size -= chunk;
+    }
+    
+    PublishStats();
+    return true;
+}
+
+char *GhostMemoryManager::ThreadReadBuffer()
+{
+    alignas(uint64_t) static thread_local char buffer[PAGE_SIZE];
+    return buffer;
+}
+
+void GhostMemoryManager::ReadPage(void *page_start, size_t offset, char *out, size_t size)
+{
+    // Note: Caller must hold mutex_
+    
+    if (IsFrozen(page_start))
+    {
+        if (offset == 0 && size == PAGE_SIZE)
+        {
+            DecodeFrozenPage(page_start, out);
+        }
+        else
+        {
+            alignas(uint64_t) char image[PAGE_SIZE];
+            DecodeFrozenPage(page_start, image);
+            memcpy(out, image + offset, size);
+        }
+        stats_.streamed_pages++;
+        return;
+    }
+    
+    // Resident pages are copied in place. Pages behind an idle probe or
+    // left to the kernel are opened just for the copy, so the access
+    // neither faults nor counts as a use.
+    auto info_it = page_info_.find(page_start);
+    bool revoked = kernel_pages_.count(page_start) ||
+                   (info_it != page_info_.end() && info_it->second.idle_probe);
+    if (revoked)
+    {
+#ifdef _WIN32
+        DWORD old_protect;
+        VirtualProtect(page_start, PAGE_SIZE, PAGE_READONLY, &old_protect);
+#else
+        mprotect(page_start, PAGE_SIZE, PROT_READ);
+#endif
+    }
+    
+    memcpy(out, (const char *)page_start + offset, size);
+    
+    if (revoked)
+    {
+#ifdef _WIN32
+        DWORD old_protect;
+        VirtualProtect(page_start, PAGE_SIZE, PAGE_NOACCESS, &old_protect);
+#else
+        mprotect(page_start, PAGE_SIZE, PROT_NONE);
+#endif
+    }
+}
+
+void GhostMemoryManager::DecodeFrozenPage(void *page_start, char *out_page)
+{
+    // Note: Caller must hold mutex_
+    
+    DecodeStoredImage(page_start, out_page);
+    
+    // Pending GhostWrite() patches; the log stays for the next thaw
+    CopyPatches(page_start, out_page);
+}
+
+bool GhostMemoryManager::HandlePageFault(void *page_start, const void *fault_ip)
+{
+    // Note: Caller must hold mutex_
+    
+    auto fault_start = std::chrono::steady_clock::now();
+    GhostStatsBlock *stats_block = stats_block_.load(std::memory_order_relaxed);
+    
+    // A resident page armed by the idle scanner was touched again:
+    // give access back and count it as recently used - nothing to restore
+    auto info_it = page_info_.find(page_start);
+    if (info_it != page_info_.end() && info_it->second.idle_probe)
+    {
+#ifdef _WIN32
+        DWORD old_protect;
+        if (!VirtualProtect(page_start, PAGE_SIZE, PAGE_READWRITE, &old_protect))
+        {
+            return false;
+        }
+#else
+        if (mprotect(page_start, PAGE_SIZE, PROT_READ | PROT_WRITE) != 0)
+        {
+            return false;
+        }
+#endif
+        info_it->second.idle_probe = false;
+        stats_.idle_soft_faults++;
+        MarkPageAsActive(page_start);
+        
+        uint64_t fault_ns = (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - fault_start).count();
+        stats_block->fault_latency.Record(fault_ns);
+        GHOST_TRACE2(idle_touch, page_start, fault_ns);
+        PublishStats();
+        return true;
+    }
+    
+    //[Trap] Access to  page_start
+    // IMPORTANT: Before getting RAM, we must check if we have room!
+    const AllocationInfo *allocation = AllocationOfPage(page_start);
+    GhostTag tag = allocation ? allocation->tag : 0;
+    uint64_t site_id = allocation ? allocation->site : 0;
+    EnforceTagQuota(tag, page_start);
+    EvictOldestPage(page_start);
+    
+    // Now we have room -> get RAM (make page accessible)
+#ifdef _WIN32
+    if (!VirtualAlloc(page_start, PAGE_SIZE, MEM_COMMIT, PAGE_READWRITE))
+    {
+        return false;
+    }
+#else
+    if (mprotect(page_start, PAGE_SIZE, PROT_READ | PROT_WRITE) != 0)
+    {
+        return false;
+    }
 #endif
+    
+    // If data was in backup -> Restore
+    TagState &tag_state = tag_states_[tag];
+    stats_.page_faults++;
+    tag_state.page_faults++;
+    GhostStorageTier restored_tier = GhostStorageTier::None;
+    auto restore_start = std::chrono::steady_clock::now();
+    if (RestorePage(page_start))
+    {
+        uint64_t restore_ns = (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - restore_start).count();
+        
+        stats_.refaults++;
+        tag_state.refaults++;
+        RecordRefault(page_start);
+        RecordRestoreLatency(page_start, restore_ns);
+        stats_block->restore_latency.Record(restore_ns);
+        
+        const PageInfo &info = page_info_[page_start];
+        restored_tier = info.tier;
+        GHOST_TRACE4(restore, page_start, (int)info.tier, info.compressed_size, restore_ns);
+        GhostLog(GhostLogLevel::Debug, "Restored ", page_start, " (tier ", info.tier, ", ",
+                 info.compressed_size, " bytes, ", restore_ns, " ns)");
+    }
+    
+    // GhostWrite() patches made while the page was frozen
+    ApplyPatchLog(page_start);
+    
+    auto site_it = alloc_sites_.find(site_id);
+    if (site_it != alloc_sites_.end())
+    {
+        site_it->second.page_faults++;
+        site_it->second.refaults += (restored_tier != GhostStorageTier::None) ? 1 : 0;
+    }
+    
+    // Add to active list
+    MarkPageAsActive(page_start);
+    if (restored_tier == GhostStorageTier::None && !tag_profiles_.empty())
+    {
+        SeedPageFromProfile(page_start, tag);
+    }
+    
+    // Periodically renegotiate the host-wide budget
+    if (coordinator_.IsAttached() &&
+        ++faults_since_budget_update_ >= config_.coordinator_update_interval)
+    {
+        UpdateCoordinatedBudget();
+    }
+    
+    uint64_t fault_ns = (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - fault_start).count();
+    stats_block->fault_latency.Record(fault_ns);
+    GHOST_TRACE4(fault_done, page_start, (int)restored_tier, fault_ns, tag);
+    RecordFaultSite(fault_ip, restored_tier != GhostStorageTier::None, fault_ns);
+    PublishStats();
+    return true;
+}
+
+void GhostMemoryManager::UpdateManagedBounds()
+{
+    // Note: Caller must hold mutex_
+    
+    if (managed_blocks.empty())
+    {
+        managed_low_.store(UINTPTR_MAX, std::memory_order_release);
+        managed_high_.store(0, std::memory_order_release);
+        return;
+    }
+    auto last = managed_blocks.rbegin();
+    managed_low_.store((uintptr_t)managed_blocks.begin()->first, std::memory_order_release);
+    managed_high_.store((uintptr_t)last->first + last->second, std::memory_order_release);
+}
+
+bool GhostMemoryManager::DispatchFault(void *owner, void *fault_addr, const void *fault_ip)
+{
+    auto &manager = *static_cast<GhostMemoryManager *>(owner);
+    
+    // Not within any of our blocks: pass it on without waiting for the
+    // mutex, which a fault on another manager's memory must not do
+    uintptr_t fault = (uintptr_t)fault_addr;
+    if (fault < manager.managed_low_.load(std::memory_order_acquire) ||
+        fault >= manager.managed_high_.load(std::memory_order_acquire))
+    {
+        return false;
+    }
+    
+    // Lock mutex for thread-safe access to shared data structures
+    // Note: While mutexes aren't technically async-signal-safe,
+    // this works in practice since the manager is initialized in main
+    // and page faults are handled per-thread by the kernel.
+    std::lock_guard<std::recursive_mutex> lock(manager.mutex_);
+    
+    // Is it our address? Blocks never overlap, so only the closest
+    // block at or below the address can contain it.
+    auto block_it = manager.managed_blocks.upper_bound(fault_addr);
+    if (block_it == manager.managed_blocks.begin())
+    {
+        return false;
+    }
+    --block_it;
+    
+    uintptr_t start = (uintptr_t)block_it->first;
+    if (fault >= start + block_it->second)
+    {
+        return false;
+    }
+    
+    void *page_start = (void *)(fault & ~(PAGE_SIZE - 1));
+    return manager.HandlePageFault(page_start, fault_ip);
+}
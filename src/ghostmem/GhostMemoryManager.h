@@ -56,16 +56,31 @@
 
 // Standard library includes
 #include <map>                  // Memory block tracking
+#include <set>                  // Pages left to the kernel
 #include <vector>               // Compressed data storage
 #include <list>                 // LRU page list
 #include <algorithm>            // Standard algorithms
 #include <mutex>                // Thread synchronization
+#include <thread>               // Idle page scanner
+#include <condition_variable>   // Idle scanner wake-up and shutdown
+#include <functional>           // Page visitor
+#include <iterator>             // GhostReadRange iterator category
 #include <string>               // String for disk file paths
 #include <iostream>             // for console log
+#include <cstdint>              // Fixed-width statistics counters
 
 // Third-party includes
 #include "../3rdparty/lz4.h"    // LZ4 compression/decompression
 
+// GhostMem includes
+#include "GhostBudgetCoordinator.h"  // Host-wide budget sharing
+#include "GhostStatsBlock.h"         // Lock-free published statistics
+#include "GhostMetricsExporter.h"    // OpenMetrics endpoint / file
+#include "GhostSymbolizer.h"         // Fault site symbolization
+#include "GhostFaultDispatcher.h"    // Shared SIGSEGV / VEH hook
+#include "GhostChaCha20.h"           // Swap file encryption
+#include "GhostLog.h"                // Asynchronous diagnostic log
+
 /**
  * @brief Memory page size in bytes (4KB - standard page size)
  * 
@@ -88,6 +103,76 @@ const size_t PAGE_SIZE = 4096;
  */
 const size_t MAX_PHYSICAL_PAGES = 5;
 
+/**
+ * @enum GhostEvictionPolicy
+ * @brief Strategy used to choose which resident page to freeze next
+ */
+enum class GhostEvictionPolicy
+{
+    LRU,        ///< Least recently used page (default)
+    CostAware   ///< Most memory freed per expected refault cost among the oldest pages
+};
+
+/**
+ * @enum GhostStorageTier
+ * @brief Where the content of a frozen page is kept
+ */
+enum class GhostStorageTier : uint8_t
+{
+    None,       ///< Never frozen
+    Memory,     ///< LZ4-compressed in the in-memory backing store
+    Disk,       ///< LZ4-compressed in the swap file
+    DiskRaw,    ///< Uncompressed in the swap file
+    Kernel      ///< Left in place and handed to the kernel (zswap / zram / swap)
+};
+
+/**
+ * @enum GhostFreezeBackend
+ * @brief Who compresses frozen pages
+ */
+enum class GhostFreezeBackend
+{
+    Compress,       ///< GhostMem compresses them itself (LZ4, RAM or swap file) - default
+    KernelCold,     ///< madvise(MADV_COLD): reclaimed first under memory pressure
+    KernelPageout   ///< madvise(MADV_PAGEOUT): reclaimed immediately
+};
+
+/**
+ * @enum GhostErrorCode
+ * @brief Failures reported through GhostConfig::error_callback
+ */
+enum class GhostErrorCode
+{
+    DiskWriteFailed,    ///< A page could not be written to the swap file; it stays resident and intact
+    DiskReadFailed,     ///< A swap file record could not be read
+    ChecksumMismatch,   ///< A swap file record does not match its CRC32C
+    DecompressFailed    ///< A stored record did not decompress to a full page
+};
+
+/**
+ * @struct GhostError
+ * @brief Details of a failed freeze or restore
+ * 
+ * For read, checksum and decompression failures the page has been
+ * zero-filled: its previous content is lost.
+ */
+struct GhostError
+{
+    GhostErrorCode code;
+    void *page;             ///< Page being frozen or restored
+    uint64_t file_offset;   ///< Swap file offset of the record (0 in memory)
+    size_t size;            ///< Record size in bytes
+};
+
+/**
+ * @brief Receives GhostError reports
+ * 
+ * Called with the manager's mutex held, usually from inside the fault
+ * handler: it must not call into the manager or allocate ghost memory.
+ * Typical handlers log and abort().
+ */
+typedef void (*GhostErrorCallback)(const GhostError &error, void *user_data);
+
 /**
  * @struct GhostConfig
  * @brief Configuration structure for GhostMemoryManager
@@ -140,6 +225,40 @@ struct GhostConfig
      */
     bool compress_before_disk = true;
 
+    /**
+     * @brief Read frozen pages from a memory mapping of the swap file
+     * 
+     * When true, the swap file is mapped read-only into the process and
+     * a disk refault decompresses its record straight from the mapping
+     * into the faulting page: no lseek / read system calls and no
+     * intermediate buffer (encrypted records are decrypted in a stack
+     * copy). Writes still use write(). The mapping grows as the file
+     * does; if it cannot be created, reads fall back to system calls.
+     * 
+     * A cold record then costs a major page fault on the mapping instead
+     * of a read() call. Only applies when use_disk_backing is true.
+     * 
+     * Default: false (read system calls)
+     */
+    bool map_disk_reads = false;
+
+    /**
+     * @brief Called when a page cannot be stored or restored intact
+     * 
+     * Every swap file record carries a CRC32C that is verified on read,
+     * and every decompression must yield a full page. Failures are
+     * logged as errors, counted in GhostStats::integrity_errors and
+     * passed to this callback (see GhostErrorCallback).
+     * 
+     * Default: nullptr (log and count only)
+     */
+    GhostErrorCallback error_callback = nullptr;
+
+    /**
+     * @brief Passed to error_callback as user_data
+     */
+    void *error_callback_data = nullptr;
+
     /**
      * @brief Enable verbose debug logging to console
      * 
@@ -147,10 +266,34 @@ struct GhostConfig
      * including page evictions, disk operations, and memory management events.
      * When false (default), all debug output is suppressed for silent operation.
      * 
+     * Shorthand for log_level = GhostLogLevel::Debug.
+     * 
      * Default: false (silent mode)
      */
     bool enable_verbose_logging = false;
 
+    /**
+     * @brief Most verbose level written to the log
+     * 
+     * Messages are queued without locks or allocation and written by a
+     * background thread (see GhostLog.h): errors and warnings to stderr,
+     * the rest to stdout. The level is process-wide; the last
+     * Initialize() sets it.
+     * 
+     * Default: GhostLogLevel::Off (or Debug with enable_verbose_logging)
+     */
+    GhostLogLevel log_level = GhostLogLevel::Off;
+
+    /**
+     * @brief Keep only every Nth Info / Debug message
+     * 
+     * Errors and warnings are never sampled. Lets Debug stay enabled on a
+     * process that faults hundreds of thousands of times per second.
+     * 
+     * Default: 1 (keep all)
+     */
+    size_t log_sample_rate = 1;
+
     /**
      * @brief Enable encryption for disk-backed pages
      * 
@@ -166,217 +309,1439 @@ struct GhostConfig
      * Default: false (no encryption)
      */
     bool encrypt_disk_pages = false;
-};
 
-/**
- * @class GhostMemoryManager
- * @brief Singleton class managing virtual memory with transparent compression
- * 
- * The GhostMemoryManager implements a virtual memory system that uses
- * in-memory compression to extend available RAM. It operates by:
- * 
- * 1. Reserving virtual address space without allocating physical RAM
- * 2. Intercepting page faults when memory is accessed
- * 3. Decompressing and restoring pages on demand
- * 4. Evicting least recently used pages when limit is reached
- * 5. Compressing evicted pages and storing them in-memory
- * 
- * The system is completely transparent to applications using the
- * GhostAllocator wrapper for STL containers.
- * 
- * Thread Safety: Thread-safe. All public methods and page fault handlers
- * use internal mutex synchronization to protect shared data structures.
- * Multiple threads can safely allocate and access GhostMem memory concurrently.
- */
-class GhostMemoryManager
-{
-private:
     /**
-     * @struct AllocationInfo
-     * @brief Metadata for tracking individual allocations within pages
+     * @brief Name of the host-wide budget coordination region
      * 
-     * Since multiple allocations can share the same 4KB page, we need
-     * to track each allocation separately to implement proper deallocation.
+     * When non-empty, this process joins a shared memory region of that
+     * name and lets the participating GhostMem processes on the host split
+     * a common resident budget between them. Each process publishes its
+     * demand and refault pressure; the granted budget replaces
+     * max_memory_pages for eviction decisions.
+     * 
+     * Example: "myapp-ghostmem"
+     * Default: "" (coordination disabled)
      */
-    struct AllocationInfo
-    {
-        void* page_start;      ///< Page-aligned base address of containing page
-        size_t offset;         ///< Byte offset within the page (0-4095)
-        size_t size;           ///< Size of this allocation in bytes
-    };
+    std::string coordinator_name;
 
     /**
-     * @brief Configuration for the memory manager
+     * @brief Host-wide resident budget in pages shared by all participants
+     * 
+     * Only used by the first process that creates the region; later
+     * participants adopt the budget already stored in it. When 0, the
+     * effective max_memory_pages of the creating process is used.
+     * 
+     * Default: 0
      */
-    GhostConfig config_;
+    size_t coordinator_total_pages = 0;
 
     /**
-     * @brief Mutex protecting all shared data structures
+     * @brief Minimum budget in pages every participant is granted
      * 
-     * This mutex must be locked when accessing or modifying:
-     * - managed_blocks
-     * - backing_store
-     * - active_ram_pages
-     * - allocation_metadata_
-     * - page_ref_counts_
-     * - config_
-     * - disk_file_handle / disk_file_descriptor
-     * - disk_page_locations
+     * Only used by the process that creates the region.
      * 
-     * Note: Uses std::recursive_mutex to allow re-entrant locking
-     * within the same thread (e.g., page fault during eviction).
+     * Default: 16 pages (64KB)
      */
-    mutable std::recursive_mutex mutex_;
+    size_t coordinator_min_pages = 16;
 
     /**
-     * @brief Map of all managed virtual memory blocks
+     * @brief Page faults between two budget updates
      * 
-     * Key: Base address of virtual allocation
-     * Value: Size of the allocation in bytes
+     * Each update publishes demand and refault pressure and rebalances
+     * the shared table. Smaller values react faster to load changes at
+     * the cost of more cross-process synchronization.
      * 
-     * This tracks all memory regions managed by GhostMem, allowing
-     * the page fault handler to determine if a fault address belongs
-     * to our managed memory.
+     * Default: 256 faults
      */
-    std::map<void *, size_t> managed_blocks;
+    size_t coordinator_update_interval = 256;
 
     /**
-     * @brief Storage for compressed page data (in-memory mode)
+     * @brief Longest time between two budget updates in milliseconds
      * 
-     * Key: Page base address (page-aligned)
-     * Value: Vector containing LZ4-compressed page data
+     * Updates normally ride on page faults. A process that stops faulting
+     * is updated by a background thread once this much time has passed,
+     * so its refault pressure decays and the pages it no longer fights
+     * for are granted to the others. 0 = fault-driven updates only.
      * 
-     * When a page is evicted from physical RAM, its contents are
-     * compressed and stored here. The compression ratio varies:
-     * - Text/strings: 5-10x compression
-     * - Repeated data: 10-50x compression
-     * - Random data: ~1x (incompressible)
+     * Default: 1000 ms
+     */
+    size_t coordinator_update_ms = 1000;
+
+    /**
+     * @brief Encode re-frozen pages as a delta against their previous version
      * 
-     * Note: Not used when disk backing is enabled (use_disk_backing=true)
+     * When true, the compressed image a page was restored from is kept as
+     * a base while the page is resident. When the page is frozen again it
+     * is XORed against that base and only the (mostly zero) difference is
+     * compressed, which is much cheaper for lightly modified pages. If the
+     * delta is not clearly smaller than the base, a full image is stored
+     * and becomes the next base.
+     * 
+     * Applies to the in-memory backing store and to compressed disk
+     * backing. In disk mode only the small delta record is appended to the
+     * swap file; the base stays where it is.
+     * 
+     * Cost: resident pages keep their compressed base in RAM.
+     * 
+     * Default: false (every freeze compresses the full page)
      */
-    std::map<void *, std::vector<char>> backing_store;
+    bool enable_delta_compression = false;
 
     /**
-     * @brief Disk page location tracking (disk-backed mode)
+     * @brief Delta freezes allowed before a page is rebased
      * 
-     * Key: Page base address
-     * Value: Pair of (file_offset, data_size)
+     * After this many consecutive delta freezes, the next freeze stores a
+     * full image again so bases do not drift too far from the page content.
      * 
-     * Tracks where each compressed page is stored on disk and its size.
-     * Only used when config_.use_disk_backing is true.
+     * Default: 8
      */
-    std::map<void *, std::pair<size_t, size_t>> disk_page_locations;
+    size_t delta_rebase_interval = 8;
 
+    /**
+     * @brief Bytes of GhostWrite() patches buffered per frozen page
+     * 
+     * GhostWrite() into a frozen page appends the change to a small
+     * per-page log instead of faulting the page in. The log is applied
+     * when the page is next thawed, or folded into the frozen image
+     * (compacted) when it is full. Writes larger than the log always
+     * fault the page in. The idle scanner also compacts logs that are at
+     * least half full.
+     * 
+     * Each patch costs 4 bytes of header plus its data. Only used with
+     * GhostFreezeBackend::Compress.
+     * 
+     * Default: 256 (0 = GhostWrite() behaves like memcpy)
+     */
+    size_t patch_log_bytes = 256;
 
-#ifdef _WIN32
     /**
-     * @brief Windows file handle for disk backing
+     * @brief Threads compressing pages in GhostIngest()
      * 
-     * Valid only when config_.use_disk_backing is true.
-     * INVALID_HANDLE_VALUE when not using disk backing.
+     * The calling thread counts as one; more threads are started per
+     * batch of pages. The manager stays locked during an ingest.
+     * 
+     * Default: 1 (compress on the calling thread)
      */
-    HANDLE disk_file_handle = INVALID_HANDLE_VALUE;
-#else
+    size_t ingest_threads = 1;
+
     /**
-     * @brief POSIX file descriptor for disk backing
+     * @brief Promote pages that thrash into a protected set
+     * 
+     * Every frozen page carries a shadow entry with the eviction clock at
+     * the time it was frozen. When it faults back in, the refault distance
+     * (evictions since then) tells whether a slightly larger budget would
+     * have kept it resident. When this option is true, such pages are
+     * promoted to a protected set that eviction skips while unprotected
+     * pages remain. A full protected set only makes room once its least
+     * recently used member has been protected for a whole budget of
+     * evictions. Refault statistics are collected either way.
+     * 
+     * Default: false (plain LRU)
+     */
+    bool enable_refault_protection = false;
+
+    /**
+     * @brief Maximum share of the resident budget that may be protected
      * 
-     * Valid only when config_.use_disk_backing is true.
-     * -1 when not using disk backing.
+     * Percentage (1-100). When a promotion would exceed the limit, the
+     * least recently used protected page is demoted first if it has been
+     * protected long enough; otherwise the promotion is skipped.
+     * 
+     * Default: 50
      */
-    int disk_file_descriptor = -1;
-#endif
+    size_t protected_pages_percent = 50;
 
     /**
-     * @brief Next available file offset for disk writes
+     * @brief Victim selection strategy
      * 
-     * Tracks the end of the disk file to append new compressed pages.
-     * Only used when config_.use_disk_backing is true.
+     * LRU always freezes the least recently used page. CostAware looks at
+     * the eviction_scan_depth oldest candidates and picks the one that
+     * frees the most memory per expected refault cost, using the page's
+     * last compressed size, its storage tier and measured restore latency,
+     * discounted by recency. Incompressible pages in in-memory mode free
+     * almost nothing and are therefore kept resident in favour of pages
+     * that compress well.
+     * 
+     * Default: GhostEvictionPolicy::LRU
      */
-    size_t disk_next_offset = 0;
+    GhostEvictionPolicy eviction_policy = GhostEvictionPolicy::LRU;
 
     /**
-     * @brief LRU list of pages currently in physical RAM
+     * @brief Number of oldest pages considered by CostAware eviction
      * 
-     * Pages are ordered from most recently used (front) to least
-     * recently used (back). When MAX_PHYSICAL_PAGES is reached,
-     * pages are evicted from the back of this list.
+     * Default: 8
+     */
+    size_t eviction_scan_depth = 8;
+
+    /**
+     * @brief File holding the hotness profile learned in previous runs
+     * 
+     * When set, Initialize() loads the profile (a missing file is fine)
+     * and the profile is saved again when the manager is re-initialized
+     * or destroyed. It records per tag how often pages thrashed and how
+     * well they compressed, plus the measured restore latency per tier,
+     * and seeds policy state from the first fault on:
+     * - With enable_refault_protection, pages of tags that thrashed are
+     *   protected on their first fault instead of after their first
+     *   thrashing refault
+     * - CostAware eviction uses the tag's compressed size and the tier
+     *   latencies for pages that have not been frozen yet
+     * - Pages of tags that did not compress use the fastest acceleration
+     *   (compression_acceleration_max)
+     * 
+     * Tags are chosen by the application and therefore stable across
+     * runs; older runs are weighted down by half on every save.
+     * 
+     * Default: "" (no profile)
+     */
+    std::string profile_path;
+
+    /**
+     * @brief Share of thrashing refaults that marks a tag as hot
      * 
-     * Invariant: active_ram_pages.size() <= MAX_PHYSICAL_PAGES
+     * Percentage of a tag's page faults (1-100), as recorded in the
+     * profile.
+     * 
+     * Default: 25
      */
-    std::list<void *> active_ram_pages;
+    size_t profile_hot_percent = 25;
 
     /**
-     * @brief Metadata for all active allocations
+     * @brief Compress frozen pages in userspace or leave them to the kernel
+     * 
+     * With KernelCold or KernelPageout, freezing a page still revokes
+     * access and keeps all of GhostMem's policy and accounting (budget,
+     * LRU / CostAware, tags, refault tracking, idle scanning), but
+     * instead of compressing the page it is left in place and handed to
+     * the kernel's reclaim, which compresses it with zswap / zram or
+     * writes it to swap. A fault only re-enables access; the kernel
+     * brings the content back. This avoids compressing twice on hosts
+     * that already run zswap or zram.
+     * 
+     * On Linux (5.4+) this uses MADV_COLD (reclaimed first under
+     * pressure) or MADV_PAGEOUT (reclaimed now). On Windows both remove
+     * the page from the working set, where the memory manager's
+     * compression store takes it. Without swap, zswap or zram the kernel
+     * cannot reclaim anonymous pages and they stay resident.
+     * 
+     * Cannot be combined with use_disk_backing; enable_delta_compression
+     * has no effect. Initialize() fails if the kernel lacks support (see
+     * GhostMemoryManager::IsFreezeBackendSupported()).
+     * 
+     * Default: GhostFreezeBackend::Compress
+     */
+    GhostFreezeBackend freeze_backend = GhostFreezeBackend::Compress;
+
+    /**
+     * @brief Tune LZ4 acceleration of new freezes to the current load
      * 
-     * Key: Pointer returned by AllocateGhost (allocation address)
-     * Value: AllocationInfo containing page, offset, and size
+     * LZ4's acceleration trades ratio for speed: 1 compresses best, each
+     * doubling roughly halves the time per page at a cost in ratio. When
+     * enabled, the manager measures the share of wall time spent in LZ4
+     * compression every compression_tune_interval_ms (fault rate times
+     * cost per page) and doubles the acceleration while it exceeds
+     * compression_cpu_percent, or halves it once the share falls below
+     * half of that. While the resident set is under three quarters of its
+     * budget no fault waits for a freeze, so the best ratio is used.
      * 
-     * This map enables proper deallocation by tracking which page
-     * each allocation belongs to and its exact size. When deallocate
-     * is called, we use this to decrement the correct page's reference count.
+     * Pages already frozen keep their encoding; LZ4 decompression speed
+     * does not depend on the acceleration.
      * 
-     * Lifecycle: Entry added in AllocateGhost, removed in DeallocateGhost
+     * Default: false (fixed compression_acceleration_min)
      */
-    std::map<void*, AllocationInfo> allocation_metadata_;
+    bool enable_adaptive_compression = false;
 
     /**
-     * @brief Reference count for each page
+     * @brief Lowest (best ratio) LZ4 acceleration
      * 
-     * Key: Page-aligned base address
-     * Value: Number of active allocations within this page
+     * Also the fixed acceleration when adaptive compression is off.
      * 
-     * Since multiple allocations can share a 4KB page, we use reference
-     * counting to determine when a page can be completely freed. When
-     * the count reaches zero, the page is removed from all tracking
-     * structures and memory is released back to the OS.
+     * Default: 1 (LZ4 default)
+     */
+    int compression_acceleration_min = 1;
+
+    /**
+     * @brief Highest (fastest) LZ4 acceleration the controller may pick
      * 
-     * Lifecycle:
-     * - Incremented in AllocateGhost when allocation added to page
-     * - Decremented in DeallocateGhost when allocation freed
-     * - Entry removed when count reaches zero (page fully freed)
+     * Default: 64
      */
-    std::map<void*, size_t> page_ref_counts_;
+    int compression_acceleration_max = 64;
 
-    // Internal tracking (diagnostic purposes only)
-    void* lib_meta_ptr_ = nullptr;
-    bool lib_meta_init_ = false;
+    /**
+     * @brief Share of wall time compression may take before speeding up
+     * 
+     * Default: 10 (percent)
+     */
+    size_t compression_cpu_percent = 10;
+
+    /**
+     * @brief Measurement window of the compression controller
+     * 
+     * Default: 100 ms
+     */
+    size_t compression_tune_interval_ms = 100;
+
+    /**
+     * @brief Freeze resident pages that have been idle for this long
+     * 
+     * When non-zero, a background thread periodically revokes access to
+     * resident pages. A page that is touched again takes a cheap soft
+     * fault and becomes accessible immediately; a page that is still
+     * untouched after idle_freeze_age_ms is frozen, even if the resident
+     * set is below its budget. This keeps RSS close to the true working
+     * set and leaves headroom for bursts.
+     * 
+     * Default: 0 (disabled)
+     */
+    size_t idle_freeze_age_ms = 0;
+
+    /**
+     * @brief Interval between idle scans in milliseconds
+     * 
+     * Pages are frozen between idle_freeze_age_ms and
+     * idle_freeze_age_ms + idle_scan_interval_ms after their last access.
+     * 
+     * Default: 1000
+     */
+    size_t idle_scan_interval_ms = 1000;
+
+    /**
+     * @brief Publish statistics into a named shared memory segment
+     * 
+     * When set, the manager's lock-free statistics block (counters,
+     * current figures and latency histograms, see GhostStatsBlock) lives
+     * in a shared memory segment of this name, so tools like ghostmem_top
+     * can watch the process live. Publishing is a handful of relaxed
+     * atomic stores per fault. The segment is removed again when the
+     * manager is re-initialized without a name or destroyed.
+     * 
+     * Default: "" (statistics stay process-private)
+     */
+    std::string stats_shm_name;
+
+    /**
+     * @brief Serve OpenMetrics text on http://127.0.0.1:<metrics_port>/metrics
+     * 
+     * A background thread answers Prometheus scrapes from the lock-free
+     * statistics block; a scrape never takes the manager's mutex. The
+     * listener only binds the loopback interface.
+     * 
+     * Default: false
+     */
+    bool enable_metrics_http = false;
+
+    /**
+     * @brief TCP port of the metrics listener (0 = pick a free port,
+     *        see GhostMemoryManager::GetMetricsPort())
+     * 
+     * Default: 9464
+     */
+    uint16_t metrics_port = 9464;
+
+    /**
+     * @brief File to rewrite periodically with OpenMetrics text
+     * 
+     * Suited for the node_exporter textfile collector or processes that
+     * must not open sockets. The file is replaced atomically and written
+     * a last time when the exporter stops.
+     * 
+     * Default: "" (no file)
+     */
+    std::string metrics_file_path;
+
+    /**
+     * @brief Interval between writes of metrics_file_path in milliseconds
+     * 
+     * Default: 5000
+     */
+    size_t metrics_interval_ms = 5000;
+
+    /**
+     * @brief Attribute every Nth page fault to the faulting instruction
+     * 
+     * The instruction pointer is taken from the signal / exception
+     * context and faults and fault latency are aggregated per code
+     * address. GetFaultSites() and PrintFaultReport() show which loops
+     * cause the faults. Sampling keeps the cost at one counter increment
+     * for unsampled faults; 1 records every fault.
+     * 
+     * Default: 0 (disabled)
+     */
+    size_t fault_ip_sample_rate = 0;
+
+    /**
+     * @brief Record the call stack of every AllocateGhost() call
+     * 
+     * Allocations are grouped by a hash of their backtrace. Live bytes,
+     * resident and frozen pages, compressed size and faults are then
+     * available per call site (GetAllocationSites()), which shows the
+     * allocations that compress badly or dominate the resident set.
+     * Capturing a backtrace costs about a microsecond per allocation.
+     * 
+     * Default: false
+     */
+    bool track_allocation_sites = false;
+
+    /**
+     * @brief Stack frames recorded per allocation site (max 32)
+     * 
+     * Deeper stacks tell apart allocations made through shared helpers
+     * such as GhostAllocator; shallower stacks merge them.
+     * 
+     * Default: 8
+     */
+    size_t allocation_site_depth = 8;
+};
+
+/**
+ * @struct GhostStats
+ * @brief Snapshot of GhostMemoryManager counters
+ * 
+ * Returned by GhostMemoryManager::GetStats(). Counters are cumulative
+ * since process start; page and byte figures describe the current state.
+ */
+struct GhostStats
+{
+    uint64_t page_faults = 0;       ///< Faults handled on managed pages
+    uint64_t refaults = 0;          ///< Faults that restored frozen page data
+    uint64_t evictions = 0;         ///< Pages frozen (compressed or written to disk)
+    uint64_t delta_freezes = 0;     ///< Freezes stored as a delta against the previous version
+    uint64_t delta_rebases = 0;     ///< Freezes that replaced a base with a full image
+    uint64_t thrash_refaults = 0;   ///< Refaults within the resident budget (budget too small)
+    uint64_t cold_refaults = 0;     ///< Refaults beyond the resident budget (genuinely cold)
+    uint64_t protected_promotions = 0; ///< Pages promoted to the protected set
+    uint64_t idle_scans = 0;        ///< Idle scanner passes
+    uint64_t idle_soft_faults = 0;  ///< Probed pages that were touched again (kept resident)
+    uint64_t idle_freezes = 0;      ///< Pages frozen by the idle scanner
+    uint64_t idle_reclaimed_bytes = 0; ///< Resident bytes released by idle freezes
+    uint64_t idle_scan_ns = 0;      ///< Time spent inside idle scans
+    size_t protected_pages = 0;     ///< Resident pages currently protected
+    size_t resident_pages = 0;      ///< Pages currently in physical RAM
+    size_t frozen_pages = 0;        ///< Pages currently held in the backing store or on disk
+    size_t compressed_bytes = 0;    ///< Bytes held by the in-memory backing store
+    size_t disk_bytes = 0;          ///< Bytes appended to the swap file
+    size_t budget_pages = 0;        ///< Effective resident page limit
+    size_t coordinator_participants = 0; ///< Processes sharing the host budget (0 = not coordinated)
+    size_t metadata_entries = 0;    ///< Entries in per-allocation and per-page bookkeeping (constant for a constant working set)
+    size_t kernel_pages = 0;        ///< Frozen pages handed to the kernel (included in frozen_pages)
+    uint64_t compression_ns = 0;    ///< Time spent in LZ4 compression of frozen pages
+    uint64_t compression_adjustments = 0; ///< Acceleration changes by the adaptive controller
+    int compression_acceleration = 1; ///< LZ4 acceleration used for new freezes
+    uint64_t integrity_errors = 0;  ///< Failed swap writes, reads, checksums or decompressions (see GhostErrorCallback)
+    uint64_t patch_writes = 0;      ///< GhostWrite() chunks logged against frozen pages (no fault)
+    uint64_t patch_compactions = 0; ///< Patch logs folded into a frozen image without a fault
+    uint64_t streamed_pages = 0;    ///< Frozen pages decoded by GhostRead() without a fault
+    uint64_t ingested_pages = 0;    ///< Pages stored frozen by GhostIngest() without a fault
+    uint64_t profile_protections = 0; ///< Pages protected on first fault because of the loaded profile
+};
+
+/**
+ * @brief Identifies the subsystem that owns an allocation
+ * 
+ * Tag 0 is the default for untagged allocations. Other values are
+ * chosen by the application (e.g. one per cache or container family).
+ */
+using GhostTag = uint32_t;
+
+/**
+ * @struct GhostTagStats
+ * @brief Per-tag snapshot returned by GhostMemoryManager::GetTagStats()
+ */
+struct GhostTagStats
+{
+    uint64_t page_faults = 0;       ///< Faults handled on pages of this tag
+    uint64_t refaults = 0;          ///< Faults that restored frozen data
+    uint64_t evictions = 0;         ///< Pages of this tag frozen
+    size_t resident_pages = 0;      ///< Pages currently in physical RAM
+    size_t frozen_pages = 0;        ///< Pages currently compressed in RAM or on disk
+    size_t compressed_bytes = 0;    ///< Bytes held for frozen pages (RAM or disk)
+    size_t quota_pages = 0;         ///< Resident page quota (0 = unlimited)
+    double compression_ratio = 0.0; ///< Frozen bytes / compressed bytes (0 = nothing frozen)
+};
+
+/**
+ * @struct GhostFaultSite
+ * @brief Sampled page faults of one faulting instruction
+ * 
+ * Returned by GhostMemoryManager::GetFaultSites(). Counts are samples;
+ * multiply by GhostConfig::fault_ip_sample_rate for an estimate of all
+ * faults.
+ */
+struct GhostFaultSite
+{
+    const void *ip = nullptr;       ///< Address of the faulting instruction
+    uint64_t samples = 0;           ///< Sampled faults at this address
+    uint64_t refaults = 0;          ///< Sampled faults that restored frozen data
+    uint64_t total_ns = 0;          ///< Summed fault handler latency
+    uint64_t max_ns = 0;            ///< Slowest sampled fault
+    GhostCodeLocation location;     ///< Module, offset and symbol of ip
+};
+
+/**
+ * @struct GhostAllocationSite
+ * @brief Ghost memory owned by one allocation call stack
+ * 
+ * Returned by GhostMemoryManager::GetAllocationSites().
+ */
+struct GhostAllocationSite
+{
+    uint64_t id = 0;                       ///< Hash of the call stack
+    std::vector<const void*> frames;       ///< Return addresses, innermost first
+    std::vector<GhostCodeLocation> locations; ///< Symbolized frames
+    uint64_t allocations = 0;              ///< Allocations made from this site
+    uint64_t live_allocations = 0;         ///< Allocations not freed yet
+    size_t live_bytes = 0;                 ///< Requested bytes not freed yet
+    size_t resident_pages = 0;             ///< Pages currently in physical RAM
+    size_t frozen_pages = 0;               ///< Pages currently compressed in RAM or on disk
+    size_t compressed_bytes = 0;           ///< Bytes held for frozen pages (RAM or disk)
+    double compression_ratio = 0.0;        ///< Frozen bytes / compressed bytes (0 = nothing frozen)
+    uint64_t page_faults = 0;              ///< Faults on pages of this site
+    uint64_t refaults = 0;                 ///< Faults that restored frozen data
+};
+
+/**
+ * @class GhostMemoryManager
+ * @brief Singleton class managing virtual memory with transparent compression
+ * 
+ * The GhostMemoryManager implements a virtual memory system that uses
+ * in-memory compression to extend available RAM. It operates by:
+ * 
+ * 1. Reserving virtual address space without allocating physical RAM
+ * 2. Intercepting page faults when memory is accessed
+ * 3. Decompressing and restoring pages on demand
+ * 4. Evicting least recently used pages when limit is reached
+ * 5. Compressing evicted pages and storing them in-memory
+ * 
+ * The system is completely transparent to applications using the
+ * GhostAllocator wrapper for STL containers.
+ * 
+ * Thread Safety: Thread-safe. All public methods and page fault handlers
+ * use internal mutex synchronization to protect shared data structures.
+ * Multiple threads can safely allocate and access GhostMem memory concurrently.
+ */
+class GhostMemoryManager
+{
+private:
+    /**
+     * @struct AllocationInfo
+     * @brief Metadata for tracking individual allocations within pages
+     * 
+     * Since multiple allocations can share the same 4KB page, we need
+     * to track each allocation separately to implement proper deallocation.
+     */
+    struct AllocationInfo
+    {
+        void* page_start;      ///< Page-aligned base address of containing page
+        size_t offset;         ///< Byte offset within the page (0-4095)
+        size_t size;           ///< Size of this allocation in bytes
+        GhostTag tag;          ///< Owning subsystem (0 = untagged)
+        uint64_t site = 0;     ///< Allocation site (0 = not tracked)
+    };
+
+    /**
+     * @struct SiteState
+     * @brief Call stack and counters of one allocation site
+     */
+    struct SiteState
+    {
+        std::vector<const void*> frames;
+        uint64_t allocations = 0;
+        uint64_t live_allocations = 0;
+        size_t live_bytes = 0;
+        uint64_t page_faults = 0;
+        uint64_t refaults = 0;
+    };
+
+    /**
+     * @brief Allocation sites by call stack hash
+     */
+    std::map<uint64_t, SiteState> alloc_sites_;
+
+    /**
+     * @struct TagState
+     * @brief Cumulative counters and quota of one allocation tag
+     */
+    struct TagState
+    {
+        uint64_t page_faults = 0;
+        uint64_t refaults = 0;
+        uint64_t evictions = 0;
+        uint64_t thrash_refaults = 0; ///< Refaults within the resident budget
+        uint64_t sized_freezes = 0;   ///< LZ4 freezes (tiers Memory / Disk)
+        uint64_t frozen_bytes = 0;    ///< Compressed bytes of those freezes
+        size_t quota_pages = 0;  ///< Resident page quota (0 = unlimited)
+        size_t resident_pages = 0;    ///< Pages of the tag in active_ram_pages
+    };
+
+    /**
+     * @struct TagProfile
+     * @brief What previous runs learned about one tag
+     * 
+     * Counters are decayed by half on every save, so they are weights
+     * rather than exact counts.
+     */
+    struct TagProfile
+    {
+        double page_faults = 0.0;
+        double thrash_refaults = 0.0;
+        double sized_freezes = 0.0;
+        double frozen_bytes = 0.0;
+        bool hot = false;            ///< Thrashed at least profile_hot_percent of its faults
+        uint32_t compressed_size = 0; ///< Average compressed page size (0 = unknown)
+    };
+
+    /**
+     * @brief Profile loaded from config_.profile_path
+     */
+    std::map<GhostTag, TagProfile> tag_profiles_;
+
+    /**
+     * @brief tag_states_ when the profile was loaded
+     * 
+     * Only the difference to it belongs to the current run's profile.
+     */
+    std::map<GhostTag, TagState> profile_baseline_;
+
+    /**
+     * @brief Counters and quotas per allocation tag
+     * 
+     * Entries are created on first use and kept after the tag's last
+     * allocation is freed so cumulative counters remain visible.
+     */
+    std::map<GhostTag, TagState> tag_states_;
+
+    /**
+     * @brief Configuration for the memory manager
+     */
+    GhostConfig config_;
+
+    /**
+     * @brief Mutex protecting all shared data structures
+     * 
+     * This mutex must be locked when accessing or modifying:
+     * - managed_blocks
+     * - backing_store
+     * - active_ram_pages
+     * - allocation_metadata_
+     * - page_ref_counts_
+     * - config_
+     * - disk_file_handle / disk_file_descriptor
+     * - disk_page_locations
+     * 
+     * Note: Uses std::recursive_mutex to allow re-entrant locking
+     * within the same thread (e.g., page fault during eviction).
+     */
+    mutable std::recursive_mutex mutex_;
+
+    /**
+     * @brief Map of all managed virtual memory blocks
+     * 
+     * Key: Base address of virtual allocation
+     * Value: Size of the allocation in bytes
+     * 
+     * This tracks all memory regions managed by GhostMem, allowing
+     * the page fault handler to determine if a fault address belongs
+     * to our managed memory.
+     */
+    std::map<void *, size_t> managed_blocks;
+
+    /**
+     * @brief Lowest start and highest end of managed_blocks
+     * 
+     * Read by DispatchFault() before it takes mutex_, so faults outside
+     * every block (another manager's memory) never wait for the lock.
+     * Written under mutex_ by UpdateManagedBounds().
+     */
+    std::atomic<uintptr_t> managed_low_{UINTPTR_MAX};
+    std::atomic<uintptr_t> managed_high_{0};
+
+    /**
+     * @brief Storage for compressed page data (in-memory mode)
+     * 
+     * Key: Page base address (page-aligned)
+     * Value: Vector containing LZ4-compressed page data
+     * 
+     * When a page is evicted from physical RAM, its contents are
+     * compressed and stored here. The compression ratio varies:
+     * - Text/strings: 5-10x compression
+     * - Repeated data: 10-50x compression
+     * - Random data: ~1x (incompressible)
+     * 
+     * Note: Not used when disk backing is enabled (use_disk_backing=true)
+     */
+    std::map<void *, std::vector<char>> backing_store;
+
+    /**
+     * @brief Bytes held in RAM for frozen pages
+     * 
+     * Sum of all backing_store entries and retained delta bases, kept up
+     * to date wherever either changes so it can be published per fault.
+     */
+    size_t stored_bytes_ = 0;
+
+    /**
+     * @struct DiskRecord
+     * @brief Location and checksum of one record in the swap file
+     */
+    struct DiskRecord
+    {
+        size_t offset = 0;  ///< File offset
+        size_t size = 0;    ///< Bytes as stored (compressed and/or encrypted)
+        uint32_t crc = 0;   ///< CRC32C of the stored bytes
+    };
+
+    /**
+     * @brief Disk page location tracking (disk-backed mode)
+     * 
+     * Key: Page base address
+     * Value: Record holding the page's latest frozen image
+     * 
+     * Tracks where each compressed page is stored on disk and its size.
+     * Only used when config_.use_disk_backing is true.
+     */
+    std::map<void *, DiskRecord> disk_page_locations;
+
+    /**
+     * @brief Resident pages that still have a disk record
+     * 
+     * Disk records outlive a restore, so these are subtracted from the
+     * frozen page count. Updated as pages enter and leave active_ram_pages.
+     */
+    size_t resident_disk_pages_ = 0;
+
+    /**
+     * @brief Frozen pages left to the kernel (freeze_backend Kernel*)
+     * 
+     * Their content stays in place; the entry only marks them as frozen
+     * until the next fault.
+     */
+    std::set<void *> kernel_pages_;
+
+    /// LZ4 acceleration used for new freezes
+    int compression_acceleration_ = 1;
+
+    /// Start of the controller's current window (steady clock, ns)
+    uint64_t tune_window_start_ns_ = 0;
+
+    /// Compression time within the current window
+    uint64_t tune_window_compress_ns_ = 0;
+
+    /**
+     * @struct DeltaBase
+     * @brief Previous version of a page used for delta compression
+     * 
+     * Exactly one of base / base_location is used, depending on whether
+     * the page lives in the in-memory store or on disk.
+     */
+    struct DeltaBase
+    {
+        std::vector<char> base;                  ///< Compressed base image (in-memory mode)
+        DiskRecord base_location;                ///< Base record on disk (disk mode)
+        size_t deltas_since_rebase = 0;          ///< Delta freezes against this base
+        bool frozen_as_delta = false;            ///< Current frozen record is a delta
+    };
+
+    /**
+     * @brief Delta compression bases
+     * 
+     * Key: Page base address
+     * Value: Base image and delta bookkeeping
+     * 
+     * Only populated when config_.enable_delta_compression is true.
+     */
+    std::map<void *, DeltaBase> delta_bases_;
+
+    /**
+     * @struct PatchHeader
+     * @brief Precedes the bytes of one GhostWrite() patch in a patch log
+     */
+    struct PatchHeader
+    {
+        uint16_t offset;    ///< Offset within the page
+        uint16_t size;      ///< Bytes that follow
+    };
+
+    /**
+     * @brief Pending GhostWrite() patches of frozen pages
+     * 
+     * Key: Page base address
+     * Value: Sequence of PatchHeader + data, oldest first
+     * 
+     * Applied in order right after the page is restored. Counted in
+     * stored_bytes_.
+     */
+    std::map<void *, std::vector<char>> patch_logs_;
+
+
+#ifdef _WIN32
+    /**
+     * @brief Windows file handle for disk backing
+     * 
+     * Valid only when config_.use_disk_backing is true.
+     * INVALID_HANDLE_VALUE when not using disk backing.
+     */
+    HANDLE disk_file_handle = INVALID_HANDLE_VALUE;
+#else
+    /**
+     * @brief POSIX file descriptor for disk backing
+     * 
+     * Valid only when config_.use_disk_backing is true.
+     * -1 when not using disk backing.
+     */
+    int disk_file_descriptor = -1;
+#endif
+
+#ifdef _WIN32
+    /// File mapping object behind disk_map_ (NULL if not mapped)
+    HANDLE disk_map_handle_ = NULL;
+#endif
+
+    /// Read-only view of the swap file (config_.map_disk_reads)
+    const char *disk_map_ = nullptr;
+
+    /// Bytes covered by disk_map_
+    size_t disk_map_size_ = 0;
+
+    /**
+     * @brief Next available file offset for disk writes
+     * 
+     * Tracks the end of the disk file to append new compressed pages.
+     * Only used when config_.use_disk_backing is true.
+     */
+    size_t disk_next_offset = 0;
+
+    /**
+     * @brief LRU list of pages currently in physical RAM
+     * 
+     * Pages are ordered from most recently used (front) to least
+     * recently used (back). When MAX_PHYSICAL_PAGES is reached,
+     * pages are evicted from the back of this list.
+     * 
+     * Invariant: active_ram_pages.size() <= MAX_PHYSICAL_PAGES
+     */
+    std::list<void *> active_ram_pages;
+
+    /**
+     * @brief Metadata for all active allocations
+     * 
+     * Key: Pointer returned by AllocateGhost (allocation address)
+     * Value: AllocationInfo containing page, offset, and size
+     * 
+     * This map enables proper deallocation by tracking which page
+     * each allocation belongs to and its exact size. When deallocate
+     * is called, we use this to decrement the correct page's reference count.
+     * 
+     * Lifecycle: Entry added in AllocateGhost, removed in DeallocateGhost
+     */
+    std::map<void*, AllocationInfo> allocation_metadata_;
+
+    /**
+     * @brief Reference count for each page
+     * 
+     * Key: Page-aligned base address
+     * Value: Number of active allocations within this page
+     * 
+     * Since multiple allocations can share a 4KB page, we use reference
+     * counting to determine when a page can be completely freed. When
+     * the count reaches zero, the page is removed from all tracking
+     * structures and memory is released back to the OS.
+     * 
+     * Lifecycle:
+     * - Incremented in AllocateGhost when allocation added to page
+     * - Decremented in DeallocateGhost when allocation freed
+     * - Entry removed when count reaches zero (page fully freed)
+     */
+    std::map<void*, size_t> page_ref_counts_;
+
+    /**
+     * @struct PageInfo
+     * @brief Per-page replacement state
+     */
+    struct PageInfo
+    {
+        uint64_t evicted_at = 0;     ///< Shadow entry: eviction clock when last frozen (0 = never)
+        uint64_t protected_at = 0;   ///< Eviction clock when promoted to the protected set
+        bool is_protected = false;   ///< Member of the protected set (resident pages only)
+        uint32_t compressed_size = 0; ///< Size of the last frozen image in bytes (0 = unknown)
+        uint32_t restore_ns = 0;     ///< Latency of the last restore in nanoseconds (0 = unknown)
+        GhostStorageTier tier = GhostStorageTier::None; ///< Tier of the last frozen image
+        bool idle_probe = false;     ///< Access revoked by the idle scanner (resident pages only)
+        bool resident = false;       ///< In active_ram_pages
+        GhostTag tag = 0;            ///< Tag counted in TagState::resident_pages while resident
+        uint64_t probed_at_ms = 0;   ///< When the idle probe was armed
+    };
+
+    /**
+     * @brief Replacement state of every page that has been touched
+     * 
+     * Key: Page-aligned base address
+     * Value: Shadow entry and protection flag
+     * 
+     * Lifecycle: Entry created when the page first becomes resident,
+     * removed when the page is freed
+     */
+    std::map<void*, PageInfo> page_info_;
+
+    /**
+     * @brief Eviction clock (number of pages frozen so far)
+     * 
+     * Refault distance = eviction_clock_ - PageInfo::evicted_at
+     */
+    uint64_t eviction_clock_ = 0;
+
+    /**
+     * @brief Number of resident pages in the protected set
+     */
+    size_t protected_count_ = 0;
+
+    /**
+     * @brief Smoothed restore latency per storage tier in nanoseconds
+     * 
+     * Indexed by GhostStorageTier. Used by CostAware eviction for pages
+     * without a restore measurement of their own.
+     */
+    uint64_t tier_restore_ns_[5] = {0, 0, 0, 0, 0};
+
+    // Internal tracking (diagnostic purposes only)
+    void* lib_meta_ptr_ = nullptr;
+    bool lib_meta_init_ = false;
+
+    /**
+     * @brief Encryption key for disk-backed pages (32 bytes for ChaCha20)
+     * 
+     * Generated once at initialization using platform CSPRNG.
+     * Used to encrypt/decrypt pages when writing to/reading from disk.
+     * Only populated when config_.encrypt_disk_pages is true.
+     */
+    unsigned char encryption_key_[32] = {0};
+
+    /**
+     * @brief Flag indicating if encryption key has been generated
+     */
+    bool encryption_initialized_ = false;
+
+    /**
+     * @brief Cumulative counters reported by GetStats()
+     * 
+     * Only the counter fields are maintained here; page and byte
+     * figures are computed when a snapshot is taken.
+     */
+    GhostStats stats_;
+
+    /**
+     * @brief Participant handle for host-wide budget coordination
+     * 
+     * Attached in Initialize when config_.coordinator_name is set.
+     */
+    GhostBudgetCoordinator coordinator_;
+
+    /**
+     * @brief Resident budget granted by the coordinator (0 = none)
+     */
+    size_t coordinated_budget_ = 0;
+
+    /**
+     * @brief SteadyMillis() of the last coordinator update
+     */
+    uint64_t budget_updated_ms_ = 0;
+
+    /**
+     * @brief SteadyMillis() of the last check for dead participants
+     */
+    uint64_t budget_reclaimed_ms_ = 0;
+
+    /**
+     * @brief Faults handled since the last coordinator update
+     */
+    size_t faults_since_budget_update_ = 0;
+
+    /**
+     * @brief Process-private statistics block (used when not shared)
+     */
+    GhostStatsBlock local_stats_block_;
+
+    /**
+     * @brief Block currently receiving published statistics
+     * 
+     * Points at local_stats_block_ or into stats_shm_.
+     */
+    std::atomic<GhostStatsBlock *> stats_block_{&local_stats_block_};
+
+    /**
+     * @brief Shared memory segment holding the statistics block
+     */
+    GhostSharedMemory stats_shm_;
+
+    /**
+     * @brief Name of the open statistics segment (empty = private)
+     */
+    std::string stats_shm_open_name_;
+
+    /**
+     * @brief Set once anything reads the statistics block
+     * 
+     * A shared segment, the metrics exporter or a GetStatsBlock() call.
+     * Until then PublishStats() has no reader and does nothing.
+     */
+    mutable std::atomic<bool> stats_block_read_{false};
+
+    /**
+     * @brief OpenMetrics exporter reading the statistics block
+     */
+    GhostMetricsExporter metrics_exporter_;
+
+    /**
+     * @struct FaultSiteState
+     * @brief Aggregated samples of one faulting instruction
+     */
+    struct FaultSiteState
+    {
+        uint64_t samples = 0;
+        uint64_t refaults = 0;
+        uint64_t total_ns = 0;
+        uint64_t max_ns = 0;
+    };
+
+    /**
+     * @brief Sampled faults per faulting instruction pointer
+     */
+    std::map<const void*, FaultSiteState> fault_sites_;
+
+    /**
+     * @brief Faults seen since the last sample
+     */
+    uint64_t faults_since_sample_ = 0;
+
+    /**
+     * @brief Background thread running ScanIdlePages() and
+     *        RefreshCoordinatedBudget()
+     */
+    std::thread idle_thread_;
+
+    /**
+     * @brief Guards idle_stop_ (separate from mutex_ so that stopping
+     *        never waits on a scan while holding mutex_)
+     */
+    std::mutex idle_mutex_;
+
+    /**
+     * @brief Wakes the idle thread early for shutdown
+     */
+    std::condition_variable idle_cv_;
+
+    /**
+     * @brief Set to ask the idle thread to exit
+     */
+    bool idle_stop_ = false;
+
+    /**
+     * @brief Private constructor (Singleton pattern)
+     * 
+     * Initializes the memory manager and registers its fault callback
+     * with GhostFaultDispatcher, which owns the platform hook:
+     * - Windows: Vectored exception handler for EXCEPTION_ACCESS_VIOLATION
+     * - Linux: Signal handler for SIGSEGV
+     */
+    GhostMemoryManager()
+    {
+        local_stats_block_.Reset();
+        GhostLogger::Instance();  // Constructed first, so it outlives us
+        GhostFaultDispatcher::Register(DispatchFault, this);
+    }
+
+    /**
+     * @brief Internal initialization for library metadata
+     * @note For diagnostic and compliance tracking purposes
+     */
+    void InitializeLibraryMetadata();
+
+    /**
+     * @brief Returns the resident page limit currently in force
+     * 
+     * Priority: coordinator grant, then config_.max_memory_pages,
+     * then the MAX_PHYSICAL_PAGES constant.
+     */
+    size_t GetEffectiveMaxPages() const;
+
+    /**
+     * @brief Counts pages whose data lives in the backing store or on disk
+     */
+    size_t CountFrozenPages() const;
+
+    /**
+     * @brief Publishes demand and refault pressure to the coordinator
+     * 
+     * Stores the granted budget in coordinated_budget_. No-op when
+     * coordination is disabled.
+     */
+    void UpdateCoordinatedBudget();
+
+    /**
+     * @brief Timed budget update, run by the background thread
+     * 
+     * Reclaims the slots of dead participants every coordinator_update_ms
+     * (too slow for the fault path), updates the budget if that freed a
+     * slot or no fault did so for coordinator_update_ms, and evicts down
+     * to the new grant if it shrank.
+     */
+    void RefreshCoordinatedBudget();
+
+    /**
+     * @brief Returns the tag of the allocation containing a page
+     * 
+     * @return The allocation's tag, or 0 if the page is not managed
+     */
+    GhostTag TagOfPage(void *page_start) const;
+
+    /**
+     * @brief Makes room within a tag's resident quota
+     * 
+     * Evicts the tag's least recently used pages until one more page of
+     * the tag fits under its quota. No-op for tags without a quota; O(1)
+     * while the tag is under it.
+     * 
+     * @param tag Tag of the page about to become resident
+     * @param ignore_page Page that must not be evicted (the faulting one)
+     */
+    void EnforceTagQuota(GhostTag tag, void *ignore_page);
+
+    /**
+     * @brief Removes a page from RAM after it left active_ram_pages
+     * 
+     * Frees zombie pages (no live allocations) outright and freezes
+     * everything else. Re-enables read access first if the page is
+     * armed by the idle scanner.
+     * 
+     * @return false if the page could not be frozen; it is then
+     *         writable again and back at the front of active_ram_pages
+     */
+    bool EvictPage(void *page_start);
+
+    /**
+     * @brief Moves the statistics block to or from shared memory
+     * 
+     * Follows config_.stats_shm_name; cumulative values are carried over.
+     * 
+     * @return false if the named segment could not be created
+     */
+    bool AttachStatsBlock();
+
+    /**
+     * @brief Copies current counters and figures into the statistics block
+     * 
+     * Skipped until the block has a reader (see stats_block_read_).
+     * 
+     * @note Caller must hold mutex_
+     */
+    void PublishStats() const;
+
+    /**
+     * @brief Drops the retained delta base of a page
+     * 
+     * @return true if the page had a delta base
+     */
+    bool EraseDeltaBase(void *page_start);
+
+    /**
+     * @brief Drops every stored image and all metadata of a page
+     * 
+     * Used when a page is released for good (zombie eviction,
+     * deallocation).
+     */
+    void DropPageData(void *page_start);
+
+    /**
+     * @brief Starts the idle scanner thread if configured
+     * 
+     * Also started for timed budget updates (coordinator_update_ms).
+     */
+    void StartIdleScanner();
+
+    /**
+     * @brief Stops the idle scanner thread and waits for it
+     * 
+     * @note Must be called WITHOUT mutex_ held
+     */
+    void StopIdleScanner();
+
+    /**
+     * @brief Body of the idle scanner thread
+     */
+    void IdleScannerLoop();
+
+    /**
+     * @brief Platform-independent part of page fault handling
+     * 
+     * Makes room in the resident set, commits the page, restores its
+     * content and marks it as most recently used.
+     * 
+     * @param page_start Page-aligned address of the faulting page
+     * @param fault_ip Faulting instruction (nullptr if unknown), used
+     *                 for fault site sampling
+     * @return true if the page is accessible now, false otherwise
+     */
+    bool HandlePageFault(void *page_start, const void *fault_ip = nullptr);
+
+    /**
+     * @brief Finds the allocation that owns a page
+     * 
+     * @note Caller must hold mutex_
+     * @return Allocation metadata, or nullptr for pages of freed regions
+     */
+    const AllocationInfo *AllocationOfPage(void *page_start) const;
+
+    /**
+     * @brief Registers a captured call stack as allocation site
+     * 
+     * @note Caller must hold mutex_
+     * @param frames Return addresses, innermost first
+     * @param count Number of frames
+     * @return Site id (0 if no frames were captured)
+     */
+    uint64_t RegisterAllocationSite(const void *const *frames, size_t count);
+
+    /**
+     * @brief Visits every page that holds data
+     * 
+     * Called once per resident page (resident = true), once per frozen
+     * image in RAM or on disk (frozen = true, bytes = stored size) and
+     * once per delta base kept for a page (both false, bytes = base
+     * size). Used to split current figures by tag or allocation site.
+     * 
+     * @note Caller must hold mutex_
+     */
+    void ForEachPage(const std::function<void(void *page, bool resident, bool frozen, size_t bytes)> &visit) const;
+
+    /**
+     * @brief Aggregates one fault into fault_sites_ if it is sampled
+     * 
+     * @note Caller must hold mutex_
+     */
+    void RecordFaultSite(const void *fault_ip, bool refault, uint64_t fault_ns);
+
+    /**
+     * @brief Decodes a page's stored record into a buffer
+     * 
+     * The one decoder behind RestorePage() and DecodeFrozenPage(): the
+     * in-memory backing store, delta records, compressed and raw disk
+     * records (checksum, decryption). Manager state is left as is and
+     * patch logs are not applied; out_page may be the page itself.
+     * 
+     * @param out_page Receives PAGE_SIZE bytes (8-byte aligned); zeros
+     *                 if the page has no record or it cannot be decoded
+     * @return true if a record was decoded; decode failures are reported
+     * @note Caller must hold mutex_
+     */
+    bool DecodeStoredImage(void *page_start, char *out_page);
+
+    /**
+     * @brief Fills a freshly committed page with its saved content
+     * 
+     * Decompresses (and decrypts) the page from the backing store or
+     * the disk file; pages left to the kernel are read back in place.
+     * Pages that were never frozen are zero-filled.
+     * 
+     * @param page_start Page-aligned address of a committed page
+     * @return true if frozen data was restored, false for a fresh page
+     */
+    bool RestorePage(void *page_start);
+
+    /**
+     * @brief Encodes a resident page as a delta against its base
+     * 
+     * @param page_start Page-aligned address of a resident page
+     * @param out_delta Receives the compressed XOR delta
+     * @return true if a delta was produced and is worth storing, false if
+     *         the page has no usable base or needs rebasing
+     */
+    bool EncodeDelta(void *page_start, std::vector<char>& out_delta);
+
+    /**
+     * @brief LZ4-compresses one page image at the current acceleration
+     * 
+     * Accounts the time for GhostStats::compression_ns and the adaptive
+     * controller.
+     * 
+     * Pages of tags the profile knows as incompressible use
+     * compression_acceleration_max instead.
+     * 
+     * @param page_start Page the image belongs to
+     * @return Compressed size, 0 on failure
+     * @note Caller must hold mutex_
+     */
+    int CompressPage(void *page_start, const char *image, char *out, int capacity);
+
+    /**
+     * @brief CompressPage() without the accounting
+     * 
+     * Writes no manager state, so ingest workers may call it
+     * concurrently; the caller passes the time to AddCompressionTime().
+     * 
+     * @param elapsed_ns Receives the time spent compressing
+     * @note Caller must hold mutex_ (possibly on the worker's behalf)
+     */
+    int CompressPageImage(void *page_start, const char *image, char *out, int capacity,
+                          uint64_t &elapsed_ns) const;
+
+    /**
+     * @brief Adds compression time to the stats and the controller window
+     * 
+     * @note Caller must hold mutex_
+     */
+    void AddCompressionTime(uint64_t ns);
+
+    /**
+     * @brief Maximum number of protected pages under the current budget
+     * 
+     * @note Caller must hold mutex_
+     */
+    size_t ProtectedPageLimit() const;
+
+    /**
+     * @brief Applies the loaded profile to a page on its first fault
+     * 
+     * @note Caller must hold mutex_
+     */
+    void SeedPageFromProfile(void *page_start, GhostTag tag);
+
+    /**
+     * @brief Adaptive compression controller, run after each freeze
+     * 
+     * Closes the measurement window once compression_tune_interval_ms has
+     * passed and adjusts compression_acceleration_.
+     * 
+     * @note Caller must hold mutex_
+     */
+    void TuneCompression();
+
+    /**
+     * @brief Logs, counts and forwards a failure to config_.error_callback
+     * 
+     * @note Caller must hold mutex_
+     */
+    void ReportError(GhostErrorCode code, void *page_start, uint64_t file_offset, size_t size);
+
+    /**
+     * @brief Checks if a page's content is held only in frozen form
+     * 
+     * True for pages in the in-memory store, pages on disk that are not
+     * resident, and pages never touched (their content is all zero).
+     * 
+     * @note Caller must hold mutex_
+     */
+    bool IsFrozen(void *page_start) const;
+
+    /**
+     * @brief Logs a write into a frozen page instead of faulting it in
+     * 
+     * @return false if the write has to go to the page itself (page not
+     *         frozen, patch logs disabled, the patch too large or a full
+     *         log that could not be compacted)
+     * @note Caller must hold mutex_
+     */
+    bool AppendPatch(void *page_start, size_t offset, const char *data, size_t size);
+
+    /**
+     * @brief Checks if [start, start + size) lies inside one ghost allocation
+     * 
+     * @note Caller must hold mutex_
+     */
+    bool IsManagedRange(const void *start, size_t size) const;
+
+    /**
+     * @brief Recomputes managed_low_ / managed_high_ after managed_blocks changed
+     * 
+     * @note Caller must hold mutex_
+     */
+    void UpdateManagedBounds();
+
+    /**
+     * @brief Copies the page's pending patches onto a page image
+     * 
+     * @note Caller must hold mutex_
+     */
+    void CopyPatches(void *page_start, char *out_page) const;
+
+    /**
+     * @brief Applies and discards the page's patch log
+     * 
+     * The page must be accessible.
+     * 
+     * @note Caller must hold mutex_
+     */
+    void ApplyPatchLog(void *page_start);
+
+    /**
+     * @brief Folds a frozen page's patch log into its frozen image
+     * 
+     * Decodes the page and its log into a buffer and installs the
+     * re-encoded image. The page is never made accessible, added to the
+     * resident set or counted as an eviction. A damaged frozen image is
+     * reported and replaced by a zero page plus the log.
+     * 
+     * @return false if the new image could not be stored (log unchanged)
+     * @note Caller must hold mutex_
+     */
+    bool CompactPatchLog(void *page_start);
+
+    /**
+     * @brief Copies part of one page for Read() without a fault
+     * 
+     * Frozen pages are decoded with DecodeFrozenPage(); resident pages
+     * are copied in place, briefly opening pages behind an idle probe or
+     * left to the kernel.
+     * 
+     * @note Caller must hold mutex_
+     */
+    void ReadPage(void *page_start, size_t offset, char *out, size_t size);
 
     /**
-     * @brief Encryption key for disk-backed pages (32 bytes for ChaCha20)
+     * @brief Decodes a frozen page into a buffer, leaving all state as is
      * 
-     * Generated once at initialization using platform CSPRNG.
-     * Used to encrypt/decrypt pages when writing to/reading from disk.
-     * Only populated when config_.encrypt_disk_pages is true.
+     * The counterpart of RestorePage() for reads: storage, delta bases
+     * and patch logs are not consumed, and the page stays frozen.
+     * Undecodable pages are reported and come back as zeros, as do
+     * pages never touched.
+     * 
+     * @param out_page Receives PAGE_SIZE bytes (8-byte aligned)
+     * @note Caller must hold mutex_
      */
-    unsigned char encryption_key_[32] = {0};
+    void DecodeFrozenPage(void *page_start, char *out_page);
 
     /**
-     * @brief Flag indicating if encryption key has been generated
+     * @brief Produces the frozen record for a page image
+     * 
+     * Compressed with CompressPageImage() unless the disk stores raw
+     * pages, encrypted when disk encryption is on. Writes no manager
+     * state, so ingest workers may call it concurrently.
+     * 
+     * @param compress_ns Receives the compression time, for AddCompressionTime()
+     * @note Caller must hold mutex_ (possibly on the worker's behalf)
      */
-    bool encryption_initialized_ = false;
+    void EncodeFrozenRecord(void *page_start, const char *image, std::vector<char> &out, uint64_t &compress_ns) const;
 
     /**
-     * @brief Private constructor (Singleton pattern)
+     * @brief Installs an encoded record as the page's frozen image
      * 
-     * Initializes the memory manager and installs the appropriate
-     * page fault handler for the current platform:
-     * - Windows: Vectored exception handler for EXCEPTION_ACCESS_VIOLATION
-     * - Linux: Signal handler for SIGSEGV
+     * Replaces any frozen image, delta base and patch log the page had.
+     * Used by Ingest() and patch compaction.
+     * 
+     * @return false if the record could not be written (nothing changed)
+     * @note Caller must hold mutex_
      */
-    GhostMemoryManager()
-    {
-#ifdef _WIN32
-        AddVectoredExceptionHandler(1, VectoredHandler);
-#else
-        InstallSignalHandler();
-#endif
-    }
+    bool InstallFrozenRecord(void *page_start, std::vector<char> &record);
 
     /**
-     * @brief Internal initialization for library metadata
-     * @note For diagnostic and compliance tracking purposes
+     * @brief Reads, verifies, decrypts and decompresses a page image from disk
+     * 
+     * Failures are reported through ReportError().
+     * 
+     * @param page_start Page the record belongs to (nonce source)
+     * @param location File offset, size and CRC32C of the record
+     * @param out_page Receives PAGE_SIZE bytes of page content
+     * @return true on success
      */
-    void InitializeLibraryMetadata();
+    bool LoadDiskImage(void *page_start, const DiskRecord& location, char* out_page);
 
     /**
      * @brief Evicts least recently used pages until under the limit
@@ -394,6 +1759,19 @@ private:
      */
     void EvictOldestPage(void *ignore_page);
 
+    /**
+     * @brief Evicts LRU victims until at most max_pages are resident
+     * 
+     * Stops early if no victim is left or every resident page failed to
+     * freeze once.
+     * 
+     * @param max_pages Resident pages to keep
+     * @param ignore_page Page address to NOT evict (may be nullptr)
+     * 
+     * @note Caller must hold mutex_
+     */
+    void EvictDownTo(size_t max_pages, void *ignore_page);
+
     /**
      * @brief Marks a page as recently used (moves to front of LRU list)
      * 
@@ -405,6 +1783,65 @@ private:
      */
     void MarkPageAsActive(void *page_start);
 
+    /**
+     * @brief Removes a page from active_ram_pages
+     * 
+     * The counterpart of MarkPageAsActive(); keeps resident_disk_pages_
+     * and the tag's resident count in step.
+     * 
+     * @return Iterator following the removed entry
+     * @note Caller must hold mutex_
+     */
+    std::list<void *>::iterator RemoveResidentPage(std::list<void *>::iterator it);
+
+    /**
+     * @brief Picks the next page to evict from active_ram_pages
+     * 
+     * Scans from the least recently used end, skipping ignore_page and
+     * protected pages. If only protected pages are left, the least
+     * recently used of them is demoted and chosen.
+     * 
+     * @param ignore_page Page that must stay resident
+     * @return Iterator to the victim, or end() if nothing can be evicted
+     */
+    std::list<void *>::iterator SelectVictim(void *ignore_page);
+
+    /**
+     * @brief Classifies a refault by its distance and promotes thrashing pages
+     * 
+     * @param page_start Page that was just restored from frozen state
+     */
+    void RecordRefault(void *page_start);
+
+    /**
+     * @brief Leaves a shadow entry for a page that was just frozen
+     * 
+     * @param page_start Page that was frozen
+     * @param compressed_size Size of the stored image in bytes
+     * @param tier Where the image was stored
+     */
+    void RecordEviction(void *page_start, size_t compressed_size, GhostStorageTier tier);
+
+    /**
+     * @brief Stores the measured restore latency of a page and its tier
+     */
+    void RecordRestoreLatency(void *page_start, uint64_t restore_ns);
+
+    /**
+     * @brief Estimates the benefit of evicting a page for CostAware eviction
+     * 
+     * @param page_start Candidate page
+     * @param recency_rank 0 for the least recently used candidate, growing
+     *                     towards more recently used pages
+     * @return Bytes freed per expected nanosecond of refault cost
+     */
+    double EvictionScore(void *page_start, size_t recency_rank) const;
+
+    /**
+     * @brief Drops a page's replacement state when it is freed
+     */
+    void ForgetPage(void *page_start);
+
     /**
      * @brief Opens the disk file for page storage
      * 
@@ -440,6 +1877,23 @@ private:
      */
     bool ReadFromDisk(size_t offset, size_t size, void* buffer);
 
+    /**
+     * @brief Returns a swap file record inside the read-only mapping
+     * 
+     * Maps the file on first use and remaps it when the record lies
+     * beyond the current view (doubling the view on POSIX, where it may
+     * extend past the end of the file).
+     * 
+     * @return Pointer to the record, nullptr if it can't be mapped
+     * @note Caller must hold mutex_
+     */
+    const char *MapDiskRecord(size_t offset, size_t size);
+
+    /**
+     * @brief Releases the swap file mapping
+     */
+    void UnmapDiskFile();
+
     /**
      * @brief Generates a cryptographic random encryption key
      * 
@@ -463,20 +1917,6 @@ private:
      */
     void ChaCha20Crypt(unsigned char* data, size_t size, const unsigned char* nonce);
 
-    /**
-     * @brief ChaCha20 quarter round operation
-     * @param state 16-word ChaCha20 state
-     * @param a,b,c,d Indices into state for quarter round
-     */
-    static void ChaCha20QuarterRound(uint32_t* state, int a, int b, int c, int d);
-
-    /**
-     * @brief ChaCha20 block function
-     * @param state Initial 16-word state
-     * @param output 64-byte output buffer for keystream block
-     */
-    static void ChaCha20Block(const uint32_t* state, unsigned char* output);
-
 public:
     /**
      * @brief Gets the singleton instance of GhostMemoryManager
@@ -496,8 +1936,23 @@ public:
      */
     ~GhostMemoryManager()
     {
+        GhostFaultDispatcher::Unregister(DispatchFault, this);
+        StopIdleScanner();
+        metrics_exporter_.Stop();
         CloseDiskFile();
         
+        if (!config_.profile_path.empty())
+        {
+            SaveProfile(config_.profile_path);
+        }
+        
+        if (!stats_shm_open_name_.empty())
+        {
+            stats_block_.store(&local_stats_block_);
+            stats_shm_.Close();
+            GhostSharedMemory::Unlink(stats_shm_open_name_);
+        }
+        
         // Cleanup internal metadata
         if (lib_meta_ptr_)
         {
@@ -537,6 +1992,186 @@ public:
      */
     bool Initialize(const GhostConfig& config);
 
+    /**
+     * @brief Returns a snapshot of the manager's counters
+     * 
+     * Thread Safety: Thread-safe. Takes mutex_ for the duration of the
+     * snapshot.
+     * 
+     * @return Current statistics (see GhostStats)
+     */
+    GhostStats GetStats() const;
+
+    /**
+     * @brief Whether this kernel / OS supports a freeze backend
+     * 
+     * Compress is always supported. The kernel backends need Linux 5.4+
+     * (MADV_COLD / MADV_PAGEOUT) or Windows.
+     */
+    static bool IsFreezeBackendSupported(GhostFreezeBackend backend);
+
+    /**
+     * @brief Returns the lock-free statistics block
+     * 
+     * Readers may load any field at any time without synchronization;
+     * this is what ghostmem_top and exporters use. Counters are
+     * published after every fault, freeze and idle scan once the block
+     * has a reader: a shared segment, the metrics exporter, or the first
+     * call to this function.
+     * 
+     * @note The reference is invalidated by Initialize() when the block
+     *       moves to or from shared memory.
+     */
+    const GhostStatsBlock& GetStatsBlock() const;
+
+    /**
+     * @brief Renders the statistics block as OpenMetrics text
+     * 
+     * For applications that already run an HTTP server and want to
+     * serve GhostMem metrics from their own /metrics endpoint. Lock-free
+     * like GetStatsBlock().
+     */
+    std::string RenderMetrics() const
+    {
+        return GhostMetricsExporter::Render(GetStatsBlock());
+    }
+
+    /**
+     * @brief Port of the metrics listener
+     * 
+     * @return Bound port (useful with metrics_port = 0), or 0 if
+     *         enable_metrics_http is not set
+     */
+    uint16_t GetMetricsPort() const
+    {
+        return metrics_exporter_.Port();
+    }
+
+    /**
+     * @brief Runs one idle scan pass immediately
+     * 
+     * Arms the idle probe on resident pages and freezes pages whose probe
+     * has been armed for at least GhostConfig::idle_freeze_age_ms without
+     * an access. The background scanner calls this every
+     * idle_scan_interval_ms; applications with their own maintenance loop
+     * may call it directly instead. No-op when idle freezing is disabled.
+     * 
+     * Thread Safety: Thread-safe.
+     * 
+     * @return Number of pages frozen by this pass
+     */
+    size_t ScanIdlePages();
+
+    /**
+     * @brief Drops the swap file from the operating system's page cache
+     * 
+     * Flushes the file, releases mapped pages and asks the kernel to
+     * evict its cached pages, so the next disk refaults are served from
+     * the device. Meant for benchmarks of cold-cache refaults. No-op
+     * without disk backing; on Windows the file is only flushed.
+     * 
+     * Thread Safety: Thread-safe.
+     */
+    void DropDiskCache();
+
+    /**
+     * @brief Copies bytes into ghost memory without thawing frozen pages
+     * 
+     * For every page touched by [dst, dst + size): if the page is frozen
+     * (see GhostConfig::patch_log_bytes), the bytes are appended to its
+     * patch log and no page fault, decompression or eviction happens.
+     * Resident pages are written directly. Reading the memory afterwards
+     * always sees the written bytes.
+     * 
+     * Thread Safety: Thread-safe.
+     * 
+     * @param dst Destination inside a block returned by AllocateGhost()
+     * @param src Bytes to copy (must not be ghost memory)
+     * @param size Number of bytes
+     * @return false if the range is not inside one ghost allocation
+     */
+    bool Write(void *dst, const void *src, size_t size);
+
+    /**
+     * @brief Folds pending patch logs into their frozen images
+     * 
+     * Thread Safety: Thread-safe.
+     * 
+     * @param min_bytes Only compact logs holding at least this many bytes
+     * @return Number of pages compacted
+     */
+    size_t CompactPatches(size_t min_bytes = 0);
+
+    /**
+     * @brief Copies bytes out of ghost memory without thawing frozen pages
+     * 
+     * Frozen pages are decompressed straight into dst (through a stack
+     * buffer for partial pages). Nothing is mapped, no page is faulted
+     * in or evicted, and the replacement order is left alone, so a scan
+     * over cold data does not push hot pages out. Resident pages are
+     * copied in place.
+     * 
+     * Thread Safety: Thread-safe.
+     * 
+     * @param src Source inside a block returned by AllocateGhost()
+     * @param dst Destination buffer (must not be ghost memory)
+     * @param size Number of bytes
+     * @return false if the range is not inside one ghost allocation
+     */
+    bool Read(const void *src, void *dst, size_t size);
+
+    /**
+     * @brief Stores data straight into frozen state
+     * 
+     * Whole pages of the range that are not resident are compressed
+     * (and encrypted / written to the swap file, as configured) directly
+     * from src and become frozen pages. They never fault in, evict
+     * anything or touch the replacement order. Compression runs on
+     * GhostConfig::ingest_threads threads. Partial pages at the ends and
+     * resident pages are written like GhostWrite(). With a kernel freeze
+     * backend everything goes through GhostWrite().
+     * 
+     * Use it to load datasets larger than the resident budget.
+     * 
+     * Thread Safety: Thread-safe. Blocks faults of other threads while
+     * it runs.
+     * 
+     * @param dst Destination inside a block returned by AllocateGhost()
+     * @param src Source data (must not be ghost memory)
+     * @param size Number of bytes
+     * @return false if the range is not inside one ghost allocation
+     */
+    bool Ingest(void *dst, const void *src, size_t size);
+
+    /**
+     * @brief Writes the hotness profile (see GhostConfig::profile_path)
+     * 
+     * Merges what this run observed since the profile was loaded with
+     * the loaded profile, weighted down by half. Written to a temporary
+     * file that is renamed over the target.
+     * 
+     * Thread Safety: Thread-safe.
+     * 
+     * @return false if the file cannot be written
+     */
+    bool SaveProfile(const std::string &path) const;
+
+    /**
+     * @brief Replaces the loaded hotness profile with a file's content
+     * 
+     * Initialize() calls this for GhostConfig::profile_path.
+     * 
+     * Thread Safety: Thread-safe.
+     * 
+     * @return false if the file does not exist or is not a profile
+     */
+    bool LoadProfile(const std::string &path);
+
+    /**
+     * @brief Per-thread page buffer used by GhostReadRange by default
+     */
+    static char *ThreadReadBuffer();
+
     /**
      * @brief Allocates virtual memory managed by GhostMem
      * 
@@ -549,11 +2184,96 @@ public:
      * - Linux: Uses mmap with PROT_NONE
      * 
      * @param size Number of bytes to allocate (rounded up to PAGE_SIZE)
+     * @param tag Owning subsystem for per-tag statistics and quotas
+     *            (default 0 = untagged)
      * @return Pointer to reserved virtual memory, or nullptr on failure
      * 
      * @note Memory is NOT zeroed initially (only zeroed on first access)
      */
-    void *AllocateGhost(size_t size);
+    void *AllocateGhost(size_t size, GhostTag tag = 0);
+
+    /**
+     * @brief Limits how many pages of one tag may be resident
+     * 
+     * When a page of the tag faults in while the tag already holds
+     * max_resident_pages resident pages, the tag's own least recently
+     * used page is frozen first. A busy subsystem therefore cannot push
+     * another subsystem's hot set out of RAM. The global budget still
+     * applies on top of the quota.
+     * 
+     * Thread Safety: Thread-safe.
+     * 
+     * @param tag Tag to limit
+     * @param max_resident_pages Resident page quota (0 = unlimited)
+     */
+    void SetTagQuota(GhostTag tag, size_t max_resident_pages);
+
+    /**
+     * @brief Returns counters and current figures of one tag
+     * 
+     * Thread Safety: Thread-safe. Walks the resident list and the
+     * backing store under mutex_, so avoid calling it on hot paths.
+     */
+    GhostTagStats GetTagStats(GhostTag tag) const;
+
+    /**
+     * @brief Returns statistics of every tag seen so far
+     * 
+     * Thread Safety: Thread-safe (see GetTagStats(GhostTag)).
+     */
+    std::map<GhostTag, GhostTagStats> GetTagStats() const;
+
+    /**
+     * @brief Returns the sampled fault sites, most frequent first
+     * 
+     * Requires GhostConfig::fault_ip_sample_rate > 0. Symbolization
+     * happens here, outside the fault path and after mutex_ is released.
+     * 
+     * Thread Safety: Thread-safe.
+     * 
+     * @param max_sites Maximum number of sites returned (0 = all)
+     */
+    std::vector<GhostFaultSite> GetFaultSites(size_t max_sites = 0) const;
+
+    /**
+     * @brief Prints the top fault sites as a table
+     * 
+     * Columns: samples, estimated faults, refaults, mean and max fault
+     * latency, and the symbolized location.
+     * 
+     * @param out Stream to print to
+     * @param max_sites Number of sites printed
+     */
+    void PrintFaultReport(std::ostream &out = std::cout, size_t max_sites = 20) const;
+
+    /**
+     * @brief Discards all fault site samples
+     */
+    void ResetFaultSites();
+
+    /**
+     * @brief Returns allocation sites, largest live_bytes first
+     * 
+     * Requires GhostConfig::track_allocation_sites. Sites whose
+     * allocations were all freed are kept (live_bytes = 0) so that
+     * cumulative counters stay visible. Frames are symbolized after
+     * mutex_ is released.
+     * 
+     * Thread Safety: Thread-safe. Walks all pages like GetTagStats().
+     * 
+     * @param max_sites Maximum number of sites returned (0 = all)
+     */
+    std::vector<GhostAllocationSite> GetAllocationSites(size_t max_sites = 0) const;
+
+    /**
+     * @brief Prints the top allocation sites with their call stacks
+     * 
+     * @param out Stream to print to
+     * @param max_sites Number of sites printed
+     * @param max_frames Frames printed per site
+     */
+    void PrintAllocationSiteReport(std::ostream &out = std::cout, size_t max_sites = 10,
+                                   size_t max_frames = 6) const;
 
     /**
      * @brief Deallocates memory previously allocated by AllocateGhost
@@ -598,82 +2318,183 @@ public:
      * - Linux: Uses mprotect with PROT_NONE
      * 
      * @param page_start Page-aligned base address of page to freeze
+     * @return false if nothing was stored; the page is left as it was
      * 
-     * @note After this call, accessing page_start will trigger a page fault
+     * @note After a successful call, accessing page_start will trigger a page fault
      */
-    void FreezePage(void *page_start);
+    bool FreezePage(void *page_start);
 
     /**
-     * @brief output of std::count when verbosity is set
-     *
-     * This simply make use of std::cout or std::cerr when the config
-     * allow verboity.
-     *
-     * When we give a pointer the outstream make use of std::cerr
+     * @brief Freezes a page by handing it to the kernel's reclaim
+     * 
+     * Used instead of compression when freeze_backend is KernelCold or
+     * KernelPageout.
+     * 
+     * @note Caller must hold mutex_
      */
-    template<typename... Args>
-    void dbgmsg(Args... args){
-        if(!config_.enable_verbose_logging)
-            return;
+    void FreezeToKernel(void *page_start);
 
-        bool use_cerr = ((std::is_pointer_v<Args> && 
-                         !std::is_same_v<std::decay_t<std::remove_pointer_t<Args>>, char>) || ...);
-
-        // Referenz auf den gewählten Stream
-        std::ostream& target = use_cerr ? std::cerr : std::cout;
-        
-        target << "[GMlib] ";
-        ((target << args << " "), ...);
-        target << std::endl;
-        
-    }
 
-#ifdef _WIN32
     /**
-     * @brief Windows vectored exception handler for page faults
+     * @brief Fault callback registered with GhostFaultDispatcher
      * 
-     * Catches EXCEPTION_ACCESS_VIOLATION exceptions and handles faults
-     * for addresses in managed_blocks. When a managed page is accessed:
+     * Called from the SIGSEGV handler (Linux) or vectored exception
+     * handler (Windows) for every access fault in the process. Claims
+     * faults on addresses in managed_blocks and resolves them with
+     * HandlePageFault():
      * 1. Evicts old pages if needed (makes room)
-     * 2. Commits physical RAM for the page
+     * 2. Makes the page accessible
      * 3. Decompresses page data if it was previously frozen
      * 4. Marks page as active in LRU list
-     * 5. Returns EXCEPTION_CONTINUE_EXECUTION to resume
      * 
-     * @param pExceptionInfo Pointer to exception information structure
-     * @return EXCEPTION_CONTINUE_EXECUTION if handled,
-     *         EXCEPTION_CONTINUE_SEARCH otherwise
+     * Faults on other addresses are left to the next registered manager;
+     * if none claims them the signal is re-raised with default handling
+     * (Linux) or the exception search continues (Windows). Addresses
+     * outside the bounds of all blocks are rejected without taking mutex_.
+     * 
+     * @param owner The manager instance
+     * @param fault_addr Accessed address
+     * @param fault_ip Faulting instruction, used for fault sampling
+     * @return true if the fault was on a managed page and was resolved
      */
-    static LONG WINAPI VectoredHandler(PEXCEPTION_POINTERS pExceptionInfo);
-#else
+    static bool DispatchFault(void *owner, void *fault_addr, const void *fault_ip);
+};
+
+/**
+ * @brief Writes into ghost memory without faulting frozen pages in
+ * 
+ * Shorthand for GhostMemoryManager::Instance().Write().
+ */
+inline bool GhostWrite(void *dst, const void *src, size_t size)
+{
+    return GhostMemoryManager::Instance().Write(dst, src, size);
+}
+
+/**
+ * @brief Loads data into ghost memory in frozen (compressed) form
+ * 
+ * Shorthand for GhostMemoryManager::Instance().Ingest().
+ */
+inline bool GhostIngest(void *dst, const void *src, size_t size)
+{
+    return GhostMemoryManager::Instance().Ingest(dst, src, size);
+}
+
+/**
+ * @brief Reads ghost memory without faulting frozen pages in
+ * 
+ * Shorthand for GhostMemoryManager::Instance().Read().
+ */
+inline bool GhostRead(const void *src, void *dst, size_t size)
+{
+    return GhostMemoryManager::Instance().Read(src, dst, size);
+}
+
+/**
+ * @class GhostReadRange
+ * @brief Iterates over a ghost memory range one page at a time via GhostRead()
+ * 
+ * Each step copies the next page-sized chunk (the first and last may be
+ * partial) into a buffer of PAGE_SIZE bytes: the caller's, or a
+ * thread-local one. The chunk stays valid until the next step.
+ * 
+ * Usage:
+ * @code
+ * uint64_t sum = 0;
+ * for (const GhostReadRange::Chunk &chunk : GhostReadRange(values, count * sizeof(uint64_t)))
+ * {
+ *     const uint64_t *v = reinterpret_cast<const uint64_t *>(chunk.data);
+ *     for (size_t i = 0; i < chunk.size / sizeof(uint64_t); i++) sum += v[i];
+ * }
+ * @endcode
+ */
+class GhostReadRange
+{
+public:
     /**
-     * @brief Installs SIGSEGV signal handler for Linux
-     * 
-     * Sets up a signal handler using sigaction with SA_SIGINFO flag
-     * to catch segmentation faults (SIGSEGV) caused by accessing
-     * protected memory regions.
+     * @struct Chunk
+     * @brief One step of the iteration
      */
-    static void InstallSignalHandler();
+    struct Chunk
+    {
+        const void *address = nullptr; ///< Ghost address of the first byte
+        const char *data = nullptr;    ///< Copy of the bytes
+        size_t size = 0;               ///< Bytes in this chunk
+    };
+
+    class iterator
+    {
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type = Chunk;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const Chunk *;
+        using reference = const Chunk &;
+
+        iterator() = default;
+
+        iterator(const char *next, const char *end, char *buffer)
+            : next_(next), end_(end), buffer_(buffer)
+        {
+            Load();
+        }
+
+        reference operator*() const { return chunk_; }
+        pointer operator->() const { return &chunk_; }
+
+        iterator &operator++()
+        {
+            Load();
+            return *this;
+        }
+
+        bool operator==(const iterator &other) const { return chunk_.address == other.chunk_.address; }
+        bool operator!=(const iterator &other) const { return !(*this == other); }
+
+    private:
+        void Load()
+        {
+            if (next_ >= end_)
+            {
+                chunk_ = Chunk();
+                return;
+            }
+            size_t offset = (uintptr_t)next_ & (PAGE_SIZE - 1);
+            size_t size = std::min<size_t>(PAGE_SIZE - offset, end_ - next_);
+            if (!GhostRead(next_, buffer_, size))
+            {
+                chunk_ = Chunk();  // Not ghost memory: stop
+                next_ = end_;
+                return;
+            }
+            chunk_.address = next_;
+            chunk_.data = buffer_;
+            chunk_.size = size;
+            next_ += size;
+        }
+
+        const char *next_ = nullptr;
+        const char *end_ = nullptr;
+        char *buffer_ = nullptr;
+        Chunk chunk_;
+    };
 
     /**
-     * @brief Linux signal handler for page faults
-     * 
-     * Catches SIGSEGV signals and handles faults for addresses in
-     * managed_blocks. When a managed page is accessed:
-     * 1. Evicts old pages if needed (makes room)
-     * 2. Changes page protection to PROT_READ | PROT_WRITE
-     * 3. Decompresses page data if it was previously frozen
-     * 4. Zeros the page if it's a new allocation
-     * 5. Marks page as active in LRU list
-     * 6. Returns to resume execution
-     * 
-     * If the fault address is not managed by GhostMem, the signal
-     * is re-raised with default handling (typically crash with core dump).
-     * 
-     * @param sig Signal number (should be SIGSEGV)
-     * @param info Pointer to signal information (contains fault address)
-     * @param context Pointer to signal context (unused)
+     * @param start First byte, inside a block returned by AllocateGhost()
+     * @param size Bytes to iterate over
+     * @param buffer PAGE_SIZE bytes for the chunks (nullptr = thread-local)
      */
-    static void SignalHandler(int sig, siginfo_t *info, void *context);
-#endif
+    GhostReadRange(const void *start, size_t size, char *buffer = nullptr)
+        : start_(static_cast<const char *>(start)), size_(size),
+          buffer_(buffer ? buffer : GhostMemoryManager::ThreadReadBuffer())
+    {
+    }
+
+    iterator begin() const { return iterator(start_, start_ + size_, buffer_); }
+    iterator end() const { return iterator(); }
+
+private:
+    const char *start_;
+    size_t size_;
+    char *buffer_;
 };
@@ -0,0 +1,421 @@
+/*******************************************************************************
+ * GhostMem - Virtual RAM through Transparent Compression
+ *
+ * Copyright (C) 2026 Swen Kalski
+ *
+ * This file is part of GhostMem.
+ *
+ * GhostMem is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GhostMem is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GhostMem. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Contact: kalski.swen@gmail.com
+ ******************************************************************************/
+
+/**
+ * @file GhostMetricsExporter.cpp
+ * @brief OpenMetrics (Prometheus) exporter for the statistics block
+ *
+ * @author Swen Kalski
+ * @date 2026
+ */
+
+#include "GhostMetricsExporter.h"
+
+#ifdef _WIN32
+#include <winsock2.h>   // Must precede windows.h
+#include <ws2tcpip.h>
+#include <windows.h>    // MoveFileExA
+#ifdef _MSC_VER
+#pragma comment(lib, "ws2_32.lib")
+#endif
+#else
+#include <arpa/inet.h>  // htonl, htons
+#include <netinet/in.h> // sockaddr_in
+#include <sys/select.h> // select
+#include <sys/socket.h> // socket, bind, listen, accept
+#include <sys/time.h>   // timeval
+#include <unistd.h>     // close
+#endif
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+
+namespace
+{
+    /// Longest a stop request waits for the listener loop to notice it
+    const long kPollIntervalMs = 100;
+
+    /// Requests larger than this are answered without reading further
+    const size_t kMaxRequestBytes = 4096;
+
+#ifdef _WIN32
+    typedef SOCKET socket_t;
+    const socket_t kInvalidSocket = INVALID_SOCKET;
+
+    void CloseSocket(socket_t s)
+    {
+        closesocket(s);
+    }
+#else
+    typedef int socket_t;
+    const socket_t kInvalidSocket = -1;
+
+    void CloseSocket(socket_t s)
+    {
+        close(s);
+    }
+#endif
+
+    void AppendMetric(std::string& out, const char* name, const char* type,
+                      const char* help, uint64_t value)
+    {
+        char line[256];
+        bool counter = (strcmp(type, "counter") == 0);
+
+        snprintf(line, sizeof(line), "# TYPE ghostmem_%s %s\n# HELP ghostmem_%s %s\n",
+                 name, type, name, help);
+        out += line;
+        snprintf(line, sizeof(line), "ghostmem_%s%s %llu\n",
+                 name, counter ? "_total" : "", (unsigned long long)value);
+        out += line;
+    }
+
+    void AppendHistogram(std::string& out, const char* name, const char* help,
+                         const GhostLatencyHistogram& histogram)
+    {
+        char line[256];
+        snprintf(line, sizeof(line),
+                 "# TYPE ghostmem_%s_seconds histogram\n"
+                 "# UNIT ghostmem_%s_seconds seconds\n"
+                 "# HELP ghostmem_%s_seconds %s\n",
+                 name, name, name, help);
+        out += line;
+
+        // Buckets are cumulative in OpenMetrics; the last log2 bucket is
+        // open-ended and therefore only appears as +Inf
+        uint64_t cumulative = 0;
+        for (size_t i = 0; i + 1 < GhostLatencyHistogram::kBuckets; i++)
+        {
+            cumulative += histogram.buckets[i].load(std::memory_order_relaxed);
+            double bound = (double)GhostLatencyHistogram::BucketUpperBound(i) / 1e9;
+            snprintf(line, sizeof(line), "ghostmem_%s_seconds_bucket{le=\"%.9g\"} %llu\n",
+                     name, bound, (unsigned long long)cumulative);
+            out += line;
+        }
+        cumulative += histogram.buckets[GhostLatencyHistogram::kBuckets - 1].load(std::memory_order_relaxed);
+        snprintf(line, sizeof(line),
+                 "ghostmem_%s_seconds_bucket{le=\"+Inf\"} %llu\n"
+                 "ghostmem_%s_seconds_count %llu\n",
+                 name, (unsigned long long)cumulative,
+                 name, (unsigned long long)cumulative);
+        out += line;
+    }
+
+    void SendAll(socket_t client, const std::string& data)
+    {
+        size_t sent = 0;
+        while (sent < data.size())
+        {
+            int n = send(client, data.data() + sent, (int)(data.size() - sent), 0);
+            if (n <= 0)
+            {
+                return;
+            }
+            sent += (size_t)n;
+        }
+    }
+}
+
+GhostMetricsExporter::~GhostMetricsExporter()
+{
+    Stop();
+}
+
+std::string GhostMetricsExporter::Render(const GhostStatsBlock& block)
+{
+    std::string out;
+    out.reserve(16384);
+    const std::memory_order relaxed = std::memory_order_relaxed;
+
+    AppendMetric(out, "page_faults", "counter", "Page faults handled (first touches and refaults)",
+                 block.page_faults.load(relaxed));
+    AppendMetric(out, "refaults", "counter", "Faults on pages that had been frozen before",
+                 block.refaults.load(relaxed));
+    AppendMetric(out, "evictions", "counter", "Pages frozen to make room for others",
+                 block.evictions.load(relaxed));
+    AppendMetric(out, "thrash_refaults", "counter", "Refaults within the resident budget (working set too large)",
+                 block.thrash_refaults.load(relaxed));
+    AppendMetric(out, "cold_refaults", "counter", "Refaults beyond the resident budget",
+                 block.cold_refaults.load(relaxed));
+    AppendMetric(out, "delta_freezes", "counter", "Freezes stored as delta against a previous version",
+                 block.delta_freezes.load(relaxed));
+    AppendMetric(out, "idle_freezes", "counter", "Pages frozen by the idle scanner",
+                 block.idle_freezes.load(relaxed));
+    AppendMetric(out, "idle_soft_faults", "counter", "Accesses that cancelled an idle probe",
+                 block.idle_soft_faults.load(relaxed));
+    AppendMetric(out, "compression_nanoseconds", "counter", "Time spent compressing frozen pages",
+                 block.compression_ns.load(relaxed));
+
+    AppendMetric(out, "resident_pages", "gauge", "Pages currently held uncompressed in RAM",
+                 block.resident_pages.load(relaxed));
+    AppendMetric(out, "frozen_pages", "gauge", "Pages currently held compressed or on disk",
+                 block.frozen_pages.load(relaxed));
+    AppendMetric(out, "compressed_bytes", "gauge", "Bytes of frozen page data held in RAM",
+                 block.compressed_bytes.load(relaxed));
+    AppendMetric(out, "disk_bytes", "gauge", "Size of the swap file in bytes",
+                 block.disk_bytes.load(relaxed));
+    AppendMetric(out, "budget_pages", "gauge", "Resident page budget",
+                 block.budget_pages.load(relaxed));
+    AppendMetric(out, "compression_acceleration", "gauge", "LZ4 acceleration used for new freezes",
+                 block.compression_acceleration.load(relaxed));
+    AppendMetric(out, "page_size_bytes", "gauge", "Page size used by the manager",
+                 block.page_size.load(relaxed));
+
+    AppendHistogram(out, "fault_latency", "Time spent in the page fault handler", block.fault_latency);
+    AppendHistogram(out, "restore_latency", "Time to decompress or read back one frozen page", block.restore_latency);
+    AppendHistogram(out, "freeze_latency", "Time to compress or write out one page", block.freeze_latency);
+
+    out += "# EOF\n";
+    return out;
+}
+
+bool GhostMetricsExporter::Start(const GhostStatsBlock* block, bool http, uint16_t port,
+                                 const std::string& file_path, size_t interval_ms)
+{
+    Stop();
+
+    block_ = block;
+    file_path_ = file_path;
+    interval_ms_ = (interval_ms > 0) ? interval_ms : 1;
+    bound_port_ = 0;
+
+    if (http)
+    {
+#ifdef _WIN32
+        WSADATA wsa;
+        if (WSAStartup(MAKEWORD(2, 2), &wsa) != 0)
+        {
+            return false;
+        }
+#endif
+        socket_t s = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+        if (s == kInvalidSocket)
+        {
+#ifdef _WIN32
+            WSACleanup();
+#endif
+            return false;
+        }
+        listener_ = (intptr_t)s;
+
+        int reuse = 1;
+        setsockopt(s, SOL_SOCKET, SO_REUSEADDR, (const char*)&reuse, sizeof(reuse));
+
+        // Metrics are for local scrapers only; never listen on other interfaces
+        sockaddr_in addr;
+        memset(&addr, 0, sizeof(addr));
+        addr.sin_family = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        addr.sin_port = htons(port);
+
+        socklen_t addr_len = sizeof(addr);
+        if (bind(s, (sockaddr*)&addr, sizeof(addr)) != 0 ||
+            listen(s, 8) != 0 ||
+            getsockname(s, (sockaddr*)&addr, &addr_len) != 0)
+        {
+            CloseListener();
+            return false;
+        }
+        bound_port_ = ntohs(addr.sin_port);
+    }
+
+    if (listener_ == -1 && file_path_.empty())
+    {
+        return true;  // Nothing to do
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(stop_mutex_);
+        stop_ = false;
+    }
+    thread_ = std::thread(&GhostMetricsExporter::Run, this);
+    return true;
+}
+
+void GhostMetricsExporter::Stop()
+{
+    if (thread_.joinable())
+    {
+        {
+            std::lock_guard<std::mutex> lock(stop_mutex_);
+            stop_ = true;
+        }
+        stop_cv_.notify_all();
+        thread_.join();
+
+        if (!file_path_.empty())
+        {
+            WriteFile();  // Final figures for short-lived processes
+        }
+    }
+
+    CloseListener();
+    block_ = nullptr;
+}
+
+void GhostMetricsExporter::CloseListener()
+{
+    if (listener_ == -1)
+    {
+        return;
+    }
+    CloseSocket((socket_t)listener_);
+    listener_ = -1;
+    bound_port_ = 0;
+#ifdef _WIN32
+    WSACleanup();
+#endif
+}
+
+void GhostMetricsExporter::Run()
+{
+    typedef std::chrono::steady_clock clock;
+    clock::time_point next_write = clock::now();
+
+    std::unique_lock<std::mutex> lock(stop_mutex_);
+    while (!stop_)
+    {
+        if (!file_path_.empty() && clock::now() >= next_write)
+        {
+            WriteFile();
+            next_write = clock::now() + std::chrono::milliseconds(interval_ms_);
+        }
+
+        if (listener_ == -1)
+        {
+            stop_cv_.wait_until(lock, next_write, [this] { return stop_; });
+            continue;
+        }
+
+        // Poll the listener so a stop request is noticed promptly
+        lock.unlock();
+        socket_t s = (socket_t)listener_;
+        fd_set readable;
+        FD_ZERO(&readable);
+        FD_SET(s, &readable);
+        timeval timeout;
+        timeout.tv_sec = 0;
+        timeout.tv_usec = kPollIntervalMs * 1000;
+        if (select((int)s + 1, &readable, nullptr, nullptr, &timeout) > 0)
+        {
+            socket_t client = accept(s, nullptr, nullptr);
+            if (client != kInvalidSocket)
+            {
+                ServeClient((intptr_t)client);
+            }
+        }
+        lock.lock();
+    }
+}
+
+void GhostMetricsExporter::ServeClient(intptr_t client_handle)
+{
+    socket_t client = (socket_t)client_handle;
+
+    // A stalled client must not block the exporter for long
+#ifdef _WIN32
+    DWORD timeout_ms = 1000;
+    setsockopt(client, SOL_SOCKET, SO_RCVTIMEO, (const char*)&timeout_ms, sizeof(timeout_ms));
+    setsockopt(client, SOL_SOCKET, SO_SNDTIMEO, (const char*)&timeout_ms, sizeof(timeout_ms));
+#else
+    timeval timeout;
+    timeout.tv_sec = 1;
+    timeout.tv_usec = 0;
+    setsockopt(client, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    setsockopt(client, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+#endif
+
+    // Only the request line matters; headers are read and ignored
+    std::string request;
+    char buffer[1024];
+    while (request.find("\r\n\r\n") == std::string::npos && request.size() < kMaxRequestBytes)
+    {
+        int n = recv(client, buffer, sizeof(buffer), 0);
+        if (n <= 0)
+        {
+            break;
+        }
+        request.append(buffer, (size_t)n);
+    }
+
+    std::string status = "200 OK";
+    std::string content_type = "application/openmetrics-text; version=1.0.0; charset=utf-8";
+    std::string body;
+
+    if (request.compare(0, 4, "GET ") != 0)
+    {
+        status = "405 Method Not Allowed";
+    }
+    else
+    {
+        size_t path_end = request.find(' ', 4);
+        std::string path = request.substr(4, (path_end == std::string::npos) ? std::string::npos : path_end - 4);
+        if (path == "/metrics" || path == "/")
+        {
+            body = Render(*block_);
+        }
+        else
+        {
+            status = "404 Not Found";
+        }
+    }
+    if (body.empty())
+    {
+        content_type = "text/plain; charset=utf-8";
+        body = status + "\n";
+    }
+
+    std::string response = "HTTP/1.1 " + status + "\r\n"
+                           "Content-Type: " + content_type + "\r\n"
+                           "Content-Length: " + std::to_string(body.size()) + "\r\n"
+                           "Connection: close\r\n\r\n" + body;
+    SendAll(client, response);
+    CloseSocket(client);
+}
+
+bool GhostMetricsExporter::WriteFile() const
+{
+    // Write a sibling file and rename it so readers never see a partial file
+    std::string temp_path = file_path_ + ".tmp";
+    FILE* file = fopen(temp_path.c_str(), "wb");
+    if (!file)
+    {
+        return false;
+    }
+
+    std::string text = Render(*block_);
+    bool ok = (fwrite(text.data(), 1, text.size(), file) == text.size());
+    ok = (fclose(file) == 0) && ok;
+    if (!ok)
+    {
+        remove(temp_path.c_str());
+        return false;
+    }
+
+#ifdef _WIN32
+    return MoveFileExA(temp_path.c_str(), file_path_.c_str(), MOVEFILE_REPLACE_EXISTING) != 0;
+#else
+    return rename(temp_path.c_str(), file_path_.c_str()) == 0;
+#endif
+}
@@ -0,0 +1,119 @@
+/*******************************************************************************
+ * GhostMem - Virtual RAM through Transparent Compression
+ *
+ * Copyright (C) 2026 Swen Kalski
+ *
+ * This file is part of GhostMem.
+ *
+ * GhostMem is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GhostMem is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GhostMem. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Contact: kalski.swen@gmail.com
+ ******************************************************************************/
+
+/**
+ * @file GhostMetricsExporter.h
+ * @brief OpenMetrics (Prometheus) exporter for the statistics block
+ *
+ * Renders a GhostStatsBlock in the OpenMetrics text format and makes it
+ * available to a scraper in one or both of two ways:
+ * - A minimal HTTP listener on 127.0.0.1 answering GET /metrics
+ * - A file rewritten periodically (atomically, via rename), e.g. for the
+ *   node_exporter textfile collector
+ *
+ * The exporter only loads relaxed atomics from the block, so a scrape
+ * never takes the manager's mutex and never delays a page fault.
+ *
+ * @author Swen Kalski
+ * @date 2026
+ */
+
+#pragma once
+
+#include "GhostStatsBlock.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+
+/**
+ * @class GhostMetricsExporter
+ * @brief Background thread serving or writing OpenMetrics text
+ */
+class GhostMetricsExporter
+{
+public:
+    GhostMetricsExporter() = default;
+    ~GhostMetricsExporter();
+
+    GhostMetricsExporter(const GhostMetricsExporter&) = delete;
+    GhostMetricsExporter& operator=(const GhostMetricsExporter&) = delete;
+
+    /**
+     * @brief Renders a statistics block as OpenMetrics text
+     *
+     * Counters get a _total suffix, latencies are exported as histograms
+     * in seconds with the block's log2 bucket bounds. The output ends
+     * with the mandatory "# EOF" line.
+     */
+    static std::string Render(const GhostStatsBlock& block);
+
+    /**
+     * @brief Starts exporting a block
+     *
+     * @param block Block to export; must stay valid until Stop()
+     * @param http Serve GET /metrics on 127.0.0.1
+     * @param port TCP port for the listener (0 = pick a free port)
+     * @param file_path File to rewrite periodically (empty = no file)
+     * @param interval_ms Interval between file writes
+     * @return false if the listener could not be bound
+     */
+    bool Start(const GhostStatsBlock* block, bool http, uint16_t port,
+               const std::string& file_path, size_t interval_ms);
+
+    /**
+     * @brief Stops the thread and closes the listener
+     *
+     * A configured file receives one final write.
+     */
+    void Stop();
+
+    /// @brief true while the exporter thread runs
+    bool IsRunning() const { return thread_.joinable(); }
+
+    /// @brief Port the listener is bound to (0 if not listening)
+    uint16_t Port() const { return bound_port_; }
+
+private:
+    void Run();
+    void ServeClient(intptr_t client);
+    bool WriteFile() const;
+    void CloseListener();
+
+    const GhostStatsBlock* block_ = nullptr;
+    std::string file_path_;
+    size_t interval_ms_ = 0;
+
+    /// Listening socket (SOCKET on Windows, fd elsewhere), -1 if none
+    intptr_t listener_ = -1;
+    uint16_t bound_port_ = 0;
+
+    std::thread thread_;
+    std::mutex stop_mutex_;
+    std::condition_variable stop_cv_;
+    bool stop_ = false;
+};
@@ -0,0 +1,229 @@
+/*******************************************************************************
+ * GhostMem - Virtual RAM through Transparent Compression
+ *
+ * Copyright (C) 2026 Swen Kalski
+ *
+ * This file is part of GhostMem.
+ *
+ * GhostMem is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GhostMem is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GhostMem. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Contact: kalski.swen@gmail.com
+ ******************************************************************************/
+
+/**
+ * @file GhostPolicies.cpp
+ * @brief Out-of-line parts of the BasicGhostManager policies
+ *
+ * @author Swen Kalski
+ * @date 2026
+ */
+
+#include "GhostPolicies.h"
+
+#ifndef _WIN32
+#include <fcntl.h>      // open, O_CREAT, O_RDWR
+#include <sys/stat.h>   // S_IRUSR, S_IWUSR
+#endif
+
+// ============================================================================
+// GhostDiskBacking
+// ============================================================================
+
+GhostDiskBacking::~GhostDiskBacking()
+{
+    Close();
+}
+
+bool GhostDiskBacking::Open(const std::string &path)
+{
+    Close();
+
+#ifdef _WIN32
+    file_ = CreateFileA(path.c_str(), GENERIC_READ | GENERIC_WRITE, 0, NULL,
+                        CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+#else
+    fd_ = open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, S_IRUSR | S_IWUSR);
+#endif
+    return IsReady();
+}
+
+void GhostDiskBacking::Close()
+{
+#ifdef _WIN32
+    if (file_ != INVALID_HANDLE_VALUE)
+    {
+        CloseHandle(file_);
+        file_ = INVALID_HANDLE_VALUE;
+    }
+#else
+    if (fd_ >= 0)
+    {
+        close(fd_);
+        fd_ = -1;
+    }
+#endif
+    records_.clear();
+    free_slots_.clear();
+    file_end_ = 0;
+}
+
+bool GhostDiskBacking::IsReady() const
+{
+#ifdef _WIN32
+    return file_ != INVALID_HANDLE_VALUE;
+#else
+    return fd_ >= 0;
+#endif
+}
+
+bool GhostDiskBacking::Store(void *page, const char *data, size_t size)
+{
+    auto it = records_.find(page);
+    if (it != records_.end() && it->second.capacity < size)
+    {
+        // Outgrew its slot - move it
+        free_slots_.emplace(it->second.capacity, it->second.offset);
+        records_.erase(it);
+        it = records_.end();
+    }
+
+    if (it == records_.end())
+    {
+        Record record;
+        auto slot = free_slots_.lower_bound(size);
+        if (slot != free_slots_.end())
+        {
+            record.capacity = slot->first;
+            record.offset = slot->second;
+            free_slots_.erase(slot);
+        }
+        else
+        {
+            record.capacity = (size + kSlotGranularity - 1) / kSlotGranularity * kSlotGranularity;
+            record.offset = file_end_;
+            file_end_ += record.capacity;
+        }
+        record.size = 0;
+        it = records_.emplace(page, record).first;
+    }
+
+    if (!WriteAt(it->second.offset, data, size))
+    {
+        free_slots_.emplace(it->second.capacity, it->second.offset);
+        records_.erase(it);
+        return false;
+    }
+    it->second.size = size;
+    return true;
+}
+
+char *GhostDiskBacking::Load(void *page, char *scratch, size_t &size)
+{
+    auto it = records_.find(page);
+    if (it == records_.end() || !ReadAt(it->second.offset, scratch, it->second.size))
+    {
+        return nullptr;
+    }
+    size = it->second.size;
+    return scratch;
+}
+
+void GhostDiskBacking::Erase(void *page)
+{
+    auto it = records_.find(page);
+    if (it != records_.end())
+    {
+        free_slots_.emplace(it->second.capacity, it->second.offset);
+        records_.erase(it);
+    }
+}
+
+bool GhostDiskBacking::WriteAt(uint64_t offset, const char *data, size_t size)
+{
+#ifdef _WIN32
+    OVERLAPPED overlapped = {};
+    overlapped.Offset = (DWORD)(offset & 0xFFFFFFFF);
+    overlapped.OffsetHigh = (DWORD)(offset >> 32);
+    DWORD written = 0;
+    return WriteFile(file_, data, (DWORD)size, &written, &overlapped) && written == size;
+#else
+    return pwrite(fd_, data, size, (off_t)offset) == (ssize_t)size;
+#endif
+}
+
+bool GhostDiskBacking::ReadAt(uint64_t offset, char *data, size_t size)
+{
+#ifdef _WIN32
+    OVERLAPPED overlapped = {};
+    overlapped.Offset = (DWORD)(offset & 0xFFFFFFFF);
+    overlapped.OffsetHigh = (DWORD)(offset >> 32);
+    DWORD bytes_read = 0;
+    return ReadFile(file_, data, (DWORD)size, &bytes_read, &overlapped) && bytes_read == size;
+#else
+    return pread(fd_, data, size, (off_t)offset) == (ssize_t)size;
+#endif
+}
+
+// ============================================================================
+// GhostPriorityInheritLock
+// ============================================================================
+
+#ifdef _WIN32
+
+GhostPriorityInheritLock::GhostPriorityInheritLock()
+{
+}
+
+GhostPriorityInheritLock::~GhostPriorityInheritLock()
+{
+}
+
+void GhostPriorityInheritLock::lock()
+{
+    mutex_.lock();
+}
+
+void GhostPriorityInheritLock::unlock()
+{
+    mutex_.unlock();
+}
+
+#else
+
+GhostPriorityInheritLock::GhostPriorityInheritLock()
+{
+    pthread_mutexattr_t attr;
+    pthread_mutexattr_init(&attr);
+    // Falls back to a normal mutex where priority inheritance is unsupported
+    pthread_mutexattr_setprotocol(&attr, PTHREAD_PRIO_INHERIT);
+    pthread_mutex_init(&mutex_, &attr);
+    pthread_mutexattr_destroy(&attr);
+}
+
+GhostPriorityInheritLock::~GhostPriorityInheritLock()
+{
+    pthread_mutex_destroy(&mutex_);
+}
+
+void GhostPriorityInheritLock::lock()
+{
+    pthread_mutex_lock(&mutex_);
+}
+
+void GhostPriorityInheritLock::unlock()
+{
+    pthread_mutex_unlock(&mutex_);
+}
+
+#endif
@@ -0,0 +1,645 @@
+/*******************************************************************************
+ * GhostMem - Virtual RAM through Transparent Compression
+ *
+ * Copyright (C) 2026 Swen Kalski
+ *
+ * This file is part of GhostMem.
+ *
+ * GhostMem is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GhostMem is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GhostMem. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Contact: kalski.swen@gmail.com
+ ******************************************************************************/
+
+/**
+ * @file GhostPolicies.h
+ * @brief Compile-time policies for BasicGhostManager
+ *
+ * A BasicGhostManager is assembled from six policies. Each group below
+ * documents the members a policy must provide; any class with those
+ * members can be plugged in. All calls happen with the manager's lock
+ * held (except the lock policy itself), so policies need no locking.
+ *
+ * | Policy   | Provided                                    |
+ * |----------|---------------------------------------------|
+ * | Backing  | GhostMemoryBacking, GhostDiskBacking        |
+ * | Codec    | GhostLz4Codec, GhostLz4StateCodec,          |
+ * |          | GhostRawCodec                               |
+ * | Cipher   | GhostNoCipher, GhostChaCha20Cipher          |
+ * | Eviction | GhostLruEviction, GhostRandomEviction       |
+ * | Lock     | GhostMutexLock, GhostNoLock,                |
+ * |          | GhostPriorityInheritLock                    |
+ * | Regions  | GhostMapRegions                             |
+ *
+ * Fixed-capacity, heap-free variants for embedded targets are in
+ * GhostFixedPolicies.h.
+ *
+ * @author Swen Kalski
+ * @date 2026
+ */
+
+#pragma once
+
+#include "GhostMemoryManager.h"     // PAGE_SIZE, platform headers, LZ4
+#include "GhostChaCha20.h"
+
+#include <cstdint>
+#include <cstring>
+#include <list>
+#include <map>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#ifndef _WIN32
+#include <pthread.h>    // Priority-inheritance mutex
+#endif
+
+// ============================================================================
+// Codecs
+//
+//   static constexpr size_t kMaxEncodedSize;  // Worst-case encoded page
+//   size_t Encode(const char *page, char *out);   // 0 = failure
+//   bool Decode(const char *in, size_t size, char *page);
+//
+// The manager holds one codec instance; Encode/Decode may be static.
+// ============================================================================
+
+/**
+ * @struct GhostLz4Codec
+ * @brief LZ4 (default acceleration), as used by GhostMemoryManager
+ */
+struct GhostLz4Codec
+{
+    static constexpr size_t kMaxEncodedSize = LZ4_COMPRESSBOUND(PAGE_SIZE);
+
+    static size_t Encode(const char *page, char *out)
+    {
+        int size = LZ4_compress_default(page, out, (int)PAGE_SIZE, (int)kMaxEncodedSize);
+        return (size > 0) ? (size_t)size : 0;
+    }
+
+    static bool Decode(const char *in, size_t size, char *page)
+    {
+        return LZ4_decompress_safe(in, page, (int)size, (int)PAGE_SIZE) == (int)PAGE_SIZE;
+    }
+};
+
+/**
+ * @class GhostLz4StateCodec
+ * @brief GhostLz4Codec with its compression state preallocated
+ *
+ * LZ4_compress_default() builds a ~16 KB hash table on the stack of the
+ * faulting thread on every call. This codec keeps it in the manager
+ * instead, so the fault path needs little stack and its memory can be
+ * locked with the manager.
+ */
+class GhostLz4StateCodec
+{
+public:
+    static constexpr size_t kMaxEncodedSize = LZ4_COMPRESSBOUND(PAGE_SIZE);
+
+    size_t Encode(const char *page, char *out)
+    {
+        int size = LZ4_compress_fast_extState(&state_, page, out, (int)PAGE_SIZE,
+                                              (int)kMaxEncodedSize, 1);
+        return (size > 0) ? (size_t)size : 0;
+    }
+
+    static bool Decode(const char *in, size_t size, char *page)
+    {
+        return GhostLz4Codec::Decode(in, size, page);
+    }
+
+private:
+    LZ4_stream_t state_;
+};
+
+/**
+ * @struct GhostRawCodec
+ * @brief Stores pages unmodified (incompressible data, or disk swap
+ *        without compression)
+ */
+struct GhostRawCodec
+{
+    static constexpr size_t kMaxEncodedSize = PAGE_SIZE;
+
+    static size_t Encode(const char *page, char *out)
+    {
+        memcpy(out, page, PAGE_SIZE);
+        return PAGE_SIZE;
+    }
+
+    static bool Decode(const char *in, size_t size, char *page)
+    {
+        if (size != PAGE_SIZE)
+        {
+            return false;
+        }
+        memcpy(page, in, PAGE_SIZE);
+        return true;
+    }
+};
+
+// ============================================================================
+// Ciphers
+//
+//   bool IsReady() const;
+//   void Apply(const void *page, char *data, size_t size);  // Symmetric
+// ============================================================================
+
+/**
+ * @struct GhostNoCipher
+ * @brief No encryption; Apply() compiles to nothing
+ */
+struct GhostNoCipher
+{
+    bool IsReady() const
+    {
+        return true;
+    }
+
+    void Apply(const void *, char *, size_t)
+    {
+    }
+};
+
+/**
+ * @class GhostChaCha20Cipher
+ * @brief ChaCha20 with a random per-instance key and the page address
+ *        as nonce, matching GhostConfig::encrypt_disk_pages
+ */
+class GhostChaCha20Cipher
+{
+public:
+    GhostChaCha20Cipher()
+    {
+        ready_ = GhostRandomBytes(key_, sizeof(key_));
+    }
+
+    ~GhostChaCha20Cipher()
+    {
+        // Don't leave the key behind in freed memory
+        volatile unsigned char *key = key_;
+        for (size_t i = 0; i < sizeof(key_); i++)
+        {
+            key[i] = 0;
+        }
+    }
+
+    GhostChaCha20Cipher(const GhostChaCha20Cipher &) = delete;
+    GhostChaCha20Cipher &operator=(const GhostChaCha20Cipher &) = delete;
+
+    bool IsReady() const
+    {
+        return ready_;
+    }
+
+    void Apply(const void *page, char *data, size_t size)
+    {
+        unsigned char nonce[GHOST_CHACHA20_NONCE_SIZE];
+        GhostChaCha20PageNonce(page, nonce);
+        GhostChaCha20Crypt(key_, nonce, 0, (unsigned char *)data, size);
+    }
+
+private:
+    unsigned char key_[GHOST_CHACHA20_KEY_SIZE] = {0};
+    bool ready_ = false;
+};
+
+// ============================================================================
+// Backing stores
+//
+//   bool IsReady() const;
+//   bool Store(void *page, const char *data, size_t size);  // Replaces
+//   char *Load(void *page, char *scratch, size_t &size);    // nullptr = none
+//   void Erase(void *page);
+//   size_t Count() const;         // Pages held
+//   size_t MemoryBytes() const;   // Bytes held in RAM
+//   size_t DiskBytes() const;     // Size of the swap file
+//
+// Load() returns the record either in place or copied into scratch
+// (Codec::kMaxEncodedSize bytes); the caller may modify it and erases the
+// page right after.
+// ============================================================================
+
+/**
+ * @class GhostMemoryBacking
+ * @brief Compressed pages kept in RAM
+ */
+class GhostMemoryBacking
+{
+public:
+    bool IsReady() const
+    {
+        return true;
+    }
+
+    bool Store(void *page, const char *data, size_t size)
+    {
+        std::vector<char> &record = records_[page];
+        bytes_ -= record.size();
+        record.assign(data, data + size);
+        bytes_ += size;
+        return true;
+    }
+
+    char *Load(void *page, char *, size_t &size)
+    {
+        auto it = records_.find(page);
+        if (it == records_.end())
+        {
+            return nullptr;
+        }
+        size = it->second.size();
+        return it->second.data();
+    }
+
+    void Erase(void *page)
+    {
+        auto it = records_.find(page);
+        if (it != records_.end())
+        {
+            bytes_ -= it->second.size();
+            records_.erase(it);
+        }
+    }
+
+    size_t Count() const
+    {
+        return records_.size();
+    }
+
+    size_t MemoryBytes() const
+    {
+        return bytes_;
+    }
+
+    size_t DiskBytes() const
+    {
+        return 0;
+    }
+
+private:
+    std::unordered_map<void *, std::vector<char>> records_;
+    size_t bytes_ = 0;
+};
+
+/**
+ * @class GhostDiskBacking
+ * @brief Pages kept in a swap file
+ *
+ * Unlike GhostMemoryManager's append-only file, slots are reused: a page
+ * is rewritten in place when its new record fits, and slots of erased or
+ * moved pages serve later records, so the file size follows the number
+ * of frozen pages instead of the number of freezes. Open() must be
+ * called before the first allocation.
+ */
+class GhostDiskBacking
+{
+public:
+    GhostDiskBacking() = default;
+    ~GhostDiskBacking();
+
+    GhostDiskBacking(const GhostDiskBacking &) = delete;
+    GhostDiskBacking &operator=(const GhostDiskBacking &) = delete;
+
+    /**
+     * @brief Creates (or truncates) the swap file
+     * @return false if the file cannot be opened
+     */
+    bool Open(const std::string &path);
+
+    /// Closes the file; stored pages are forgotten
+    void Close();
+
+    bool IsReady() const;
+
+    bool Store(void *page, const char *data, size_t size);
+    char *Load(void *page, char *scratch, size_t &size);
+    void Erase(void *page);
+
+    size_t Count() const
+    {
+        return records_.size();
+    }
+
+    size_t MemoryBytes() const
+    {
+        return 0;
+    }
+
+    size_t DiskBytes() const
+    {
+        return (size_t)file_end_;
+    }
+
+private:
+    /// Slot sizes are rounded up to this so freed slots fit more records
+    static constexpr size_t kSlotGranularity = 256;
+
+    struct Record
+    {
+        uint64_t offset;
+        size_t capacity;    ///< Slot size
+        size_t size;        ///< Bytes used by the current record
+    };
+
+    bool WriteAt(uint64_t offset, const char *data, size_t size);
+    bool ReadAt(uint64_t offset, char *data, size_t size);
+
+    std::unordered_map<void *, Record> records_;
+    std::multimap<size_t, uint64_t> free_slots_;    ///< capacity -> offset
+    uint64_t file_end_ = 0;
+#ifdef _WIN32
+    HANDLE file_ = INVALID_HANDLE_VALUE;
+#else
+    int fd_ = -1;
+#endif
+};
+
+// ============================================================================
+// Eviction
+//
+//   void Insert(void *page);         // Page became resident
+//   void Remove(void *page);         // Page was freed while resident
+//   bool Contains(void *page) const;
+//   void *Victim();                  // Removes and returns the next page
+//                                    // to freeze (nullptr if empty)
+//   size_t Size() const;             // Resident pages
+//   bool Full() const;               // No room for another page
+//
+// Resident pages are accessed without faults, so "recency" is the time of
+// the last fault, as in GhostMemoryManager.
+// ============================================================================
+
+/**
+ * @class GhostLruEviction
+ * @brief Evicts the page that faulted in longest ago, in O(1)
+ */
+class GhostLruEviction
+{
+public:
+    void Insert(void *page)
+    {
+        order_.push_front(page);
+        index_[page] = order_.begin();
+    }
+
+    void Remove(void *page)
+    {
+        auto it = index_.find(page);
+        if (it != index_.end())
+        {
+            order_.erase(it->second);
+            index_.erase(it);
+        }
+    }
+
+    bool Contains(void *page) const
+    {
+        return index_.count(page) != 0;
+    }
+
+    void *Victim()
+    {
+        if (order_.empty())
+        {
+            return nullptr;
+        }
+        void *page = order_.back();
+        order_.pop_back();
+        index_.erase(page);
+        return page;
+    }
+
+    size_t Size() const
+    {
+        return index_.size();
+    }
+
+    bool Full() const
+    {
+        return false;
+    }
+
+private:
+    std::list<void *> order_;   ///< Most recent fault first
+    std::unordered_map<void *, std::list<void *>::iterator> index_;
+};
+
+/**
+ * @class GhostRandomEviction
+ * @brief Evicts a random resident page
+ *
+ * Avoids LRU's worst case - a cyclic scan over slightly more pages than
+ * the budget, where LRU always evicts the page needed next.
+ */
+class GhostRandomEviction
+{
+public:
+    void Insert(void *page)
+    {
+        index_[page] = pages_.size();
+        pages_.push_back(page);
+    }
+
+    void Remove(void *page)
+    {
+        auto it = index_.find(page);
+        if (it != index_.end())
+        {
+            RemoveAt(it->second);
+        }
+    }
+
+    bool Contains(void *page) const
+    {
+        return index_.count(page) != 0;
+    }
+
+    void *Victim()
+    {
+        if (pages_.empty())
+        {
+            return nullptr;
+        }
+        // xorshift64
+        state_ ^= state_ << 13;
+        state_ ^= state_ >> 7;
+        state_ ^= state_ << 17;
+        void *page = pages_[state_ % pages_.size()];
+        RemoveAt(index_[page]);
+        return page;
+    }
+
+    size_t Size() const
+    {
+        return pages_.size();
+    }
+
+    bool Full() const
+    {
+        return false;
+    }
+
+private:
+    void RemoveAt(size_t position)
+    {
+        void *page = pages_[position];
+        pages_[position] = pages_.back();
+        index_[pages_[position]] = position;
+        pages_.pop_back();
+        index_.erase(page);
+    }
+
+    std::vector<void *> pages_;
+    std::unordered_map<void *, size_t> index_;
+    uint64_t state_ = 0x9E3779B97F4A7C15ULL;
+};
+
+// ============================================================================
+// Region tables
+//
+//   bool Insert(void *start, size_t size);   // false = table full
+//   bool Remove(void *start, size_t &size);  // false = not an allocation
+//   bool Lookup(const void *addr, void *&start, size_t &size) const;
+//                                            // Allocation containing addr
+//   template <class F> void ForEach(F f);    // f(start, size) for each
+// ============================================================================
+
+/**
+ * @class GhostMapRegions
+ * @brief Allocations in a std::map, unbounded
+ */
+class GhostMapRegions
+{
+public:
+    bool Insert(void *start, size_t size)
+    {
+        regions_[start] = size;
+        return true;
+    }
+
+    bool Remove(void *start, size_t &size)
+    {
+        auto it = regions_.find(start);
+        if (it == regions_.end())
+        {
+            return false;
+        }
+        size = it->second;
+        regions_.erase(it);
+        return true;
+    }
+
+    bool Lookup(const void *addr, void *&start, size_t &size) const
+    {
+        // Only the closest region at or below the address can contain it
+        auto it = regions_.upper_bound(const_cast<void *>(addr));
+        if (it == regions_.begin())
+        {
+            return false;
+        }
+        --it;
+        if ((uintptr_t)addr >= (uintptr_t)it->first + it->second)
+        {
+            return false;
+        }
+        start = it->first;
+        size = it->second;
+        return true;
+    }
+
+    template <class F>
+    void ForEach(F f)
+    {
+        for (const auto &region : regions_)
+        {
+            f(region.first, region.second);
+        }
+    }
+
+private:
+    std::map<void *, size_t> regions_;  ///< Allocation start -> size
+};
+
+// ============================================================================
+// Locks (BasicLockable)
+// ============================================================================
+
+/**
+ * @class GhostMutexLock
+ * @brief Serializes faults and allocations across threads
+ */
+class GhostMutexLock
+{
+public:
+    void lock()
+    {
+        mutex_.lock();
+    }
+
+    void unlock()
+    {
+        mutex_.unlock();
+    }
+
+private:
+    std::mutex mutex_;
+};
+
+/**
+ * @class GhostPriorityInheritLock
+ * @brief Mutex with priority inheritance (POSIX PTHREAD_PRIO_INHERIT)
+ *
+ * A low-priority thread holding the lock inherits the priority of a
+ * real-time thread waiting for it, so the waiter is not delayed by
+ * medium-priority work. On Windows, where the scheduler boosts lock
+ * holders itself, this is a plain mutex.
+ */
+class GhostPriorityInheritLock
+{
+public:
+    GhostPriorityInheritLock();
+    ~GhostPriorityInheritLock();
+
+    GhostPriorityInheritLock(const GhostPriorityInheritLock &) = delete;
+    GhostPriorityInheritLock &operator=(const GhostPriorityInheritLock &) = delete;
+
+    void lock();
+    void unlock();
+
+private:
+#ifdef _WIN32
+    std::mutex mutex_;
+#else
+    pthread_mutex_t mutex_;
+#endif
+};
+
+/**
+ * @struct GhostNoLock
+ * @brief For managers used by a single thread only
+ */
+struct GhostNoLock
+{
+    void lock()
+    {
+    }
+
+    void unlock()
+    {
+    }
+};
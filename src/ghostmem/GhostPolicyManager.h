@@ -0,0 +1,347 @@
+/*******************************************************************************
+ * GhostMem - Virtual RAM through Transparent Compression
+ *
+ * Copyright (C) 2026 Swen Kalski
+ *
+ * This file is part of GhostMem.
+ *
+ * GhostMem is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GhostMem is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GhostMem. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Contact: kalski.swen@gmail.com
+ ******************************************************************************/
+
+/**
+ * @file GhostPolicyManager.h
+ * @brief Ghost memory manager specialized at compile time
+ *
+ * GhostMemoryManager decides on every fault and freeze whether to use
+ * disk, compression and encryption, and carries tags, quotas, the idle
+ * scanner and diagnostics. BasicGhostManager is the lean alternative for
+ * deployments that know their configuration at build time: backing
+ * store, codec, cipher, eviction, locking and the allocation table are
+ * template parameters
+ * (see GhostPolicies.h), so the fault path contains only the chosen code,
+ * fully inlinable, with no configuration branches or virtual calls.
+ *
+ * Both kinds of manager can be used in the same process; faults are
+ * routed through GhostFaultDispatcher.
+ *
+ * @code
+ * GhostLz4Manager manager(256);                 // 256 resident pages
+ * int *data = static_cast<int *>(manager.Allocate(1 << 20));
+ * data[0] = 42;                                 // Faults in, LZ4 on evict
+ * manager.Deallocate(data);
+ * @endcode
+ *
+ * @author Swen Kalski
+ * @date 2026
+ */
+
+#pragma once
+
+#include "GhostPolicies.h"
+#include "GhostFaultDispatcher.h"
+
+#include <mutex>
+
+/**
+ * @class BasicGhostManager
+ * @brief Ghost memory manager assembled from compile-time policies
+ *
+ * @tparam Backing Where frozen pages go (GhostMemoryBacking, GhostDiskBacking)
+ * @tparam Codec Page encoding (GhostLz4Codec, GhostRawCodec)
+ * @tparam Cipher Encryption of stored records (GhostNoCipher, GhostChaCha20Cipher)
+ * @tparam Eviction Choice of the page to freeze (GhostLruEviction, GhostRandomEviction)
+ * @tparam Lock Serialization (GhostMutexLock, GhostNoLock for single-threaded use)
+ * @tparam Regions Table of allocations (GhostMapRegions, GhostFixedRegions)
+ */
+template <class Backing, class Codec, class Cipher, class Eviction, class Lock,
+          class Regions = GhostMapRegions>
+class BasicGhostManager
+{
+public:
+    /**
+     * @param max_resident_pages Pages kept in physical RAM before freezing
+     */
+    explicit BasicGhostManager(size_t max_resident_pages = MAX_PHYSICAL_PAGES)
+        : BasicGhostManager(max_resident_pages, false)
+    {
+    }
+
+    /**
+     * @brief Releases all memory still allocated from this manager
+     */
+    ~BasicGhostManager()
+    {
+        if (registered_)
+        {
+            GhostFaultDispatcher::Unregister(OnFault, this);
+        }
+        regions_.ForEach([this](void *ptr, size_t size) { Release(ptr, size); });
+    }
+
+    BasicGhostManager(const BasicGhostManager &) = delete;
+    BasicGhostManager &operator=(const BasicGhostManager &) = delete;
+
+    /**
+     * @brief Reserves virtual memory; pages are committed on first access
+     *
+     * @param size Bytes (rounded up to PAGE_SIZE)
+     * @return Page-aligned pointer, nullptr if the reservation failed, the
+     *         backing or cipher is not ready, or the fault hook or region
+     *         table is full
+     */
+    void *Allocate(size_t size)
+    {
+        std::lock_guard<Lock> lock(lock_);
+
+        if (!registered_ || !backing_.IsReady() || !cipher_.IsReady() || size == 0)
+        {
+            return nullptr;
+        }
+
+        size_t aligned_size = (size + PAGE_SIZE - 1) & ~(PAGE_SIZE - 1);
+#ifdef _WIN32
+        void *ptr = VirtualAlloc(NULL, aligned_size, MEM_RESERVE, PAGE_NOACCESS);
+#else
+        void *ptr = mmap(NULL, aligned_size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (ptr == MAP_FAILED) ptr = nullptr;
+#endif
+        if (ptr && !regions_.Insert(ptr, aligned_size))
+        {
+#ifdef _WIN32
+            VirtualFree(ptr, 0, MEM_RELEASE);
+#else
+            munmap(ptr, aligned_size);
+#endif
+            ptr = nullptr;
+        }
+        return ptr;
+    }
+
+    /**
+     * @brief Frees memory returned by Allocate()
+     */
+    void Deallocate(void *ptr)
+    {
+        std::lock_guard<Lock> lock(lock_);
+
+        size_t size = 0;
+        if (regions_.Remove(ptr, size))
+        {
+            Release(ptr, size);
+        }
+    }
+
+    /**
+     * @brief Counters and current figures
+     *
+     * Fills page_faults, refaults, evictions, resident_pages,
+     * frozen_pages, compressed_bytes (RAM backing), disk_bytes (swap file
+     * size) and budget_pages; the other fields stay 0.
+     */
+    GhostStats GetStats() const
+    {
+        std::lock_guard<Lock> lock(lock_);
+
+        GhostStats stats;
+        stats.page_faults = page_faults_;
+        stats.refaults = refaults_;
+        stats.evictions = evictions_;
+        stats.resident_pages = eviction_.Size();
+        stats.frozen_pages = backing_.Count();
+        stats.compressed_bytes = backing_.MemoryBytes();
+        stats.disk_bytes = backing_.DiskBytes();
+        stats.budget_pages = max_resident_pages_;
+        return stats;
+    }
+
+    /**
+     * @brief The backing store, e.g. to Open() a GhostDiskBacking file
+     *        before the first allocation
+     */
+    Backing &GetBacking()
+    {
+        return backing_;
+    }
+
+protected:
+    /**
+     * @param max_resident_pages Pages kept in physical RAM before freezing
+     * @param dispatch_first Receive faults before managers registered
+     *        without the flag (see GhostFaultDispatcher::Register())
+     */
+    BasicGhostManager(size_t max_resident_pages, bool dispatch_first)
+        : max_resident_pages_(max_resident_pages > 0 ? max_resident_pages : 1)
+    {
+        registered_ = GhostFaultDispatcher::Register(OnFault, this, dispatch_first);
+    }
+
+private:
+    static bool OnFault(void *owner, void *fault_addr, const void *)
+    {
+        return static_cast<BasicGhostManager *>(owner)->HandleFault(fault_addr);
+    }
+
+    bool HandleFault(void *fault_addr)
+    {
+        std::lock_guard<Lock> lock(lock_);
+
+        void *region = nullptr;
+        size_t region_size = 0;
+        if (!regions_.Lookup(fault_addr, region, region_size))
+        {
+            return false;
+        }
+
+        void *page = (void *)((uintptr_t)fault_addr & ~(PAGE_SIZE - 1));
+        if (eviction_.Contains(page))
+        {
+            return true;  // Another thread faulted it in meanwhile
+        }
+
+        // A victim that cannot be stored goes back to the front, so each
+        // resident page is tried at most once
+        size_t attempts = eviction_.Size();
+        while ((eviction_.Size() >= max_resident_pages_ || eviction_.Full()) && attempts-- > 0)
+        {
+            void *victim = eviction_.Victim();
+            if (!victim)
+            {
+                break;
+            }
+            Freeze(victim);
+        }
+        if (eviction_.Full())
+        {
+            return false;  // No page could be stored, nowhere to track this one
+        }
+
+#ifdef _WIN32
+        if (!VirtualAlloc(page, PAGE_SIZE, MEM_COMMIT, PAGE_READWRITE))
+        {
+            return false;
+        }
+#else
+        if (mprotect(page, PAGE_SIZE, PROT_READ | PROT_WRITE) != 0)
+        {
+            return false;
+        }
+#endif
+
+        size_t size = 0;
+        char *record = backing_.Load(page, scratch_, size);
+        if (record)
+        {
+            cipher_.Apply(page, record, size);
+            if (!codec_.Decode(record, size, (char *)page))
+            {
+                return false;  // Page content is lost
+            }
+            backing_.Erase(page);
+            refaults_++;
+        }
+
+        eviction_.Insert(page);
+        page_faults_++;
+        return true;
+    }
+
+    void Freeze(void *page)
+    {
+        // Note: Caller must hold lock_
+
+        // Write-protect first so no store from another thread slips in
+        // between encoding and releasing the page
+#ifdef _WIN32
+        DWORD old_protect;
+        VirtualProtect(page, PAGE_SIZE, PAGE_READONLY, &old_protect);
+#else
+        mprotect(page, PAGE_SIZE, PROT_READ);
+#endif
+
+        size_t size = codec_.Encode((const char *)page, scratch_);
+        if (size > 0)
+        {
+            cipher_.Apply(page, scratch_, size);
+        }
+        if (size == 0 || !backing_.Store(page, scratch_, size))
+        {
+            // Keep the page resident (over budget) rather than lose it
+#ifdef _WIN32
+            VirtualProtect(page, PAGE_SIZE, PAGE_READWRITE, &old_protect);
+#else
+            mprotect(page, PAGE_SIZE, PROT_READ | PROT_WRITE);
+#endif
+            eviction_.Insert(page);
+            return;
+        }
+
+        // Release the physical page; the next access faults
+#ifdef _WIN32
+        VirtualFree(page, PAGE_SIZE, MEM_DECOMMIT);
+#else
+        mprotect(page, PAGE_SIZE, PROT_NONE);
+        madvise(page, PAGE_SIZE, MADV_DONTNEED);
+#endif
+        evictions_++;
+    }
+
+    void Release(void *ptr, size_t size)
+    {
+        // Note: Caller must hold lock_ (or be the destructor)
+
+        for (size_t offset = 0; offset < size; offset += PAGE_SIZE)
+        {
+            void *page = (char *)ptr + offset;
+            eviction_.Remove(page);
+            backing_.Erase(page);
+        }
+#ifdef _WIN32
+        VirtualFree(ptr, 0, MEM_RELEASE);
+#else
+        munmap(ptr, size);
+#endif
+    }
+
+    Regions regions_;
+    Backing backing_;
+    Codec codec_;
+    Cipher cipher_;
+    Eviction eviction_;
+    mutable Lock lock_;
+    size_t max_resident_pages_;
+    bool registered_ = false;
+
+    uint64_t page_faults_ = 0;
+    uint64_t refaults_ = 0;
+    uint64_t evictions_ = 0;
+
+    /// Encoded page being frozen or restored
+    char scratch_[Codec::kMaxEncodedSize];
+};
+
+/**
+ * @brief In-memory LZ4 with LRU eviction - the default configuration of
+ *        GhostMemoryManager without any runtime switches
+ */
+using GhostLz4Manager = BasicGhostManager<GhostMemoryBacking, GhostLz4Codec, GhostNoCipher,
+                                          GhostLruEviction, GhostMutexLock>;
+
+/**
+ * @brief LZ4-compressed, ChaCha20-encrypted pages in a swap file
+ *        (call GetBacking().Open(path) before allocating)
+ */
+using GhostEncryptedDiskManager = BasicGhostManager<GhostDiskBacking, GhostLz4Codec, GhostChaCha20Cipher,
+                                                    GhostLruEviction, GhostMutexLock>;
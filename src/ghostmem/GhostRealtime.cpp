@@ -0,0 +1,160 @@
+/*******************************************************************************
+ * GhostMem - Virtual RAM through Transparent Compression
+ *
+ * Copyright (C) 2026 Swen Kalski
+ *
+ * This file is part of GhostMem.
+ *
+ * GhostMem is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GhostMem is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GhostMem. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Contact: kalski.swen@gmail.com
+ ******************************************************************************/
+
+/**
+ * @file GhostRealtime.cpp
+ * @brief Memory locking for GhostRealtimeManager
+ *
+ * @author Swen Kalski
+ * @date 2026
+ */
+
+#include "GhostRealtime.h"
+
+#include <mutex>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <link.h>       // dl_iterate_phdr
+#include <sys/mman.h>   // mlock
+#endif
+
+namespace
+{
+    /// An address inside the fault handler's module
+    const void *FaultPathAddress()
+    {
+        return reinterpret_cast<const void *>(&GhostFaultDispatcher::Dispatch);
+    }
+
+#ifndef _WIN32
+    struct LockRequest
+    {
+        uintptr_t target;
+        bool found;
+        bool locked;
+    };
+
+    int LockModuleSegments(struct dl_phdr_info *info, size_t, void *data)
+    {
+        LockRequest *request = static_cast<LockRequest *>(data);
+
+        bool contains = false;
+        for (int i = 0; i < info->dlpi_phnum; i++)
+        {
+            const ElfW(Phdr) &segment = info->dlpi_phdr[i];
+            uintptr_t start = info->dlpi_addr + segment.p_vaddr;
+            if (segment.p_type == PT_LOAD &&
+                request->target >= start && request->target < start + segment.p_memsz)
+            {
+                contains = true;
+            }
+        }
+        if (!contains)
+        {
+            return 0;
+        }
+
+        // Code, read-only data, data and bss of the module
+        request->found = true;
+        request->locked = true;
+        for (int i = 0; i < info->dlpi_phnum; i++)
+        {
+            const ElfW(Phdr) &segment = info->dlpi_phdr[i];
+            if (segment.p_type != PT_LOAD || segment.p_memsz == 0)
+            {
+                continue;
+            }
+            uintptr_t start = info->dlpi_addr + segment.p_vaddr;
+            uintptr_t page_start = start & ~(uintptr_t)(PAGE_SIZE - 1);
+            size_t length = (size_t)(start + segment.p_memsz - page_start);
+            if (mlock((const void *)page_start, length) != 0)
+            {
+                request->locked = false;
+            }
+        }
+        return 1;
+    }
+#endif
+}
+
+bool GhostLockMemory(const void *addr, size_t size)
+{
+#ifdef _WIN32
+    return VirtualLock(const_cast<void *>(addr), size) != FALSE;
+#else
+    return mlock(addr, size) == 0;
+#endif
+}
+
+void GhostUnlockMemory(const void *addr, size_t size)
+{
+#ifdef _WIN32
+    VirtualUnlock(const_cast<void *>(addr), size);
+#else
+    munlock(addr, size);
+#endif
+}
+
+bool GhostLockFaultPath()
+{
+    static std::once_flag once;
+    static bool locked = false;
+
+    std::call_once(once, []()
+    {
+#ifdef _WIN32
+        HMODULE module = NULL;
+        if (!GetModuleHandleExA(GET_MODULE_HANDLE_EX_FLAG_FROM_ADDRESS |
+                                GET_MODULE_HANDLE_EX_FLAG_UNCHANGED_REFCOUNT,
+                                (LPCSTR)FaultPathAddress(), &module))
+        {
+            return;
+        }
+
+        // Walk the image's regions and lock the committed ones
+        locked = true;
+        MEMORY_BASIC_INFORMATION info;
+        const char *address = (const char *)module;
+        while (VirtualQuery(address, &info, sizeof(info)) == sizeof(info) &&
+               info.AllocationBase == (PVOID)module)
+        {
+            if (info.State == MEM_COMMIT && !(info.Protect & (PAGE_NOACCESS | PAGE_GUARD)))
+            {
+                if (!VirtualLock(info.BaseAddress, info.RegionSize))
+                {
+                    locked = false;
+                }
+            }
+            address = (const char *)info.BaseAddress + info.RegionSize;
+        }
+#else
+        LockRequest request = {(uintptr_t)FaultPathAddress(), false, false};
+        dl_iterate_phdr(LockModuleSegments, &request);
+        locked = request.found && request.locked;
+#endif
+    });
+
+    return locked;
+}
@@ -0,0 +1,146 @@
+/*******************************************************************************
+ * GhostMem - Virtual RAM through Transparent Compression
+ *
+ * Copyright (C) 2026 Swen Kalski
+ *
+ * This file is part of GhostMem.
+ *
+ * GhostMem is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GhostMem is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GhostMem. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Contact: kalski.swen@gmail.com
+ ******************************************************************************/
+
+/**
+ * @file GhostRealtime.h
+ * @brief Bounded-latency ghost memory for real-time threads
+ *
+ * A fault in GhostMemoryManager may allocate, wait for the recursive
+ * mutex while another thread writes to the swap file, or read the swap
+ * file itself, so its latency has no upper bound. GhostRealtimeManager
+ * removes each of these:
+ *
+ * - Metadata and compressed pages live in fixed tables and a pool inside
+ *   the manager (GhostFixedPolicies.h): no heap use after construction.
+ * - No disk tier: a page restored from disk would need a read on the
+ *   fault path. Frozen pages stay in the compressed pool.
+ * - The LZ4 state is preallocated (GhostLz4StateCodec).
+ * - The manager object, and the code and static data of the module that
+ *   contains the fault handler, are locked into RAM, so the fault path
+ *   itself cannot take a major fault.
+ * - The lock uses priority inheritance (GhostPriorityInheritLock).
+ * - Faults are offered to the manager before any other manager, so they
+ *   never wait for GhostMemoryManager's mutex on their way in.
+ *
+ * Every fault then does a fixed amount of work: at most one freeze (LZ4
+ * of one page into the pool) and one restore (one LZ4 decompression),
+ * plus three to four mprotect/madvise calls. kWorstCaseFaultMicros is
+ * the bound the benchmark suite checks on request (see PerformanceMetrics_
+ * RealtimeFaultLatency in tests/test_metrics.cpp).
+ *
+ * @author Swen Kalski
+ * @date 2026
+ */
+
+#pragma once
+
+#include "GhostFixedPolicies.h"
+
+#include <cstddef>
+
+/**
+ * @brief Locks a memory range into RAM (mlock / VirtualLock)
+ * @return false if the OS refused, e.g. RLIMIT_MEMLOCK is too low
+ */
+bool GhostLockMemory(const void *addr, size_t size);
+
+/**
+ * @brief Undoes GhostLockMemory()
+ */
+void GhostUnlockMemory(const void *addr, size_t size);
+
+/**
+ * @brief Locks the code and static data of the module containing the
+ *        fault handler (the executable or the GhostMem shared library)
+ *
+ * Done once per process and kept until exit; later calls return the
+ * first result.
+ *
+ * @return false if the module could not be found or locked
+ */
+bool GhostLockFaultPath();
+
+/**
+ * @class GhostRealtimeManager
+ * @brief Fixed-capacity manager with a bounded, lock-friendly fault path
+ *
+ * @tparam MaxFrozenPages Frozen pages the pool can index
+ * @tparam PoolBytes Bytes of compressed storage
+ * @tparam MaxResidentPages Pages resident at once
+ * @tparam MaxRegions Live allocations
+ *
+ * The object holds the pool; give it static storage or allocate it once
+ * at startup, before the real-time threads run. Capacity limits behave as
+ * for GhostFixedManager.
+ *
+ * @code
+ * static GhostRealtimeManager<1024, 1024 * 1024, 64, 4> manager(64);
+ * if (!manager.IsLocked()) { ... raise RLIMIT_MEMLOCK ... }
+ * float *samples = static_cast<float *>(manager.Allocate(4 << 20));
+ * @endcode
+ */
+template <size_t MaxFrozenPages, size_t PoolBytes, size_t MaxResidentPages, size_t MaxRegions>
+class GhostRealtimeManager
+    : public BasicGhostManager<GhostFixedMemoryBacking<MaxFrozenPages, PoolBytes>,
+                               GhostLz4StateCodec, GhostNoCipher,
+                               GhostFixedLruEviction<MaxResidentPages>,
+                               GhostPriorityInheritLock,
+                               GhostFixedRegions<MaxRegions>>
+{
+public:
+    /// Fault latency bound on a real-time kernel: one freeze
+    /// plus one restore of incompressible data. Typical figures on a
+    /// 2+ GHz x86-64 core are 20-30 us p99 and ~100 us max; the bound
+    /// leaves room for interrupts and hypervisor steal time.
+    static constexpr double kWorstCaseFaultMicros = 1000.0;
+
+    explicit GhostRealtimeManager(size_t max_resident_pages = MaxResidentPages)
+        : GhostRealtimeManager::BasicGhostManager(max_resident_pages, true)
+    {
+        object_locked_ = GhostLockMemory(this, sizeof(*this));
+        locked_ = object_locked_ && GhostLockFaultPath();
+    }
+
+    ~GhostRealtimeManager()
+    {
+        if (object_locked_)
+        {
+            GhostUnlockMemory(this, sizeof(*this));
+        }
+    }
+
+    /**
+     * @brief Whether the manager and the fault path are locked into RAM
+     *
+     * If false, the manager still works, but a fault may wait for the
+     * kernel to page the handler or the pool back in.
+     */
+    bool IsLocked() const
+    {
+        return locked_;
+    }
+
+private:
+    bool object_locked_ = false;
+    bool locked_ = false;
+};
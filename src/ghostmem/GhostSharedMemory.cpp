@@ -0,0 +1,167 @@
+/*******************************************************************************
+ * GhostMem - Virtual RAM through Transparent Compression
+ *
+ * Copyright (C) 2026 Swen Kalski
+ *
+ * This file is part of GhostMem.
+ *
+ * GhostMem is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GhostMem is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GhostMem. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Contact: kalski.swen@gmail.com
+ ******************************************************************************/
+
+/**
+ * @file GhostSharedMemory.cpp
+ * @brief Named shared memory segments shared between processes
+ *
+ * @author Swen Kalski
+ * @date 2026
+ */
+
+#include "GhostSharedMemory.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <cerrno>
+#include <fcntl.h>      // O_CREAT, O_RDWR
+#include <sys/mman.h>   // shm_open, mmap
+#include <sys/stat.h>   // fstat
+#include <unistd.h>     // ftruncate, close
+#endif
+
+GhostSharedMemory::~GhostSharedMemory()
+{
+    Close();
+}
+
+bool GhostSharedMemory::Open(const std::string& name, size_t size, bool create,
+                             bool read_only, bool* out_created)
+{
+    Close();
+
+    bool created = false;
+
+#ifdef _WIN32
+    std::string full_name = "Local\\" + name;
+    DWORD access = read_only ? FILE_MAP_READ : FILE_MAP_ALL_ACCESS;
+
+    HANDLE handle = OpenFileMappingA(access, FALSE, full_name.c_str());
+    if (handle == NULL && create && !read_only)
+    {
+        handle = CreateFileMappingA(INVALID_HANDLE_VALUE, NULL, PAGE_READWRITE,
+                                    (DWORD)((unsigned long long)size >> 32),
+                                    (DWORD)(size & 0xFFFFFFFF),
+                                    full_name.c_str());
+        created = (handle != NULL && GetLastError() != ERROR_ALREADY_EXISTS);
+    }
+    if (handle == NULL)
+    {
+        return false;
+    }
+
+    void* view = MapViewOfFile(handle, access, 0, 0, size);
+    if (view == NULL)
+    {
+        CloseHandle(handle);
+        return false;
+    }
+
+    mapping_handle_ = handle;
+    data_ = view;
+#else
+    std::string full_name = "/" + name;
+    int fd = -1;
+
+    if (create && !read_only)
+    {
+        // Try exclusive creation first so we know who initializes the segment
+        fd = shm_open(full_name.c_str(), O_CREAT | O_EXCL | O_RDWR, S_IRUSR | S_IWUSR);
+        created = (fd >= 0);
+    }
+    if (fd < 0)
+    {
+        fd = shm_open(full_name.c_str(), read_only ? O_RDONLY : O_RDWR, 0);
+    }
+    if (fd < 0)
+    {
+        return false;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0)
+    {
+        close(fd);
+        return false;
+    }
+
+    if ((size_t)st.st_size < size)
+    {
+        // The creator may not have sized the segment yet; growing it to the
+        // agreed size is idempotent. Observers cannot do that, so they fail.
+        if (read_only || ftruncate(fd, (off_t)size) != 0)
+        {
+            close(fd);
+            return false;
+        }
+    }
+
+    void* view = mmap(NULL, size, read_only ? PROT_READ : (PROT_READ | PROT_WRITE),
+                      MAP_SHARED, fd, 0);
+    close(fd);  // The mapping keeps the segment alive
+
+    if (view == MAP_FAILED)
+    {
+        return false;
+    }
+
+    data_ = view;
+#endif
+
+    size_ = size;
+    if (out_created)
+    {
+        *out_created = created;
+    }
+    return true;
+}
+
+void GhostSharedMemory::Close()
+{
+    if (data_ == nullptr)
+    {
+        return;
+    }
+
+#ifdef _WIN32
+    UnmapViewOfFile(data_);
+    CloseHandle((HANDLE)mapping_handle_);
+    mapping_handle_ = nullptr;
+#else
+    munmap(data_, size_);
+#endif
+
+    data_ = nullptr;
+    size_ = 0;
+}
+
+void GhostSharedMemory::Unlink(const std::string& name)
+{
+#ifndef _WIN32
+    std::string full_name = "/" + name;
+    shm_unlink(full_name.c_str());
+#else
+    (void)name;
+#endif
+}
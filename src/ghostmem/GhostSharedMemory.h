@@ -0,0 +1,96 @@
+/*******************************************************************************
+ * GhostMem - Virtual RAM through Transparent Compression
+ *
+ * Copyright (C) 2026 Swen Kalski
+ *
+ * This file is part of GhostMem.
+ *
+ * GhostMem is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GhostMem is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GhostMem. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Contact: kalski.swen@gmail.com
+ ******************************************************************************/
+
+/**
+ * @file GhostSharedMemory.h
+ * @brief Named shared memory segments shared between processes
+ *
+ * Thin cross-platform wrapper around POSIX shm_open/mmap and Windows
+ * named file mappings. Used by the features that need to exchange
+ * state with other processes on the same host.
+ *
+ * @author Swen Kalski
+ * @date 2026
+ */
+
+#pragma once
+
+#include <string>
+#include <cstddef>
+
+/**
+ * @class GhostSharedMemory
+ * @brief RAII handle for a named shared memory segment
+ *
+ * The segment is identified by a plain name such as "ghostmem-budget".
+ * The platform-specific prefix ("/" on POSIX, "Local\\" on Windows) is
+ * added internally, so the same name works on both platforms.
+ *
+ * Freshly created segments are zero-filled by the operating system.
+ */
+class GhostSharedMemory
+{
+public:
+    GhostSharedMemory() = default;
+    ~GhostSharedMemory();
+
+    GhostSharedMemory(const GhostSharedMemory&) = delete;
+    GhostSharedMemory& operator=(const GhostSharedMemory&) = delete;
+
+    /**
+     * @brief Opens (and optionally creates) a named segment
+     *
+     * @param name Segment name without platform prefix
+     * @param size Size of the segment in bytes
+     * @param create Create the segment if it does not exist yet
+     * @param read_only Map the segment read-only (for observers)
+     * @param out_created Receives true if this call created the segment
+     * @return true on success, false if the segment could not be mapped
+     */
+    bool Open(const std::string& name, size_t size, bool create,
+              bool read_only = false, bool* out_created = nullptr);
+
+    /**
+     * @brief Unmaps the segment (the segment itself stays alive)
+     */
+    void Close();
+
+    /**
+     * @brief Removes a named segment from the system
+     *
+     * Processes that still have the segment mapped keep their mapping.
+     * No-op on Windows, where the mapping disappears with its last handle.
+     */
+    static void Unlink(const std::string& name);
+
+    void* Data() const { return data_; }
+    size_t Size() const { return size_; }
+    bool IsOpen() const { return data_ != nullptr; }
+
+private:
+    void* data_ = nullptr;
+    size_t size_ = 0;
+#ifdef _WIN32
+    void* mapping_handle_ = nullptr;
+#endif
+};
@@ -0,0 +1,135 @@
+/*******************************************************************************
+ * GhostMem - Virtual RAM through Transparent Compression
+ *
+ * Copyright (C) 2026 Swen Kalski
+ *
+ * This file is part of GhostMem.
+ *
+ * GhostMem is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GhostMem is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GhostMem. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Contact: kalski.swen@gmail.com
+ ******************************************************************************/
+
+/**
+ * @file GhostStatsBlock.cpp
+ * @brief Lock-free statistics block readable from other threads and processes
+ *
+ * @author Swen Kalski
+ * @date 2026
+ */
+
+#include "GhostStatsBlock.h"
+
+#include <cstddef>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <unistd.h>     // getpid
+#endif
+
+namespace
+{
+    // The block is nothing but 64-bit atomics, so it can be walked as an array
+    const size_t kBlockWords = sizeof(GhostStatsBlock) / sizeof(std::atomic<uint64_t>);
+    static_assert(sizeof(GhostStatsBlock) % sizeof(std::atomic<uint64_t>) == 0,
+                  "GhostStatsBlock must consist of 64-bit atomics only");
+
+    std::atomic<uint64_t>* Words(GhostStatsBlock* block)
+    {
+        return reinterpret_cast<std::atomic<uint64_t>*>(block);
+    }
+
+    const std::atomic<uint64_t>* Words(const GhostStatsBlock* block)
+    {
+        return reinterpret_cast<const std::atomic<uint64_t>*>(block);
+    }
+}
+
+uint64_t GhostLatencyHistogram::Count() const
+{
+    uint64_t count = 0;
+    for (const auto& bucket : buckets)
+    {
+        count += bucket.load(std::memory_order_relaxed);
+    }
+    return count;
+}
+
+uint64_t GhostLatencyHistogram::Percentile(double quantile) const
+{
+    uint64_t counts[kBuckets];
+    uint64_t total = 0;
+    for (size_t i = 0; i < kBuckets; i++)
+    {
+        counts[i] = buckets[i].load(std::memory_order_relaxed);
+        total += counts[i];
+    }
+    if (total == 0)
+    {
+        return 0;
+    }
+
+    // Rank of the sample we are looking for (1-based)
+    uint64_t rank = (uint64_t)(quantile * (double)total);
+    if (rank < 1)
+    {
+        rank = 1;
+    }
+    if (rank > total)
+    {
+        rank = total;
+    }
+
+    uint64_t seen = 0;
+    for (size_t i = 0; i < kBuckets; i++)
+    {
+        seen += counts[i];
+        if (seen >= rank)
+        {
+            return BucketUpperBound(i);
+        }
+    }
+    return BucketUpperBound(kBuckets - 1);
+}
+
+void GhostStatsBlock::Reset()
+{
+    std::atomic<uint64_t>* words = Words(this);
+    for (size_t i = 0; i < kBlockWords; i++)
+    {
+        words[i].store(0, std::memory_order_relaxed);
+    }
+
+#ifdef _WIN32
+    pid.store((uint64_t)GetCurrentProcessId(), std::memory_order_relaxed);
+#else
+    pid.store((uint64_t)getpid(), std::memory_order_relaxed);
+#endif
+    version.store(kVersion, std::memory_order_relaxed);
+    magic.store(kMagic, std::memory_order_release);
+}
+
+void GhostStatsBlock::CopyFrom(const GhostStatsBlock& other)
+{
+    std::atomic<uint64_t>* words = Words(this);
+    const std::atomic<uint64_t>* source = Words(&other);
+
+    // Identity fields are kept; everything after them is copied
+    const size_t first = offsetof(GhostStatsBlock, page_faults) / sizeof(std::atomic<uint64_t>);
+    for (size_t i = first; i < kBlockWords; i++)
+    {
+        words[i].store(source[i].load(std::memory_order_relaxed), std::memory_order_relaxed);
+    }
+}
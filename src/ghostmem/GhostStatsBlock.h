@@ -0,0 +1,167 @@
+/*******************************************************************************
+ * GhostMem - Virtual RAM through Transparent Compression
+ *
+ * Copyright (C) 2026 Swen Kalski
+ *
+ * This file is part of GhostMem.
+ *
+ * GhostMem is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GhostMem is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GhostMem. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Contact: kalski.swen@gmail.com
+ ******************************************************************************/
+
+/**
+ * @file GhostStatsBlock.h
+ * @brief Lock-free statistics block readable from other threads and processes
+ *
+ * The manager publishes its counters into a GhostStatsBlock after every
+ * fault, freeze and idle scan, and records latencies directly into the
+ * block's histograms. Readers (ghostmem_top, exporters) only ever load
+ * relaxed atomics and never take the manager's mutex.
+ *
+ * The block is plain data made of lock-free 64-bit atomics, so it can
+ * live in process-private memory or in a named shared memory segment
+ * (see GhostConfig::stats_shm_name).
+ *
+ * @author Swen Kalski
+ * @date 2026
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @struct GhostLatencyHistogram
+ * @brief Log2-bucketed latency histogram
+ *
+ * Bucket i counts latencies in [2^i, 2^(i+1)) nanoseconds; bucket 0 also
+ * takes 0 and 1 ns and the last bucket takes everything above its lower
+ * bound. 40 buckets cover up to about 9 minutes.
+ */
+struct GhostLatencyHistogram
+{
+    static constexpr size_t kBuckets = 40;
+
+    std::atomic<uint64_t> buckets[kBuckets];
+
+    /// @brief Index of the bucket a latency falls into
+    static size_t BucketOf(uint64_t ns)
+    {
+        size_t index = 0;
+#if defined(__GNUC__) || defined(__clang__)
+        index = (ns > 1) ? (size_t)(63 - __builtin_clzll(ns)) : 0;
+#else
+        while (ns > 1)
+        {
+            ns >>= 1;
+            index++;
+        }
+#endif
+        return (index < kBuckets) ? index : kBuckets - 1;
+    }
+
+    /// @brief Exclusive upper bound of a bucket in nanoseconds
+    static uint64_t BucketUpperBound(size_t index)
+    {
+        return 1ULL << (index + 1);
+    }
+
+    void Record(uint64_t ns)
+    {
+        buckets[BucketOf(ns)].fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /// @brief Number of recorded samples
+    uint64_t Count() const;
+
+    /**
+     * @brief Upper bound of the bucket containing the given quantile
+     *
+     * @param quantile Value between 0.0 and 1.0 (e.g. 0.99)
+     * @return Latency in nanoseconds, 0 if the histogram is empty
+     */
+    uint64_t Percentile(double quantile) const;
+};
+
+/**
+ * @struct GhostStatsBlock
+ * @brief Published counters, gauges and latency histograms of one manager
+ *
+ * Field meanings match GhostStats. The layout is versioned; readers must
+ * check magic and version before interpreting the rest.
+ */
+struct GhostStatsBlock
+{
+    /// "GHOSTSTB" - marks an initialized block
+    static constexpr uint64_t kMagic = 0x4254535453484F47ULL;
+
+    /// Bumped whenever the layout changes
+    static constexpr uint64_t kVersion = 2;
+
+    std::atomic<uint64_t> magic;
+    std::atomic<uint64_t> version;
+    std::atomic<uint64_t> pid;              ///< Publishing process
+    std::atomic<uint64_t> page_size;
+    std::atomic<uint64_t> publish_count;    ///< Incremented on every publish
+
+    // Cumulative counters
+    std::atomic<uint64_t> page_faults;
+    std::atomic<uint64_t> refaults;
+    std::atomic<uint64_t> evictions;
+    std::atomic<uint64_t> thrash_refaults;
+    std::atomic<uint64_t> cold_refaults;
+    std::atomic<uint64_t> delta_freezes;
+    std::atomic<uint64_t> idle_freezes;
+    std::atomic<uint64_t> idle_soft_faults;
+    std::atomic<uint64_t> compression_ns;
+
+    // Current figures
+    std::atomic<uint64_t> resident_pages;
+    std::atomic<uint64_t> frozen_pages;
+    std::atomic<uint64_t> compressed_bytes;
+    std::atomic<uint64_t> disk_bytes;
+    std::atomic<uint64_t> budget_pages;
+    std::atomic<uint64_t> compression_acceleration;
+
+    // Latencies
+    GhostLatencyHistogram fault_latency;    ///< Whole fault handler
+    GhostLatencyHistogram restore_latency;  ///< Decompression / disk read of frozen data
+    GhostLatencyHistogram freeze_latency;   ///< Compression / disk write of one page
+
+    /**
+     * @brief Zeroes every field and stamps magic, version and pid
+     */
+    void Reset();
+
+    /**
+     * @brief Copies all counters and histograms from another block
+     *
+     * Used when the manager moves its statistics between private and
+     * shared memory, so cumulative values continue seamlessly.
+     */
+    void CopyFrom(const GhostStatsBlock& other);
+
+    /// @brief true if magic and version match this build
+    bool IsValid() const
+    {
+        return magic.load(std::memory_order_acquire) == kMagic &&
+               version.load(std::memory_order_relaxed) == kVersion;
+    }
+};
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free,
+              "Stats block requires address-free 64-bit atomics");
@@ -0,0 +1,167 @@
+/*******************************************************************************
+ * GhostMem - Virtual RAM through Transparent Compression
+ *
+ * Copyright (C) 2026 Swen Kalski
+ *
+ * This file is part of GhostMem.
+ *
+ * GhostMem is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GhostMem is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GhostMem. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Contact: kalski.swen@gmail.com
+ ******************************************************************************/
+
+/**
+ * @file GhostSymbolizer.cpp
+ * @brief Captures backtraces and maps code addresses to module, offset
+ *        and symbol name
+ *
+ * @author Swen Kalski
+ * @date 2026
+ */
+
+#include "GhostSymbolizer.h"
+
+#include <cstdio>
+#include <cstdlib>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <dlfcn.h>      // dladdr
+#if defined(__GLIBC__) || defined(__APPLE__)
+#include <execinfo.h>   // backtrace
+#define GHOSTMEM_HAVE_BACKTRACE 1
+#endif
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#include <cxxabi.h>     // abi::__cxa_demangle
+#endif
+
+namespace
+{
+    std::string Demangle(const char *name)
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        int status = 0;
+        char *demangled = abi::__cxa_demangle(name, nullptr, nullptr, &status);
+        if (status == 0 && demangled)
+        {
+            std::string result(demangled);
+            free(demangled);
+            return result;
+        }
+#endif
+        return name;
+    }
+
+    /// Upper bound for one capture (skipped frames included)
+    const size_t kMaxCaptureFrames = 64;
+
+    std::string BaseName(const std::string &path)
+    {
+        size_t slash = path.find_last_of("/\\");
+        return (slash == std::string::npos) ? path : path.substr(slash + 1);
+    }
+}
+
+std::string GhostCodeLocation::ToString() const
+{
+    char text[64];
+    std::string result;
+
+    if (!symbol.empty())
+    {
+        snprintf(text, sizeof(text), "+0x%llx", (unsigned long long)symbol_offset);
+        result = symbol + text + " ";
+    }
+
+    snprintf(text, sizeof(text), "+0x%llx", (unsigned long long)module_offset);
+    result += "(" + (module.empty() ? std::string("?") : BaseName(module)) + text + ")";
+    return result;
+}
+
+GhostCodeLocation GhostSymbolize(const void *address)
+{
+    GhostCodeLocation location;
+    location.module_offset = (uintptr_t)address;
+
+#ifdef _WIN32
+    HMODULE module = NULL;
+    if (GetModuleHandleExA(GET_MODULE_HANDLE_EX_FLAG_FROM_ADDRESS |
+                           GET_MODULE_HANDLE_EX_FLAG_UNCHANGED_REFCOUNT,
+                           (LPCSTR)address, &module))
+    {
+        char path[MAX_PATH];
+        DWORD length = GetModuleFileNameA(module, path, MAX_PATH);
+        if (length > 0)
+        {
+            location.module.assign(path, length);
+        }
+        location.module_offset = (uintptr_t)address - (uintptr_t)module;
+    }
+#else
+    Dl_info info;
+    if (dladdr(address, &info) != 0)
+    {
+        if (info.dli_fname)
+        {
+            location.module = info.dli_fname;
+        }
+        location.module_offset = (uintptr_t)address - (uintptr_t)info.dli_fbase;
+        if (info.dli_sname && info.dli_saddr)
+        {
+            location.symbol = Demangle(info.dli_sname);
+            location.symbol_offset = (uintptr_t)address - (uintptr_t)info.dli_saddr;
+        }
+    }
+#endif
+
+    return location;
+}
+
+#if defined(__GNUC__) || defined(__clang__)
+__attribute__((noinline))
+#elif defined(_MSC_VER)
+__declspec(noinline)
+#endif
+size_t GhostCaptureBacktrace(const void **frames, size_t max_frames, size_t skip)
+{
+    skip++;  // This function
+    if (max_frames + skip > kMaxCaptureFrames)
+    {
+        max_frames = (kMaxCaptureFrames > skip) ? kMaxCaptureFrames - skip : 0;
+    }
+    if (max_frames == 0)
+    {
+        return 0;
+    }
+
+#ifdef _WIN32
+    return CaptureStackBackTrace((DWORD)skip, (DWORD)max_frames, (PVOID *)frames, NULL);
+#elif defined(GHOSTMEM_HAVE_BACKTRACE)
+    void *buffer[kMaxCaptureFrames];
+    int captured = backtrace(buffer, (int)(max_frames + skip));
+    size_t count = 0;
+    for (int i = (int)skip; i < captured; i++)
+    {
+        frames[count++] = buffer[i];
+    }
+    return count;
+#else
+    (void)frames;
+    (void)max_frames;
+    return 0;
+#endif
+}
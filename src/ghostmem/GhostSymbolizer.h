@@ -0,0 +1,82 @@
+/*******************************************************************************
+ * GhostMem - Virtual RAM through Transparent Compression
+ *
+ * Copyright (C) 2026 Swen Kalski
+ *
+ * This file is part of GhostMem.
+ *
+ * GhostMem is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GhostMem is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GhostMem. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Contact: kalski.swen@gmail.com
+ ******************************************************************************/
+
+/**
+ * @file GhostSymbolizer.h
+ * @brief Captures backtraces and maps code addresses to module, offset
+ *        and symbol name
+ *
+ * Resolution uses only what the dynamic loader knows (dladdr on POSIX,
+ * the module list on Windows), so it works in release builds without
+ * debug information. Functions that are not exported (static functions,
+ * executables linked without -rdynamic) resolve to their module and
+ * offset only; `addr2line -f -C -e <module> <offset>` turns those into
+ * file and line when debug information is available.
+ *
+ * @author Swen Kalski
+ * @date 2026
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/**
+ * @struct GhostCodeLocation
+ * @brief Symbolized code address
+ */
+struct GhostCodeLocation
+{
+    std::string module;         ///< Path of the executable or shared library ("" = unknown)
+    uintptr_t module_offset = 0; ///< Address relative to the module's load base
+    std::string symbol;         ///< Demangled function name ("" = not exported)
+    uintptr_t symbol_offset = 0; ///< Address relative to the start of symbol
+
+    /**
+     * @brief One-line description, e.g. "Scan(int)+0x2a (app+0x1234)"
+     */
+    std::string ToString() const;
+};
+
+/**
+ * @brief Resolves a code address
+ *
+ * Not async-signal-safe; call it from normal context (e.g. when a report
+ * is requested), never from the fault handler.
+ */
+GhostCodeLocation GhostSymbolize(const void *address);
+
+/**
+ * @brief Captures the return addresses of the calling thread's stack
+ *
+ * Uses backtrace() on glibc / macOS and CaptureStackBackTrace() on
+ * Windows; returns 0 frames where neither is available.
+ *
+ * @param frames Output array
+ * @param max_frames Capacity of frames
+ * @param skip Frames to drop above the caller (0 = caller is frames[0])
+ * @return Number of frames stored
+ */
+size_t GhostCaptureBacktrace(const void **frames, size_t max_frames, size_t skip);
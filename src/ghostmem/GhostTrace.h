@@ -0,0 +1,105 @@
+/*******************************************************************************
+ * GhostMem - Virtual RAM through Transparent Compression
+ *
+ * Copyright (C) 2026 Swen Kalski
+ *
+ * This file is part of GhostMem.
+ *
+ * GhostMem is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GhostMem is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GhostMem. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Contact: kalski.swen@gmail.com
+ ******************************************************************************/
+
+/**
+ * @file GhostTrace.h
+ * @brief USDT (SystemTap-compatible) static tracepoints
+ *
+ * When built with GHOSTMEM_ENABLE_USDT (CMake option ENABLE_USDT, needs
+ * <sys/sdt.h> from systemtap-sdt-dev), each GHOST_TRACE point compiles to
+ * a single nop plus an ELF note describing its arguments. perf, bpftrace
+ * and SystemTap patch the nop into a breakpoint only while attached, so
+ * an unattached probe costs nothing measurable. Without the option, the
+ * macros expand to nothing.
+ *
+ * Provider "ghostmem", probes and arguments:
+ *
+ * | Probe           | Arguments                                          |
+ * |-----------------|----------------------------------------------------|
+ * | fault_entry     | fault address (before the manager's lock is taken) |
+ * | fault_done      | page, restored tier, latency ns, tag               |
+ * | idle_touch      | page, latency ns                                   |
+ * | restore         | page, tier, stored size, latency ns                |
+ * | evict           | page, resident pages                               |
+ * | freeze          | page, tier, stored size, latency ns                |
+ * | disk_write      | file offset, size, latency ns                      |
+ * | disk_read       | file offset, size, latency ns                      |
+ *
+ * Tiers use GhostStorageTier values: 0 none (first touch), 1 memory,
+ * 2 disk (compressed), 3 disk (raw). Latencies are in nanoseconds.
+ *
+ * Example (bpftrace, fault latency histogram in microseconds):
+ * @code
+ * bpftrace -e 'usdt:./app:ghostmem:fault_done { @us = hist(arg2 / 1000); }'
+ * @endcode
+ *
+ * @author Swen Kalski
+ * @date 2026
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+#if defined(GHOSTMEM_ENABLE_USDT) && !defined(_WIN32)
+#include <sys/sdt.h>
+#define GHOSTMEM_HAVE_USDT 1
+#endif
+
+#ifdef GHOSTMEM_HAVE_USDT
+#define GHOST_TRACE1(name, a1) \
+    DTRACE_PROBE1(ghostmem, name, a1)
+#define GHOST_TRACE2(name, a1, a2) \
+    DTRACE_PROBE2(ghostmem, name, a1, a2)
+#define GHOST_TRACE3(name, a1, a2, a3) \
+    DTRACE_PROBE3(ghostmem, name, a1, a2, a3)
+#define GHOST_TRACE4(name, a1, a2, a3, a4) \
+    DTRACE_PROBE4(ghostmem, name, a1, a2, a3, a4)
+#else
+// Arguments are not evaluated; sizeof only keeps them "used"
+#define GHOST_TRACE1(name, a1) \
+    do { (void)sizeof(a1); } while (0)
+#define GHOST_TRACE2(name, a1, a2) \
+    do { (void)sizeof(a1); (void)sizeof(a2); } while (0)
+#define GHOST_TRACE3(name, a1, a2, a3) \
+    do { (void)sizeof(a1); (void)sizeof(a2); (void)sizeof(a3); } while (0)
+#define GHOST_TRACE4(name, a1, a2, a3, a4) \
+    do { (void)sizeof(a1); (void)sizeof(a2); (void)sizeof(a3); (void)sizeof(a4); } while (0)
+#endif
+
+/**
+ * @brief Timestamp for latencies that are only needed by tracepoints
+ *
+ * Returns 0 when probes are compiled out, so untraced builds do not pay
+ * for reading the clock around every disk access.
+ */
+inline uint64_t GhostTraceNow()
+{
+#ifdef GHOSTMEM_HAVE_USDT
+    return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+#else
+    return 0;
+#endif
+}
@@ -0,0 +1,135 @@
+#include "test_framework.h"
+#include "ghostmem/GhostMemoryManager.h"
+#include <chrono>
+#include <cstring>
+#include <thread>
+
+static void FillMixedPages(char* data, size_t num_pages) {
+    const char* text = "adaptive acceleration trades ratio for speed ";
+    size_t len = strlen(text);
+    uint32_t state = 12345;
+    for (size_t p = 0; p < num_pages; p++) {
+        for (size_t i = 0; i < PAGE_SIZE; i++) {
+            state = state * 1103515245u + 12345u;
+            data[p * PAGE_SIZE + i] = (i % 8 == 0) ? static_cast<char>(state >> 24) : text[(i + p) % len];
+        }
+    }
+}
+
+static bool CheckMixedPages(char* data, size_t num_pages) {
+    const char* text = "adaptive acceleration trades ratio for speed ";
+    size_t len = strlen(text);
+    uint32_t state = 12345;
+    for (size_t p = 0; p < num_pages; p++) {
+        volatile char* page = data + p * PAGE_SIZE;
+        for (size_t i = 0; i < PAGE_SIZE; i++) {
+            state = state * 1103515245u + 12345u;
+            char expected = (i % 8 == 0) ? static_cast<char>(state >> 24) : text[(i + p) % len];
+            if (page[i] != expected) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// Cyclic scans over twice the budget: every fault compresses one page
+static void Thrash(char* data, size_t num_pages, size_t rounds) {
+    for (size_t r = 0; r < rounds; r++) {
+        for (size_t p = 0; p < num_pages; p++) {
+            volatile char* byte = data + p * PAGE_SIZE + 1;
+            *byte = *byte;
+        }
+    }
+}
+
+// Without adaptation the minimum acceleration is used as a fixed setting
+TEST(AdaptiveCompressionDisabledIsFixed) {
+    GhostConfig config;
+    config.max_memory_pages = 4;
+    config.compression_acceleration_min = 8;
+    ASSERT_TRUE(GhostMemoryManager::Instance().Initialize(config));
+
+    GhostStats before = GhostMemoryManager::Instance().GetStats();
+    const size_t num_pages = 8;
+    char* data = static_cast<char*>(GhostMemoryManager::Instance().AllocateGhost(num_pages * PAGE_SIZE));
+    ASSERT_NOT_NULL(data);
+    FillMixedPages(data, num_pages);
+    Thrash(data, num_pages, 3);
+    ASSERT_TRUE(CheckMixedPages(data, num_pages));
+
+    GhostStats after = GhostMemoryManager::Instance().GetStats();
+    ASSERT_EQ(after.compression_acceleration, 8);
+    ASSERT_EQ(after.compression_adjustments, before.compression_adjustments);
+    ASSERT_TRUE(after.compression_ns > before.compression_ns);
+
+    GhostMemoryManager::Instance().DeallocateGhost(data, num_pages * PAGE_SIZE);
+    ASSERT_TRUE(GhostMemoryManager::Instance().Initialize(GhostConfig()));
+}
+
+// Compression over its CPU share speeds up; pages stay intact throughout
+TEST(AdaptiveCompressionSpeedsUpUnderLoad) {
+    GhostConfig config;
+    config.max_memory_pages = 8;
+    config.enable_adaptive_compression = true;
+    config.compression_acceleration_max = 16;
+    config.compression_cpu_percent = 1;
+    config.compression_tune_interval_ms = 1;
+    ASSERT_TRUE(GhostMemoryManager::Instance().Initialize(config));
+    ASSERT_EQ(GhostMemoryManager::Instance().GetStats().compression_acceleration, 1);
+
+    GhostStats before = GhostMemoryManager::Instance().GetStats();
+    const size_t num_pages = 16;
+    char* data = static_cast<char*>(GhostMemoryManager::Instance().AllocateGhost(num_pages * PAGE_SIZE));
+    ASSERT_NOT_NULL(data);
+    FillMixedPages(data, num_pages);
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (GhostMemoryManager::Instance().GetStats().compression_acceleration < 16 &&
+           std::chrono::steady_clock::now() < deadline) {
+        Thrash(data, num_pages, 10);
+    }
+    ASSERT_TRUE(CheckMixedPages(data, num_pages));
+
+    GhostStats after = GhostMemoryManager::Instance().GetStats();
+    ASSERT_EQ(after.compression_acceleration, 16);  // Capped at the maximum
+    ASSERT_TRUE(after.compression_adjustments - before.compression_adjustments >= 4);
+    ASSERT_EQ(GhostMemoryManager::Instance().GetStatsBlock().compression_acceleration.load(), 16u);
+
+    GhostMemoryManager::Instance().DeallocateGhost(data, num_pages * PAGE_SIZE);
+    ASSERT_TRUE(GhostMemoryManager::Instance().Initialize(GhostConfig()));
+}
+
+// Occasional freezes use little CPU: acceleration falls back to the minimum
+TEST(AdaptiveCompressionRelaxesWhenQuiet) {
+    GhostConfig config;
+    config.max_memory_pages = 8;
+    config.enable_adaptive_compression = true;
+    config.compression_acceleration_min = 2;
+    config.compression_acceleration_max = 32;
+    config.compression_cpu_percent = 1;
+    config.compression_tune_interval_ms = 2;
+    ASSERT_TRUE(GhostMemoryManager::Instance().Initialize(config));
+
+    const size_t num_pages = 16;
+    char* data = static_cast<char*>(GhostMemoryManager::Instance().AllocateGhost(num_pages * PAGE_SIZE));
+    ASSERT_NOT_NULL(data);
+    FillMixedPages(data, num_pages);
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (GhostMemoryManager::Instance().GetStats().compression_acceleration < 32 &&
+           std::chrono::steady_clock::now() < deadline) {
+        Thrash(data, num_pages, 10);
+    }
+    ASSERT_EQ(GhostMemoryManager::Instance().GetStats().compression_acceleration, 32);
+
+    // One fault (one freeze) per window: far below 1% of the time
+    for (size_t i = 0; i < 12; i++) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        volatile char* byte = data + (i % num_pages) * PAGE_SIZE;
+        *byte = *byte;
+    }
+    ASSERT_EQ(GhostMemoryManager::Instance().GetStats().compression_acceleration, 2);
+    ASSERT_TRUE(CheckMixedPages(data, num_pages));
+
+    GhostMemoryManager::Instance().DeallocateGhost(data, num_pages * PAGE_SIZE);
+    ASSERT_TRUE(GhostMemoryManager::Instance().Initialize(GhostConfig()));
+}
@@ -0,0 +1,126 @@
+#include "test_framework.h"
+#include "ghostmem/GhostMemoryManager.h"
+#include <cstdint>
+#include <cstring>
+#include <sstream>
+#include <string>
+
+#ifdef _MSC_VER
+#define GHOST_TEST_NOINLINE __declspec(noinline)
+#else
+#define GHOST_TEST_NOINLINE __attribute__((noinline))
+#endif
+
+static const size_t kSitePages = 6;
+
+// Two allocation sites: one with text-like data, one with noise
+GHOST_TEST_NOINLINE char* AllocateCompressible() {
+    char* data = static_cast<char*>(GhostMemoryManager::Instance().AllocateGhost(kSitePages * PAGE_SIZE));
+    for (size_t p = 0; p < kSitePages; p++) {
+        memset(data + p * PAGE_SIZE, 'A', PAGE_SIZE);
+    }
+    return data;
+}
+
+GHOST_TEST_NOINLINE char* AllocateNoise() {
+    char* data = static_cast<char*>(GhostMemoryManager::Instance().AllocateGhost(kSitePages * PAGE_SIZE));
+    uint32_t state = 0x12345678;
+    for (size_t p = 0; p < kSitePages; p++) {
+        char* page = data + p * PAGE_SIZE;
+        for (size_t i = 0; i < PAGE_SIZE; i++) {
+            state = state * 1664525u + 1013904223u;
+            page[i] = static_cast<char>(state >> 24);
+        }
+    }
+    return data;
+}
+
+// Called through pointers so the compiler cannot clone or inline them
+static char* (*volatile allocate_compressible)() = AllocateCompressible;
+static char* (*volatile allocate_noise)() = AllocateNoise;
+
+// The site whose innermost frame is the closest return address after function
+static const GhostAllocationSite* FindSite(const std::vector<GhostAllocationSite>& sites, const void* function) {
+    uintptr_t start = reinterpret_cast<uintptr_t>(function);
+    const GhostAllocationSite* best = nullptr;
+    uintptr_t best_distance = 1024;
+    for (const GhostAllocationSite& site : sites) {
+        if (site.frames.empty()) {
+            continue;
+        }
+        uintptr_t caller = reinterpret_cast<uintptr_t>(site.frames[0]);
+        if (caller > start && caller - start < best_distance) {
+            best = &site;
+            best_distance = caller - start;
+        }
+    }
+    return best;
+}
+
+// Live bytes, page placement and compression are split by call stack
+TEST(AllocationSitesAggregateByCallStack) {
+    GhostConfig config;
+    config.max_memory_pages = 4;
+    config.track_allocation_sites = true;
+    ASSERT_TRUE(GhostMemoryManager::Instance().Initialize(config));
+
+    // Same stack both times (volatile count keeps the loop from unrolling)
+    char* compressible[2];
+    volatile int count = 2;
+    for (int i = 0; i < count; i++) {
+        compressible[i] = allocate_compressible();
+        ASSERT_NOT_NULL(compressible[i]);
+    }
+    char* noise = allocate_noise();
+    ASSERT_NOT_NULL(noise);
+
+    std::vector<GhostAllocationSite> sites = GhostMemoryManager::Instance().GetAllocationSites();
+    const GhostAllocationSite* text = FindSite(sites, reinterpret_cast<const void*>(&AllocateCompressible));
+    const GhostAllocationSite* random = FindSite(sites, reinterpret_cast<const void*>(&AllocateNoise));
+    ASSERT_NOT_NULL(text);
+    ASSERT_NOT_NULL(random);
+    ASSERT_TRUE(text->id != random->id);
+
+    ASSERT_EQ(text->allocations, 2u);
+    ASSERT_EQ(text->live_allocations, 2u);
+    ASSERT_EQ(text->live_bytes, 2 * kSitePages * PAGE_SIZE);
+    ASSERT_EQ(text->resident_pages + text->frozen_pages, 2 * kSitePages);
+    ASSERT_EQ(text->page_faults, 2 * kSitePages);
+    ASSERT_TRUE(text->compression_ratio > 10.0);
+
+    ASSERT_EQ(random->live_bytes, kSitePages * PAGE_SIZE);
+    ASSERT_EQ(random->resident_pages + random->frozen_pages, kSitePages);
+    ASSERT_TRUE(random->frozen_pages > 0);
+    ASSERT_TRUE(random->compression_ratio < 1.5);
+    ASSERT_TRUE(!random->locations.empty());
+
+    std::ostringstream report;
+    GhostMemoryManager::Instance().PrintAllocationSiteReport(report, 10, 3);
+    ASSERT_TRUE(report.str().find("live bytes") != std::string::npos);
+    ASSERT_TRUE(report.str().find(random->locations[0].ToString()) != std::string::npos);
+    ASSERT_TRUE(!(report.flags() & std::ios::fixed));
+
+    // Freed allocations leave the site with its cumulative counters
+    for (int i = 0; i < 2; i++) {
+        GhostMemoryManager::Instance().DeallocateGhost(compressible[i], kSitePages * PAGE_SIZE);
+    }
+    GhostMemoryManager::Instance().DeallocateGhost(noise, kSitePages * PAGE_SIZE);
+    sites = GhostMemoryManager::Instance().GetAllocationSites();
+    text = FindSite(sites, reinterpret_cast<const void*>(&AllocateCompressible));
+    ASSERT_NOT_NULL(text);
+    ASSERT_EQ(text->live_bytes, 0u);
+    ASSERT_EQ(text->live_allocations, 0u);
+    ASSERT_EQ(text->allocations, 2u);
+    ASSERT_EQ(text->resident_pages + text->frozen_pages, 0u);
+
+    ASSERT_TRUE(GhostMemoryManager::Instance().Initialize(GhostConfig()));
+}
+
+// Without tracking no stacks are captured
+TEST(AllocationSitesDisabledByDefault) {
+    size_t before = GhostMemoryManager::Instance().GetAllocationSites().size();
+    char* data = allocate_compressible();
+    ASSERT_NOT_NULL(data);
+    ASSERT_EQ(GhostMemoryManager::Instance().GetAllocationSites().size(), before);
+    GhostMemoryManager::Instance().DeallocateGhost(data, kSitePages * PAGE_SIZE);
+}
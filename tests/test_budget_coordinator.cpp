@@ -0,0 +1,331 @@
+#include "test_framework.h"
+#include "ghostmem/GhostMemoryManager.h"
+#include "ghostmem/GhostBudgetCoordinator.h"
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+
+#ifndef _WIN32
+#include <sys/wait.h>
+#include <unistd.h>
+#else
+#include <windows.h>
+#endif
+
+// Unique region name per test run so parallel CI jobs don't collide
+static std::string TestRegionName(const char* suffix) {
+#ifdef _WIN32
+    unsigned long pid = GetCurrentProcessId();
+#else
+    unsigned long pid = static_cast<unsigned long>(getpid());
+#endif
+    return std::string("ghostmem-test-") + suffix + "-" + std::to_string(pid);
+}
+
+// A single participant receives the whole host budget
+TEST(CoordinatorSingleParticipant) {
+    std::string name = TestRegionName("single");
+    GhostSharedMemory::Unlink(name);
+
+    GhostBudgetCoordinator coordinator;
+    ASSERT_TRUE(coordinator.Attach(name, 100, 10));
+    ASSERT_EQ(coordinator.ParticipantCount(), 1u);
+    ASSERT_EQ(coordinator.TotalPages(), 100u);
+
+    // Demand below the budget - the rest is granted as headroom
+    ASSERT_EQ(coordinator.Update(30, 0), 100u);
+
+    coordinator.Detach();
+    ASSERT_TRUE(!coordinator.IsAttached());
+    GhostSharedMemory::Unlink(name);
+}
+
+// Small consumers get what they need, the rest goes to the big one
+TEST(CoordinatorSplitsByDemand) {
+    std::string name = TestRegionName("demand");
+    GhostSharedMemory::Unlink(name);
+
+    GhostBudgetCoordinator small_proc;
+    GhostBudgetCoordinator big_proc;
+    ASSERT_TRUE(small_proc.Attach(name, 100, 10));
+    ASSERT_TRUE(big_proc.Attach(name, 100, 10));
+    ASSERT_EQ(small_proc.ParticipantCount(), 2u);
+
+    small_proc.Update(20, 0);
+    big_proc.Update(200, 0);
+
+    ASSERT_EQ(small_proc.GrantedPages(), 20u);
+    ASSERT_EQ(big_proc.GrantedPages(), 80u);
+
+    GhostSharedMemory::Unlink(name);
+}
+
+// With equal demand, the participant that refaults receives more pages
+TEST(CoordinatorFavoursRefaultPressure) {
+    std::string name = TestRegionName("pressure");
+    GhostSharedMemory::Unlink(name);
+
+    GhostBudgetCoordinator thrashing;
+    GhostBudgetCoordinator idle;
+    ASSERT_TRUE(thrashing.Attach(name, 200, 10));
+    ASSERT_TRUE(idle.Attach(name, 200, 10));
+
+    uint64_t refaults = 0;
+    for (int round = 0; round < 5; round++) {
+        refaults += 100;
+        thrashing.Update(500, refaults);
+        idle.Update(500, 0);
+    }
+
+    ASSERT_TRUE(thrashing.GrantedPages() > idle.GrantedPages());
+    ASSERT_TRUE(idle.GrantedPages() >= 10u);  // Floor is honoured
+    ASSERT_EQ(thrashing.GrantedPages() + idle.GrantedPages(), 200u);
+
+    GhostSharedMemory::Unlink(name);
+}
+
+// Leaving participants return their budget to the others
+TEST(CoordinatorDetachRebalances) {
+    std::string name = TestRegionName("detach");
+    GhostSharedMemory::Unlink(name);
+
+    GhostBudgetCoordinator first;
+    GhostBudgetCoordinator second;
+    ASSERT_TRUE(first.Attach(name, 64, 8));
+    ASSERT_TRUE(second.Attach(name, 64, 8));
+
+    first.Update(64, 0);
+    second.Update(64, 0);
+    ASSERT_EQ(first.GrantedPages() + second.GrantedPages(), 64u);
+
+    second.Detach();
+    ASSERT_EQ(first.ParticipantCount(), 1u);
+    ASSERT_EQ(first.GrantedPages(), 64u);
+
+    GhostSharedMemory::Unlink(name);
+}
+
+#ifndef _WIN32
+// Several real processes share one region; dead ones are reclaimed
+TEST(CoordinatorAcrossProcesses) {
+    std::string name = TestRegionName("procs");
+    GhostSharedMemory::Unlink(name);
+
+    GhostBudgetCoordinator parent;
+    ASSERT_TRUE(parent.Attach(name, 120, 10));
+
+    const int NUM_CHILDREN = 3;
+    int ready_pipe[2];
+    int release_pipe[2];
+    ASSERT_EQ(pipe(ready_pipe), 0);
+    ASSERT_EQ(pipe(release_pipe), 0);
+
+    pid_t children[NUM_CHILDREN];
+    for (int i = 0; i < NUM_CHILDREN; i++) {
+        pid_t pid = fork();
+        if (pid == 0) {
+            close(ready_pipe[0]);
+            close(release_pipe[1]);
+
+            GhostBudgetCoordinator child;
+            char status = child.Attach(name, 0, 0) ? 1 : 0;
+            child.Update(40, 0);
+            ssize_t ignored = write(ready_pipe[1], &status, 1);
+            (void)ignored;
+
+            // Wait until the parent has inspected the table
+            char c;
+            ignored = read(release_pipe[0], &c, 1);
+
+            // The last child "crashes" without detaching
+            if (i != NUM_CHILDREN - 1) {
+                child.Detach();
+            }
+            _exit(0);
+        }
+        children[i] = pid;
+    }
+
+    close(ready_pipe[1]);
+    close(release_pipe[0]);
+
+    int attached = 0;
+    for (int i = 0; i < NUM_CHILDREN; i++) {
+        char status = 0;
+        if (read(ready_pipe[0], &status, 1) == 1 && status == 1) {
+            attached++;
+        }
+    }
+    ASSERT_EQ(attached, NUM_CHILDREN);
+    ASSERT_EQ(parent.ParticipantCount(), static_cast<size_t>(NUM_CHILDREN + 1));
+
+    parent.Update(40, 0);
+    ASSERT_EQ(parent.GrantedPages(), 30u);  // 120 pages split four ways
+
+    // Let the children go and wait for them
+    close(release_pipe[1]);
+    for (int i = 0; i < NUM_CHILDREN; i++) {
+        waitpid(children[i], nullptr, 0);
+    }
+    close(ready_pipe[0]);
+
+    // Only the crashed child's slot is left to reclaim; updates never do it
+    parent.Update(40, 0);
+    ASSERT_EQ(parent.ParticipantCount(), 2u);
+    ASSERT_TRUE(parent.Reclaim());
+    ASSERT_TRUE(!parent.Reclaim());
+    parent.Update(40, 0);
+    ASSERT_EQ(parent.ParticipantCount(), 1u);
+    ASSERT_EQ(parent.GrantedPages(), 120u);
+
+    GhostSharedMemory::Unlink(name);
+}
+#endif
+
+// A manager that stops faulting keeps publishing, so its refault
+// pressure decays and its share goes to a participant that still needs it
+TEST(CoordinatorIdleManagerReleasesShare) {
+    std::string name = TestRegionName("idle");
+    GhostSharedMemory::Unlink(name);
+
+    GhostBudgetCoordinator other;
+    ASSERT_TRUE(other.Attach(name, 100, 10));
+
+    GhostConfig config;
+    config.coordinator_name = name;
+    config.coordinator_update_interval = 4;
+    config.coordinator_update_ms = 10;
+    ASSERT_TRUE(GhostMemoryManager::Instance().Initialize(config));
+
+    // Cycle over more pages than the whole host budget: every fault refaults
+    const size_t num_pages = 200;
+    char* data = static_cast<char*>(GhostMemoryManager::Instance().AllocateGhost(num_pages * PAGE_SIZE));
+    ASSERT_NOT_NULL(data);
+    for (int round = 0; round < 3; round++) {
+        for (size_t i = 0; i < num_pages; i++) {
+            data[i * PAGE_SIZE] = static_cast<char>(round + 1);
+        }
+    }
+    size_t busy_share = other.Update(500, 0);
+
+    // No faults from here on; only the background thread updates the manager
+    std::this_thread::sleep_for(std::chrono::milliseconds(400));
+    size_t idle_share = other.Update(500, 0);
+
+    GhostMemoryManager::Instance().DeallocateGhost(data, num_pages * PAGE_SIZE);
+    ASSERT_TRUE(GhostMemoryManager::Instance().Initialize(GhostConfig()));
+    other.Detach();
+    GhostSharedMemory::Unlink(name);
+
+    ASSERT_TRUE(idle_share >= busy_share + 10);
+}
+
+// A grant that shrinks while the manager is idle is applied by the
+// background thread, keeping exactly the granted pages resident
+TEST(CoordinatorIdleShrinkKeepsGrant) {
+    std::string name = TestRegionName("shrink");
+    GhostSharedMemory::Unlink(name);
+
+    GhostConfig config;
+    config.coordinator_name = name;
+    config.coordinator_total_pages = 32;
+    config.coordinator_min_pages = 4;
+    config.coordinator_update_ms = 10;
+    ASSERT_TRUE(GhostMemoryManager::Instance().Initialize(config));
+
+    const size_t num_pages = 24;
+    char* data = static_cast<char*>(GhostMemoryManager::Instance().AllocateGhost(num_pages * PAGE_SIZE));
+    ASSERT_NOT_NULL(data);
+    for (size_t i = 0; i < num_pages; i++) {
+        data[i * PAGE_SIZE] = static_cast<char>(i + 1);
+    }
+    GhostStats before = GhostMemoryManager::Instance().GetStats();
+
+    // A thrashing participant takes most of the host budget
+    GhostBudgetCoordinator other;
+    ASSERT_TRUE(other.Attach(name, 0, 0));
+    for (uint64_t refaults = 1000; refaults <= 5000; refaults += 1000) {
+        other.Update(500, refaults);
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    GhostStats after = GhostMemoryManager::Instance().GetStats();
+
+    GhostMemoryManager::Instance().DeallocateGhost(data, num_pages * PAGE_SIZE);
+    ASSERT_TRUE(GhostMemoryManager::Instance().Initialize(GhostConfig()));
+    other.Detach();
+    GhostSharedMemory::Unlink(name);
+
+    ASSERT_EQ(before.resident_pages, num_pages);
+    ASSERT_TRUE(after.budget_pages < num_pages);
+    ASSERT_EQ(after.resident_pages, after.budget_pages);
+}
+
+#ifdef __linux__
+// A lock left by a dead process whose pid now belongs to a live one
+// (here: our own pid with another start time) is still reclaimed
+TEST(CoordinatorReclaimsLockOfReusedPid) {
+    std::string name = TestRegionName("reused");
+    GhostSharedMemory::Unlink(name);
+
+    GhostBudgetCoordinator first;
+    ASSERT_TRUE(first.Attach(name, 64, 8));
+
+    // lock_owner is the region's second 64-bit word: pid in the low half,
+    // start stamp in the high half
+    GhostSharedMemory raw;
+    ASSERT_TRUE(raw.Open(name, 2 * sizeof(uint64_t), false));
+    std::atomic<uint64_t>* lock_owner = static_cast<std::atomic<uint64_t>*>(raw.Data()) + 1;
+    lock_owner->store((0xFFFFFFFFULL << 32) | static_cast<uint64_t>(getpid()));
+
+    GhostBudgetCoordinator second;
+    ASSERT_TRUE(second.Attach(name, 0, 0));
+    ASSERT_EQ(second.ParticipantCount(), 2u);
+    ASSERT_EQ(lock_owner->load(), 0u);
+
+    raw.Close();
+    GhostSharedMemory::Unlink(name);
+}
+#endif
+
+// The manager applies the granted budget and reports it in its stats
+TEST(CoordinatorManagerIntegration) {
+    std::string name = TestRegionName("manager");
+    GhostSharedMemory::Unlink(name);
+
+    GhostConfig config;
+    config.coordinator_name = name;
+    config.coordinator_total_pages = 8;
+    config.coordinator_min_pages = 2;
+    config.coordinator_update_interval = 4;
+    ASSERT_TRUE(GhostMemoryManager::Instance().Initialize(config));
+
+    GhostStats stats = GhostMemoryManager::Instance().GetStats();
+    ASSERT_EQ(stats.coordinator_participants, 1u);
+    ASSERT_EQ(stats.budget_pages, 8u);
+
+    // Touch more pages than the budget; residency must stay within it
+    const size_t num_pages = 16;
+    char* data = static_cast<char*>(GhostMemoryManager::Instance().AllocateGhost(num_pages * PAGE_SIZE));
+    ASSERT_NOT_NULL(data);
+    for (size_t i = 0; i < num_pages; i++) {
+        data[i * PAGE_SIZE] = static_cast<char>(i + 1);
+    }
+    for (size_t i = 0; i < num_pages; i++) {
+        ASSERT_EQ(data[i * PAGE_SIZE], static_cast<char>(i + 1));
+    }
+
+    stats = GhostMemoryManager::Instance().GetStats();
+    ASSERT_TRUE(stats.resident_pages <= 8u);
+    ASSERT_TRUE(stats.refaults > 0);
+
+    GhostMemoryManager::Instance().DeallocateGhost(data, num_pages * PAGE_SIZE);
+
+    // Back to the default, uncoordinated configuration
+    ASSERT_TRUE(GhostMemoryManager::Instance().Initialize(GhostConfig()));
+    stats = GhostMemoryManager::Instance().GetStats();
+    ASSERT_EQ(stats.coordinator_participants, 0u);
+    ASSERT_EQ(stats.budget_pages, MAX_PHYSICAL_PAGES);
+
+    GhostSharedMemory::Unlink(name);
+}
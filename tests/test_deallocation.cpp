@@ -242,3 +242,30 @@ TEST(SmallAllocations) {
     GhostMemoryManager::Instance().DeallocateGhost(ptr2, 200);
     GhostMemoryManager::Instance().DeallocateGhost(ptr3, 300);
 }
+
+// Freed allocations leave no bookkeeping behind
+TEST(MetadataReleasedAfterFree) {
+    GhostConfig config;
+    config.max_memory_pages = 64;  // No evictions of other tests' pages meanwhile
+    ASSERT_TRUE(GhostMemoryManager::Instance().Initialize(config));
+    size_t before = GhostMemoryManager::Instance().GetStats().metadata_entries;
+
+    const int count = 10;
+    const size_t size = 3 * PAGE_SIZE;
+    char* blocks[count];
+    for (int i = 0; i < count; i++) {
+        blocks[i] = static_cast<char*>(GhostMemoryManager::Instance().AllocateGhost(size));
+        ASSERT_NOT_NULL(blocks[i]);
+        for (size_t p = 0; p < size; p += PAGE_SIZE) {
+            blocks[i][p] = static_cast<char>(i);
+        }
+    }
+    ASSERT_TRUE(GhostMemoryManager::Instance().GetStats().metadata_entries > before);
+
+    for (int i = 0; i < count; i++) {
+        GhostMemoryManager::Instance().DeallocateGhost(blocks[i], size);
+    }
+    ASSERT_EQ(GhostMemoryManager::Instance().GetStats().metadata_entries, before);
+
+    ASSERT_TRUE(GhostMemoryManager::Instance().Initialize(GhostConfig()));
+}
@@ -0,0 +1,146 @@
+#include "test_framework.h"
+#include "ghostmem/GhostMemoryManager.h"
+#include <cstdio>
+#include <cstdint>
+#include <vector>
+
+// Fills pages with pseudo-random (incompressible) content so that a full
+// re-compression is expensive and a delta is clearly smaller
+static void FillRandomPages(uint8_t* data, size_t num_pages, uint32_t seed) {
+    uint32_t state = seed;
+    for (size_t i = 0; i < num_pages * PAGE_SIZE; i++) {
+        state = state * 1664525u + 1013904223u;
+        data[i] = static_cast<uint8_t>(state >> 24);
+    }
+}
+
+// Bumps one counter per page, cycling through more pages than fit in RAM
+static void RunCounterCycles(uint8_t* data, size_t num_pages, int cycles) {
+    for (int cycle = 0; cycle < cycles; cycle++) {
+        for (size_t p = 0; p < num_pages; p++) {
+            // volatile keeps the compiler from merging the cycles into one pass
+            volatile uint32_t* counter = reinterpret_cast<volatile uint32_t*>(data + p * PAGE_SIZE);
+            *counter = *counter + 1;
+        }
+    }
+}
+
+static void VerifyPages(const uint8_t* data, size_t num_pages, uint32_t seed, uint32_t counter_delta) {
+    std::vector<uint8_t> expected(num_pages * PAGE_SIZE);
+    FillRandomPages(expected.data(), num_pages, seed);
+    for (size_t p = 0; p < num_pages; p++) {
+        uint32_t* counter = reinterpret_cast<uint32_t*>(expected.data() + p * PAGE_SIZE);
+        *counter += counter_delta;
+    }
+    for (size_t i = 0; i < num_pages * PAGE_SIZE; i++) {
+        if (data[i] != expected[i]) {
+            throw std::runtime_error("Page content mismatch at byte " + std::to_string(i));
+        }
+    }
+}
+
+// Lightly modified pages are re-frozen as deltas and restore correctly
+TEST(DeltaCompressionInMemory) {
+    GhostConfig config;
+    config.max_memory_pages = 4;
+    config.enable_delta_compression = true;
+    config.delta_rebase_interval = 1000;  // Never rebase in this test
+    ASSERT_TRUE(GhostMemoryManager::Instance().Initialize(config));
+
+    const size_t num_pages = 8;
+    uint8_t* data = static_cast<uint8_t*>(GhostMemoryManager::Instance().AllocateGhost(num_pages * PAGE_SIZE));
+    ASSERT_NOT_NULL(data);
+    FillRandomPages(data, num_pages, 42);
+
+    GhostStats before = GhostMemoryManager::Instance().GetStats();
+    RunCounterCycles(data, num_pages, 5);
+    GhostStats after = GhostMemoryManager::Instance().GetStats();
+
+    ASSERT_TRUE(after.delta_freezes > before.delta_freezes);
+    VerifyPages(data, num_pages, 42, 5);
+
+    GhostMemoryManager::Instance().DeallocateGhost(data, num_pages * PAGE_SIZE);
+    ASSERT_TRUE(GhostMemoryManager::Instance().Initialize(GhostConfig()));
+}
+
+// A page is rebased to a full image after delta_rebase_interval deltas
+TEST(DeltaCompressionRebase) {
+    GhostConfig config;
+    config.max_memory_pages = 4;
+    config.enable_delta_compression = true;
+    config.delta_rebase_interval = 2;
+    ASSERT_TRUE(GhostMemoryManager::Instance().Initialize(config));
+
+    const size_t num_pages = 8;
+    uint8_t* data = static_cast<uint8_t*>(GhostMemoryManager::Instance().AllocateGhost(num_pages * PAGE_SIZE));
+    ASSERT_NOT_NULL(data);
+    FillRandomPages(data, num_pages, 7);
+
+    GhostStats before = GhostMemoryManager::Instance().GetStats();
+    RunCounterCycles(data, num_pages, 8);
+    GhostStats after = GhostMemoryManager::Instance().GetStats();
+
+    ASSERT_TRUE(after.delta_freezes > before.delta_freezes);
+    ASSERT_TRUE(after.delta_rebases > before.delta_rebases);
+    VerifyPages(data, num_pages, 7, 8);
+
+    GhostMemoryManager::Instance().DeallocateGhost(data, num_pages * PAGE_SIZE);
+    ASSERT_TRUE(GhostMemoryManager::Instance().Initialize(GhostConfig()));
+}
+
+// Heavily rewritten pages fall back to full images and stay correct
+TEST(DeltaCompressionRewrittenPages) {
+    GhostConfig config;
+    config.max_memory_pages = 4;
+    config.enable_delta_compression = true;
+    ASSERT_TRUE(GhostMemoryManager::Instance().Initialize(config));
+
+    const size_t num_pages = 8;
+    uint8_t* data = static_cast<uint8_t*>(GhostMemoryManager::Instance().AllocateGhost(num_pages * PAGE_SIZE));
+    ASSERT_NOT_NULL(data);
+
+    for (uint32_t round = 1; round <= 4; round++) {
+        FillRandomPages(data, num_pages, round);
+    }
+    VerifyPages(data, num_pages, 4, 0);
+
+    GhostMemoryManager::Instance().DeallocateGhost(data, num_pages * PAGE_SIZE);
+    ASSERT_TRUE(GhostMemoryManager::Instance().Initialize(GhostConfig()));
+}
+
+// In disk mode, deltas keep the swap file from growing by full pages
+TEST(DeltaCompressionDiskBacked) {
+    const char* swap_path = "test_delta.swap";
+    const size_t num_pages = 8;
+    const int cycles = 6;
+    size_t growth[2] = {0, 0};
+
+    for (int with_delta = 0; with_delta < 2; with_delta++) {
+        GhostConfig config;
+        config.use_disk_backing = true;
+        config.disk_file_path = swap_path;
+        config.max_memory_pages = 4;
+        config.enable_delta_compression = (with_delta == 1);
+        config.delta_rebase_interval = 1000;
+        ASSERT_TRUE(GhostMemoryManager::Instance().Initialize(config));
+
+        uint8_t* data = static_cast<uint8_t*>(GhostMemoryManager::Instance().AllocateGhost(num_pages * PAGE_SIZE));
+        ASSERT_NOT_NULL(data);
+        FillRandomPages(data, num_pages, 99);
+        RunCounterCycles(data, num_pages, 1);  // Establish bases
+
+        size_t start = GhostMemoryManager::Instance().GetStats().disk_bytes;
+        RunCounterCycles(data, num_pages, cycles);
+        growth[with_delta] = GhostMemoryManager::Instance().GetStats().disk_bytes - start;
+
+        VerifyPages(data, num_pages, 99, cycles + 1);
+        GhostMemoryManager::Instance().DeallocateGhost(data, num_pages * PAGE_SIZE);
+    }
+
+    std::cout << "Swap growth without delta: " << growth[0]
+              << " bytes, with delta: " << growth[1] << " bytes\n";
+    ASSERT_TRUE(growth[1] * 4 < growth[0]);
+
+    ASSERT_TRUE(GhostMemoryManager::Instance().Initialize(GhostConfig()));
+    std::remove(swap_path);
+}
@@ -1,6 +1,7 @@
 #include "test_framework.h"
 #include "ghostmem/GhostMemoryManager.h"
 #include "ghostmem/GhostAllocator.h"
+#include <cstring>
 #include <vector>
 #include <string>
 
@@ -59,3 +60,50 @@ TEST(DefaultConfigValues) {
     ASSERT_TRUE(config.compress_before_disk);  // Default: compress
     ASSERT_EQ(config.max_memory_pages, 0);  // Default: use constant
 }
+
+#ifdef __linux__
+// Pages whose swap write fails stay resident with their contents intact.
+// Not built on GhostTestAllocation: its teardown removes the swap file.
+static void RunFullDiskCheck(bool compress) {
+    GhostConfig config;
+    config.use_disk_backing = true;
+    config.disk_file_path = "/dev/full";  // Every write fails with ENOSPC
+    config.compress_before_disk = compress;
+    config.max_memory_pages = 2;
+    ASSERT_TRUE(GhostMemoryManager::Instance().Initialize(config));
+
+    const size_t pages = 4;
+    char* data = static_cast<char*>(GhostMemoryManager::Instance().AllocateGhost(pages * PAGE_SIZE));
+    GhostStats before = GhostMemoryManager::Instance().GetStats();
+    bool ok = data != nullptr;
+    for (size_t p = 0; ok && p < pages; p++) {
+        memset(data + p * PAGE_SIZE, 'A' + static_cast<int>(p), PAGE_SIZE);
+    }
+    if (ok) {
+        data[0] = 'z';  // Used to restore a zero page over the unsaved contents
+    }
+    for (size_t p = 0; ok && p < pages; p++) {
+        ok = data[p * PAGE_SIZE + 1] == 'A' + static_cast<int>(p)
+             && data[p * PAGE_SIZE + PAGE_SIZE - 1] == 'A' + static_cast<int>(p);
+    }
+    ok = ok && data[0] == 'z';
+    GhostStats stats = GhostMemoryManager::Instance().GetStats();
+
+    if (data != nullptr) {
+        GhostMemoryManager::Instance().DeallocateGhost(data, pages * PAGE_SIZE);
+    }
+    GhostMemoryManager::Instance().Initialize(GhostConfig());
+    ASSERT_TRUE(data != nullptr);
+    ASSERT_TRUE(ok);
+    ASSERT_EQ(stats.evictions - before.evictions, 0);
+    ASSERT_TRUE(stats.integrity_errors > before.integrity_errors);  // DiskWriteFailed
+}
+
+TEST(DiskWriteFailureKeepsPagesRaw) {
+    RunFullDiskCheck(false);
+}
+
+TEST(DiskWriteFailureKeepsPagesCompressed) {
+    RunFullDiskCheck(true);
+}
+#endif
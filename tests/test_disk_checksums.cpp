@@ -0,0 +1,208 @@
+#include "test_framework.h"
+#include "ghostmem/GhostMemoryManager.h"
+#include "ghostmem/GhostCrc32c.h"
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+struct RecordedErrors {
+    size_t count = 0;
+    size_t checksum_mismatches = 0;
+    size_t write_failures = 0;
+    std::vector<void*> pages;
+};
+
+static void RecordError(const GhostError& error, void* user_data) {
+    RecordedErrors* errors = static_cast<RecordedErrors*>(user_data);
+    errors->count++;
+    if (error.code == GhostErrorCode::ChecksumMismatch) {
+        errors->checksum_mismatches++;
+    }
+    if (error.code == GhostErrorCode::DiskWriteFailed) {
+        errors->write_failures++;
+    }
+    errors->pages.push_back(error.page);
+}
+
+static char PatternByte(size_t page, size_t i) {
+    return static_cast<char>('A' + (i * 7 + page * 13) % 53 + (i % 64 == 0 ? page : 0));
+}
+
+// Flips every byte of the swap file behind the manager's back
+static bool CorruptFile(const char* path, size_t size) {
+    FILE* file = fopen(path, "r+b");
+    if (!file) {
+        return false;
+    }
+    std::vector<unsigned char> bytes(size);
+    bool ok = fread(bytes.data(), 1, size, file) == size;
+    for (auto& byte : bytes) {
+        byte ^= 0x5A;
+    }
+    ok = ok && fseek(file, 0, SEEK_SET) == 0 && fwrite(bytes.data(), 1, size, file) == size;
+    fclose(file);
+    return ok;
+}
+
+TEST(Crc32cKnownVectors) {
+    const char* check = "123456789";
+    ASSERT_EQ(GhostCrc32c(check, 9), 0xE3069283u);
+    ASSERT_EQ(GhostCrc32cSoftware(check, 9), 0xE3069283u);
+    ASSERT_EQ(GhostCrc32c(check, 0), 0u);
+
+    // RFC 3720 (iSCSI) test patterns
+    unsigned char zeros[32] = {};
+    unsigned char ones[32];
+    memset(ones, 0xFF, sizeof(ones));
+    ASSERT_EQ(GhostCrc32c(zeros, sizeof(zeros)), 0x8A9136AAu);
+    ASSERT_EQ(GhostCrc32c(ones, sizeof(ones)), 0x62A8AB43u);
+}
+
+// Every length and alignment gives the same result as the table version
+TEST(Crc32cHardwareMatchesSoftware) {
+    std::vector<unsigned char> buffer(PAGE_SIZE + 64);
+    uint32_t state = 99;
+    for (auto& byte : buffer) {
+        state = state * 1664525u + 1013904223u;
+        byte = static_cast<unsigned char>(state >> 24);
+    }
+    for (size_t offset = 0; offset < 8; offset++) {
+        for (size_t size = 0; size < 80; size++) {
+            ASSERT_EQ(GhostCrc32c(buffer.data() + offset, size), GhostCrc32cSoftware(buffer.data() + offset, size));
+        }
+        ASSERT_EQ(GhostCrc32c(buffer.data() + offset, PAGE_SIZE), GhostCrc32cSoftware(buffer.data() + offset, PAGE_SIZE));
+    }
+}
+
+// Damaged records are reported once each and come back as zero pages
+static void RunCorruptionCheck(bool compress, bool encrypt, bool mapped, const char* path) {
+    RecordedErrors errors;
+    GhostConfig config;
+    config.use_disk_backing = true;
+    config.disk_file_path = path;
+    config.compress_before_disk = compress;
+    config.encrypt_disk_pages = encrypt;
+    config.map_disk_reads = mapped;
+    config.max_memory_pages = 4;
+    config.error_callback = RecordError;
+    config.error_callback_data = &errors;
+    const size_t num_pages = 24;
+    GhostTestAllocation run(config, num_pages);
+    char* data = run.data;
+    const GhostStats& before = run.before;
+    for (size_t p = 0; p < num_pages; p++) {
+        for (size_t i = 0; i < PAGE_SIZE; i++) {
+            data[p * PAGE_SIZE + i] = PatternByte(p, i);
+        }
+    }
+    ASSERT_EQ(errors.count, 0u);
+
+    // The first num_pages - 4 pages are on disk; the last four are resident
+    // and get written behind the damaged region while we read
+    ASSERT_TRUE(CorruptFile(path, GhostMemoryManager::Instance().GetStats().disk_bytes));
+    const size_t damaged = num_pages - 4;
+    for (size_t p = 0; p < num_pages; p++) {
+        volatile char* page = data + p * PAGE_SIZE;
+        bool intact = true;
+        bool zero = true;
+        for (size_t i = 0; i < PAGE_SIZE; i++) {
+            intact = intact && page[i] == PatternByte(p, i);
+            zero = zero && page[i] == 0;
+        }
+        ASSERT_TRUE(p < damaged ? zero : intact);
+    }
+
+    // The callback runs inside the fault handler: read its results only
+    // after a call into the manager
+    ASSERT_EQ(GhostMemoryManager::Instance().GetStats().integrity_errors - before.integrity_errors, damaged);
+    ASSERT_EQ(errors.count, damaged);
+    ASSERT_EQ(errors.checksum_mismatches, damaged);
+    for (size_t p = 0; p < damaged; p++) {
+        ASSERT_TRUE(errors.pages[p] == data + p * PAGE_SIZE);
+    }
+
+    // Zeroed pages are ordinary pages again
+    for (size_t p = 0; p < num_pages; p++) {
+        data[p * PAGE_SIZE + 5] = static_cast<char>(p + 1);
+    }
+    for (size_t p = 0; p < num_pages; p++) {
+        volatile char* byte = data + p * PAGE_SIZE + 5;
+        ASSERT_EQ(*byte, static_cast<char>(p + 1));
+    }
+    ASSERT_EQ(GhostMemoryManager::Instance().GetStats().integrity_errors - before.integrity_errors, damaged);
+    ASSERT_EQ(errors.count, damaged);
+}
+
+TEST(DiskChecksumCompressedRead) {
+    RunCorruptionCheck(true, false, false, "test_disk_crc_lz4.swap");
+}
+
+TEST(DiskChecksumCompressedMapped) {
+    RunCorruptionCheck(true, true, true, "test_disk_crc_mapped.swap");
+}
+
+TEST(DiskChecksumRawEncrypted) {
+    RunCorruptionCheck(false, true, false, "test_disk_crc_raw.swap");
+}
+
+TEST(DiskChecksumRawMapped) {
+    RunCorruptionCheck(false, false, true, "test_disk_crc_raw_mapped.swap");
+}
+
+#ifdef __linux__
+// Failed swap writes are reported and the page stays resident and intact.
+// Not built on GhostTestAllocation: its teardown removes the swap file.
+static void RunWriteFailureCheck(bool compress, bool encrypt) {
+    RecordedErrors errors;
+    GhostConfig config;
+    config.use_disk_backing = true;
+    config.disk_file_path = "/dev/full";  // Every write fails with ENOSPC
+    config.compress_before_disk = compress;
+    config.encrypt_disk_pages = encrypt;
+    config.max_memory_pages = 4;
+    config.error_callback = RecordError;
+    config.error_callback_data = &errors;
+    ASSERT_TRUE(GhostMemoryManager::Instance().Initialize(config));
+
+    const size_t num_pages = 8;
+    char* data = static_cast<char*>(GhostMemoryManager::Instance().AllocateGhost(num_pages * PAGE_SIZE));
+    GhostStats before = GhostMemoryManager::Instance().GetStats();
+    bool intact = data != nullptr;
+    for (size_t p = 0; intact && p < num_pages; p++) {
+        for (size_t i = 0; i < PAGE_SIZE; i++) {
+            data[p * PAGE_SIZE + i] = PatternByte(p, i);
+        }
+    }
+    for (size_t p = 0; intact && p < num_pages; p++) {
+        volatile char* page = data + p * PAGE_SIZE;
+        for (size_t i = 0; i < PAGE_SIZE; i++) {
+            intact = intact && page[i] == PatternByte(p, i);
+        }
+    }
+    GhostStats after = GhostMemoryManager::Instance().GetStats();
+    bool pages_in_range = true;
+    for (void* page : errors.pages) {
+        pages_in_range = pages_in_range && page >= data && page < data + num_pages * PAGE_SIZE;
+    }
+
+    if (data != nullptr) {
+        GhostMemoryManager::Instance().DeallocateGhost(data, num_pages * PAGE_SIZE);
+    }
+    GhostMemoryManager::Instance().Initialize(GhostConfig());
+    ASSERT_TRUE(data != nullptr);
+    ASSERT_TRUE(intact);
+    ASSERT_EQ(after.evictions - before.evictions, 0u);
+    ASSERT_TRUE(errors.write_failures > 0);
+    ASSERT_EQ(errors.write_failures, errors.count);
+    ASSERT_EQ(after.integrity_errors - before.integrity_errors, errors.count);
+    ASSERT_TRUE(pages_in_range);
+}
+
+TEST(DiskWriteFailureCompressedEncrypted) {
+    RunWriteFailureCheck(true, true);
+}
+
+TEST(DiskWriteFailureRaw) {
+    RunWriteFailureCheck(false, false);
+}
+#endif
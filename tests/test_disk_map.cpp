@@ -0,0 +1,93 @@
+#include "test_framework.h"
+#include "ghostmem/GhostMemoryManager.h"
+#include <cstdio>
+#include <cstring>
+
+static void FillDiskPages(char* data, size_t num_pages, unsigned seed) {
+    uint32_t state = seed;
+    for (size_t p = 0; p < num_pages; p++) {
+        for (size_t i = 0; i < PAGE_SIZE; i++) {
+            state = state * 1664525u + 1013904223u;
+            data[p * PAGE_SIZE + i] = (i % 16 == 0) ? static_cast<char>(state >> 24) : static_cast<char>('a' + (i + p) % 26);
+        }
+    }
+}
+
+static bool CheckDiskPages(char* data, size_t num_pages, unsigned seed) {
+    uint32_t state = seed;
+    for (size_t p = 0; p < num_pages; p++) {
+        volatile char* page = data + p * PAGE_SIZE;
+        for (size_t i = 0; i < PAGE_SIZE; i++) {
+            state = state * 1664525u + 1013904223u;
+            char expected = (i % 16 == 0) ? static_cast<char>(state >> 24) : static_cast<char>('a' + (i + p) % 26);
+            if (page[i] != expected) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// Pages written to disk come back through the mapping in every record format
+static void RunMappedRoundTrip(bool compress, bool encrypt, bool delta, const char* path) {
+    GhostConfig config;
+    config.use_disk_backing = true;
+    config.disk_file_path = path;
+    config.compress_before_disk = compress;
+    config.encrypt_disk_pages = encrypt;
+    config.enable_delta_compression = delta;
+    config.map_disk_reads = true;
+    config.max_memory_pages = 4;
+    const size_t num_pages = 48;
+    GhostTestAllocation run(config, num_pages);
+    char* data = run.data;
+
+    FillDiskPages(data, num_pages, 7);
+    ASSERT_TRUE(CheckDiskPages(data, num_pages, 7));
+    FillDiskPages(data, num_pages, 7);  // Re-freezes as deltas when enabled
+    ASSERT_TRUE(CheckDiskPages(data, num_pages, 7));
+
+    // The file keeps growing past the first mapping's reach
+    GhostMemoryManager::Instance().DropDiskCache();
+    FillDiskPages(data, num_pages, 9);
+    ASSERT_TRUE(CheckDiskPages(data, num_pages, 9));
+
+    GhostStats after = GhostMemoryManager::Instance().GetStats();
+    ASSERT_TRUE(after.refaults - run.before.refaults >= 3 * (num_pages - 4));
+    ASSERT_TRUE(after.disk_bytes > 0);
+}
+
+TEST(DiskMapCompressedRoundTrip) {
+    RunMappedRoundTrip(true, false, false, "test_disk_map_lz4.swap");
+}
+
+TEST(DiskMapRawEncryptedRoundTrip) {
+    RunMappedRoundTrip(false, true, false, "test_disk_map_raw.swap");
+}
+
+TEST(DiskMapEncryptedDeltaRoundTrip) {
+    RunMappedRoundTrip(true, true, true, "test_disk_map_delta.swap");
+}
+
+// A swap file larger than the initial 1 MB view is remapped transparently
+TEST(DiskMapGrowsWithFile) {
+    GhostConfig config;
+    config.use_disk_backing = true;
+    config.disk_file_path = "test_disk_map_grow.swap";
+    config.compress_before_disk = false;
+    config.map_disk_reads = true;
+    config.max_memory_pages = 8;
+    ASSERT_TRUE(GhostMemoryManager::Instance().Initialize(config));
+
+    const size_t num_pages = 400;  // > 1 MB of raw records per pass
+    char* data = static_cast<char*>(GhostMemoryManager::Instance().AllocateGhost(num_pages * PAGE_SIZE));
+    ASSERT_NOT_NULL(data);
+    FillDiskPages(data, num_pages, 3);
+    ASSERT_TRUE(CheckDiskPages(data, num_pages, 3));
+    ASSERT_TRUE(CheckDiskPages(data, num_pages, 3));
+    ASSERT_TRUE(GhostMemoryManager::Instance().GetStats().disk_bytes > 2 * 1024 * 1024);
+
+    GhostMemoryManager::Instance().DeallocateGhost(data, num_pages * PAGE_SIZE);
+    ASSERT_TRUE(GhostMemoryManager::Instance().Initialize(GhostConfig()));
+    std::remove("test_disk_map_grow.swap");
+}
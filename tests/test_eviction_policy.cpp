@@ -0,0 +1,144 @@
+#include "test_framework.h"
+#include "ghostmem/GhostMemoryManager.h"
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+// Page p is incompressible when p is even and nearly empty when p is odd
+static void FillMixedPages(uint8_t* data, size_t num_pages) {
+    uint32_t state = 12345;
+    for (size_t p = 0; p < num_pages; p++) {
+        uint8_t* page = data + p * PAGE_SIZE;
+        if (p % 2 == 0) {
+            for (size_t i = 0; i < PAGE_SIZE; i++) {
+                state = state * 1664525u + 1013904223u;
+                page[i] = static_cast<uint8_t>(state >> 24);
+            }
+        } else {
+            memset(page, 0, PAGE_SIZE);
+        }
+    }
+}
+
+static void TouchPages(uint8_t* data, size_t num_pages, int rounds) {
+    for (int round = 0; round < rounds; round++) {
+        for (size_t p = 0; p < num_pages; p++) {
+            volatile uint8_t* byte = data + p * PAGE_SIZE + PAGE_SIZE - 1;
+            *byte = static_cast<uint8_t>(*byte + 1);
+        }
+    }
+}
+
+// Runs the mixed workload and returns the compressed bytes held afterwards
+static size_t CompressedBytesAfterWorkload(GhostEvictionPolicy policy) {
+    GhostConfig config;
+    config.max_memory_pages = 4;
+    config.eviction_policy = policy;
+    if (!GhostMemoryManager::Instance().Initialize(config)) {
+        throw std::runtime_error("Initialize failed");
+    }
+
+    // Earlier tests may leave frozen pages behind - only count our own
+    size_t baseline = GhostMemoryManager::Instance().GetStats().compressed_bytes;
+
+    const size_t num_pages = 8;
+    uint8_t* data = static_cast<uint8_t*>(GhostMemoryManager::Instance().AllocateGhost(num_pages * PAGE_SIZE));
+    if (!data) {
+        throw std::runtime_error("AllocateGhost failed");
+    }
+    FillMixedPages(data, num_pages);
+    TouchPages(data, num_pages, 4);
+
+    size_t compressed = GhostMemoryManager::Instance().GetStats().compressed_bytes - baseline;
+
+    // Content survives whichever pages were chosen
+    std::vector<uint8_t> expected(num_pages * PAGE_SIZE);
+    FillMixedPages(expected.data(), num_pages);
+    for (size_t p = 0; p < num_pages; p++) {
+        expected[p * PAGE_SIZE + PAGE_SIZE - 1] += 4;
+    }
+    if (memcmp(data, expected.data(), expected.size()) != 0) {
+        throw std::runtime_error("Page content mismatch");
+    }
+
+    GhostMemoryManager::Instance().DeallocateGhost(data, num_pages * PAGE_SIZE);
+    return compressed;
+}
+
+// Cost-aware eviction keeps incompressible pages resident and freezes
+// the pages that compress well, so the same budget holds fewer bytes
+TEST(EvictionPolicyPrefersCompressiblePages) {
+    size_t lru = CompressedBytesAfterWorkload(GhostEvictionPolicy::LRU);
+    size_t cost_aware = CompressedBytesAfterWorkload(GhostEvictionPolicy::CostAware);
+
+    std::cout << "Compressed bytes after mixed workload: LRU=" << lru
+              << ", CostAware=" << cost_aware << "\n";
+    ASSERT_TRUE(cost_aware < lru);
+    // The page touched last is resident, so at most one incompressible page
+    // has to make way for it; LRU freezes two
+    ASSERT_TRUE(cost_aware < 2 * PAGE_SIZE);
+    ASSERT_TRUE(lru >= 2 * PAGE_SIZE);
+
+    ASSERT_TRUE(GhostMemoryManager::Instance().Initialize(GhostConfig()));
+}
+
+// A scan depth of one degenerates to plain LRU
+TEST(EvictionPolicyDepthOneIsLru) {
+    GhostConfig config;
+    config.max_memory_pages = 4;
+    config.eviction_policy = GhostEvictionPolicy::CostAware;
+    config.eviction_scan_depth = 1;
+    ASSERT_TRUE(GhostMemoryManager::Instance().Initialize(config));
+
+    const size_t num_pages = 6;
+    char* data = static_cast<char*>(GhostMemoryManager::Instance().AllocateGhost(num_pages * PAGE_SIZE));
+    ASSERT_NOT_NULL(data);
+
+    // A cyclic loop over more pages than fit misses on every access under LRU
+    for (size_t p = 0; p < num_pages; p++) {
+        data[p * PAGE_SIZE] = static_cast<char>(p);
+    }
+    GhostStats before = GhostMemoryManager::Instance().GetStats();
+    for (int round = 0; round < 3; round++) {
+        for (size_t p = 0; p < num_pages; p++) {
+            volatile char* byte = data + p * PAGE_SIZE;
+            ASSERT_EQ(*byte, static_cast<char>(p));
+        }
+    }
+    GhostStats after = GhostMemoryManager::Instance().GetStats();
+    ASSERT_EQ(after.page_faults - before.page_faults, 3 * num_pages);
+
+    GhostMemoryManager::Instance().DeallocateGhost(data, num_pages * PAGE_SIZE);
+    ASSERT_TRUE(GhostMemoryManager::Instance().Initialize(GhostConfig()));
+}
+
+// Disk-backed cost-aware eviction stays correct
+TEST(EvictionPolicyCostAwareDisk) {
+    const char* swap_path = "test_eviction_policy.swap";
+
+    GhostConfig config;
+    config.use_disk_backing = true;
+    config.disk_file_path = swap_path;
+    config.max_memory_pages = 4;
+    config.eviction_policy = GhostEvictionPolicy::CostAware;
+    ASSERT_TRUE(GhostMemoryManager::Instance().Initialize(config));
+
+    const size_t num_pages = 12;
+    uint8_t* data = static_cast<uint8_t*>(GhostMemoryManager::Instance().AllocateGhost(num_pages * PAGE_SIZE));
+    ASSERT_NOT_NULL(data);
+    for (size_t p = 0; p < num_pages; p++) {
+        memset(data + p * PAGE_SIZE, static_cast<int>(p + 1), PAGE_SIZE);
+    }
+    TouchPages(data, num_pages, 3);
+
+    for (size_t p = 0; p < num_pages; p++) {
+        ASSERT_EQ(data[p * PAGE_SIZE], static_cast<uint8_t>(p + 1));
+        ASSERT_EQ(data[p * PAGE_SIZE + PAGE_SIZE - 1], static_cast<uint8_t>(p + 4));
+    }
+    ASSERT_TRUE(GhostMemoryManager::Instance().GetStats().resident_pages <= 4u);
+
+    GhostMemoryManager::Instance().DeallocateGhost(data, num_pages * PAGE_SIZE);
+    ASSERT_TRUE(GhostMemoryManager::Instance().Initialize(GhostConfig()));
+    std::remove(swap_path);
+}
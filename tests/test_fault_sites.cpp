@@ -0,0 +1,106 @@
+#include "test_framework.h"
+#include "ghostmem/GhostMemoryManager.h"
+#include <cstdint>
+#include <sstream>
+#include <string>
+
+#ifdef _MSC_VER
+#define GHOST_TEST_NOINLINE __declspec(noinline)
+#else
+#define GHOST_TEST_NOINLINE __attribute__((noinline))
+#endif
+
+// The one instruction in here that faults should be reported as a site
+GHOST_TEST_NOINLINE void TouchForFaultSites(char* data, size_t num_pages) {
+    for (size_t p = 0; p < num_pages; p++) {
+        volatile char* byte = data + p * PAGE_SIZE;
+        *byte = static_cast<char>(*byte + 1);
+    }
+}
+
+// Called through a pointer so the compiler cannot clone or inline it
+static void (*volatile touch_pages)(char*, size_t) = TouchForFaultSites;
+
+static bool InsideTouchFunction(const void* ip) {
+    uintptr_t start = reinterpret_cast<uintptr_t>(&TouchForFaultSites);
+    uintptr_t address = reinterpret_cast<uintptr_t>(ip);
+    return address >= start && address < start + 1024;
+}
+
+// Every fault is attributed to the faulting instruction at rate 1
+TEST(FaultSitesAttributeToInstruction) {
+    GhostConfig config;
+    config.max_memory_pages = 4;
+    config.fault_ip_sample_rate = 1;
+    ASSERT_TRUE(GhostMemoryManager::Instance().Initialize(config));
+    GhostMemoryManager::Instance().ResetFaultSites();
+
+    const size_t num_pages = 12;
+    char* data = static_cast<char*>(GhostMemoryManager::Instance().AllocateGhost(num_pages * PAGE_SIZE));
+    ASSERT_NOT_NULL(data);
+    touch_pages(data, num_pages);  // First touches
+    touch_pages(data, num_pages);  // Refaults (budget is 4 pages)
+
+    // One site per faulting instruction (several if the loop is unrolled)
+    std::vector<GhostFaultSite> sites = GhostMemoryManager::Instance().GetFaultSites();
+    ASSERT_TRUE(!sites.empty());
+
+    uint64_t samples = 0;
+    uint64_t refaults = 0;
+    std::string module = GhostSymbolize(reinterpret_cast<const void*>(&TouchForFaultSites)).module;
+    for (const GhostFaultSite& site : sites) {
+        ASSERT_TRUE(InsideTouchFunction(site.ip));
+        ASSERT_EQ(site.location.module, module);
+        ASSERT_TRUE(site.max_ns > 0);
+        ASSERT_TRUE(site.total_ns >= site.max_ns);
+        samples += site.samples;
+        refaults += site.refaults;
+    }
+    ASSERT_EQ(samples, 2 * num_pages);
+    ASSERT_EQ(refaults, num_pages);
+    ASSERT_TRUE(!module.empty());
+
+    const GhostFaultSite& top = sites[0];
+
+    // The report names the module of the faulting code
+    std::ostringstream report;
+    GhostMemoryManager::Instance().PrintFaultReport(report, 5);
+    ASSERT_TRUE(report.str().find("1 in 1 faults sampled") != std::string::npos);
+    ASSERT_TRUE(report.str().find(top.location.ToString()) != std::string::npos);
+
+    // The caller's stream formatting is left as it was
+    ASSERT_TRUE(!(report.flags() & std::ios::fixed));
+    ASSERT_EQ(report.precision(), 6);
+
+    GhostMemoryManager::Instance().DeallocateGhost(data, num_pages * PAGE_SIZE);
+    GhostMemoryManager::Instance().ResetFaultSites();
+    ASSERT_TRUE(GhostMemoryManager::Instance().Initialize(GhostConfig()));
+}
+
+// Only every Nth fault is recorded, and nothing when sampling is off
+TEST(FaultSitesSampling) {
+    GhostConfig config;
+    config.max_memory_pages = 4;
+    config.fault_ip_sample_rate = 4;
+    ASSERT_TRUE(GhostMemoryManager::Instance().Initialize(config));
+    GhostMemoryManager::Instance().ResetFaultSites();
+
+    const size_t num_pages = 20;
+    char* data = static_cast<char*>(GhostMemoryManager::Instance().AllocateGhost(num_pages * PAGE_SIZE));
+    ASSERT_NOT_NULL(data);
+    touch_pages(data, num_pages);
+
+    uint64_t samples = 0;
+    for (const GhostFaultSite& site : GhostMemoryManager::Instance().GetFaultSites()) {
+        samples += site.samples;
+    }
+    ASSERT_EQ(samples, num_pages / 4);
+    ASSERT_EQ(GhostMemoryManager::Instance().GetFaultSites(1).size(), 1u);
+
+    ASSERT_TRUE(GhostMemoryManager::Instance().Initialize(GhostConfig()));
+    GhostMemoryManager::Instance().ResetFaultSites();
+    touch_pages(data, num_pages);
+    ASSERT_TRUE(GhostMemoryManager::Instance().GetFaultSites().empty());
+
+    GhostMemoryManager::Instance().DeallocateGhost(data, num_pages * PAGE_SIZE);
+}
@@ -0,0 +1,206 @@
+#include "test_framework.h"
+#include "ghostmem/GhostFixedPolicies.h"
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+// Counts heap allocations made by the current thread while armed
+static thread_local bool g_count_allocations = false;
+static thread_local size_t g_allocations = 0;
+
+void* operator new(size_t size) {
+    if (g_count_allocations) {
+        g_allocations++;
+    }
+    void* ptr = std::malloc(size ? size : 1);
+    if (!ptr) {
+        throw std::bad_alloc();
+    }
+    return ptr;
+}
+
+void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept {
+    std::free(ptr);
+}
+
+static const size_t kFixedPages = 32;
+
+// 32 frozen pages, pool for all of them, 4 resident pages, 2 allocations
+typedef GhostFixedManager<kFixedPages, kFixedPages * GhostLz4Codec::kMaxEncodedSize, 4, 2> TestFixedManager;
+
+static void FillPattern(char* data, size_t num_pages, unsigned seed) {
+    for (size_t p = 0; p < num_pages; p++) {
+        for (size_t i = 0; i < PAGE_SIZE; i += 64) {
+            data[p * PAGE_SIZE + i] = static_cast<char>((p * 31 + i / 64 + seed) & 0x7F);
+        }
+    }
+}
+
+static bool CheckPattern(char* data, size_t num_pages, unsigned seed) {
+    for (size_t p = 0; p < num_pages; p++) {
+        volatile char* page = data + p * PAGE_SIZE;
+        for (size_t i = 0; i < PAGE_SIZE; i += 64) {
+            if (page[i] != static_cast<char>((p * 31 + i / 64 + seed) & 0x7F)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// Random inserts and erases against a brute-force list
+TEST(FixedPageMapMatchesReference) {
+    GhostFixedPageMap<int, 64> map;
+    void* keys[64] = {};
+    uint64_t state = 88172645463325252ULL;
+
+    for (int step = 0; step < 20000; step++) {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        size_t slot = state % 64;
+        void* page = reinterpret_cast<void*>((state % 512 + 1) * PAGE_SIZE);
+
+        if (keys[slot]) {
+            ASSERT_TRUE(map.Erase(keys[slot]));
+            ASSERT_TRUE(map.Find(keys[slot]) == nullptr);
+            keys[slot] = nullptr;
+        } else {
+            bool present = false;
+            for (void* key : keys) {
+                present = present || key == page;
+            }
+            if (!present) {
+                ASSERT_NOT_NULL(map.Insert(page, static_cast<int>(slot)));
+                keys[slot] = page;
+            }
+        }
+    }
+
+    size_t live = 0;
+    for (size_t slot = 0; slot < 64; slot++) {
+        if (keys[slot]) {
+            live++;
+            ASSERT_NOT_NULL(map.Find(keys[slot]));
+            ASSERT_EQ(*map.Find(keys[slot]), static_cast<int>(slot));
+        }
+    }
+    ASSERT_EQ(map.Size(), live);
+}
+
+// After construction, faults, freezes and frees never touch the heap
+TEST(FixedManagerNoHeapAfterConstruction) {
+    static TestFixedManager manager(4);
+
+    g_allocations = 0;
+    g_count_allocations = true;
+    char* data = static_cast<char*>(manager.Allocate(kFixedPages * PAGE_SIZE));
+    bool allocated = data != nullptr;
+    if (allocated) {
+        FillPattern(data, kFixedPages, 1);
+        allocated = CheckPattern(data, kFixedPages, 1) && CheckPattern(data, kFixedPages, 1);
+        FillPattern(data, kFixedPages, 2);
+        allocated = allocated && CheckPattern(data, kFixedPages, 2);
+    }
+    GhostStats stats = manager.GetStats();
+    manager.Deallocate(data);
+    g_count_allocations = false;
+
+    ASSERT_TRUE(allocated);
+    ASSERT_EQ(g_allocations, 0u);
+    ASSERT_EQ(stats.resident_pages, 4u);
+    ASSERT_EQ(stats.frozen_pages, kFixedPages - 4);
+    ASSERT_TRUE(stats.refaults > 0);
+    ASSERT_EQ(manager.GetStats().frozen_pages, 0u);
+    ASSERT_EQ(manager.GetStats().compressed_bytes, 0u);
+    ASSERT_EQ(manager.GetBacking().FreeChunks(), manager.GetBacking().kChunks);
+}
+
+// Capacities are hard limits, not hints
+TEST(FixedManagerCapacityLimits) {
+    static GhostFixedManager<8, 8 * GhostLz4Codec::kMaxEncodedSize, 2, 2> manager(100);
+
+    char* first = static_cast<char*>(manager.Allocate(4 * PAGE_SIZE));
+    char* second = static_cast<char*>(manager.Allocate(4 * PAGE_SIZE));
+    ASSERT_NOT_NULL(first);
+    ASSERT_NOT_NULL(second);
+    ASSERT_TRUE(manager.Allocate(PAGE_SIZE) == nullptr);  // Region table full
+
+    // Budget 100 is capped by the resident table
+    FillPattern(first, 4, 3);
+    FillPattern(second, 4, 4);
+    ASSERT_EQ(manager.GetStats().resident_pages, 2u);
+    ASSERT_TRUE(CheckPattern(first, 4, 3));
+    ASSERT_TRUE(CheckPattern(second, 4, 4));
+
+    manager.Deallocate(first);
+    char* third = static_cast<char*>(manager.Allocate(PAGE_SIZE));
+    ASSERT_NOT_NULL(third);
+    manager.Deallocate(third);
+    manager.Deallocate(second);
+}
+
+// A small pool fills up; pages that don't fit stay resident and intact
+TEST(FixedMemoryBackingPoolExhaustion) {
+    GhostFixedMemoryBacking<16, 1024, 128> backing;
+    char record[600];
+    char scratch[GhostLz4Codec::kMaxEncodedSize];
+    memset(record, 'r', sizeof(record));
+
+    void* a = reinterpret_cast<void*>(1 * PAGE_SIZE);
+    void* b = reinterpret_cast<void*>(2 * PAGE_SIZE);
+    ASSERT_TRUE(backing.Store(a, record, 600));         // 5 of 8 chunks
+    ASSERT_TRUE(!backing.Store(b, record, 600));        // Only 3 left
+    ASSERT_TRUE(backing.Store(b, record, 300));
+    ASSERT_EQ(backing.FreeChunks(), 0u);
+
+    size_t size = 0;
+    char* loaded = backing.Load(a, scratch, size);
+    ASSERT_NOT_NULL(loaded);
+    ASSERT_EQ(size, 600u);
+    ASSERT_TRUE(memcmp(loaded, record, 600) == 0);
+
+    backing.Erase(a);
+    ASSERT_EQ(backing.FreeChunks(), 5u);
+    ASSERT_TRUE(backing.Store(a, record, 600));
+    ASSERT_EQ(backing.Count(), 2u);
+    ASSERT_EQ(backing.MemoryBytes(), 900u);
+}
+
+// Incompressible pages that don't fit the pool stay resident, over budget
+TEST(FixedManagerPoolFullKeepsPagesResident) {
+    static GhostFixedManager<8, 2048, 8, 1> manager(2);
+    char* data = static_cast<char*>(manager.Allocate(6 * PAGE_SIZE));
+    ASSERT_NOT_NULL(data);
+
+    uint64_t state = 0x2545F4914F6CDD1DULL;
+    for (size_t p = 0; p < 6; p++) {
+        for (size_t i = 0; i < PAGE_SIZE; i++) {
+            state ^= state << 13;
+            state ^= state >> 7;
+            state ^= state << 17;
+            data[p * PAGE_SIZE + i] = static_cast<char>(state);
+        }
+    }
+    GhostStats stats = manager.GetStats();
+    ASSERT_EQ(stats.resident_pages, 6u);
+    ASSERT_EQ(stats.frozen_pages, 0u);
+    ASSERT_EQ(stats.evictions, 0u);
+
+    state = 0x2545F4914F6CDD1DULL;
+    bool intact = true;
+    for (size_t p = 0; p < 6; p++) {
+        for (size_t i = 0; i < PAGE_SIZE; i++) {
+            state ^= state << 13;
+            state ^= state >> 7;
+            state ^= state << 17;
+            intact = intact && data[p * PAGE_SIZE + i] == static_cast<char>(state);
+        }
+    }
+    ASSERT_TRUE(intact);
+    manager.Deallocate(data);
+}
@@ -1,6 +1,9 @@
 #pragma once
 
+#include "ghostmem/GhostMemoryManager.h"
+#include <cstdio>
 #include <iostream>
+#include <stdexcept>
 #include <string>
 #include <vector>
 #include <functional>
@@ -80,3 +83,50 @@ public:
     if ((ptr) == nullptr) { \
         throw std::runtime_error("Assertion failed: " #ptr " != nullptr"); \
     }
+
+// One ghost allocation under a test configuration: initializes the manager
+// with config, allocates num_pages and snapshots the stats in `before`.
+// The destructor frees the allocation, restores the default configuration
+// and removes the swap file, also when an assertion fails.
+class GhostTestAllocation {
+public:
+    GhostTestAllocation(const GhostConfig& config, size_t pages) : num_pages(pages), config_(config) {
+        ASSERT_TRUE(GhostMemoryManager::Instance().Initialize(config));
+        data = static_cast<char*>(GhostMemoryManager::Instance().AllocateGhost(num_pages * PAGE_SIZE));
+        if (data == nullptr) {
+            TearDown();
+            throw std::runtime_error("Assertion failed: AllocateGhost() != nullptr");
+        }
+        before = GhostMemoryManager::Instance().GetStats();
+    }
+
+    ~GhostTestAllocation() {
+        TearDown();
+    }
+
+    GhostTestAllocation(const GhostTestAllocation&) = delete;
+    GhostTestAllocation& operator=(const GhostTestAllocation&) = delete;
+
+    // Frees the allocation early, e.g. to check what freeing releases
+    void Free() {
+        if (data != nullptr) {
+            GhostMemoryManager::Instance().DeallocateGhost(data, num_pages * PAGE_SIZE);
+            data = nullptr;
+        }
+    }
+
+    char* data = nullptr;
+    const size_t num_pages;
+    GhostStats before;
+
+private:
+    void TearDown() {
+        Free();
+        GhostMemoryManager::Instance().Initialize(GhostConfig());
+        if (config_.use_disk_backing) {
+            std::remove(config_.disk_file_path.c_str());
+        }
+    }
+
+    GhostConfig config_;
+};
@@ -0,0 +1,103 @@
+#include "test_framework.h"
+#include "ghostmem/GhostMemoryManager.h"
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+static void FillTextPages(char* data, size_t num_pages) {
+    const char* text = "ghost pages handed to the kernel ";
+    size_t len = strlen(text);
+    for (size_t p = 0; p < num_pages; p++) {
+        for (size_t i = 0; i < PAGE_SIZE; i++) {
+            data[p * PAGE_SIZE + i] = text[(i + p) % len];
+        }
+    }
+}
+
+static bool CheckTextPages(char* data, size_t num_pages) {
+    const char* text = "ghost pages handed to the kernel ";
+    size_t len = strlen(text);
+    for (size_t p = 0; p < num_pages; p++) {
+        volatile char* page = data + p * PAGE_SIZE;
+        for (size_t i = 0; i < PAGE_SIZE; i += 97) {
+            if (page[i] != text[(i + p) % len]) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// Frozen pages keep their content and are accounted as kernel pages
+static void RunKernelBackendRoundTrip(GhostFreezeBackend backend) {
+    GhostConfig config;
+    config.max_memory_pages = 4;
+    config.freeze_backend = backend;
+    const size_t num_pages = 12;
+    GhostTestAllocation run(config, num_pages);
+    char* data = run.data;
+    const GhostStats& before = run.before;
+
+    FillTextPages(data, num_pages);
+    GhostStats frozen = GhostMemoryManager::Instance().GetStats();
+    ASSERT_EQ(frozen.kernel_pages - before.kernel_pages, num_pages - 4);
+    ASSERT_EQ(frozen.compressed_bytes, before.compressed_bytes);
+    ASSERT_EQ(frozen.evictions - before.evictions, num_pages - 4);
+
+    ASSERT_TRUE(CheckTextPages(data, num_pages));
+    GhostStats after = GhostMemoryManager::Instance().GetStats();
+    ASSERT_EQ(after.refaults - frozen.refaults, num_pages);
+
+    run.Free();
+    ASSERT_EQ(GhostMemoryManager::Instance().GetStats().kernel_pages, before.kernel_pages);
+}
+
+TEST(FreezeBackendKernelCold) {
+    if (!GhostMemoryManager::IsFreezeBackendSupported(GhostFreezeBackend::KernelCold)) {
+        printf("  (MADV_COLD not supported here, skipped)\n");
+        return;
+    }
+    RunKernelBackendRoundTrip(GhostFreezeBackend::KernelCold);
+}
+
+TEST(FreezeBackendKernelPageout) {
+    if (!GhostMemoryManager::IsFreezeBackendSupported(GhostFreezeBackend::KernelPageout)) {
+        printf("  (MADV_PAGEOUT not supported here, skipped)\n");
+        return;
+    }
+    RunKernelBackendRoundTrip(GhostFreezeBackend::KernelPageout);
+}
+
+TEST(FreezeBackendRejectsDiskBacking) {
+    GhostConfig config;
+    config.freeze_backend = GhostFreezeBackend::KernelPageout;
+    config.use_disk_backing = true;
+    config.disk_file_path = "test_freeze_backend.swap";
+    ASSERT_TRUE(!GhostMemoryManager::Instance().Initialize(config));
+    ASSERT_TRUE(GhostMemoryManager::Instance().Initialize(GhostConfig()));
+    std::remove("test_freeze_backend.swap");
+}
+
+// Pages frozen by one backend are restored after switching to the other
+TEST(FreezeBackendSwitchKeepsFrozenPages) {
+    if (!GhostMemoryManager::IsFreezeBackendSupported(GhostFreezeBackend::KernelPageout)) {
+        return;
+    }
+    GhostConfig config;
+    config.max_memory_pages = 2;
+    config.freeze_backend = GhostFreezeBackend::KernelPageout;
+    ASSERT_TRUE(GhostMemoryManager::Instance().Initialize(config));
+
+    const size_t num_pages = 6;
+    char* data = static_cast<char*>(GhostMemoryManager::Instance().AllocateGhost(num_pages * PAGE_SIZE));
+    ASSERT_NOT_NULL(data);
+    FillTextPages(data, num_pages);
+
+    config.freeze_backend = GhostFreezeBackend::Compress;
+    ASSERT_TRUE(GhostMemoryManager::Instance().Initialize(config));
+    ASSERT_TRUE(CheckTextPages(data, num_pages));
+    ASSERT_TRUE(CheckTextPages(data, num_pages));
+
+    GhostMemoryManager::Instance().DeallocateGhost(data, num_pages * PAGE_SIZE);
+    ASSERT_TRUE(GhostMemoryManager::Instance().Initialize(GhostConfig()));
+}
@@ -0,0 +1,131 @@
+#include "test_framework.h"
+#include "ghostmem/GhostMemoryManager.h"
+#include <chrono>
+#include <cstdio>
+#include <thread>
+
+// Pages not touched for the idle age are frozen while under budget
+TEST(IdleScanFreezesUntouchedPages) {
+    GhostConfig config;
+    config.max_memory_pages = 16;
+    config.idle_freeze_age_ms = 50;
+    config.idle_scan_interval_ms = 60000;  // Scans are driven by the test
+    ASSERT_TRUE(GhostMemoryManager::Instance().Initialize(config));
+
+    const size_t num_pages = 4;
+    char* data = static_cast<char*>(GhostMemoryManager::Instance().AllocateGhost(num_pages * PAGE_SIZE));
+    ASSERT_NOT_NULL(data);
+    for (size_t p = 0; p < num_pages; p++) {
+        data[p * PAGE_SIZE] = static_cast<char>(p + 1);
+    }
+
+    GhostStats before = GhostMemoryManager::Instance().GetStats();
+    GhostMemoryManager::Instance().ScanIdlePages();  // Arms every resident page
+
+    // Pages 0 and 1 stay in use, 2 and 3 go idle
+    for (size_t p = 0; p < 2; p++) {
+        volatile char* byte = data + p * PAGE_SIZE;
+        *byte = static_cast<char>(*byte + 10);
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(60));
+
+    size_t frozen = GhostMemoryManager::Instance().ScanIdlePages();
+    GhostStats after = GhostMemoryManager::Instance().GetStats();
+
+    ASSERT_TRUE(frozen >= 2u);
+    ASSERT_EQ(after.idle_soft_faults - before.idle_soft_faults, 2u);
+    ASSERT_TRUE(after.idle_reclaimed_bytes > before.idle_reclaimed_bytes);
+    ASSERT_EQ(after.idle_scans - before.idle_scans, 2u);
+
+    // Frozen pages come back intact; pages in use were never frozen
+    uint64_t refaults_before = after.refaults;
+    ASSERT_EQ(data[0], static_cast<char>(11));
+    ASSERT_EQ(data[PAGE_SIZE], static_cast<char>(12));
+    ASSERT_EQ(GhostMemoryManager::Instance().GetStats().refaults, refaults_before);
+    ASSERT_EQ(data[2 * PAGE_SIZE], static_cast<char>(3));
+    ASSERT_EQ(data[3 * PAGE_SIZE], static_cast<char>(4));
+    ASSERT_EQ(GhostMemoryManager::Instance().GetStats().refaults, refaults_before + 2);
+
+    GhostMemoryManager::Instance().DeallocateGhost(data, num_pages * PAGE_SIZE);
+    ASSERT_TRUE(GhostMemoryManager::Instance().Initialize(GhostConfig()));
+}
+
+// The background scanner keeps a hot page resident and freezes cold ones
+TEST(IdleScannerBackgroundThread) {
+    GhostConfig config;
+    config.max_memory_pages = 32;
+    config.idle_freeze_age_ms = 100;
+    config.idle_scan_interval_ms = 20;
+    ASSERT_TRUE(GhostMemoryManager::Instance().Initialize(config));
+
+    const size_t num_pages = 8;
+    char* data = static_cast<char*>(GhostMemoryManager::Instance().AllocateGhost(num_pages * PAGE_SIZE));
+    ASSERT_NOT_NULL(data);
+    for (size_t p = 0; p < num_pages; p++) {
+        data[p * PAGE_SIZE] = static_cast<char>(p + 1);
+    }
+
+    GhostStats before = GhostMemoryManager::Instance().GetStats();
+
+    // Keep page 0 hot for well over the idle age
+    auto until = std::chrono::steady_clock::now() + std::chrono::milliseconds(600);
+    while (std::chrono::steady_clock::now() < until) {
+        volatile char* hot = data;
+        *hot = *hot;
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+
+    GhostStats after = GhostMemoryManager::Instance().GetStats();
+    std::cout << "Idle scans: " << (after.idle_scans - before.idle_scans)
+              << ", frozen: " << (after.idle_freezes - before.idle_freezes)
+              << ", reclaimed: " << (after.idle_reclaimed_bytes - before.idle_reclaimed_bytes)
+              << " bytes, scan time: " << (after.idle_scan_ns - before.idle_scan_ns) / 1000 << " us\n";
+
+    ASSERT_TRUE(after.idle_scans > before.idle_scans);
+    ASSERT_TRUE(after.idle_freezes - before.idle_freezes >= num_pages - 1);
+    ASSERT_TRUE(after.idle_soft_faults > before.idle_soft_faults);
+    ASSERT_TRUE(after.resident_pages <= 1u);
+
+    for (size_t p = 0; p < num_pages; p++) {
+        ASSERT_EQ(data[p * PAGE_SIZE], static_cast<char>(p + 1));
+    }
+
+    GhostMemoryManager::Instance().DeallocateGhost(data, num_pages * PAGE_SIZE);
+    ASSERT_TRUE(GhostMemoryManager::Instance().Initialize(GhostConfig()));
+}
+
+// Idle-frozen pages are written to the swap file in disk mode
+TEST(IdleScanDiskBacked) {
+    const char* swap_path = "test_idle_scanner.swap";
+
+    GhostConfig config;
+    config.use_disk_backing = true;
+    config.disk_file_path = swap_path;
+    config.max_memory_pages = 16;
+    config.idle_freeze_age_ms = 1;
+    config.idle_scan_interval_ms = 60000;
+    ASSERT_TRUE(GhostMemoryManager::Instance().Initialize(config));
+
+    const size_t num_pages = 4;
+    char* data = static_cast<char*>(GhostMemoryManager::Instance().AllocateGhost(num_pages * PAGE_SIZE));
+    ASSERT_NOT_NULL(data);
+    for (size_t p = 0; p < num_pages; p++) {
+        data[p * PAGE_SIZE] = static_cast<char>(p + 1);
+    }
+
+    GhostMemoryManager::Instance().ScanIdlePages();
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    ASSERT_TRUE(GhostMemoryManager::Instance().ScanIdlePages() >= num_pages);
+
+    GhostStats stats = GhostMemoryManager::Instance().GetStats();
+    ASSERT_EQ(stats.resident_pages, 0u);
+    ASSERT_TRUE(stats.disk_bytes > 0);
+
+    for (size_t p = 0; p < num_pages; p++) {
+        ASSERT_EQ(data[p * PAGE_SIZE], static_cast<char>(p + 1));
+    }
+
+    GhostMemoryManager::Instance().DeallocateGhost(data, num_pages * PAGE_SIZE);
+    ASSERT_TRUE(GhostMemoryManager::Instance().Initialize(GhostConfig()));
+    std::remove(swap_path);
+}
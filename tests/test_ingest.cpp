@@ -0,0 +1,109 @@
+#include "test_framework.h"
+#include "ghostmem/GhostMemoryManager.h"
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+static std::vector<char> MakeDataset(size_t size, unsigned seed) {
+    const char* words[] = {"ghost ", "memory ", "ingest ", "frozen ", "page ", "record "};
+    std::vector<char> data(size);
+    uint32_t state = seed;
+    size_t i = 0;
+    while (i < size) {
+        state = state * 1664525u + 1013904223u;
+        const char* word = words[(state >> 16) % 6];
+        for (size_t j = 0; word[j] && i < size; j++) {
+            data[i++] = word[j];
+        }
+    }
+    return data;
+}
+
+static bool MatchesDataset(const char* ghost, const std::vector<char>& expected) {
+    for (size_t i = 0; i < expected.size(); i++) {
+        if (static_cast<const volatile char*>(ghost)[i] != expected[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Whole pages go straight into the frozen store on worker threads
+static void RunIngest(bool disk, bool encrypt, size_t threads, const char* path) {
+    GhostConfig config;
+    config.max_memory_pages = 4;
+    config.use_disk_backing = disk;
+    config.disk_file_path = path;
+    config.encrypt_disk_pages = encrypt;
+    config.ingest_threads = threads;
+    const size_t num_pages = 1500;  // More than one batch
+    GhostTestAllocation run(config, num_pages);
+    char* data = run.data;
+    const GhostStats& before = run.before;
+    std::vector<char> dataset = MakeDataset(num_pages * PAGE_SIZE, 5);
+
+    ASSERT_TRUE(GhostIngest(data, dataset.data(), dataset.size()));
+    GhostStats after = GhostMemoryManager::Instance().GetStats();
+    ASSERT_EQ(after.page_faults, before.page_faults);
+    ASSERT_EQ(after.evictions, before.evictions);
+    ASSERT_EQ(after.ingested_pages - before.ingested_pages, num_pages);
+    ASSERT_EQ(after.frozen_pages - before.frozen_pages, num_pages);
+    ASSERT_TRUE(after.compression_ns > before.compression_ns);
+    ASSERT_TRUE(disk ? after.disk_bytes > before.disk_bytes : after.compressed_bytes < dataset.size() / 2);
+
+    // Readable without faults, then through the fault path
+    std::vector<char> copy(dataset.size());
+    ASSERT_TRUE(GhostRead(data, copy.data(), copy.size()));
+    ASSERT_TRUE(copy == dataset);
+    ASSERT_EQ(GhostMemoryManager::Instance().GetStats().page_faults, after.page_faults);
+    ASSERT_TRUE(MatchesDataset(data, dataset));
+    ASSERT_EQ(GhostMemoryManager::Instance().GetStats().refaults - after.refaults, num_pages);
+}
+
+TEST(IngestInMemory) {
+    RunIngest(false, false, 1, "");
+}
+
+TEST(IngestInMemoryParallel) {
+    RunIngest(false, false, 3, "");
+}
+
+TEST(IngestDiskEncryptedParallel) {
+    RunIngest(true, true, 2, "test_ingest.swap");
+}
+
+// Ingest over existing content: frozen, delta, patched and resident pages
+TEST(IngestReplacesExistingContent) {
+    GhostConfig config;
+    config.max_memory_pages = 4;
+    config.enable_delta_compression = true;
+    ASSERT_TRUE(GhostMemoryManager::Instance().Initialize(config));
+
+    const size_t num_pages = 16;
+    char* data = static_cast<char*>(GhostMemoryManager::Instance().AllocateGhost(num_pages * PAGE_SIZE));
+    ASSERT_NOT_NULL(data);
+    memset(data, 'o', num_pages * PAGE_SIZE);
+    data[5] = 'p';  // Page 0 refrozen later as a delta
+    ASSERT_TRUE(GhostWrite(data + PAGE_SIZE, "pending", 7));
+
+    // Unaligned range: the partial end pages are written normally
+    std::vector<char> dataset = MakeDataset(num_pages * PAGE_SIZE - 300, 11);
+    GhostStats before = GhostMemoryManager::Instance().GetStats();
+    ASSERT_TRUE(GhostIngest(data + 100, dataset.data(), dataset.size()));
+    GhostStats after = GhostMemoryManager::Instance().GetStats();
+    ASSERT_TRUE(after.ingested_pages - before.ingested_pages >= num_pages - 2 - 4);
+
+    ASSERT_TRUE(MatchesDataset(data + 100, dataset));
+    for (size_t i = 0; i < 100; i++) {
+        ASSERT_EQ(data[i], i == 5 ? 'p' : 'o');
+    }
+    for (size_t i = num_pages * PAGE_SIZE - 200; i < num_pages * PAGE_SIZE; i++) {
+        ASSERT_EQ(data[i], 'o');
+    }
+    char outside[16];
+    ASSERT_TRUE(!GhostIngest(outside, dataset.data(), sizeof(outside)));
+    ASSERT_TRUE(!GhostIngest(data + num_pages * PAGE_SIZE - 8, dataset.data(), 16));
+
+    GhostMemoryManager::Instance().DeallocateGhost(data, num_pages * PAGE_SIZE);
+    ASSERT_TRUE(GhostMemoryManager::Instance().Initialize(GhostConfig()));
+}
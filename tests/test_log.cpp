@@ -0,0 +1,132 @@
+#include "test_framework.h"
+#include "ghostmem/GhostMemoryManager.h"
+#include "ghostmem/GhostLog.h"
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Redirects the log into a temporary file and reads it back
+static FILE* CaptureLog(GhostLogLevel level, size_t sample_rate) {
+    GhostLogger::Instance().Flush();
+    FILE* file = tmpfile();
+    GhostLogger::Instance().SetOutput(file);
+    GhostLogger::Instance().Configure(level, sample_rate);
+    return file;
+}
+
+static std::string ReadLog(FILE* file) {
+    GhostLogger::Instance().Flush();
+    GhostLogger::Instance().SetOutput(nullptr);
+    GhostLogger::Instance().Configure(GhostLogLevel::Off, 1);
+
+    std::string text;
+    char buffer[1024];
+    rewind(file);
+    size_t n;
+    while ((n = fread(buffer, 1, sizeof(buffer), file)) > 0) {
+        text.append(buffer, n);
+    }
+    fclose(file);
+    return text;
+}
+
+static size_t CountOccurrences(const std::string& text, const char* needle) {
+    size_t count = 0;
+    for (size_t pos = text.find(needle); pos != std::string::npos; pos = text.find(needle, pos + 1)) {
+        count++;
+    }
+    return count;
+}
+
+// Arguments are stored binary and formatted by the background thread
+TEST(LogFormatsArguments) {
+    FILE* file = CaptureLog(GhostLogLevel::Info, 1);
+    std::string path = "ghost.swap";
+    GhostLog(GhostLogLevel::Info, "pages=", 42, " free=", static_cast<size_t>(7), " ok=", true,
+             " ratio=", 2.5, " tier=", 'x', " path=", path);
+    GhostLog(GhostLogLevel::Error, "negative ", -3);
+    GhostLog(GhostLogLevel::Debug, "filtered by level");
+    GhostLog(GhostLogLevel::Info, std::string(300, 'a'));
+    std::string text = ReadLog(file);
+
+    ASSERT_TRUE(text.find("INFO ") != std::string::npos);
+    ASSERT_TRUE(text.find("pages=42 free=7 ok=true ratio=2.5 tier=x path=ghost.swap\n") != std::string::npos);
+    ASSERT_TRUE(text.find("ERROR") != std::string::npos);
+    ASSERT_TRUE(text.find("negative -3\n") != std::string::npos);
+    ASSERT_TRUE(text.find("filtered") == std::string::npos);
+    ASSERT_TRUE(text.find("aaa...\n") != std::string::npos);  // Cut to the record size
+    ASSERT_EQ(CountOccurrences(text, "\n"), 3u);
+}
+
+// Info and Debug are sampled, errors are always kept
+TEST(LogSamplesVerboseLevels) {
+    FILE* file = CaptureLog(GhostLogLevel::Debug, 4);
+    for (int i = 0; i < 100; i++) {
+        GhostLog(GhostLogLevel::Debug, "sampled ", i);
+    }
+    for (int i = 0; i < 3; i++) {
+        GhostLog(GhostLogLevel::Error, "kept ", i);
+    }
+    std::string text = ReadLog(file);
+
+    ASSERT_EQ(CountOccurrences(text, "sampled "), 25u);
+    ASSERT_EQ(CountOccurrences(text, "kept "), 3u);
+}
+
+// A full ring drops records instead of blocking, and says so
+TEST(LogDropsWhenRingFull) {
+    FILE* file = CaptureLog(GhostLogLevel::Info, 1);
+    uint64_t dropped_before = GhostLogger::Instance().Dropped();
+    const size_t total = GhostLogger::kRingRecords * 4;
+    for (size_t i = 0; i < total; i++) {
+        GhostLog(GhostLogLevel::Info, "burst ", i);
+    }
+    uint64_t dropped = GhostLogger::Instance().Dropped() - dropped_before;
+    std::string text = ReadLog(file);
+
+    ASSERT_TRUE(dropped > 0);
+    ASSERT_EQ(CountOccurrences(text, "burst ") + dropped, total);
+    ASSERT_TRUE(text.find("log messages dropped") != std::string::npos);
+}
+
+// Every thread gets its own ring; rings of exited threads are reused
+TEST(LogManyThreads) {
+    FILE* file = CaptureLog(GhostLogLevel::Info, 1);
+    uint64_t dropped_before = GhostLogger::Instance().Dropped();
+    for (int wave = 0; wave < 3; wave++) {
+        std::vector<std::thread> threads;
+        for (int t = 0; t < 40; t++) {
+            threads.emplace_back([t]() {
+                for (int i = 0; i < 50; i++) {
+                    GhostLog(GhostLogLevel::Info, "thread ", t, " message ", i);
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        GhostLogger::Instance().Flush();
+    }
+    std::string text = ReadLog(file);
+
+    ASSERT_EQ(GhostLogger::Instance().Dropped(), dropped_before);
+    ASSERT_EQ(CountOccurrences(text, " message "), 3u * 40u * 50u);
+}
+
+// The manager logs through the ring at the configured level
+TEST(LogManagerErrors) {
+    FILE* file = CaptureLog(GhostLogLevel::Off, 1);
+    GhostConfig config;
+    config.log_level = GhostLogLevel::Error;
+    config.use_disk_backing = true;
+    config.disk_file_path = "/nonexistent-ghostmem-dir/test.swap";
+    ASSERT_TRUE(!GhostMemoryManager::Instance().Initialize(config));
+    std::string text = ReadLog(file);
+
+    ASSERT_TRUE(text.find("ERROR") != std::string::npos);
+    ASSERT_TRUE(text.find("Failed to open disk file: /nonexistent-ghostmem-dir/test.swap") != std::string::npos);
+    ASSERT_TRUE(text.find("INFO") == std::string::npos);
+    ASSERT_TRUE(GhostMemoryManager::Instance().Initialize(GhostConfig()));
+}
@@ -1,10 +1,18 @@
 #include "test_framework.h"
 #include "ghostmem/GhostMemoryManager.h"
+#include "ghostmem/GhostCrc32c.h"
+#include "ghostmem/GhostRealtime.h"
+#include <algorithm>
 #include <chrono>
+#include <cstdio>
+#include <cstdlib>
 #include <cstring>
 #include <vector>
 #include <random>
 #include <iomanip>
+#ifdef __linux__
+#include <sys/resource.h>
+#endif
 
 /**
  * @file test_metrics.cpp
@@ -15,6 +23,12 @@
  * 2. Memory savings achieved through compression
  * 3. Performance comparisons between native C++ and GhostMem
  * 4. Speed impact of compression/decompression cycles
+ * 5. Userspace vs kernel (zswap / zram) compression of frozen pages
+ * 6. Swap file reads through system calls vs a memory mapping, and the
+ *    cost of their CRC32C checks
+ * 7. Bulk loading through the fault path vs GhostIngest
+ * 8. Worst-case fault latency of GhostRealtimeManager
+ * 9. Warm-up with and without a hotness profile from an earlier run
  */
 
 // ============================================================================
@@ -443,10 +457,408 @@ TEST(PerformanceMetrics_CompressionCycleOverhead) {
               << " ms per page access\n\n";
 }
 
+TEST(PerformanceMetrics_EvictionPolicyComparison) {
+    std::cout << "\n=== Performance Test: LRU vs Cost-Aware Eviction ===\n";
+    
+    // Half the pages hold random bytes, half hold text
+    const size_t num_pages = 32;
+    const size_t budget = 12;
+    const size_t accesses = 4000;
+    const char* text = "The quick brown fox jumps over the lazy dog. ";
+    const size_t text_len = strlen(text);
+    
+    const GhostEvictionPolicy policies[2] = {GhostEvictionPolicy::LRU, GhostEvictionPolicy::CostAware};
+    const char* names[2] = {"LRU", "CostAware"};
+    
+    for (int i = 0; i < 2; i++) {
+        GhostConfig config;
+        config.max_memory_pages = budget;
+        config.eviction_policy = policies[i];
+        ASSERT_TRUE(GhostMemoryManager::Instance().Initialize(config));
+        size_t baseline_bytes = GhostMemoryManager::Instance().GetStats().compressed_bytes;
+        
+        uint8_t* data = static_cast<uint8_t*>(GhostMemoryManager::Instance().AllocateGhost(num_pages * PAGE_SIZE));
+        ASSERT_NOT_NULL(data);
+        
+        std::mt19937 fill_gen(1234);
+        for (size_t p = 0; p < num_pages; p++) {
+            uint8_t* page = data + p * PAGE_SIZE;
+            for (size_t j = 0; j < PAGE_SIZE; j++) {
+                page[j] = (p % 2 == 0) ? static_cast<uint8_t>(fill_gen()) : static_cast<uint8_t>(text[j % text_len]);
+            }
+        }
+        
+        // Skewed random access: most touches go to a quarter of the pages
+        std::mt19937 access_gen(42);
+        GhostStats before = GhostMemoryManager::Instance().GetStats();
+        auto start = std::chrono::high_resolution_clock::now();
+        for (size_t a = 0; a < accesses; a++) {
+            size_t p = (access_gen() % 4 != 0) ? access_gen() % (num_pages / 4) : access_gen() % num_pages;
+            volatile uint8_t* byte = data + p * PAGE_SIZE;
+            *byte = static_cast<uint8_t>(*byte + 1);
+        }
+        auto end = std::chrono::high_resolution_clock::now();
+        GhostStats after = GhostMemoryManager::Instance().GetStats();
+        
+        double elapsed = std::chrono::duration<double, std::milli>(end - start).count();
+        size_t compressed = after.compressed_bytes - baseline_bytes;
+        size_t footprint = after.resident_pages * PAGE_SIZE + compressed;
+        
+        std::cout << names[i] << ":\n";
+        std::cout << "  Page faults: " << (after.page_faults - before.page_faults) << "\n";
+        std::cout << "  Time: " << std::fixed << std::setprecision(4) << elapsed << " ms\n";
+        std::cout << "  Compressed store: " << compressed << " bytes\n";
+        std::cout << "  Resident + compressed: " << (footprint / 1024) << " KB of "
+                  << (num_pages * PAGE_SIZE / 1024) << " KB\n";
+        
+        GhostMemoryManager::Instance().DeallocateGhost(data, num_pages * PAGE_SIZE);
+    }
+    
+    ASSERT_TRUE(GhostMemoryManager::Instance().Initialize(GhostConfig()));
+    std::cout << "\n";
+}
+
+TEST(PerformanceMetrics_FreezeBackendComparison) {
+    std::cout << "\n=== Performance Test: Userspace vs Kernel Compression ===\n";
+    
+    // Cyclic scan over twice the budget: every access freezes and restores
+    const size_t num_pages = 64;
+    const size_t budget = 32;
+    const size_t rounds = 5;
+    const char* text = "The quick brown fox jumps over the lazy dog. ";
+    const size_t text_len = strlen(text);
+    
+    const GhostFreezeBackend backends[3] = {GhostFreezeBackend::Compress, GhostFreezeBackend::KernelCold,
+                                            GhostFreezeBackend::KernelPageout};
+    const char* names[3] = {"Compress (LZ4)", "KernelCold", "KernelPageout"};
+    
+    for (int b = 0; b < 3; b++) {
+        if (!GhostMemoryManager::IsFreezeBackendSupported(backends[b])) {
+            std::cout << names[b] << ": not supported on this host\n";
+            continue;
+        }
+        GhostConfig config;
+        config.max_memory_pages = budget;
+        config.freeze_backend = backends[b];
+        ASSERT_TRUE(GhostMemoryManager::Instance().Initialize(config));
+        
+        GhostStats baseline = GhostMemoryManager::Instance().GetStats();
+        char* data = static_cast<char*>(GhostMemoryManager::Instance().AllocateGhost(num_pages * PAGE_SIZE));
+        ASSERT_NOT_NULL(data);
+        for (size_t p = 0; p < num_pages; p++) {
+            for (size_t j = 0; j < PAGE_SIZE; j++) {
+                data[p * PAGE_SIZE + j] = text[(j + p) % text_len];
+            }
+        }
+        
+        GhostStats before = GhostMemoryManager::Instance().GetStats();
+        auto start = std::chrono::high_resolution_clock::now();
+        for (size_t r = 0; r < rounds; r++) {
+            for (size_t p = 0; p < num_pages; p++) {
+                volatile char* byte = data + p * PAGE_SIZE;
+                *byte = static_cast<char>(*byte + 1);
+            }
+        }
+        auto end = std::chrono::high_resolution_clock::now();
+        GhostStats after = GhostMemoryManager::Instance().GetStats();
+        
+        double elapsed_us = std::chrono::duration<double, std::micro>(end - start).count();
+        uint64_t faults = after.page_faults - before.page_faults;
+        ASSERT_TRUE(faults > 0);
+        
+        std::cout << names[b] << ":\n";
+        std::cout << "  Time per fault: " << std::fixed << std::setprecision(2)
+                  << (elapsed_us / faults) << " us\n";
+        std::cout << "  Held by GhostMem: " << ((after.compressed_bytes - baseline.compressed_bytes) / 1024)
+                  << " KB, by the kernel: " << (after.kernel_pages - baseline.kernel_pages) << " pages\n";
+        
+        GhostMemoryManager::Instance().DeallocateGhost(data, num_pages * PAGE_SIZE);
+    }
+    
+    ASSERT_TRUE(GhostMemoryManager::Instance().Initialize(GhostConfig()));
+    std::cout << "\n";
+}
+
+TEST(PerformanceMetrics_DiskReadPath) {
+    std::cout << "\n=== Performance Test: Swap File Reads (read() vs mmap) ===\n";
+    
+    // Cyclic scan over 8x the budget: every access restores one page from
+    // disk and writes another; the write cost is the same in both modes
+    const size_t num_pages = 256;
+    const size_t budget = 32;
+    const size_t rounds = 3;
+    const char* text = "Frozen pages on disk, read back on the next fault. ";
+    const size_t text_len = strlen(text);
+    const char* path = "perf_disk_read.swap";
+    double hot_refault_us = 0.0;
+    
+    for (int mapped = 0; mapped < 2; mapped++) {
+        GhostConfig config;
+        config.use_disk_backing = true;
+        config.disk_file_path = path;
+        config.max_memory_pages = budget;
+        config.map_disk_reads = (mapped != 0);
+        ASSERT_TRUE(GhostMemoryManager::Instance().Initialize(config));
+        
+        char* data = static_cast<char*>(GhostMemoryManager::Instance().AllocateGhost(num_pages * PAGE_SIZE));
+        ASSERT_NOT_NULL(data);
+        for (size_t p = 0; p < num_pages; p++) {
+            for (size_t j = 0; j < PAGE_SIZE; j++) {
+                data[p * PAGE_SIZE + j] = text[(j + p) % text_len];
+            }
+        }
+        
+        std::cout << (mapped ? "mmap" : "read()") << ":\n";
+        for (int cold = 0; cold < 2; cold++) {
+            double elapsed_us = 0.0;
+            uint64_t refaults = 0;
+            for (size_t r = 0; r < rounds; r++) {
+                if (cold) {
+                    GhostMemoryManager::Instance().DropDiskCache();
+                }
+                GhostStats before = GhostMemoryManager::Instance().GetStats();
+                auto start = std::chrono::high_resolution_clock::now();
+                for (size_t p = 0; p < num_pages; p++) {
+                    volatile char* byte = data + p * PAGE_SIZE;
+                    *byte = static_cast<char>(*byte + 1);
+                }
+                auto end = std::chrono::high_resolution_clock::now();
+                elapsed_us += std::chrono::duration<double, std::micro>(end - start).count();
+                refaults += GhostMemoryManager::Instance().GetStats().refaults - before.refaults;
+            }
+            ASSERT_TRUE(refaults > 0);
+            if (mapped && !cold) {
+                hot_refault_us = elapsed_us / refaults;
+            }
+            std::cout << "  " << (cold ? "Cold" : "Hot ") << " page cache: " << std::fixed << std::setprecision(2)
+                      << (elapsed_us / refaults) << " us per disk refault\n";
+        }
+        
+        GhostMemoryManager::Instance().DeallocateGhost(data, num_pages * PAGE_SIZE);
+    }
+    
+    ASSERT_TRUE(GhostMemoryManager::Instance().Initialize(GhostConfig()));
+    std::remove(path);
+    
+    // Every disk refault checksums one record on write and one on read;
+    // records are at most a page, so a full page bounds the cost
+    std::vector<char> page(PAGE_SIZE);
+    for (size_t j = 0; j < PAGE_SIZE; j++) {
+        page[j] = text[j % text_len];
+    }
+    const int crc_iterations = 20000;
+    volatile uint32_t crc_sink = 0;
+    auto crc_start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < crc_iterations; i++) {
+        page[0] = static_cast<char>(i);
+        crc_sink = crc_sink ^ GhostCrc32c(page.data(), PAGE_SIZE);
+    }
+    auto crc_end = std::chrono::high_resolution_clock::now();
+    double crc_ns = std::chrono::duration<double, std::nano>(crc_end - crc_start).count() / crc_iterations;
+    std::cout << "CRC32C (" << (GhostCrc32cIsHardware() ? "hardware" : "software") << "): "
+              << std::fixed << std::setprecision(1) << crc_ns << " ns per 4 KB page, "
+              << std::setprecision(2) << (2.0 * crc_ns / 10.0 / hot_refault_us) << "% of a hot mmap refault\n";
+    std::cout << "\n";
+}
+
+TEST(PerformanceMetrics_IngestVsFaultPath) {
+    std::cout << "\n=== Performance Test: Bulk Load (fault path vs GhostIngest) ===\n";
+    
+    // A dataset 16x the resident budget: through the fault path every
+    // page is faulted in, filled and evicted again
+    const size_t num_pages = 4096;
+    const size_t budget = 256;
+    const char* text = "Bulk loaded rows compress while they are copied in. ";
+    const size_t text_len = strlen(text);
+    std::vector<char> dataset(num_pages * PAGE_SIZE);
+    for (size_t j = 0; j < dataset.size(); j++) {
+        dataset[j] = text[(j + j / PAGE_SIZE) % text_len];
+    }
+    double mb = dataset.size() / (1024.0 * 1024.0);
+    
+    for (int mode = 0; mode < 3; mode++) {
+        GhostConfig config;
+        config.max_memory_pages = budget;
+        config.ingest_threads = (mode == 2) ? 4 : 1;
+        ASSERT_TRUE(GhostMemoryManager::Instance().Initialize(config));
+        char* data = static_cast<char*>(GhostMemoryManager::Instance().AllocateGhost(dataset.size()));
+        ASSERT_NOT_NULL(data);
+        
+        GhostStats before = GhostMemoryManager::Instance().GetStats();
+        auto start = std::chrono::high_resolution_clock::now();
+        if (mode == 0) {
+            memcpy(data, dataset.data(), dataset.size());
+        } else {
+            ASSERT_TRUE(GhostIngest(data, dataset.data(), dataset.size()));
+        }
+        auto end = std::chrono::high_resolution_clock::now();
+        GhostStats after = GhostMemoryManager::Instance().GetStats();
+        double ms = std::chrono::duration<double, std::milli>(end - start).count();
+        
+        const char* names[] = {"memcpy (fault path)", "GhostIngest, 1 thread", "GhostIngest, 4 threads"};
+        std::cout << std::left << std::setw(24) << names[mode] << std::right << std::fixed << std::setprecision(1)
+                  << std::setw(8) << (mb / (ms / 1000.0)) << " MB/s, "
+                  << (after.page_faults - before.page_faults) << " faults, "
+                  << (after.evictions - before.evictions) << " evictions\n";
+        
+        GhostMemoryManager::Instance().DeallocateGhost(data, dataset.size());
+    }
+    
+    ASSERT_TRUE(GhostMemoryManager::Instance().Initialize(GhostConfig()));
+    std::cout << "\n";
+}
+
+#ifdef __linux__
+// Involuntary context switches of the calling thread
+static long InvoluntarySwitches() {
+    struct rusage usage;
+    getrusage(RUSAGE_THREAD, &usage);
+    return usage.ru_nivcsw;
+}
+#else
+static long InvoluntarySwitches() {
+    return 0;
+}
+#endif
+
+TEST(PerformanceMetrics_RealtimeFaultLatency) {
+    std::cout << "\n=== Performance Test: Real-Time Fault Latency ===\n";
+    
+    // Every access below faults, freezing one page and restoring another
+    const size_t num_pages = 48;
+    const size_t budget = 8;
+    const size_t samples = 3000;
+    static GhostRealtimeManager<num_pages, num_pages * GhostLz4Codec::kMaxEncodedSize, budget, 1> manager(budget);
+    
+    uint8_t* data = static_cast<uint8_t*>(manager.Allocate(num_pages * PAGE_SIZE));
+    ASSERT_NOT_NULL(data);
+    
+    // Random pages are the slowest to compress, text the slowest to decompress
+    const char* text = "The quick brown fox jumps over the lazy dog. ";
+    const size_t text_len = strlen(text);
+    std::mt19937 fill_gen(99);
+    for (size_t p = 0; p < num_pages; p++) {
+        uint8_t* page = data + p * PAGE_SIZE;
+        for (size_t j = 0; j < PAGE_SIZE; j++) {
+            page[j] = (p % 2 == 0) ? static_cast<uint8_t>(fill_gen()) : static_cast<uint8_t>(text[j % text_len]);
+        }
+    }
+    
+    // Samples during which the scheduler preempted us say nothing about
+    // the fault path and are left out
+    std::vector<double> latencies;
+    latencies.reserve(samples);
+    size_t preempted = 0;
+    uint64_t faults_before = manager.GetStats().page_faults;
+    for (size_t i = 0; i < samples; i++) {
+        volatile uint8_t* byte = data + (i % num_pages) * PAGE_SIZE + 100;
+        long switches = InvoluntarySwitches();
+        auto start = std::chrono::steady_clock::now();
+        *byte = static_cast<uint8_t>(*byte + 1);
+        auto end = std::chrono::steady_clock::now();
+        if (InvoluntarySwitches() != switches) {
+            preempted++;
+            continue;
+        }
+        latencies.push_back(std::chrono::duration<double, std::micro>(end - start).count());
+    }
+    uint64_t faults = manager.GetStats().page_faults - faults_before;
+    manager.Deallocate(data);
+    
+    ASSERT_EQ(faults, samples);
+    ASSERT_TRUE(latencies.size() > samples / 2);
+    std::sort(latencies.begin(), latencies.end());
+    double p50 = latencies[latencies.size() / 2];
+    double p99 = latencies[latencies.size() * 99 / 100];
+    double worst = latencies.back();
+    
+    std::cout << "Memory locked: " << (manager.IsLocked() ? "yes" : "no (RLIMIT_MEMLOCK)") << "\n";
+    std::cout << "Faults measured: " << latencies.size() << " (" << preempted << " preempted, skipped)\n";
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << "Fault latency p50: " << p50 << " us\n";
+    std::cout << "Fault latency p99: " << p99 << " us\n";
+    std::cout << "Fault latency max: " << worst << " us (bound "
+              << decltype(manager)::kWorstCaseFaultMicros << " us)\n";
+    
+    // Any thread can stall past the bound on a kernel without real-time
+    // scheduling, so the check is opt-in: set GHOSTMEM_CHECK_RT_BOUND=1
+    // on a PREEMPT_RT system with the test on an isolated core
+    const char* check = std::getenv("GHOSTMEM_CHECK_RT_BOUND");
+    if (check != nullptr && strcmp(check, "1") == 0) {
+        std::cout << "\n";
+        ASSERT_TRUE(worst <= decltype(manager)::kWorstCaseFaultMicros);
+    } else {
+        std::cout << "Bound not checked (set GHOSTMEM_CHECK_RT_BOUND=1 to check it)\n\n";
+    }
+}
+
 // ============================================================================
 // MEMORY SAVINGS ESTIMATION TESTS
 // ============================================================================
 
+TEST(PerformanceMetrics_ProfileWarmup) {
+    std::cout << "\n=== Performance Test: Warm-Up with a Hotness Profile ===\n";
+    
+    // A small hot set is revisited between scans over a large cold set.
+    // Refault protection only learns which pages are hot after they have
+    // been pushed out once; a profile from the first run seeds it.
+    const char* path = "test_metrics_warmup.prof";
+    const GhostTag hot_tag = 901;
+    const GhostTag cold_tag = 902;
+    const size_t hot_pages = 16;
+    const size_t cold_pages = 400;
+    const size_t scan_pages = 24;
+    const size_t rounds = cold_pages / scan_pages;
+    std::remove(path);
+    
+    uint64_t refaults[2] = {0, 0};
+    for (int run = 0; run < 2; run++) {
+        GhostConfig config;
+        config.max_memory_pages = 32;
+        config.enable_refault_protection = true;
+        config.protected_pages_percent = 50;
+        config.profile_path = path;
+        ASSERT_TRUE(GhostMemoryManager::Instance().Initialize(config));
+        
+        char* hot = static_cast<char*>(GhostMemoryManager::Instance().AllocateGhost(hot_pages * PAGE_SIZE, hot_tag));
+        char* cold = static_cast<char*>(GhostMemoryManager::Instance().AllocateGhost(cold_pages * PAGE_SIZE, cold_tag));
+        ASSERT_NOT_NULL(hot);
+        ASSERT_NOT_NULL(cold);
+        
+        GhostTagStats before = GhostMemoryManager::Instance().GetTagStats(hot_tag);
+        auto start = std::chrono::high_resolution_clock::now();
+        for (size_t r = 0; r < rounds; r++) {
+            for (size_t p = 0; p < hot_pages; p++) {
+                volatile char* byte = hot + p * PAGE_SIZE;
+                *byte = static_cast<char>(*byte + 1);
+            }
+            for (size_t p = r * scan_pages; p < (r + 1) * scan_pages; p++) {
+                volatile char* byte = cold + p * PAGE_SIZE;
+                *byte = static_cast<char>(r);
+            }
+        }
+        auto end = std::chrono::high_resolution_clock::now();
+        GhostTagStats after = GhostMemoryManager::Instance().GetTagStats(hot_tag);
+        double ms = std::chrono::duration<double, std::milli>(end - start).count();
+        refaults[run] = after.refaults - before.refaults;
+        
+        const char* names[] = {"Cold start", "Profile loaded"};
+        std::cout << std::left << std::setw(16) << names[run] << std::right << std::fixed << std::setprecision(2)
+                  << std::setw(8) << ms << " ms, " << refaults[run] << " hot-page refaults, "
+                  << GhostMemoryManager::Instance().GetStats().profile_protections << " pages protected from the profile\n";
+        
+        GhostMemoryManager::Instance().DeallocateGhost(hot, hot_pages * PAGE_SIZE);
+        GhostMemoryManager::Instance().DeallocateGhost(cold, cold_pages * PAGE_SIZE);
+        
+        // Saves the profile for the next run
+        ASSERT_TRUE(GhostMemoryManager::Instance().Initialize(GhostConfig()));
+    }
+    
+    ASSERT_TRUE(refaults[1] < refaults[0]);
+    std::remove(path);
+    std::cout << "\n";
+}
+
 TEST(MemoryMetrics_EstimatedSavings) {
     std::cout << "\n=== Memory Savings Estimation ===\n";
     
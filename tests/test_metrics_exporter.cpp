@@ -0,0 +1,155 @@
+#ifdef _WIN32
+#include <winsock2.h>   // Must precede windows.h from GhostMemoryManager.h
+#endif
+#include "test_framework.h"
+#include "ghostmem/GhostMemoryManager.h"
+#include "ghostmem/GhostMetricsExporter.h"
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <string>
+
+#ifndef _WIN32
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+// Sends one HTTP GET to 127.0.0.1 and returns the raw response
+static std::string HttpGet(uint16_t port, const std::string& path) {
+#ifdef _WIN32
+    WSADATA wsa;
+    WSAStartup(MAKEWORD(2, 2), &wsa);
+    SOCKET s = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+#else
+    int s = socket(AF_INET, SOCK_STREAM, 0);
+#endif
+    sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = htons(port);
+
+    std::string response;
+    if (connect(s, (sockaddr*)&addr, sizeof(addr)) == 0) {
+        std::string request = "GET " + path + " HTTP/1.1\r\nHost: localhost\r\n\r\n";
+        send(s, request.data(), (int)request.size(), 0);
+        char buffer[4096];
+        int n;
+        while ((n = recv(s, buffer, sizeof(buffer), 0)) > 0) {
+            response.append(buffer, n);
+        }
+    }
+#ifdef _WIN32
+    closesocket(s);
+    WSACleanup();
+#else
+    close(s);
+#endif
+    return response;
+}
+
+static bool Contains(const std::string& text, const std::string& needle) {
+    return text.find(needle) != std::string::npos;
+}
+
+// Counters, gauges and cumulative histogram buckets in OpenMetrics syntax
+TEST(MetricsRenderOpenMetrics) {
+    std::unique_ptr<GhostStatsBlock> block(new GhostStatsBlock);
+    block->Reset();
+    block->page_faults.store(42);
+    block->resident_pages.store(7);
+    block->fault_latency.Record(1000);     // Bucket [512, 1024) ns
+    block->fault_latency.Record(1000);
+    block->fault_latency.Record(3000000);  // ~3 ms
+
+    std::string text = GhostMetricsExporter::Render(*block);
+
+    ASSERT_TRUE(Contains(text, "# TYPE ghostmem_page_faults counter\n"));
+    ASSERT_TRUE(Contains(text, "\nghostmem_page_faults_total 42\n"));
+    ASSERT_TRUE(Contains(text, "# TYPE ghostmem_resident_pages gauge\n"));
+    ASSERT_TRUE(Contains(text, "\nghostmem_resident_pages 7\n"));
+    ASSERT_TRUE(Contains(text, "# TYPE ghostmem_fault_latency_seconds histogram\n"));
+    ASSERT_TRUE(Contains(text, "# UNIT ghostmem_fault_latency_seconds seconds\n"));
+    ASSERT_TRUE(Contains(text, "ghostmem_fault_latency_seconds_bucket{le=\"5.12e-07\"} 0\n"));
+    ASSERT_TRUE(Contains(text, "ghostmem_fault_latency_seconds_bucket{le=\"1.024e-06\"} 2\n"));
+    ASSERT_TRUE(Contains(text, "ghostmem_fault_latency_seconds_bucket{le=\"+Inf\"} 3\n"));
+    ASSERT_TRUE(Contains(text, "ghostmem_fault_latency_seconds_count 3\n"));
+    ASSERT_TRUE(Contains(text, "ghostmem_restore_latency_seconds_count 0\n"));
+
+    // The terminator is mandatory and must be the last line
+    ASSERT_EQ(text.rfind("# EOF\n"), text.size() - 6);
+}
+
+// The file target is written at start and once more when stopping
+TEST(MetricsFileExport) {
+    const char* path = "ghostmem_test_metrics.prom";
+    std::remove(path);
+
+    GhostConfig config;
+    config.max_memory_pages = 4;
+    config.metrics_file_path = path;
+    config.metrics_interval_ms = 60000;
+    ASSERT_TRUE(GhostMemoryManager::Instance().Initialize(config));
+
+    const size_t num_pages = 6;
+    char* data = static_cast<char*>(GhostMemoryManager::Instance().AllocateGhost(num_pages * PAGE_SIZE));
+    ASSERT_NOT_NULL(data);
+    for (size_t p = 0; p < num_pages; p++) {
+        data[p * PAGE_SIZE] = 1;
+    }
+    uint64_t faults = GhostMemoryManager::Instance().GetStats().page_faults;
+    GhostMemoryManager::Instance().DeallocateGhost(data, num_pages * PAGE_SIZE);
+
+    // Re-initializing stops the exporter, which writes the final figures
+    ASSERT_TRUE(GhostMemoryManager::Instance().Initialize(GhostConfig()));
+
+    std::ifstream file(path);
+    ASSERT_TRUE(file.good());
+    std::stringstream content;
+    content << file.rdbuf();
+    ASSERT_TRUE(Contains(content.str(), "\nghostmem_page_faults_total " + std::to_string(faults) + "\n"));
+    ASSERT_TRUE(Contains(content.str(), "# EOF\n"));
+    file.close();
+    std::remove(path);
+}
+
+// Scrapes over HTTP see live values without pausing the process
+TEST(MetricsHttpEndpoint) {
+    GhostConfig config;
+    config.max_memory_pages = 4;
+    config.enable_metrics_http = true;
+    config.metrics_port = 0;  // Any free port
+    ASSERT_TRUE(GhostMemoryManager::Instance().Initialize(config));
+
+    uint16_t port = GhostMemoryManager::Instance().GetMetricsPort();
+    ASSERT_TRUE(port != 0);
+
+    const size_t num_pages = 6;
+    char* data = static_cast<char*>(GhostMemoryManager::Instance().AllocateGhost(num_pages * PAGE_SIZE));
+    ASSERT_NOT_NULL(data);
+    for (size_t p = 0; p < num_pages; p++) {
+        data[p * PAGE_SIZE] = 1;
+    }
+    uint64_t faults = GhostMemoryManager::Instance().GetStats().page_faults;
+
+    std::string response = HttpGet(port, "/metrics");
+    ASSERT_TRUE(Contains(response, "HTTP/1.1 200 OK\r\n"));
+    ASSERT_TRUE(Contains(response, "Content-Type: application/openmetrics-text"));
+    ASSERT_TRUE(Contains(response, "\nghostmem_page_faults_total " + std::to_string(faults) + "\n"));
+    ASSERT_TRUE(Contains(response, "\nghostmem_resident_pages 4\n"));
+    ASSERT_TRUE(Contains(response, "# EOF\n"));
+
+    ASSERT_TRUE(Contains(HttpGet(port, "/other"), "HTTP/1.1 404 Not Found\r\n"));
+
+    // Same text is available to applications with their own server
+    ASSERT_TRUE(Contains(GhostMemoryManager::Instance().RenderMetrics(),
+                         "\nghostmem_page_faults_total " + std::to_string(faults) + "\n"));
+
+    GhostMemoryManager::Instance().DeallocateGhost(data, num_pages * PAGE_SIZE);
+    ASSERT_TRUE(GhostMemoryManager::Instance().Initialize(GhostConfig()));
+    ASSERT_EQ(GhostMemoryManager::Instance().GetMetricsPort(), 0u);
+}
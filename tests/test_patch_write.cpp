@@ -0,0 +1,271 @@
+#include "test_framework.h"
+#include "ghostmem/GhostMemoryManager.h"
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+static char RecordByte(size_t page, size_t i) {
+    return static_cast<char>('a' + (i * 3 + page) % 26);
+}
+
+static void FillRecords(char* data, size_t num_pages) {
+    for (size_t p = 0; p < num_pages; p++) {
+        for (size_t i = 0; i < PAGE_SIZE; i++) {
+            data[p * PAGE_SIZE + i] = RecordByte(p, i);
+        }
+    }
+}
+
+// Checks a page against the fill pattern with one counter at offset 64
+static bool CheckRecord(char* data, size_t page, uint64_t counter) {
+    volatile char* bytes = data + page * PAGE_SIZE;
+    for (size_t i = 0; i < PAGE_SIZE; i++) {
+        if (i >= 64 && i < 64 + sizeof(counter)) {
+            continue;
+        }
+        if (bytes[i] != RecordByte(page, i)) {
+            return false;
+        }
+    }
+    uint64_t stored;
+    memcpy(&stored, data + page * PAGE_SIZE + 64, sizeof(stored));
+    return stored == counter;
+}
+
+// Small writes into frozen pages are logged instead of faulting them in
+TEST(PatchWriteAvoidsFaults) {
+    GhostConfig config;
+    config.max_memory_pages = 4;
+    ASSERT_TRUE(GhostMemoryManager::Instance().Initialize(config));
+
+    const size_t num_pages = 16;
+    char* data = static_cast<char*>(GhostMemoryManager::Instance().AllocateGhost(num_pages * PAGE_SIZE));
+    ASSERT_NOT_NULL(data);
+    FillRecords(data, num_pages);
+
+    GhostStats before = GhostMemoryManager::Instance().GetStats();
+    for (size_t p = 0; p < num_pages - 4; p++) {
+        uint64_t counter = 1000 + p;
+        ASSERT_TRUE(GhostWrite(data + p * PAGE_SIZE + 64, &counter, sizeof(counter)));
+    }
+    GhostStats after = GhostMemoryManager::Instance().GetStats();
+    ASSERT_EQ(after.page_faults, before.page_faults);
+    ASSERT_EQ(after.evictions, before.evictions);
+    ASSERT_EQ(after.patch_writes - before.patch_writes, num_pages - 4);
+    ASSERT_TRUE(after.compressed_bytes > before.compressed_bytes);
+
+    // The next real thaw applies the log
+    for (size_t p = 0; p < num_pages - 4; p++) {
+        ASSERT_TRUE(CheckRecord(data, p, 1000 + p));
+    }
+    ASSERT_TRUE(GhostMemoryManager::Instance().GetStats().page_faults > after.page_faults);
+
+    GhostMemoryManager::Instance().DeallocateGhost(data, num_pages * PAGE_SIZE);
+    ASSERT_TRUE(GhostMemoryManager::Instance().Initialize(GhostConfig()));
+}
+
+// A full log is folded into the frozen image, still without a fault
+TEST(PatchWriteCompactsFullLog) {
+    GhostConfig config;
+    config.max_memory_pages = 2;
+    config.patch_log_bytes = 64;
+    config.enable_delta_compression = true;
+    ASSERT_TRUE(GhostMemoryManager::Instance().Initialize(config));
+
+    const size_t num_pages = 8;
+    char* data = static_cast<char*>(GhostMemoryManager::Instance().AllocateGhost(num_pages * PAGE_SIZE));
+    ASSERT_NOT_NULL(data);
+    FillRecords(data, num_pages);
+
+    GhostStats before = GhostMemoryManager::Instance().GetStats();
+    for (uint64_t counter = 1; counter <= 100; counter++) {
+        ASSERT_TRUE(GhostWrite(data + 64, &counter, sizeof(counter)));
+    }
+    GhostStats after = GhostMemoryManager::Instance().GetStats();
+    ASSERT_EQ(after.page_faults, before.page_faults);
+    ASSERT_EQ(after.evictions, before.evictions);
+    ASSERT_EQ(after.patch_writes - before.patch_writes, 100u);
+    ASSERT_TRUE(after.patch_compactions - before.patch_compactions >= 100u / 6);
+
+    ASSERT_TRUE(CheckRecord(data, 0, 100));
+
+    // Writes larger than the log go straight to the page
+    char block[128];
+    memset(block, 'z', sizeof(block));
+    ASSERT_TRUE(GhostWrite(data + 3 * PAGE_SIZE + 256, block, sizeof(block)));
+    ASSERT_EQ(*static_cast<volatile char*>(data + 3 * PAGE_SIZE + 300), 'z');
+
+    GhostMemoryManager::Instance().DeallocateGhost(data, num_pages * PAGE_SIZE);
+    ASSERT_TRUE(GhostMemoryManager::Instance().Initialize(GhostConfig()));
+}
+
+// Disk-frozen and never touched pages take patches too; writes may span pages
+TEST(PatchWriteDiskAndFreshPages) {
+    GhostConfig config;
+    config.use_disk_backing = true;
+    config.disk_file_path = "test_patch_write.swap";
+    config.max_memory_pages = 4;
+    ASSERT_TRUE(GhostMemoryManager::Instance().Initialize(config));
+
+    const size_t num_pages = 12;
+    char* data = static_cast<char*>(GhostMemoryManager::Instance().AllocateGhost(num_pages * PAGE_SIZE));
+    ASSERT_NOT_NULL(data);
+    FillRecords(data, num_pages / 2);
+
+    GhostStats before = GhostMemoryManager::Instance().GetStats();
+    uint64_t counter = 42;
+    ASSERT_TRUE(GhostWrite(data + PAGE_SIZE + 64, &counter, sizeof(counter)));
+    const char* text = "written across the boundary of two untouched pages";
+    char* spanning = data + 9 * PAGE_SIZE - 10;
+    ASSERT_TRUE(GhostWrite(spanning, text, strlen(text) + 1));
+    ASSERT_EQ(GhostMemoryManager::Instance().GetStats().page_faults, before.page_faults);
+    ASSERT_EQ(GhostMemoryManager::Instance().GetStats().patch_writes - before.patch_writes, 3u);
+
+    // Background compaction writes new disk records
+    ASSERT_EQ(GhostMemoryManager::Instance().CompactPatches(), 3u);
+    GhostStats compacted = GhostMemoryManager::Instance().GetStats();
+    ASSERT_EQ(compacted.page_faults, before.page_faults);
+    ASSERT_TRUE(compacted.disk_bytes > before.disk_bytes);
+
+    ASSERT_TRUE(CheckRecord(data, 1, 42));
+    ASSERT_TRUE(strcmp(spanning, text) == 0);
+    ASSERT_EQ(*static_cast<volatile char*>(data + 9 * PAGE_SIZE + 100), 0);
+
+    // Ranges outside ghost allocations are rejected
+    char outside[16];
+    ASSERT_TRUE(!GhostWrite(outside, text, sizeof(outside)));
+    ASSERT_TRUE(!GhostWrite(data + num_pages * PAGE_SIZE - 4, text, 8));
+
+    GhostMemoryManager::Instance().DeallocateGhost(data, num_pages * PAGE_SIZE);
+    ASSERT_TRUE(GhostMemoryManager::Instance().Initialize(GhostConfig()));
+    std::remove("test_patch_write.swap");
+}
+
+// Compaction never opens the page, so a thread storing into it meanwhile
+// neither sees a half-restored page nor loses a store
+TEST(PatchCompactionWithConcurrentWriter) {
+    GhostConfig config;
+    config.max_memory_pages = 4;
+    ASSERT_TRUE(GhostMemoryManager::Instance().Initialize(config));
+
+    const size_t num_pages = 8;
+    const size_t word_offset = 128;
+    char* data = static_cast<char*>(GhostMemoryManager::Instance().AllocateGhost(num_pages * PAGE_SIZE));
+    ASSERT_NOT_NULL(data);
+    FillRecords(data, num_pages);
+    GhostStats before = GhostMemoryManager::Instance().GetStats();
+
+    std::atomic<bool> done(false);
+    std::atomic<int> bad_reads(0);
+    uint64_t stored[num_pages] = {};
+    std::thread writer([&]() {
+        for (uint64_t round = 1; round <= 300; round++) {
+            for (size_t p = 0; p < num_pages; p++) {
+                volatile uint64_t* word = reinterpret_cast<volatile uint64_t*>(data + p * PAGE_SIZE + word_offset);
+                uint64_t value = round * num_pages + p;
+                *word = value;
+                if (*word != value || data[p * PAGE_SIZE] != RecordByte(p, 0)) {
+                    bad_reads++;
+                }
+                stored[p] = value;
+            }
+        }
+        done = true;
+    });
+
+    // Patch another field of every page and fold the logs meanwhile
+    uint64_t counter = 0;
+    uint64_t patched[num_pages] = {};
+    int failed_writes = 0;
+    while (!done) {
+        for (size_t p = 0; p < num_pages; p++) {
+            counter++;
+            if (!GhostWrite(data + p * PAGE_SIZE + 64, &counter, sizeof(counter))) {
+                failed_writes++;
+            }
+            patched[p] = counter;
+        }
+        GhostMemoryManager::Instance().CompactPatches();
+    }
+    writer.join();
+
+    ASSERT_EQ(failed_writes, 0);
+    ASSERT_EQ(bad_reads.load(), 0);
+    ASSERT_TRUE(GhostMemoryManager::Instance().GetStats().patch_compactions > before.patch_compactions);
+    for (size_t p = 0; p < num_pages; p++) {
+        uint64_t word;
+        memcpy(&word, data + p * PAGE_SIZE + word_offset, sizeof(word));
+        ASSERT_EQ(word, stored[p]);
+        memcpy(&word, data + p * PAGE_SIZE + 64, sizeof(word));
+        ASSERT_EQ(word, patched[p]);
+        for (size_t i = 0; i < PAGE_SIZE; i++) {
+            bool field = (i >= 64 && i < 64 + sizeof(word)) || (i >= word_offset && i < word_offset + sizeof(word));
+            if (!field) {
+                ASSERT_EQ(data[p * PAGE_SIZE + i], RecordByte(p, i));
+            }
+        }
+    }
+
+    GhostMemoryManager::Instance().DeallocateGhost(data, num_pages * PAGE_SIZE);
+    ASSERT_TRUE(GhostMemoryManager::Instance().Initialize(GhostConfig()));
+}
+
+static void CountError(const GhostError&, void* user_data) {
+    (*static_cast<size_t*>(user_data))++;
+}
+
+// Compacting onto a damaged swap record reports it once and replaces it
+// with what a fault would restore: a zero page plus the patches
+TEST(PatchWriteCompactsDamagedRecord) {
+    size_t errors = 0;
+    GhostConfig config;
+    config.use_disk_backing = true;
+    config.disk_file_path = "test_patch_damaged.swap";
+    config.max_memory_pages = 4;
+    config.patch_log_bytes = 64;
+    config.error_callback = CountError;
+    config.error_callback_data = &errors;
+    ASSERT_TRUE(GhostMemoryManager::Instance().Initialize(config));
+
+    const size_t num_pages = 8;
+    char* data = static_cast<char*>(GhostMemoryManager::Instance().AllocateGhost(num_pages * PAGE_SIZE));
+    ASSERT_NOT_NULL(data);
+    FillRecords(data, num_pages);
+
+    // Flip every byte written so far; page 0 is among the frozen pages
+    size_t disk_bytes = GhostMemoryManager::Instance().GetStats().disk_bytes;
+    FILE* file = fopen("test_patch_damaged.swap", "r+b");
+    ASSERT_NOT_NULL(file);
+    std::vector<unsigned char> bytes(disk_bytes);
+    bool corrupted = fread(bytes.data(), 1, disk_bytes, file) == disk_bytes;
+    for (auto& byte : bytes) {
+        byte ^= 0x5A;
+    }
+    corrupted = corrupted && fseek(file, 0, SEEK_SET) == 0 && fwrite(bytes.data(), 1, disk_bytes, file) == disk_bytes;
+    fclose(file);
+    ASSERT_TRUE(corrupted);
+
+    GhostStats before = GhostMemoryManager::Instance().GetStats();
+    for (uint64_t counter = 1; counter <= 50; counter++) {
+        ASSERT_TRUE(GhostWrite(data + 64, &counter, sizeof(counter)));
+    }
+    GhostMemoryManager::Instance().CompactPatches();
+    GhostStats after = GhostMemoryManager::Instance().GetStats();
+    ASSERT_EQ(after.page_faults, before.page_faults);
+    ASSERT_EQ(after.integrity_errors - before.integrity_errors, 1u);
+    ASSERT_EQ(errors, 1u);
+    ASSERT_TRUE(after.patch_compactions - before.patch_compactions >= 50u / 6);
+
+    uint64_t stored = 0;
+    memcpy(&stored, data + 64, sizeof(stored));
+    ASSERT_EQ(stored, 50u);
+    ASSERT_EQ(*static_cast<volatile char*>(data + 63), 0);
+    ASSERT_EQ(*static_cast<volatile char*>(data + PAGE_SIZE - 1), 0);
+    ASSERT_EQ(GhostMemoryManager::Instance().GetStats().integrity_errors, after.integrity_errors);
+
+    GhostMemoryManager::Instance().DeallocateGhost(data, num_pages * PAGE_SIZE);
+    ASSERT_TRUE(GhostMemoryManager::Instance().Initialize(GhostConfig()));
+    std::remove("test_patch_damaged.swap");
+}
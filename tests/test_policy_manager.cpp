@@ -0,0 +1,238 @@
+#include "test_framework.h"
+#include "ghostmem/GhostPolicyManager.h"
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+static const size_t kPolicyPages = 16;
+
+// Writes a distinct byte to every page, one page at a time
+static void FillPages(char* data, size_t num_pages) {
+    for (size_t p = 0; p < num_pages; p++) {
+        memset(data + p * PAGE_SIZE, 'A' + static_cast<int>(p % 26), PAGE_SIZE);
+    }
+}
+
+static bool CheckPages(char* data, size_t num_pages) {
+    for (size_t p = 0; p < num_pages; p++) {
+        volatile char* page = data + p * PAGE_SIZE;
+        if (page[0] != 'A' + static_cast<int>(p % 26) || page[PAGE_SIZE - 1] != page[0]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// RFC 8439 section 2.4.2 test vector
+TEST(PolicyChaCha20MatchesRfc8439) {
+    unsigned char key[GHOST_CHACHA20_KEY_SIZE];
+    for (size_t i = 0; i < sizeof(key); i++) {
+        key[i] = static_cast<unsigned char>(i);
+    }
+    unsigned char nonce[GHOST_CHACHA20_NONCE_SIZE] = {0, 0, 0, 0, 0, 0, 0, 0x4a, 0, 0, 0, 0};
+    const char* text = "Ladies and Gentlemen of the class of '99: If I could offer you "
+                       "only one tip for the future, sunscreen would be it.";
+    std::vector<unsigned char> data(text, text + strlen(text));
+
+    GhostChaCha20Crypt(key, nonce, 1, data.data(), data.size());
+    const unsigned char expected[16] = {0x6e, 0x2e, 0x35, 0x9a, 0x25, 0x68, 0xf9, 0x80,
+                                        0x41, 0xba, 0x07, 0x28, 0xdd, 0x0d, 0x69, 0x81};
+    ASSERT_TRUE(memcmp(data.data(), expected, sizeof(expected)) == 0);
+
+    GhostChaCha20Crypt(key, nonce, 1, data.data(), data.size());
+    ASSERT_TRUE(memcmp(data.data(), text, data.size()) == 0);
+}
+
+// In-memory LZ4 + LRU: every page survives freezing, LRU order is exact
+TEST(PolicyManagerLz4RoundTrip) {
+    GhostLz4Manager manager(4);
+    char* data = static_cast<char*>(manager.Allocate(kPolicyPages * PAGE_SIZE));
+    ASSERT_NOT_NULL(data);
+
+    FillPages(data, kPolicyPages);
+    GhostStats stats = manager.GetStats();
+    ASSERT_EQ(stats.page_faults, kPolicyPages);
+    ASSERT_EQ(stats.evictions, kPolicyPages - 4);
+    ASSERT_EQ(stats.resident_pages, 4u);
+    ASSERT_EQ(stats.frozen_pages, kPolicyPages - 4);
+    ASSERT_TRUE(stats.compressed_bytes > 0);
+    ASSERT_TRUE(stats.compressed_bytes < PAGE_SIZE);  // Uniform pages compress to a few bytes
+
+    // A cyclic scan over more pages than the budget refaults every page
+    ASSERT_TRUE(CheckPages(data, kPolicyPages));
+    stats = manager.GetStats();
+    ASSERT_EQ(stats.refaults, kPolicyPages);
+    ASSERT_EQ(stats.budget_pages, 4u);
+
+    manager.Deallocate(data);
+    stats = manager.GetStats();
+    ASSERT_EQ(stats.resident_pages, 0u);
+    ASSERT_EQ(stats.frozen_pages, 0u);
+    ASSERT_EQ(stats.compressed_bytes, 0u);
+}
+
+// Encrypted swap file: nothing readable on disk, slots are reused
+TEST(PolicyManagerEncryptedDisk) {
+    const char* path = "test_policy_manager.swap";
+    const char* marker = "GHOSTMEM-PLAINTEXT-MARKER";
+    {
+        GhostEncryptedDiskManager manager(4);
+        ASSERT_TRUE(manager.Allocate(PAGE_SIZE) == nullptr);  // File not open yet
+        ASSERT_TRUE(manager.GetBacking().Open(path));
+
+        char* data = static_cast<char*>(manager.Allocate(kPolicyPages * PAGE_SIZE));
+        ASSERT_NOT_NULL(data);
+        FillPages(data, kPolicyPages);
+        for (size_t p = 0; p < kPolicyPages; p++) {
+            memcpy(data + p * PAGE_SIZE + 64, marker, strlen(marker));
+        }
+        // Push the last pages out as well
+        char* other = static_cast<char*>(manager.Allocate(4 * PAGE_SIZE));
+        ASSERT_NOT_NULL(other);
+        FillPages(other, 4);
+        size_t first_pass_bytes = manager.GetStats().disk_bytes;
+        ASSERT_TRUE(first_pass_bytes > 0);
+
+        std::string contents;
+        FILE* file = fopen(path, "rb");
+        ASSERT_NOT_NULL(file);
+        char buffer[4096];
+        size_t got;
+        while ((got = fread(buffer, 1, sizeof(buffer), file)) > 0) {
+            contents.append(buffer, got);
+        }
+        fclose(file);
+        ASSERT_TRUE(contents.find(marker) == std::string::npos);
+
+        for (size_t p = 0; p < kPolicyPages; p++) {
+            ASSERT_TRUE(memcmp(data + p * PAGE_SIZE + 64, marker, strlen(marker)) == 0);
+            ASSERT_EQ(data[p * PAGE_SIZE], static_cast<char>('A' + p % 26));
+        }
+        ASSERT_TRUE(CheckPages(other, 4));
+
+        // Refreezing the same pages reuses their slots
+        ASSERT_TRUE(manager.GetStats().disk_bytes <= first_pass_bytes + 2 * PAGE_SIZE);
+
+        manager.Deallocate(data);
+        manager.Deallocate(other);
+        ASSERT_EQ(manager.GetStats().frozen_pages, 0u);
+        manager.GetBacking().Close();
+    }
+    std::remove(path);
+}
+
+// Raw codec, random eviction, no locking
+TEST(PolicyManagerRawRandomSingleThread) {
+    BasicGhostManager<GhostMemoryBacking, GhostRawCodec, GhostNoCipher,
+                      GhostRandomEviction, GhostNoLock> manager(3);
+    char* data = static_cast<char*>(manager.Allocate(kPolicyPages * PAGE_SIZE));
+    ASSERT_NOT_NULL(data);
+
+    FillPages(data, kPolicyPages);
+    ASSERT_TRUE(CheckPages(data, kPolicyPages));
+    ASSERT_TRUE(CheckPages(data, kPolicyPages));
+
+    GhostStats stats = manager.GetStats();
+    ASSERT_EQ(stats.resident_pages, 3u);
+    ASSERT_EQ(stats.frozen_pages, kPolicyPages - 3);
+    ASSERT_EQ(stats.compressed_bytes, (kPolicyPages - 3) * PAGE_SIZE);
+    manager.Deallocate(data);
+}
+
+// Faults reach the right manager when both kinds are in use
+TEST(PolicyManagerCoexistsWithSingleton) {
+    GhostConfig config;
+    config.max_memory_pages = 4;
+    ASSERT_TRUE(GhostMemoryManager::Instance().Initialize(config));
+    uint64_t singleton_faults = GhostMemoryManager::Instance().GetStats().page_faults;
+
+    GhostLz4Manager manager(4);
+    char* ours = static_cast<char*>(manager.Allocate(8 * PAGE_SIZE));
+    char* theirs = static_cast<char*>(GhostMemoryManager::Instance().AllocateGhost(8 * PAGE_SIZE));
+    ASSERT_NOT_NULL(ours);
+    ASSERT_NOT_NULL(theirs);
+
+    for (size_t p = 0; p < 8; p++) {
+        memset(ours + p * PAGE_SIZE, 'o', PAGE_SIZE);
+        memset(theirs + p * PAGE_SIZE, 't', PAGE_SIZE);
+    }
+    for (size_t p = 0; p < 8; p++) {
+        ASSERT_EQ(ours[p * PAGE_SIZE + 7], 'o');
+        ASSERT_EQ(theirs[p * PAGE_SIZE + 7], 't');
+    }
+
+    ASSERT_EQ(manager.GetStats().page_faults, 16u);
+    ASSERT_EQ(GhostMemoryManager::Instance().GetStats().page_faults - singleton_faults, 16u);
+
+    manager.Deallocate(ours);
+    GhostMemoryManager::Instance().DeallocateGhost(theirs, 8 * PAGE_SIZE);
+    ASSERT_TRUE(GhostMemoryManager::Instance().Initialize(GhostConfig()));
+}
+
+static std::vector<int> g_dispatch_order;
+
+static bool RecordDispatch(void* owner, void*, const void*) {
+    g_dispatch_order.push_back(*static_cast<int*>(owner));
+    return false;
+}
+
+// Callbacks registered with first = true see a fault before the others,
+// whatever their slot (a real-time manager never waits behind the singleton)
+TEST(DispatcherOffersFaultsToFirstCallbacksFirst) {
+    int normal = 1;
+    int first = 2;
+    int unmanaged = 0;
+    g_dispatch_order.clear();
+    bool registered_normal = GhostFaultDispatcher::Register(RecordDispatch, &normal);
+    bool registered_first = GhostFaultDispatcher::Register(RecordDispatch, &first, true);
+    bool claimed = GhostFaultDispatcher::Dispatch(&unmanaged, nullptr);
+    GhostFaultDispatcher::Unregister(RecordDispatch, &normal);
+    GhostFaultDispatcher::Unregister(RecordDispatch, &first);
+
+    ASSERT_TRUE(registered_normal && registered_first);
+    ASSERT_TRUE(!claimed);
+    ASSERT_EQ(g_dispatch_order.size(), 2u);
+    ASSERT_EQ(g_dispatch_order[0], 2);
+    ASSERT_EQ(g_dispatch_order[1], 1);
+}
+
+// Threads rewriting their own pages while the others evict them
+TEST(PolicyManagerConcurrentWriters) {
+    GhostLz4Manager manager(4);
+    const int NUM_THREADS = 4;
+    const size_t NUM_PAGES = 6;
+    std::atomic<int> failures(0);
+    std::vector<std::thread> threads;
+
+    for (int t = 0; t < NUM_THREADS; t++) {
+        threads.emplace_back([&, t]() {
+            char* data = static_cast<char*>(manager.Allocate(NUM_PAGES * PAGE_SIZE));
+            if (data == nullptr) {
+                failures++;
+                return;
+            }
+            for (int round = 0; round < 100; round++) {
+                char value = static_cast<char>('a' + (t * 7 + round) % 26);
+                for (size_t p = 0; p < NUM_PAGES; p++) {
+                    memset(data + p * PAGE_SIZE, value, PAGE_SIZE);
+                }
+                for (size_t p = 0; p < NUM_PAGES; p++) {
+                    volatile char* page = data + p * PAGE_SIZE;
+                    if (page[0] != value || page[PAGE_SIZE - 1] != value) {
+                        failures++;
+                    }
+                }
+            }
+            manager.Deallocate(data);
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    ASSERT_EQ(failures.load(), 0);
+    ASSERT_EQ(manager.GetStats().resident_pages, 0u);
+}
@@ -0,0 +1,110 @@
+#include "test_framework.h"
+#include "ghostmem/GhostMemoryManager.h"
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+static const GhostTag kHotTag = 701;
+static const GhostTag kColdTag = 702;
+
+// Fault count recorded for a tag, -1 if the profile has no line for it
+static double ProfileFaults(const char* path, GhostTag tag) {
+    std::ifstream file(path);
+    std::string line;
+    while (std::getline(file, line)) {
+        std::istringstream fields(line);
+        std::string kind;
+        GhostTag id = 0;
+        double faults = 0.0;
+        if (fields >> kind >> id >> faults && kind == "tag" && id == tag) {
+            return faults;
+        }
+    }
+    return -1.0;
+}
+
+static void Touch(char* data, size_t first_page, size_t num_pages) {
+    for (size_t p = first_page; p < first_page + num_pages; p++) {
+        volatile char* byte = data + p * PAGE_SIZE;
+        *byte = static_cast<char>(*byte + 1);
+    }
+}
+
+// What a run observed is saved on re-initialization and decays by half
+// in every later run that does not see the tag again
+TEST(ProfileSavedAndDecayed) {
+    const char* path = "test_profile_roundtrip.prof";
+    std::remove(path);
+
+    GhostConfig config;
+    config.max_memory_pages = 4;
+    config.profile_path = path;
+    ASSERT_TRUE(GhostMemoryManager::Instance().Initialize(config));
+
+    const size_t num_pages = 8;
+    char* hot = static_cast<char*>(GhostMemoryManager::Instance().AllocateGhost(num_pages * PAGE_SIZE, kHotTag));
+    ASSERT_NOT_NULL(hot);
+    for (size_t r = 0; r < 4; r++) {
+        Touch(hot, 0, num_pages);  // Cyclic over twice the budget: every fault thrashes
+    }
+    GhostMemoryManager::Instance().DeallocateGhost(hot, num_pages * PAGE_SIZE);
+
+    ASSERT_TRUE(GhostMemoryManager::Instance().Initialize(config));
+    std::ifstream file(path);
+    std::string header;
+    ASSERT_TRUE(std::getline(file, header) && header == "ghostmem-profile 1");
+    double faults = ProfileFaults(path, kHotTag);
+    ASSERT_EQ(faults, 32.0);
+    ASSERT_EQ(ProfileFaults(path, kColdTag), -1.0);
+
+    ASSERT_TRUE(GhostMemoryManager::Instance().Initialize(GhostConfig()));
+    ASSERT_EQ(ProfileFaults(path, kHotTag), faults / 2);
+
+    // Not a profile: ignored
+    std::ofstream(path) << "something else\n";
+    ASSERT_TRUE(!GhostMemoryManager::Instance().LoadProfile(path));
+    std::remove(path);
+    ASSERT_TRUE(!GhostMemoryManager::Instance().LoadProfile(path));
+}
+
+// Pages of a tag that thrashed before are protected on their first fault
+TEST(ProfileProtectsHotTagsOnFirstFault) {
+    const char* path = "test_profile_seed.prof";
+    std::ofstream(path) << "ghostmem-profile 1\n"
+                           "tag " << kHotTag << " 100 80 0 0\n"
+                           "tag " << kColdTag << " 100 0 0 0\n";
+
+    GhostConfig config;
+    config.max_memory_pages = 8;
+    config.enable_refault_protection = true;
+    config.protected_pages_percent = 50;
+    config.profile_path = path;
+    ASSERT_TRUE(GhostMemoryManager::Instance().Initialize(config));
+
+    GhostStats before = GhostMemoryManager::Instance().GetStats();
+    const size_t hot_pages = 3;
+    const size_t cold_pages = 40;
+    char* hot = static_cast<char*>(GhostMemoryManager::Instance().AllocateGhost(hot_pages * PAGE_SIZE, kHotTag));
+    char* cold = static_cast<char*>(GhostMemoryManager::Instance().AllocateGhost(cold_pages * PAGE_SIZE, kColdTag));
+    ASSERT_NOT_NULL(hot);
+    ASSERT_NOT_NULL(cold);
+
+    Touch(hot, 0, hot_pages);
+    GhostStats seeded = GhostMemoryManager::Instance().GetStats();
+    ASSERT_EQ(seeded.profile_protections - before.profile_protections, hot_pages);
+    ASSERT_EQ(seeded.protected_pages, hot_pages);
+
+    // A long scan of cold pages does not push the hot pages out
+    Touch(cold, 0, cold_pages);
+    GhostTagStats hot_before = GhostMemoryManager::Instance().GetTagStats(kHotTag);
+    Touch(hot, 0, hot_pages);
+    GhostTagStats hot_after = GhostMemoryManager::Instance().GetTagStats(kHotTag);
+    ASSERT_EQ(hot_after.page_faults, hot_before.page_faults);
+    ASSERT_EQ(GhostMemoryManager::Instance().GetStats().profile_protections - before.profile_protections, hot_pages);
+
+    GhostMemoryManager::Instance().DeallocateGhost(hot, hot_pages * PAGE_SIZE);
+    GhostMemoryManager::Instance().DeallocateGhost(cold, cold_pages * PAGE_SIZE);
+    ASSERT_TRUE(GhostMemoryManager::Instance().Initialize(GhostConfig()));
+    std::remove(path);
+}
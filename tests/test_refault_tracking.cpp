@@ -0,0 +1,97 @@
+#include "test_framework.h"
+#include "ghostmem/GhostMemoryManager.h"
+
+// Touches the first byte of each page in order, `rounds` times
+static void CyclePages(char* data, size_t num_pages, int rounds) {
+    for (int round = 0; round < rounds; round++) {
+        for (size_t p = 0; p < num_pages; p++) {
+            volatile char* byte = data + p * PAGE_SIZE;
+            *byte = static_cast<char>(*byte + 1);
+        }
+    }
+}
+
+// A loop slightly larger than the budget refaults within the budget
+TEST(RefaultDistanceThrash) {
+    GhostConfig config;
+    config.max_memory_pages = 4;
+    ASSERT_TRUE(GhostMemoryManager::Instance().Initialize(config));
+
+    const size_t num_pages = 5;
+    char* data = static_cast<char*>(GhostMemoryManager::Instance().AllocateGhost(num_pages * PAGE_SIZE));
+    ASSERT_NOT_NULL(data);
+    CyclePages(data, num_pages, 1);
+
+    GhostStats before = GhostMemoryManager::Instance().GetStats();
+    CyclePages(data, num_pages, 10);
+    GhostStats after = GhostMemoryManager::Instance().GetStats();
+
+    ASSERT_TRUE(after.thrash_refaults - before.thrash_refaults > 0);
+    ASSERT_EQ(after.cold_refaults, before.cold_refaults);
+
+    GhostMemoryManager::Instance().DeallocateGhost(data, num_pages * PAGE_SIZE);
+    ASSERT_TRUE(GhostMemoryManager::Instance().Initialize(GhostConfig()));
+}
+
+// A scan much larger than the budget produces cold refaults only
+TEST(RefaultDistanceCold) {
+    GhostConfig config;
+    config.max_memory_pages = 4;
+    ASSERT_TRUE(GhostMemoryManager::Instance().Initialize(config));
+
+    const size_t num_pages = 40;
+    char* data = static_cast<char*>(GhostMemoryManager::Instance().AllocateGhost(num_pages * PAGE_SIZE));
+    ASSERT_NOT_NULL(data);
+    CyclePages(data, num_pages, 1);
+
+    GhostStats before = GhostMemoryManager::Instance().GetStats();
+    CyclePages(data, num_pages, 2);
+    GhostStats after = GhostMemoryManager::Instance().GetStats();
+
+    ASSERT_TRUE(after.cold_refaults - before.cold_refaults >= num_pages);
+    ASSERT_EQ(after.thrash_refaults, before.thrash_refaults);
+
+    GhostMemoryManager::Instance().DeallocateGhost(data, num_pages * PAGE_SIZE);
+    ASSERT_TRUE(GhostMemoryManager::Instance().Initialize(GhostConfig()));
+}
+
+// Protecting thrashing pages turns a 100% miss loop into partial hits
+TEST(RefaultProtectionReducesFaults) {
+    const size_t num_pages = 6;
+    uint64_t faults[2] = {0, 0};
+
+    for (int protect = 0; protect < 2; protect++) {
+        GhostConfig config;
+        config.max_memory_pages = 4;
+        config.enable_refault_protection = (protect == 1);
+        ASSERT_TRUE(GhostMemoryManager::Instance().Initialize(config));
+
+        char* data = static_cast<char*>(GhostMemoryManager::Instance().AllocateGhost(num_pages * PAGE_SIZE));
+        ASSERT_NOT_NULL(data);
+        CyclePages(data, num_pages, 1);
+
+        GhostStats before = GhostMemoryManager::Instance().GetStats();
+        CyclePages(data, num_pages, 20);
+        GhostStats after = GhostMemoryManager::Instance().GetStats();
+        faults[protect] = after.page_faults - before.page_faults;
+
+        if (protect == 1) {
+            ASSERT_TRUE(after.protected_promotions > before.protected_promotions);
+            ASSERT_TRUE(after.protected_pages <= 2u);  // 50% of the budget
+        }
+
+        // Data survives promotion, demotion and eviction
+        for (size_t p = 0; p < num_pages; p++) {
+            ASSERT_EQ(data[p * PAGE_SIZE], static_cast<char>(21));
+        }
+
+        GhostMemoryManager::Instance().DeallocateGhost(data, num_pages * PAGE_SIZE);
+    }
+
+    std::cout << "Faults over 20 loops of 6 pages (budget 4): LRU=" << faults[0]
+              << ", protected=" << faults[1] << "\n";
+    ASSERT_TRUE(faults[1] < faults[0]);
+
+    ASSERT_TRUE(GhostMemoryManager::Instance().Initialize(GhostConfig()));
+    ASSERT_EQ(GhostMemoryManager::Instance().GetStats().protected_pages, 0u);
+}
@@ -0,0 +1,182 @@
+#include "test_framework.h"
+#include "ghostmem/GhostMemoryManager.h"
+#include "ghostmem/GhostStatsBlock.h"
+#include "ghostmem/GhostSharedMemory.h"
+#include <memory>
+#include <string>
+
+#ifndef _WIN32
+#include <unistd.h>
+#else
+#include <windows.h>
+#endif
+
+static std::string StatsSegmentName() {
+#ifdef _WIN32
+    unsigned long pid = GetCurrentProcessId();
+#else
+    unsigned long pid = static_cast<unsigned long>(getpid());
+#endif
+    return "ghostmem-test-stats-" + std::to_string(pid);
+}
+
+// Latencies land in log2 buckets and percentiles report bucket bounds
+TEST(LatencyHistogramBuckets) {
+    ASSERT_EQ(GhostLatencyHistogram::BucketOf(0), 0u);
+    ASSERT_EQ(GhostLatencyHistogram::BucketOf(1), 0u);
+    ASSERT_EQ(GhostLatencyHistogram::BucketOf(2), 1u);
+    ASSERT_EQ(GhostLatencyHistogram::BucketOf(1023), 9u);
+    ASSERT_EQ(GhostLatencyHistogram::BucketOf(1024), 10u);
+    ASSERT_EQ(GhostLatencyHistogram::BucketOf(~0ULL), GhostLatencyHistogram::kBuckets - 1);
+
+    std::unique_ptr<GhostStatsBlock> block(new GhostStatsBlock);
+    block->Reset();
+    ASSERT_TRUE(block->IsValid());
+    ASSERT_EQ(block->fault_latency.Percentile(0.5), 0u);
+
+    // 90 fast samples (~1us) and 10 slow ones (~1ms)
+    for (int i = 0; i < 90; i++) {
+        block->fault_latency.Record(1000);
+    }
+    for (int i = 0; i < 10; i++) {
+        block->fault_latency.Record(1000000);
+    }
+    ASSERT_EQ(block->fault_latency.Count(), 100u);
+    ASSERT_EQ(block->fault_latency.Percentile(0.5), 1024u);
+    ASSERT_EQ(block->fault_latency.Percentile(0.9), 1024u);
+    ASSERT_EQ(block->fault_latency.Percentile(0.99), 1048576u);
+}
+
+// The manager publishes counters and latencies without taking its mutex on read
+TEST(StatsBlockTracksManager) {
+    GhostConfig config;
+    config.max_memory_pages = 4;
+    ASSERT_TRUE(GhostMemoryManager::Instance().Initialize(config));
+
+    const GhostStatsBlock& block = GhostMemoryManager::Instance().GetStatsBlock();
+    uint64_t faults_before = block.page_faults.load();
+    uint64_t fault_samples_before = block.fault_latency.Count();
+    uint64_t restore_samples_before = block.restore_latency.Count();
+
+    const size_t num_pages = 10;
+    char* data = static_cast<char*>(GhostMemoryManager::Instance().AllocateGhost(num_pages * PAGE_SIZE));
+    ASSERT_NOT_NULL(data);
+    for (int round = 0; round < 2; round++) {
+        for (size_t p = 0; p < num_pages; p++) {
+            volatile char* byte = data + p * PAGE_SIZE;
+            *byte = static_cast<char>(*byte + 1);
+        }
+    }
+
+    GhostStats stats = GhostMemoryManager::Instance().GetStats();
+    ASSERT_EQ(block.page_faults.load(), stats.page_faults);
+    ASSERT_EQ(block.refaults.load(), stats.refaults);
+    ASSERT_EQ(block.evictions.load(), stats.evictions);
+    ASSERT_EQ(block.resident_pages.load(), stats.resident_pages);
+    ASSERT_EQ(block.compressed_bytes.load(), stats.compressed_bytes);
+    ASSERT_EQ(block.fault_latency.Count() - fault_samples_before, stats.page_faults - faults_before);
+    ASSERT_TRUE(block.restore_latency.Count() - restore_samples_before >= num_pages);
+    ASSERT_TRUE(block.freeze_latency.Count() > 0);
+
+    GhostMemoryManager::Instance().DeallocateGhost(data, num_pages * PAGE_SIZE);
+    ASSERT_TRUE(GhostMemoryManager::Instance().Initialize(GhostConfig()));
+}
+
+// The running compressed byte count matches a full walk of the stores
+TEST(StatsCompressedBytesConsistent) {
+    GhostConfig config;
+    config.max_memory_pages = 4;
+    config.enable_delta_compression = true;
+    ASSERT_TRUE(GhostMemoryManager::Instance().Initialize(config));
+
+    const size_t num_pages = 12;
+    char* data = static_cast<char*>(GhostMemoryManager::Instance().AllocateGhost(num_pages * PAGE_SIZE, 909));
+    ASSERT_NOT_NULL(data);
+    for (int round = 0; round < 3; round++) {
+        for (size_t p = 0; p < num_pages; p++) {
+            volatile char* byte = data + p * PAGE_SIZE + round * 64;
+            *byte = static_cast<char>(*byte + 1);
+        }
+    }
+
+    size_t walked = 0;
+    for (const auto& entry : GhostMemoryManager::Instance().GetTagStats()) {
+        walked += entry.second.compressed_bytes;
+    }
+    ASSERT_EQ(GhostMemoryManager::Instance().GetStats().compressed_bytes, walked);
+
+    GhostMemoryManager::Instance().DeallocateGhost(data, num_pages * PAGE_SIZE);
+    ASSERT_TRUE(GhostMemoryManager::Instance().Initialize(GhostConfig()));
+}
+
+// Frozen pages found by a full walk of the stores
+static size_t WalkedFrozenPages() {
+    size_t walked = 0;
+    for (const auto& entry : GhostMemoryManager::Instance().GetTagStats()) {
+        walked += entry.second.frozen_pages;
+    }
+    return walked;
+}
+
+// Disk records outlive a restore; pages read back are resident, not frozen
+TEST(StatsFrozenPagesWithDiskBacking) {
+    GhostConfig config;
+    config.max_memory_pages = 4;
+    config.use_disk_backing = true;
+    config.disk_file_path = "test_stats_frozen.swap";
+    GhostTestAllocation run(config, 12);
+
+    const GhostStatsBlock& block = GhostMemoryManager::Instance().GetStatsBlock();
+    for (int round = 0; round < 3; round++) {
+        for (size_t p = 0; p < run.num_pages; p++) {
+            volatile char* byte = run.data + p * PAGE_SIZE;
+            *byte = static_cast<char>(*byte + 1);
+        }
+    }
+
+    GhostStats stats = GhostMemoryManager::Instance().GetStats();
+    ASSERT_EQ(stats.frozen_pages, WalkedFrozenPages());
+    ASSERT_EQ(block.frozen_pages.load(), stats.frozen_pages);
+
+    run.Free();
+    stats = GhostMemoryManager::Instance().GetStats();
+    ASSERT_EQ(stats.frozen_pages, WalkedFrozenPages());
+    ASSERT_EQ(block.frozen_pages.load(), stats.frozen_pages);
+}
+
+// Another process (here: a read-only mapping) sees the published block
+TEST(StatsBlockInSharedMemory) {
+    std::string name = StatsSegmentName();
+
+    uint64_t faults_private = GhostMemoryManager::Instance().GetStatsBlock().page_faults.load();
+
+    GhostConfig config;
+    config.max_memory_pages = 4;
+    config.stats_shm_name = name;
+    ASSERT_TRUE(GhostMemoryManager::Instance().Initialize(config));
+
+    GhostSharedMemory observer;
+    ASSERT_TRUE(observer.Open(name, sizeof(GhostStatsBlock), false, true));
+    const GhostStatsBlock& shared = *static_cast<const GhostStatsBlock*>(observer.Data());
+    ASSERT_TRUE(shared.IsValid());
+    ASSERT_EQ(shared.page_faults.load(), faults_private);  // Carried over
+    ASSERT_EQ(shared.page_size.load(), static_cast<uint64_t>(PAGE_SIZE));
+
+    const size_t num_pages = 6;
+    char* data = static_cast<char*>(GhostMemoryManager::Instance().AllocateGhost(num_pages * PAGE_SIZE));
+    ASSERT_NOT_NULL(data);
+    for (size_t p = 0; p < num_pages; p++) {
+        data[p * PAGE_SIZE] = 1;
+    }
+    ASSERT_EQ(shared.page_faults.load(), faults_private + num_pages);
+    ASSERT_EQ(shared.resident_pages.load(), 4u);
+
+    GhostMemoryManager::Instance().DeallocateGhost(data, num_pages * PAGE_SIZE);
+
+    // Dropping the name moves the statistics back into the process
+    ASSERT_TRUE(GhostMemoryManager::Instance().Initialize(GhostConfig()));
+    ASSERT_EQ(GhostMemoryManager::Instance().GetStatsBlock().page_faults.load(), faults_private + num_pages);
+
+    GhostSharedMemory reopened;
+    ASSERT_TRUE(!reopened.Open(name, sizeof(GhostStatsBlock), false, true));
+}
@@ -0,0 +1,109 @@
+#include "test_framework.h"
+#include "ghostmem/GhostMemoryManager.h"
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+static uint64_t ValueAt(size_t index) {
+    return index * 2654435761u + 17;
+}
+
+static void FillValues(uint64_t* values, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        values[i] = ValueAt(i);
+    }
+}
+
+// A scan over cold pages decodes them without faulting or evicting the hot set
+static void RunScan(bool disk, bool delta, const char* path) {
+    GhostConfig config;
+    config.max_memory_pages = 8;
+    config.use_disk_backing = disk;
+    config.disk_file_path = path;
+    config.enable_delta_compression = delta;
+    const size_t num_pages = 64;
+    const size_t count = num_pages * PAGE_SIZE / sizeof(uint64_t);
+    GhostTestAllocation run(config, num_pages);
+    uint64_t* values = reinterpret_cast<uint64_t*>(run.data);
+    FillValues(values, count);
+    if (delta) {
+        // Freeze some pages a second time as deltas
+        for (size_t p = 0; p < num_pages; p += 4) {
+            values[p * PAGE_SIZE / sizeof(uint64_t) + 3] = ValueAt(p * PAGE_SIZE / sizeof(uint64_t) + 3);
+        }
+    }
+
+    // The last pages touched are hot and must stay resident
+    volatile uint64_t* hot = values + (count - 1);
+    (void)*hot;
+
+    GhostStats before = GhostMemoryManager::Instance().GetStats();
+    uint64_t sum = 0;
+    uint64_t expected = 0;
+    size_t chunks = 0;
+    const size_t skip = 5;  // Start unaligned
+    for (const GhostReadRange::Chunk& chunk : GhostReadRange(values + skip, (count - skip) * sizeof(uint64_t))) {
+        const uint64_t* v = reinterpret_cast<const uint64_t*>(chunk.data);
+        for (size_t i = 0; i < chunk.size / sizeof(uint64_t); i++) {
+            sum += v[i];
+        }
+        chunks++;
+    }
+    for (size_t i = skip; i < count; i++) {
+        expected += ValueAt(i);
+    }
+    GhostStats after = GhostMemoryManager::Instance().GetStats();
+
+    ASSERT_EQ(sum, expected);
+    ASSERT_EQ(chunks, num_pages);
+    ASSERT_EQ(after.page_faults, before.page_faults);
+    ASSERT_EQ(after.evictions, before.evictions);
+    ASSERT_EQ(after.resident_pages, before.resident_pages);
+    ASSERT_TRUE(after.streamed_pages - before.streamed_pages >= num_pages - 8);
+
+    // Reading the hot page afterwards does not fault
+    ASSERT_EQ(*hot, ValueAt(count - 1));
+    ASSERT_EQ(GhostMemoryManager::Instance().GetStats().page_faults, after.page_faults);
+}
+
+TEST(StreamReadInMemory) {
+    RunScan(false, false, "");
+}
+
+TEST(StreamReadDeltaPages) {
+    RunScan(false, true, "");
+}
+
+TEST(StreamReadDisk) {
+    RunScan(true, true, "test_stream_read.swap");
+}
+
+// GhostRead sees pending GhostWrite patches, untouched pages read as zero
+TEST(StreamReadPatchesAndFreshPages) {
+    GhostConfig config;
+    config.max_memory_pages = 2;
+    ASSERT_TRUE(GhostMemoryManager::Instance().Initialize(config));
+
+    const size_t num_pages = 8;
+    char* data = static_cast<char*>(GhostMemoryManager::Instance().AllocateGhost(num_pages * PAGE_SIZE));
+    ASSERT_NOT_NULL(data);
+    memset(data, 'x', 4 * PAGE_SIZE);
+    ASSERT_TRUE(GhostWrite(data + 10, "patched", 7));
+
+    GhostStats before = GhostMemoryManager::Instance().GetStats();
+    char buffer[32];
+    ASSERT_TRUE(GhostRead(data + 8, buffer, 12));
+    ASSERT_TRUE(memcmp(buffer, "xxpatchedxxx", 12) == 0);
+    ASSERT_TRUE(GhostRead(data + 6 * PAGE_SIZE - 4, buffer, 8));  // Spans two untouched pages
+    for (size_t i = 0; i < 8; i++) {
+        ASSERT_EQ(buffer[i], 0);
+    }
+    ASSERT_TRUE(!GhostRead(data + num_pages * PAGE_SIZE - 4, buffer, 8));
+    ASSERT_EQ(GhostMemoryManager::Instance().GetStats().page_faults, before.page_faults);
+
+    // The log is still applied by the next real thaw
+    ASSERT_TRUE(memcmp(data + 8, "xxpatchedxxx", 12) == 0);
+
+    GhostMemoryManager::Instance().DeallocateGhost(data, num_pages * PAGE_SIZE);
+    ASSERT_TRUE(GhostMemoryManager::Instance().Initialize(GhostConfig()));
+}
@@ -0,0 +1,157 @@
+#include "test_framework.h"
+#include "ghostmem/GhostMemoryManager.h"
+#include "ghostmem/GhostAllocator.h"
+#include <cstring>
+#include <list>
+#include <vector>
+
+static void TouchPages(char* data, size_t num_pages) {
+    for (size_t p = 0; p < num_pages; p++) {
+        volatile char* byte = data + p * PAGE_SIZE;
+        *byte = static_cast<char>(*byte + 1);
+    }
+}
+
+// Counters and current figures are split by allocation tag
+TEST(TagStatsArePerTag) {
+    GhostConfig config;
+    config.max_memory_pages = 4;
+    ASSERT_TRUE(GhostMemoryManager::Instance().Initialize(config));
+
+    const size_t num_pages = 6;
+    char* first = static_cast<char*>(GhostMemoryManager::Instance().AllocateGhost(num_pages * PAGE_SIZE, 101));
+    char* second = static_cast<char*>(GhostMemoryManager::Instance().AllocateGhost(num_pages * PAGE_SIZE, 102));
+    ASSERT_NOT_NULL(first);
+    ASSERT_NOT_NULL(second);
+
+    for (size_t p = 0; p < num_pages; p++) {
+        memset(first + p * PAGE_SIZE, 'A', PAGE_SIZE);  // Compresses very well
+    }
+    TouchPages(second, num_pages);
+
+    GhostTagStats a = GhostMemoryManager::Instance().GetTagStats(101);
+    GhostTagStats b = GhostMemoryManager::Instance().GetTagStats(102);
+
+    ASSERT_EQ(a.page_faults, num_pages);
+    ASSERT_EQ(b.page_faults, num_pages);
+    ASSERT_EQ(a.resident_pages + a.frozen_pages, num_pages);
+    ASSERT_EQ(b.resident_pages + b.frozen_pages, num_pages);
+    ASSERT_EQ(a.resident_pages, 0u);  // Pushed out by the second tag
+    ASSERT_EQ(a.evictions, num_pages);
+    ASSERT_TRUE(a.compression_ratio > 10.0);
+
+    // Faults on the first tag are charged to it only
+    TouchPages(first, 2);
+    GhostTagStats a2 = GhostMemoryManager::Instance().GetTagStats(101);
+    ASSERT_EQ(a2.refaults - a.refaults, 2u);
+    ASSERT_EQ(GhostMemoryManager::Instance().GetTagStats(102).refaults, b.refaults);
+
+    std::map<GhostTag, GhostTagStats> all = GhostMemoryManager::Instance().GetTagStats();
+    ASSERT_TRUE(all.count(101) == 1 && all.count(102) == 1);
+
+    GhostMemoryManager::Instance().DeallocateGhost(first, num_pages * PAGE_SIZE);
+    GhostMemoryManager::Instance().DeallocateGhost(second, num_pages * PAGE_SIZE);
+    ASSERT_TRUE(GhostMemoryManager::Instance().Initialize(GhostConfig()));
+}
+
+// A quota keeps a scanning tag from evicting another tag's hot set
+TEST(TagQuotaProtectsOtherTags) {
+    GhostConfig config;
+    config.max_memory_pages = 8;
+    ASSERT_TRUE(GhostMemoryManager::Instance().Initialize(config));
+    GhostMemoryManager::Instance().SetTagQuota(202, 3);
+
+    const size_t hot_pages = 4;
+    const size_t scan_pages = 32;
+    char* hot = static_cast<char*>(GhostMemoryManager::Instance().AllocateGhost(hot_pages * PAGE_SIZE, 201));
+    char* scan = static_cast<char*>(GhostMemoryManager::Instance().AllocateGhost(scan_pages * PAGE_SIZE, 202));
+    ASSERT_NOT_NULL(hot);
+    ASSERT_NOT_NULL(scan);
+
+    TouchPages(hot, hot_pages);
+    GhostTagStats hot_before = GhostMemoryManager::Instance().GetTagStats(201);
+
+    for (int round = 0; round < 3; round++) {
+        TouchPages(scan, scan_pages);
+        TouchPages(hot, hot_pages);
+    }
+
+    GhostTagStats hot_after = GhostMemoryManager::Instance().GetTagStats(201);
+    GhostTagStats scan_stats = GhostMemoryManager::Instance().GetTagStats(202);
+    ASSERT_EQ(hot_after.page_faults, hot_before.page_faults);
+    ASSERT_EQ(hot_after.resident_pages, hot_pages);
+    ASSERT_TRUE(scan_stats.resident_pages <= 3u);
+    ASSERT_EQ(scan_stats.quota_pages, 3u);
+    ASSERT_EQ(scan[0], static_cast<char>(3));
+
+    GhostMemoryManager::Instance().SetTagQuota(202, 0);
+    GhostMemoryManager::Instance().DeallocateGhost(hot, hot_pages * PAGE_SIZE);
+    GhostMemoryManager::Instance().DeallocateGhost(scan, scan_pages * PAGE_SIZE);
+    ASSERT_TRUE(GhostMemoryManager::Instance().Initialize(GhostConfig()));
+}
+
+// The quota follows pages as they are freed, and a lowered quota applies
+// on the tag's next fault
+TEST(TagQuotaTracksResidentPages) {
+    const GhostTag kTag = 204;
+    GhostConfig config;
+    config.max_memory_pages = 16;
+    ASSERT_TRUE(GhostMemoryManager::Instance().Initialize(config));
+    GhostMemoryManager::Instance().SetTagQuota(kTag, 3);
+
+    const size_t num_pages = 3;
+    char* first = static_cast<char*>(GhostMemoryManager::Instance().AllocateGhost(num_pages * PAGE_SIZE, kTag));
+    ASSERT_NOT_NULL(first);
+    TouchPages(first, num_pages);
+    GhostMemoryManager::Instance().DeallocateGhost(first, num_pages * PAGE_SIZE);
+
+    // Freed pages no longer count against the quota
+    char* second = static_cast<char*>(GhostMemoryManager::Instance().AllocateGhost(num_pages * PAGE_SIZE, kTag));
+    ASSERT_NOT_NULL(second);
+    uint64_t evictions_before = GhostMemoryManager::Instance().GetTagStats(kTag).evictions;
+    TouchPages(second, num_pages);
+    ASSERT_EQ(GhostMemoryManager::Instance().GetTagStats(kTag).evictions, evictions_before);
+    ASSERT_EQ(GhostMemoryManager::Instance().GetTagStats(kTag).resident_pages, num_pages);
+
+    char* third = static_cast<char*>(GhostMemoryManager::Instance().AllocateGhost(PAGE_SIZE, kTag));
+    ASSERT_NOT_NULL(third);
+    GhostMemoryManager::Instance().SetTagQuota(kTag, 1);
+    TouchPages(third, 1);
+    ASSERT_EQ(GhostMemoryManager::Instance().GetTagStats(kTag).resident_pages, 1u);
+
+    GhostMemoryManager::Instance().SetTagQuota(kTag, 0);
+    GhostMemoryManager::Instance().DeallocateGhost(second, num_pages * PAGE_SIZE);
+    GhostMemoryManager::Instance().DeallocateGhost(third, PAGE_SIZE);
+    ASSERT_TRUE(GhostMemoryManager::Instance().Initialize(GhostConfig()));
+}
+
+// Containers using the tagged allocator charge their pages to the tag
+TEST(TaggedAllocatorWithContainers) {
+    const GhostTag kTag = 303;
+    {
+        std::vector<int, TaggedGhostAllocator<int, kTag>> vec;
+        for (int i = 0; i < 5000; i++) {
+            vec.push_back(i);
+        }
+
+        // Node-based containers rebind the allocator to their node type
+        std::list<int, TaggedGhostAllocator<int, kTag>> lst;
+        for (int i = 0; i < 10; i++) {
+            lst.push_back(i);
+        }
+
+        for (int i = 0; i < 5000; i++) {
+            ASSERT_EQ(vec[i], i);
+        }
+        ASSERT_EQ(lst.size(), 10u);
+
+        GhostTagStats stats = GhostMemoryManager::Instance().GetTagStats(kTag);
+        ASSERT_TRUE(stats.page_faults > 0);
+        ASSERT_TRUE(stats.resident_pages + stats.frozen_pages > 0);
+    }
+
+    // Untagged allocations are not charged to the tag
+    GhostTagStats before = GhostMemoryManager::Instance().GetTagStats(kTag);
+    std::vector<int, GhostAllocator<int>> untagged(2000, 1);
+    ASSERT_EQ(GhostMemoryManager::Instance().GetTagStats(kTag).page_faults, before.page_faults);
+}
@@ -6,6 +6,7 @@
 #include <atomic>
 #include <random>
 #include <mutex>
+#include <cstdint>
 
 // Test concurrent allocations from multiple threads
 TEST(ConcurrentAllocations) {
@@ -314,3 +315,51 @@ TEST(ConcurrentRandomDataManipulation) {
     ASSERT_EQ(verification_success.load(), NUM_THREADS);
     ASSERT_EQ(verification_failures.load(), 0);
 }
+
+// Pages rewritten while other threads evict them must keep every store
+TEST(ConcurrentWritesDuringEviction) {
+    GhostConfig config;
+    config.max_memory_pages = 4;
+    ASSERT_TRUE(GhostMemoryManager::Instance().Initialize(config));
+
+    const int NUM_THREADS = 4;
+    const size_t NUM_PAGES = 6;
+    const int ROUNDS = 300;
+    const size_t WORDS = PAGE_SIZE / sizeof(uint64_t);
+    std::atomic<int> corrupted_pages(0);
+    std::vector<std::thread> threads;
+
+    for (int t = 0; t < NUM_THREADS; t++) {
+        threads.emplace_back([&, t]() {
+            uint64_t* data = static_cast<uint64_t*>(
+                GhostMemoryManager::Instance().AllocateGhost(NUM_PAGES * PAGE_SIZE));
+            if (data == nullptr) {
+                corrupted_pages++;
+                return;
+            }
+            for (int round = 0; round < ROUNDS; round++) {
+                for (size_t p = 0; p < NUM_PAGES; p++) {
+                    volatile uint64_t* page = data + p * WORDS;
+                    uint64_t value = ((uint64_t)t << 48) | ((uint64_t)round << 16) | p;
+                    for (size_t i = 0; i < WORDS; i++) {
+                        page[i] = value + i;
+                    }
+                    for (size_t i = 0; i < WORDS; i++) {
+                        if (page[i] != value + i) {
+                            corrupted_pages++;
+                            break;
+                        }
+                    }
+                }
+            }
+            GhostMemoryManager::Instance().DeallocateGhost(data, NUM_PAGES * PAGE_SIZE);
+        });
+    }
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    ASSERT_TRUE(GhostMemoryManager::Instance().Initialize(GhostConfig()));
+    ASSERT_EQ(corrupted_pages.load(), 0);
+}
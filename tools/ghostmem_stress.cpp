@@ -0,0 +1,665 @@
+/**
+ * @file ghostmem_stress.cpp
+ * @brief Soak and stress harness for sustained concurrent pressure
+ *
+ * Runs many threads that allocate, free, read and rewrite ghost memory
+ * while the live working set is a fixed multiple of the resident budget.
+ * Every page carries a pattern derived from its allocation, page index and
+ * write version, so any lost or stale page is detected on the next read.
+ *
+ * Each report interval prints throughput, operation and fault latency,
+ * resident/frozen pages, compressed and swap bytes, process RSS and the
+ * manager's metadata entry count. The run fails (exit code 1) on:
+ *   - data corruption or failed allocations
+ *   - throughput in the last third of the run dropping below the first
+ *     third by more than --max-throughput-drop
+ *   - operation p99 latency growing by more than --max-latency-growth
+ *   - RSS growing by more than --max-rss-growth-mb after warm-up
+ *   - swap file exceeding --max-swap-mb (disk mode)
+ *   - pages, compressed bytes or metadata left over after everything
+ *     has been freed (leaks)
+ *
+ * Usage: ghostmem_stress [options]   (see --help)
+ */
+
+#include "ghostmem/GhostMemoryManager.h"
+#include "ghostmem/GhostStatsBlock.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef _WIN32
+#include <psapi.h>      // GetProcessMemoryInfo (windows.h comes with GhostMemoryManager.h)
+#else
+#include <unistd.h>     // sysconf
+#endif
+
+namespace {
+
+struct Options {
+    unsigned threads = 4;
+    double duration_s = 60.0;
+    double report_s = 10.0;
+    size_t budget_pages = 256;
+    double oversubscription = 4.0;
+    size_t max_alloc_pages = 16;
+    std::string disk_path;
+    GhostFreezeBackend freeze_backend = GhostFreezeBackend::Compress;
+    std::string csv_path;
+    std::string stats_shm_name;
+    double max_throughput_drop = 0.5;
+    double max_latency_growth = 4.0;
+    double max_rss_growth_mb = 64.0;
+    double max_swap_mb = 0.0;
+    uint64_t seed = 1;
+};
+
+struct Object {
+    char* data = nullptr;
+    size_t pages = 0;
+    uint64_t id = 0;
+    std::vector<uint32_t> versions;
+};
+
+// One row of the report, also used for the drift checks at the end
+struct Interval {
+    double elapsed_s = 0.0;
+    double ops_per_s = 0.0;
+    uint64_t op_p50_ns = 0;
+    uint64_t op_p99_ns = 0;
+    double faults_per_s = 0.0;
+    double refaults_per_s = 0.0;
+    uint64_t fault_p99_ns = 0;
+    GhostStats stats;
+    uint64_t rss_bytes = 0;
+    uint64_t live_pages = 0;
+};
+
+struct BucketSnapshot {
+    uint64_t counts[GhostLatencyHistogram::kBuckets] = {};
+};
+
+volatile std::sig_atomic_t g_interrupted = 0;
+std::atomic<bool> g_stop{false};
+std::atomic<uint64_t> g_next_object_id{1};
+std::atomic<uint64_t> g_ops{0};
+std::atomic<uint64_t> g_live_pages{0};
+std::atomic<uint64_t> g_corruptions{0};
+std::atomic<uint64_t> g_allocation_failures{0};
+GhostLatencyHistogram g_op_latency;  // Static storage: zero-initialized
+
+void OnInterrupt(int) {
+    g_interrupted = 1;
+}
+
+uint64_t NowNs() {
+    return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+uint64_t Mix(uint64_t value) {
+    // splitmix64 finalizer
+    value += 0x9E3779B97F4A7C15ULL;
+    value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    value = (value ^ (value >> 27)) * 0x94D049BB133111EBULL;
+    return value ^ (value >> 31);
+}
+
+// Word i of a page. Objects rotate between highly compressible,
+// incompressible and half-empty content to exercise every store path.
+uint64_t PatternWord(uint64_t id, size_t page, uint32_t version, size_t i) {
+    uint64_t key = (id << 24) ^ ((uint64_t)page << 8) ^ version;
+    switch (id % 3) {
+    case 0:
+        return key ^ (i & 7);
+    case 1:
+        return Mix(key * 1024 + i);
+    default:
+        return (i < PAGE_SIZE / 16) ? Mix(key * 1024 + i) : 0;
+    }
+}
+
+void FillPage(const Object& object, size_t page) {
+    uint64_t* words = reinterpret_cast<uint64_t*>(object.data + page * PAGE_SIZE);
+    for (size_t i = 0; i < PAGE_SIZE / sizeof(uint64_t); i++) {
+        words[i] = PatternWord(object.id, page, object.versions[page], i);
+    }
+}
+
+bool VerifyPage(const Object& object, size_t page) {
+    const volatile uint64_t* words =
+        reinterpret_cast<const volatile uint64_t*>(object.data + page * PAGE_SIZE);
+    for (size_t i = 0; i < PAGE_SIZE / sizeof(uint64_t); i++) {
+        uint64_t expected = PatternWord(object.id, page, object.versions[page], i);
+        uint64_t actual = words[i];
+        if (actual != expected) {
+            if (g_corruptions.fetch_add(1) < 10) {
+                fprintf(stderr, "CORRUPTION: object %llu page %zu (version %u) word %zu at %p: "
+                                "expected %016llx, found %016llx\n",
+                        (unsigned long long)object.id, page, object.versions[page], i,
+                        (const void*)(words + i),
+                        (unsigned long long)expected, (unsigned long long)actual);
+            }
+            return false;
+        }
+    }
+    return true;
+}
+
+void FreeObject(Object& object) {
+    for (size_t p = 0; p < object.pages; p++) {
+        VerifyPage(object, p);
+    }
+    GhostMemoryManager::Instance().DeallocateGhost(object.data, object.pages * PAGE_SIZE);
+    g_live_pages.fetch_sub(object.pages);
+    object.data = nullptr;
+}
+
+void Worker(const Options& options, unsigned index, size_t target_pages) {
+    std::mt19937_64 rng(options.seed * 7919 + index);
+    std::vector<Object> objects;
+    size_t live_pages = 0;
+
+    while (!g_stop.load(std::memory_order_relaxed)) {
+        unsigned roll = (unsigned)(rng() % 100);
+        uint64_t start = NowNs();
+
+        if (objects.empty() || (live_pages < target_pages && roll < 40)) {
+            Object object;
+            object.pages = 1 + (size_t)(rng() % options.max_alloc_pages);
+            object.id = g_next_object_id.fetch_add(1);
+            object.versions.assign(object.pages, 0);
+            object.data = static_cast<char*>(
+                GhostMemoryManager::Instance().AllocateGhost(object.pages * PAGE_SIZE));
+            if (object.data == nullptr) {
+                g_allocation_failures.fetch_add(1);
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+                continue;
+            }
+            for (size_t p = 0; p < object.pages; p++) {
+                FillPage(object, p);
+            }
+            live_pages += object.pages;
+            g_live_pages.fetch_add(object.pages);
+            objects.push_back(std::move(object));
+        } else if (roll < 10 || live_pages > target_pages + options.max_alloc_pages) {
+            size_t victim = (size_t)(rng() % objects.size());
+            live_pages -= objects[victim].pages;
+            FreeObject(objects[victim]);
+            objects[victim] = std::move(objects.back());
+            objects.pop_back();
+        } else if (roll < 60) {
+            const Object& object = objects[rng() % objects.size()];
+            VerifyPage(object, (size_t)(rng() % object.pages));
+        } else {
+            Object& object = objects[rng() % objects.size()];
+            size_t page = (size_t)(rng() % object.pages);
+            object.versions[page]++;
+            FillPage(object, page);
+        }
+
+        g_op_latency.Record(NowNs() - start);
+        g_ops.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // Verify and release everything so the leak check sees an empty manager
+    for (Object& object : objects) {
+        FreeObject(object);
+    }
+}
+
+BucketSnapshot Snap(const GhostLatencyHistogram& histogram) {
+    BucketSnapshot snap;
+    for (size_t i = 0; i < GhostLatencyHistogram::kBuckets; i++) {
+        snap.counts[i] = histogram.buckets[i].load(std::memory_order_relaxed);
+    }
+    return snap;
+}
+
+// Percentile of the samples recorded between two snapshots
+uint64_t IntervalPercentile(const BucketSnapshot& before, const BucketSnapshot& after, double quantile) {
+    uint64_t total = 0;
+    for (size_t i = 0; i < GhostLatencyHistogram::kBuckets; i++) {
+        total += after.counts[i] - before.counts[i];
+    }
+    if (total == 0) {
+        return 0;
+    }
+    uint64_t rank = (uint64_t)(quantile * (double)total);
+    uint64_t seen = 0;
+    for (size_t i = 0; i < GhostLatencyHistogram::kBuckets; i++) {
+        seen += after.counts[i] - before.counts[i];
+        if (seen > rank) {
+            return GhostLatencyHistogram::BucketUpperBound(i);
+        }
+    }
+    return GhostLatencyHistogram::BucketUpperBound(GhostLatencyHistogram::kBuckets - 1);
+}
+
+uint64_t ResidentSetBytes() {
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS counters;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+        return counters.WorkingSetSize;
+    }
+    return 0;
+#elif defined(__linux__)
+    FILE* file = fopen("/proc/self/statm", "r");
+    if (file == nullptr) {
+        return 0;
+    }
+    unsigned long long size = 0;
+    unsigned long long resident = 0;
+    int fields = fscanf(file, "%llu %llu", &size, &resident);
+    fclose(file);
+    return (fields == 2) ? resident * (uint64_t)sysconf(_SC_PAGESIZE) : 0;
+#else
+    return 0;  // Not measured; the RSS check is skipped
+#endif
+}
+
+double Median(std::vector<double> values) {
+    if (values.empty()) {
+        return 0.0;
+    }
+    std::sort(values.begin(), values.end());
+    return values[values.size() / 2];
+}
+
+double MiB(uint64_t bytes) {
+    return bytes / (double)(1ULL << 20);
+}
+
+// Accepts plain seconds or a unit suffix: 90, 90s, 15m, 6h
+bool ParseDuration(const char* text, double& seconds) {
+    char* end = nullptr;
+    double value = strtod(text, &end);
+    if (end == text || value < 0) {
+        return false;
+    }
+    if (*end == '\0' || strcmp(end, "s") == 0) {
+        seconds = value;
+    } else if (strcmp(end, "m") == 0) {
+        seconds = value * 60;
+    } else if (strcmp(end, "h") == 0) {
+        seconds = value * 3600;
+    } else if (strcmp(end, "ms") == 0) {
+        seconds = value / 1000;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+void PrintUsage() {
+    printf("Usage: ghostmem_stress [options]\n\n");
+    printf("Sustained concurrent allocate/free/read/write load against GhostMem.\n");
+    printf("  --threads N                Worker threads (default 4)\n");
+    printf("  --duration T               Run time: 90, 90s, 15m, 6h (default 60s)\n");
+    printf("  --report T                 Report interval (default 10s); the first is warm-up\n");
+    printf("  --budget-pages N           Resident page budget (default 256)\n");
+    printf("  --oversubscription R       Live working set / budget (default 4.0)\n");
+    printf("  --max-alloc-pages N        Largest allocation in pages (default 16)\n");
+    printf("  --disk PATH                Freeze to this swap file instead of RAM (removed at exit)\n");
+    printf("  --freeze-backend B         compress (default), cold or pageout: leave frozen\n");
+    printf("                             pages to the kernel's zswap / zram / swap\n");
+    printf("  --csv PATH                 Also write every interval as a CSV row\n");
+    printf("  --stats-shm NAME           Publish statistics for ghostmem_top\n");
+    printf("  --max-throughput-drop F    Allowed throughput loss, late vs early (default 0.5)\n");
+    printf("  --max-latency-growth X     Allowed op p99 growth factor (default 4.0)\n");
+    printf("  --max-rss-growth-mb M      Allowed RSS growth after warm-up (default 64)\n");
+    printf("  --max-swap-mb M            Fail if the swap file grows beyond M (default: off)\n");
+    printf("  --seed N                   Random seed (default 1)\n");
+}
+
+bool ParseOptions(int argc, char** argv, Options& options, bool& help) {
+    for (int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+        const char* value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+        if (strcmp(arg, "-h") == 0 || strcmp(arg, "--help") == 0) {
+            help = true;
+            return true;
+        }
+        if (value == nullptr) {
+            return false;
+        }
+        i++;
+        if (strcmp(arg, "--threads") == 0) {
+            options.threads = (unsigned)atoi(value);
+        } else if (strcmp(arg, "--duration") == 0) {
+            if (!ParseDuration(value, options.duration_s)) return false;
+        } else if (strcmp(arg, "--report") == 0) {
+            if (!ParseDuration(value, options.report_s)) return false;
+        } else if (strcmp(arg, "--budget-pages") == 0) {
+            options.budget_pages = (size_t)atol(value);
+        } else if (strcmp(arg, "--oversubscription") == 0) {
+            options.oversubscription = atof(value);
+        } else if (strcmp(arg, "--max-alloc-pages") == 0) {
+            options.max_alloc_pages = (size_t)atol(value);
+        } else if (strcmp(arg, "--disk") == 0) {
+            options.disk_path = value;
+        } else if (strcmp(arg, "--freeze-backend") == 0) {
+            if (strcmp(value, "compress") == 0) {
+                options.freeze_backend = GhostFreezeBackend::Compress;
+            } else if (strcmp(value, "cold") == 0) {
+                options.freeze_backend = GhostFreezeBackend::KernelCold;
+            } else if (strcmp(value, "pageout") == 0) {
+                options.freeze_backend = GhostFreezeBackend::KernelPageout;
+            } else {
+                return false;
+            }
+        } else if (strcmp(arg, "--csv") == 0) {
+            options.csv_path = value;
+        } else if (strcmp(arg, "--stats-shm") == 0) {
+            options.stats_shm_name = value;
+        } else if (strcmp(arg, "--max-throughput-drop") == 0) {
+            options.max_throughput_drop = atof(value);
+        } else if (strcmp(arg, "--max-latency-growth") == 0) {
+            options.max_latency_growth = atof(value);
+        } else if (strcmp(arg, "--max-rss-growth-mb") == 0) {
+            options.max_rss_growth_mb = atof(value);
+        } else if (strcmp(arg, "--max-swap-mb") == 0) {
+            options.max_swap_mb = atof(value);
+        } else if (strcmp(arg, "--seed") == 0) {
+            options.seed = strtoull(value, nullptr, 10);
+        } else {
+            return false;
+        }
+    }
+    return options.threads > 0 && options.budget_pages > 0 && options.max_alloc_pages > 0 &&
+           options.oversubscription > 0 && options.duration_s > 0 && options.report_s > 0;
+}
+
+void PrintInterval(const Interval& row) {
+    printf("%7.1f %10.0f %9llu %9llu %9.0f %9.0f %9llu %6zu %7zu %9.1f %8.1f %8.1f %9zu\n",
+           row.elapsed_s, row.ops_per_s,
+           (unsigned long long)row.op_p50_ns, (unsigned long long)row.op_p99_ns,
+           row.faults_per_s, row.refaults_per_s, (unsigned long long)row.fault_p99_ns,
+           row.stats.resident_pages, row.stats.frozen_pages,
+           MiB(row.stats.compressed_bytes), MiB(row.stats.disk_bytes), MiB(row.rss_bytes),
+           row.stats.metadata_entries);
+    fflush(stdout);
+}
+
+void WriteCsvRow(FILE* csv, const Interval& row) {
+    fprintf(csv, "%.3f,%.1f,%llu,%llu,%.1f,%.1f,%llu,%zu,%zu,%zu,%zu,%llu,%zu,%llu\n",
+            row.elapsed_s, row.ops_per_s,
+            (unsigned long long)row.op_p50_ns, (unsigned long long)row.op_p99_ns,
+            row.faults_per_s, row.refaults_per_s, (unsigned long long)row.fault_p99_ns,
+            row.stats.resident_pages, row.stats.frozen_pages,
+            row.stats.compressed_bytes, row.stats.disk_bytes,
+            (unsigned long long)row.rss_bytes, row.stats.metadata_entries,
+            (unsigned long long)row.live_pages);
+    fflush(csv);
+}
+
+// Compares the first and last third of the steady-state intervals
+int CheckDrift(const Options& options, const std::vector<Interval>& rows) {
+    int failures = 0;
+    if (rows.size() < 3) {
+        printf("drift:      skipped (need at least 3 intervals after warm-up, have %zu)\n", rows.size());
+        return 0;
+    }
+
+    size_t third = rows.size() / 3;
+    std::vector<double> early_ops, late_ops, early_p99, late_p99;
+    for (size_t i = 0; i < third; i++) {
+        early_ops.push_back(rows[i].ops_per_s);
+        early_p99.push_back((double)rows[i].op_p99_ns);
+        late_ops.push_back(rows[rows.size() - 1 - i].ops_per_s);
+        late_p99.push_back((double)rows[rows.size() - 1 - i].op_p99_ns);
+    }
+
+    double early = Median(early_ops);
+    double late = Median(late_ops);
+    printf("throughput: %.0f -> %.0f ops/s", early, late);
+    if (early > 0 && late < early * (1.0 - options.max_throughput_drop)) {
+        printf("  FAIL (dropped more than %.0f%%)\n", options.max_throughput_drop * 100);
+        failures++;
+    } else {
+        printf("  ok\n");
+    }
+
+    double early_latency = Median(early_p99);
+    double late_latency = Median(late_p99);
+    printf("op p99:     %.0f -> %.0f ns", early_latency, late_latency);
+    if (early_latency > 0 && late_latency > early_latency * options.max_latency_growth) {
+        printf("  FAIL (grew more than %.1fx)\n", options.max_latency_growth);
+        failures++;
+    } else {
+        printf("  ok\n");
+    }
+
+    uint64_t rss_start = rows.front().rss_bytes;
+    uint64_t rss_end = rows.back().rss_bytes;
+    if (rss_start == 0 || rss_end == 0) {
+        printf("rss:        not available on this platform\n");
+    } else {
+        double growth = MiB(rss_end) - MiB(rss_start);
+        printf("rss:        %.1f -> %.1f MiB", MiB(rss_start), MiB(rss_end));
+        if (growth > options.max_rss_growth_mb) {
+            printf("  FAIL (grew more than %.0f MiB)\n", options.max_rss_growth_mb);
+            failures++;
+        } else {
+            printf("  ok\n");
+        }
+    }
+
+    double minutes = (rows.back().elapsed_s - rows.front().elapsed_s) / 60.0;
+    double swap_growth = MiB(rows.back().stats.disk_bytes) - MiB(rows.front().stats.disk_bytes);
+    printf("swap file:  %.1f MiB", MiB(rows.back().stats.disk_bytes));
+    if (minutes > 0 && rows.back().stats.disk_bytes > 0) {
+        printf(" (+%.1f MiB/min)", swap_growth / minutes);
+    }
+    if (options.max_swap_mb > 0 && MiB(rows.back().stats.disk_bytes) > options.max_swap_mb) {
+        printf("  FAIL (limit %.0f MiB)\n", options.max_swap_mb);
+        failures++;
+    } else {
+        printf("  ok\n");
+    }
+
+    size_t metadata_min = rows.front().stats.metadata_entries;
+    size_t metadata_max = metadata_min;
+    for (const Interval& row : rows) {
+        metadata_min = std::min(metadata_min, row.stats.metadata_entries);
+        metadata_max = std::max(metadata_max, row.stats.metadata_entries);
+    }
+    printf("metadata:   %zu .. %zu entries\n", metadata_min, metadata_max);
+    return failures;
+}
+
+// After every object is freed, the manager must be back where it started
+int CheckLeaks(const GhostStats& baseline, const GhostStats& after) {
+    int failures = 0;
+    struct Figure {
+        const char* name;
+        size_t before;
+        size_t now;
+    } figures[] = {
+        {"resident pages", baseline.resident_pages, after.resident_pages},
+        {"frozen pages", baseline.frozen_pages, after.frozen_pages},
+        {"compressed bytes", baseline.compressed_bytes, after.compressed_bytes},
+        {"metadata entries", baseline.metadata_entries, after.metadata_entries},
+    };
+    for (const Figure& figure : figures) {
+        if (figure.now != figure.before) {
+            printf("leak:       %s %zu -> %zu after freeing everything  FAIL\n",
+                   figure.name, figure.before, figure.now);
+            failures++;
+        }
+    }
+    if (failures == 0) {
+        printf("leaks:      none (all pages, compressed data and metadata released)\n");
+    }
+    return failures;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    bool help = false;
+    if (!ParseOptions(argc, argv, options, help)) {
+        PrintUsage();
+        return 2;
+    }
+    if (help) {
+        PrintUsage();
+        return 0;
+    }
+
+    GhostConfig config;
+    config.max_memory_pages = options.budget_pages;
+    config.stats_shm_name = options.stats_shm_name;
+    if (!options.disk_path.empty()) {
+        config.use_disk_backing = true;
+        config.disk_file_path = options.disk_path;
+    }
+    config.freeze_backend = options.freeze_backend;
+    if (!GhostMemoryManager::Instance().Initialize(config)) {
+        fprintf(stderr, "ghostmem_stress: failed to initialize GhostMem\n");
+        return 1;
+    }
+
+    FILE* csv = nullptr;
+    if (!options.csv_path.empty()) {
+        csv = fopen(options.csv_path.c_str(), "w");
+        if (csv == nullptr) {
+            fprintf(stderr, "ghostmem_stress: cannot write %s\n", options.csv_path.c_str());
+            return 1;
+        }
+        fprintf(csv, "elapsed_s,ops_per_s,op_p50_ns,op_p99_ns,faults_per_s,refaults_per_s,"
+                     "fault_p99_ns,resident_pages,frozen_pages,compressed_bytes,swap_bytes,"
+                     "rss_bytes,metadata_entries,live_pages\n");
+    }
+
+    std::signal(SIGINT, OnInterrupt);
+
+    size_t target_pages = (size_t)(options.budget_pages * options.oversubscription) / options.threads;
+    if (target_pages == 0) {
+        target_pages = 1;
+    }
+    printf("ghostmem_stress: %u threads, budget %zu pages, working set %.1fx (%zu pages/thread), %s, %.0fs\n",
+           options.threads, options.budget_pages, options.oversubscription, target_pages,
+           options.freeze_backend != GhostFreezeBackend::Compress ? "kernel-offload" :
+           options.disk_path.empty() ? "in-memory" : "disk-backed", options.duration_s);
+    printf("%7s %10s %9s %9s %9s %9s %9s %6s %7s %9s %8s %8s %9s\n",
+           "time_s", "ops/s", "op_p50ns", "op_p99ns", "faults/s", "refault/s", "flt_p99ns",
+           "resid", "frozen", "comp_MiB", "swap_MiB", "rss_MiB", "metadata");
+
+    GhostStats baseline = GhostMemoryManager::Instance().GetStats();
+    const GhostStatsBlock& block = GhostMemoryManager::Instance().GetStatsBlock();
+
+    std::vector<std::thread> workers;
+    for (unsigned i = 0; i < options.threads; i++) {
+        workers.emplace_back(Worker, std::cref(options), i, target_pages);
+    }
+
+    auto started = std::chrono::steady_clock::now();
+    auto previous_time = started;
+    uint64_t previous_ops = 0;
+    GhostStats previous_stats = baseline;
+    BucketSnapshot previous_op = Snap(g_op_latency);
+    BucketSnapshot previous_fault = Snap(block.fault_latency);
+    std::vector<Interval> rows;
+    int failures = 0;
+
+    auto next_report = started + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        std::chrono::duration<double>(options.report_s));
+    auto deadline = started + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        std::chrono::duration<double>(options.duration_s));
+    bool warmup = true;
+
+    while (!g_interrupted && g_corruptions.load() == 0) {
+        auto now = std::chrono::steady_clock::now();
+        if (now >= deadline) {
+            break;
+        }
+        if (now < next_report) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(
+                std::min<long long>(100, std::chrono::duration_cast<std::chrono::milliseconds>(
+                    std::min(next_report, deadline) - now).count() + 1)));
+            continue;
+        }
+
+        Interval row;
+        double seconds = std::chrono::duration<double>(now - previous_time).count();
+        uint64_t ops = g_ops.load();
+        BucketSnapshot op = Snap(g_op_latency);
+        BucketSnapshot fault = Snap(block.fault_latency);
+        row.stats = GhostMemoryManager::Instance().GetStats();
+        row.elapsed_s = std::chrono::duration<double>(now - started).count();
+        row.ops_per_s = (ops - previous_ops) / seconds;
+        row.op_p50_ns = IntervalPercentile(previous_op, op, 0.50);
+        row.op_p99_ns = IntervalPercentile(previous_op, op, 0.99);
+        row.faults_per_s = (row.stats.page_faults - previous_stats.page_faults) / seconds;
+        row.refaults_per_s = (row.stats.refaults - previous_stats.refaults) / seconds;
+        row.fault_p99_ns = IntervalPercentile(previous_fault, fault, 0.99);
+        row.rss_bytes = ResidentSetBytes();
+        row.live_pages = g_live_pages.load();
+
+        PrintInterval(row);
+        if (csv != nullptr) {
+            WriteCsvRow(csv, row);
+        }
+        if (!warmup) {
+            rows.push_back(row);
+        }
+        warmup = false;
+
+        previous_time = now;
+        previous_ops = ops;
+        previous_stats = row.stats;
+        previous_op = op;
+        previous_fault = fault;
+        next_report += std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+            std::chrono::duration<double>(options.report_s));
+    }
+
+    g_stop.store(true);
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+    if (csv != nullptr) {
+        fclose(csv);
+    }
+
+    GhostStats final_stats = GhostMemoryManager::Instance().GetStats();
+    printf("\n%llu operations, %llu faults (%llu refaults), %llu evictions\n",
+           (unsigned long long)g_ops.load(),
+           (unsigned long long)(final_stats.page_faults - baseline.page_faults),
+           (unsigned long long)(final_stats.refaults - baseline.refaults),
+           (unsigned long long)(final_stats.evictions - baseline.evictions));
+
+    if (g_corruptions.load() > 0) {
+        printf("integrity:  %llu corrupted pages  FAIL\n", (unsigned long long)g_corruptions.load());
+        failures++;
+    } else {
+        printf("integrity:  ok\n");
+    }
+    if (g_allocation_failures.load() > 0) {
+        printf("allocation: %llu failed  FAIL\n", (unsigned long long)g_allocation_failures.load());
+        failures++;
+    }
+    failures += CheckDrift(options, rows);
+    failures += CheckLeaks(baseline, final_stats);
+
+    // Closes the swap file; it only held pages of this run
+    GhostMemoryManager::Instance().Initialize(GhostConfig());
+    if (!options.disk_path.empty()) {
+        std::remove(options.disk_path.c_str());
+    }
+
+    printf("\n%s\n", failures == 0 ? "PASSED" : "FAILED");
+    return failures == 0 ? 0 : 1;
+}
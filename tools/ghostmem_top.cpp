@@ -0,0 +1,229 @@
+/**
+ * @file ghostmem_top.cpp
+ * @brief Live view of a running GhostMem process
+ *
+ * Attaches read-only to the statistics segment a process publishes when
+ * it sets GhostConfig::stats_shm_name, and shows fault, refault and
+ * eviction rates, memory figures and latency percentiles. The monitored
+ * process is never paused or locked.
+ *
+ * Usage: ghostmem_top <segment-name> [-i interval_ms] [-n iterations] [--once]
+ */
+
+#include "ghostmem/GhostSharedMemory.h"
+#include "ghostmem/GhostStatsBlock.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+
+#ifndef _WIN32
+#include <cerrno>
+#include <signal.h>     // kill
+#endif
+
+namespace {
+
+struct Snapshot {
+    uint64_t page_faults = 0;
+    uint64_t refaults = 0;
+    uint64_t evictions = 0;
+    uint64_t thrash_refaults = 0;
+    uint64_t idle_freezes = 0;
+    uint64_t compression_ns = 0;
+    std::chrono::steady_clock::time_point taken;
+};
+
+Snapshot TakeSnapshot(const GhostStatsBlock& block) {
+    Snapshot snap;
+    snap.page_faults = block.page_faults.load(std::memory_order_relaxed);
+    snap.refaults = block.refaults.load(std::memory_order_relaxed);
+    snap.evictions = block.evictions.load(std::memory_order_relaxed);
+    snap.thrash_refaults = block.thrash_refaults.load(std::memory_order_relaxed);
+    snap.idle_freezes = block.idle_freezes.load(std::memory_order_relaxed);
+    snap.compression_ns = block.compression_ns.load(std::memory_order_relaxed);
+    snap.taken = std::chrono::steady_clock::now();
+    return snap;
+}
+
+std::string FormatBytes(uint64_t bytes) {
+    char text[32];
+    if (bytes >= (1ULL << 30)) {
+        snprintf(text, sizeof(text), "%.2f GiB", bytes / (double)(1ULL << 30));
+    } else if (bytes >= (1ULL << 20)) {
+        snprintf(text, sizeof(text), "%.2f MiB", bytes / (double)(1ULL << 20));
+    } else if (bytes >= (1ULL << 10)) {
+        snprintf(text, sizeof(text), "%.2f KiB", bytes / (double)(1ULL << 10));
+    } else {
+        snprintf(text, sizeof(text), "%llu B", (unsigned long long)bytes);
+    }
+    return text;
+}
+
+std::string FormatNs(uint64_t ns) {
+    char text[32];
+    if (ns == 0) {
+        snprintf(text, sizeof(text), "-");
+    } else if (ns >= 1000000000ULL) {
+        snprintf(text, sizeof(text), "%.2fs", ns / 1e9);
+    } else if (ns >= 1000000ULL) {
+        snprintf(text, sizeof(text), "%.2fms", ns / 1e6);
+    } else if (ns >= 1000ULL) {
+        snprintf(text, sizeof(text), "%.1fus", ns / 1e3);
+    } else {
+        snprintf(text, sizeof(text), "%lluns", (unsigned long long)ns);
+    }
+    return text;
+}
+
+void PrintHistogram(const char* name, const GhostLatencyHistogram& histogram) {
+    printf("  %-8s %10llu  %9s %9s %9s %9s\n", name,
+           (unsigned long long)histogram.Count(),
+           FormatNs(histogram.Percentile(0.50)).c_str(),
+           FormatNs(histogram.Percentile(0.90)).c_str(),
+           FormatNs(histogram.Percentile(0.99)).c_str(),
+           FormatNs(histogram.Percentile(0.999)).c_str());
+}
+
+bool ProcessAlive(uint64_t pid) {
+#ifdef _WIN32
+    (void)pid;
+    return true;  // The mapping disappears with the process on Windows
+#else
+    return kill((pid_t)pid, 0) == 0 || errno == EPERM;
+#endif
+}
+
+void PrintScreen(const char* name, const GhostStatsBlock& block,
+                 const Snapshot& previous, const Snapshot& current, bool clear) {
+    double seconds = std::chrono::duration<double>(current.taken - previous.taken).count();
+    if (seconds <= 0.0) {
+        seconds = 1.0;
+    }
+
+    uint64_t page_size = block.page_size.load(std::memory_order_relaxed);
+    uint64_t resident = block.resident_pages.load(std::memory_order_relaxed);
+    uint64_t frozen = block.frozen_pages.load(std::memory_order_relaxed);
+    uint64_t compressed = block.compressed_bytes.load(std::memory_order_relaxed);
+    uint64_t disk = block.disk_bytes.load(std::memory_order_relaxed);
+    uint64_t budget = block.budget_pages.load(std::memory_order_relaxed);
+
+    if (clear) {
+        printf("\033[H\033[2J");
+    }
+    printf("ghostmem_top - %s (pid %llu)\n\n", name,
+           (unsigned long long)block.pid.load(std::memory_order_relaxed));
+
+    printf("Rates (per second)\n");
+    printf("  faults %10.1f   refaults %10.1f   thrash %8.1f\n",
+           (current.page_faults - previous.page_faults) / seconds,
+           (current.refaults - previous.refaults) / seconds,
+           (current.thrash_refaults - previous.thrash_refaults) / seconds);
+    printf("  evictions %7.1f   idle freezes %6.1f\n",
+           (current.evictions - previous.evictions) / seconds,
+           (current.idle_freezes - previous.idle_freezes) / seconds);
+    printf("  compressing %5.1f%% of the time, LZ4 acceleration %llu\n\n",
+           (current.compression_ns - previous.compression_ns) / (seconds * 1e7),
+           (unsigned long long)block.compression_acceleration.load(std::memory_order_relaxed));
+
+    printf("Memory\n");
+    printf("  resident   %8llu / %llu pages  (%s)\n",
+           (unsigned long long)resident, (unsigned long long)budget,
+           FormatBytes(resident * page_size).c_str());
+    printf("  frozen     %8llu pages\n", (unsigned long long)frozen);
+    printf("  compressed %s in RAM", FormatBytes(compressed).c_str());
+    if (compressed > 0 && disk == 0) {
+        printf("  (ratio %.2f:1)", (double)(frozen * page_size) / (double)compressed);
+    }
+    printf("\n  swap file  %s\n\n", FormatBytes(disk).c_str());
+
+    printf("Latency    %10s  %9s %9s %9s %9s\n", "samples", "p50", "p90", "p99", "p99.9");
+    PrintHistogram("fault", block.fault_latency);
+    PrintHistogram("restore", block.restore_latency);
+    PrintHistogram("freeze", block.freeze_latency);
+    printf("\nTotals: %llu faults, %llu refaults, %llu evictions\n",
+           (unsigned long long)current.page_faults,
+           (unsigned long long)current.refaults,
+           (unsigned long long)current.evictions);
+    fflush(stdout);
+}
+
+void PrintUsage() {
+    printf("Usage: ghostmem_top <segment-name> [-i interval_ms] [-n iterations] [--once]\n\n");
+    printf("Shows live statistics of a process that set GhostConfig::stats_shm_name.\n");
+    printf("  -i interval_ms  Refresh interval (default 1000)\n");
+    printf("  -n iterations   Exit after this many refreshes (default: run forever)\n");
+    printf("  --once          Print one sample without clearing the screen and exit\n");
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const char* name = nullptr;
+    int interval_ms = 1000;
+    long iterations = -1;
+    bool once = false;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-h") == 0 || strcmp(argv[i], "--help") == 0) {
+            PrintUsage();
+            return 0;
+        } else if (strcmp(argv[i], "-i") == 0 && i + 1 < argc) {
+            interval_ms = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "-n") == 0 && i + 1 < argc) {
+            iterations = atol(argv[++i]);
+        } else if (strcmp(argv[i], "--once") == 0) {
+            once = true;
+        } else if (argv[i][0] != '-' && name == nullptr) {
+            name = argv[i];
+        } else {
+            PrintUsage();
+            return 2;
+        }
+    }
+
+    if (name == nullptr) {
+        PrintUsage();
+        return 2;
+    }
+    if (interval_ms <= 0) {
+        interval_ms = 1000;
+    }
+
+    GhostSharedMemory segment;
+    if (!segment.Open(name, sizeof(GhostStatsBlock), false, true)) {
+        fprintf(stderr, "ghostmem_top: cannot open statistics segment '%s'\n", name);
+        return 1;
+    }
+
+    const GhostStatsBlock& block = *static_cast<const GhostStatsBlock*>(segment.Data());
+    if (!block.IsValid()) {
+        fprintf(stderr, "ghostmem_top: '%s' is not a GhostMem statistics segment "
+                        "(or was written by an incompatible version)\n", name);
+        return 1;
+    }
+
+    Snapshot previous = TakeSnapshot(block);
+    if (once) {
+        // Rates need two samples - take a short one
+        std::this_thread::sleep_for(std::chrono::milliseconds(interval_ms < 200 ? interval_ms : 200));
+        PrintScreen(name, block, previous, TakeSnapshot(block), false);
+        return 0;
+    }
+
+    for (long n = 0; iterations < 0 || n < iterations; n++) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(interval_ms));
+        Snapshot current = TakeSnapshot(block);
+        PrintScreen(name, block, previous, current, true);
+        previous = current;
+
+        if (!ProcessAlive(block.pid.load(std::memory_order_relaxed))) {
+            printf("\nProcess has exited.\n");
+            return 0;
+        }
+    }
+    return 0;
+}